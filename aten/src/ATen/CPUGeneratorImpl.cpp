@@ -45,6 +45,17 @@ struct CPUGeneratorImplState {
   bool is_next_float_normal_sample_valid;
 };
 
+/**
+ * CPUGeneratorImplStatePhilox is CPUGeneratorImplState followed by the
+ * offset of the Philox engine. It is only produced by get_state() once
+ * the Philox engine has been used, so the state of a generator that only
+ * ran the mt19937 engine keeps the size of CPUGeneratorImplState.
+ */
+struct CPUGeneratorImplStatePhilox {
+  CPUGeneratorImplState state;
+  uint64_t philox_offset;
+};
+
 /**
  * PyTorch maintains a collection of default generators that get
  * initialized once. The purpose of these default generators is to
@@ -92,6 +103,7 @@ void CPUGeneratorImpl::set_current_seed(uint64_t seed) {
   next_float_normal_sample_.reset();
   next_double_normal_sample_.reset();
   engine_ = mt19937(seed);
+  philox_offset_ = 0;
 }
 
 /**
@@ -117,27 +129,34 @@ uint64_t CPUGeneratorImpl::seed() {
 /**
  * Sets the internal state of CPUGeneratorImpl. The new internal state
  * must be a strided CPU byte tensor and of the same size as either
- * CPUGeneratorImplStateLegacy (for legacy CPU generator state) or
- * CPUGeneratorImplState (for new state).
+ * CPUGeneratorImplStateLegacy (for legacy CPU generator state),
+ * CPUGeneratorImplState (for new state) or CPUGeneratorImplStatePhilox
+ * (for new state with a Philox offset).
  *
  * FIXME: Remove support of the legacy state in the future?
  */
 void CPUGeneratorImpl::set_state(const c10::TensorImpl& new_state) {
   using detail::CPUGeneratorImplState;
   using detail::CPUGeneratorImplStateLegacy;
+  using detail::CPUGeneratorImplStatePhilox;
 
   static_assert(std::is_pod<CPUGeneratorImplStateLegacy>::value, "CPUGeneratorImplStateLegacy is not a PODType");
   static_assert(std::is_pod<CPUGeneratorImplState>::value, "CPUGeneratorImplState is not a PODType");
+  static_assert(std::is_pod<CPUGeneratorImplStatePhilox>::value, "CPUGeneratorImplStatePhilox is not a PODType");
 
   static const size_t size_legacy = sizeof(CPUGeneratorImplStateLegacy);
   static const size_t size_current = sizeof(CPUGeneratorImplState);
+  static const size_t size_philox = sizeof(CPUGeneratorImplStatePhilox);
   static_assert(size_legacy != size_current, "CPUGeneratorImplStateLegacy and CPUGeneratorImplState can't be of the same size");
+  static_assert(size_philox != size_current && size_philox != size_legacy,
+                "CPUGeneratorImplStatePhilox can't be of the same size as the other states");
 
   detail::check_rng_state(new_state);
 
   at::mt19937 engine;
   auto float_normal_sample = c10::optional<float>();
   auto double_normal_sample = c10::optional<double>();
+  uint64_t philox_offset = 0;
 
   // Construct the state of at::CPUGeneratorImpl based on input byte tensor size.
   CPUGeneratorImplStateLegacy* legacy_pod;
@@ -158,8 +177,12 @@ void CPUGeneratorImpl::set_state(const c10::TensorImpl& new_state) {
       // we return the sin version of the normal sample when in caching mode
       double_normal_sample = c10::optional<double>(r * ::sin(theta));
     }
-  } else if (new_state_size == size_current) {
+  } else if (new_state_size == size_current || new_state_size == size_philox) {
     auto rng_state = (CPUGeneratorImplState*)new_state.data();
+    if (new_state_size == size_philox) {
+      philox_offset = ((CPUGeneratorImplStatePhilox*)new_state.data())->philox_offset;
+      TORCH_CHECK(philox_offset % 4 == 0, "Invalid Philox offset");
+    }
     legacy_pod = &rng_state->legacy_pod;
     // update next_float_normal_sample
     if (rng_state->is_next_float_normal_sample_valid) {
@@ -175,7 +198,8 @@ void CPUGeneratorImpl::set_state(const c10::TensorImpl& new_state) {
     }
   } else {
     AT_ERROR("Expected either a CPUGeneratorImplStateLegacy of size ", size_legacy,
-             " or a CPUGeneratorImplState of size ", size_current,
+             ", a CPUGeneratorImplState of size ", size_current,
+             " or a CPUGeneratorImplStatePhilox of size ", size_philox,
              " but found the input RNG state size to be ", new_state_size);
   }
 
@@ -194,6 +218,7 @@ void CPUGeneratorImpl::set_state(const c10::TensorImpl& new_state) {
   this->engine_ = engine;
   this->next_float_normal_sample_ = float_normal_sample;
   this->next_double_normal_sample_ = double_normal_sample;
+  this->philox_offset_ = philox_offset;
 }
 
 /**
@@ -202,15 +227,18 @@ void CPUGeneratorImpl::set_state(const c10::TensorImpl& new_state) {
  */
 c10::intrusive_ptr<c10::TensorImpl> CPUGeneratorImpl::get_state() const {
   using detail::CPUGeneratorImplState;
+  using detail::CPUGeneratorImplStatePhilox;
 
-  static const size_t size = sizeof(CPUGeneratorImplState);
-  static_assert(std::is_pod<CPUGeneratorImplState>::value, "CPUGeneratorImplState is not a PODType");
+  static_assert(std::is_pod<CPUGeneratorImplStatePhilox>::value, "CPUGeneratorImplStatePhilox is not a PODType");
+  const size_t size = this->philox_offset_ != 0 ? sizeof(CPUGeneratorImplStatePhilox) : sizeof(CPUGeneratorImplState);
 
   auto state_tensor = at::detail::empty_cpu({(int64_t)size}, ScalarType::Byte, c10::nullopt, c10::nullopt, c10::nullopt, c10::nullopt);
   auto rng_state = state_tensor.data_ptr();
 
   // accumulate generator data to be copied into byte tensor
-  auto accum_state = std::make_unique<CPUGeneratorImplState>();
+  auto accum_philox_state = std::make_unique<CPUGeneratorImplStatePhilox>();
+  accum_philox_state->philox_offset = this->philox_offset_;
+  auto accum_state = &accum_philox_state->state;
   auto rng_data = this->engine_.data();
   accum_state->legacy_pod.the_initial_seed = rng_data.seed_;
   accum_state->legacy_pod.left = rng_data.left_;
@@ -232,7 +260,7 @@ c10::intrusive_ptr<c10::TensorImpl> CPUGeneratorImpl::get_state() const {
     accum_state->next_float_normal_sample = *(this->next_float_normal_sample_);
   }
 
-  memcpy(rng_state, accum_state.get(), size);
+  memcpy(rng_state, accum_philox_state.get(), size);
   return state_tensor.getIntrusivePtr();
 }
 
@@ -312,6 +340,44 @@ void CPUGeneratorImpl::set_engine(at::mt19937 engine) {
   engine_ = engine;
 }
 
+/**
+ * Sets the offset of the Philox engine, in 32 bit randoms
+ *
+ * See Note [Acquire lock when using random generators]
+ */
+void CPUGeneratorImpl::set_philox_offset(uint64_t offset) {
+  // the offset has to fall on a Philox counter, see philox_engine_inputs
+  TORCH_CHECK(offset % 4 == 0, "offset must be a multiple of 4");
+  philox_offset_ = offset;
+}
+
+/**
+ * Gets the offset of the Philox engine, in 32 bit randoms
+ */
+uint64_t CPUGeneratorImpl::philox_offset() const {
+  return philox_offset_;
+}
+
+/**
+ * Gets the seed and the offset to start a Philox engine at for a kernel
+ * that draws `increment` 32 bit randoms, and advances the offset past them.
+ * The seed is the current seed of the generator, so the Philox stream
+ * restarts whenever the generator is reseeded. Same as
+ * CUDAGeneratorImpl::philox_engine_inputs, the offset counts 32 bit
+ * randoms and stays a multiple of 4, i.e. of one Philox counter; a kernel
+ * starts its engine at counter offset / 4.
+ *
+ * See Note [Acquire lock when using random generators]
+ */
+std::pair<uint64_t, uint64_t> CPUGeneratorImpl::philox_engine_inputs(uint64_t increment) {
+  // rounds increment up to the nearest multiple of 4
+  increment = ((increment + 3) / 4) * 4;
+  TORCH_INTERNAL_ASSERT(this->philox_offset_ % 4 == 0);
+  uint64_t offset = this->philox_offset_;
+  this->philox_offset_ += increment;
+  return std::make_pair(this->current_seed(), offset);
+}
+
 /**
  * Public clone method implementation
  *
@@ -331,6 +397,7 @@ CPUGeneratorImpl* CPUGeneratorImpl::clone_impl() const {
   gen->set_engine(engine_);
   gen->set_next_float_normal_sample(next_float_normal_sample_);
   gen->set_next_double_normal_sample(next_double_normal_sample_);
+  gen->set_philox_offset(philox_offset_);
   return gen;
 }
 
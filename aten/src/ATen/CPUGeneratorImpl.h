@@ -28,12 +28,16 @@ struct TORCH_API CPUGeneratorImpl : public c10::GeneratorImpl {
   void set_next_double_normal_sample(c10::optional<double> randn);
   at::mt19937 engine();
   void set_engine(at::mt19937 engine);
+  void set_philox_offset(uint64_t offset);
+  uint64_t philox_offset() const;
+  std::pair<uint64_t, uint64_t> philox_engine_inputs(uint64_t increment);
 
 private:
   CPUGeneratorImpl* clone_impl() const override;
   at::mt19937 engine_;
   c10::optional<float> next_float_normal_sample_;
   c10::optional<double> next_double_normal_sample_;
+  uint64_t philox_offset_ = 0;
 };
 
 namespace detail {
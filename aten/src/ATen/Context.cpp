@@ -267,6 +267,22 @@ void Context::setDisplayVmapFallbackWarnings(bool enabled) {
   display_vmap_fallback_warnings_ = enabled;
 }
 
+bool Context::cacheTensorIteratorPlans() const {
+  return cache_tensor_iterator_plans_;
+}
+
+void Context::setCacheTensorIteratorPlans(bool enabled) {
+  cache_tensor_iterator_plans_ = enabled;
+}
+
+bool Context::usePhiloxCPURNG() const {
+  return use_philox_cpu_rng_;
+}
+
+void Context::setUsePhiloxCPURNG(bool enabled) {
+  use_philox_cpu_rng_ = enabled;
+}
+
 void Context::setDefaultMobileCPUAllocator() {
   TORCH_CHECK(prev_allocator_ptr_ == nullptr,
       "Already within the scope of another non-default cpu allocator."
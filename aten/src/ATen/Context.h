@@ -202,6 +202,16 @@ class TORCH_API Context {
   void setDisplayVmapFallbackWarnings(bool enabled);
   bool areVmapFallbackWarningsEnabled() const;
 
+  // Opt-in cache of TensorIterator geometry for repeated same-shape
+  // elementwise calls, see NOTE: [TensorIterator plan cache].
+  bool cacheTensorIteratorPlans() const;
+  void setCacheTensorIteratorPlans(bool);
+
+  // Draw the randoms of CPU uniform_, normal_ and bernoulli_ from the
+  // counter based Philox engine, in parallel, see Note [Philox CPU RNG].
+  bool usePhiloxCPURNG() const;
+  void setUsePhiloxCPURNG(bool);
+
   void setDefaultMobileCPUAllocator();
   void unsetDefaultMobileCPUAllocator();
 
@@ -232,6 +242,8 @@ class TORCH_API Context {
   bool release_original_weights = false;
   #endif
   bool display_vmap_fallback_warnings_ = false;
+  bool cache_tensor_iterator_plans_ = false;
+  bool use_philox_cpu_rng_ = false;
   c10::optional<at::QEngine> quantized_engine = c10::nullopt;
   std::unique_ptr<THCState, void(*)(THCState*)> thc_state;
   std::unique_ptr<THHState, void(*)(THHState*)> thh_state;
@@ -517,58 +517,6 @@ Tensor & _th_renorm_(Tensor & self, const Scalar& p, int64_t dim, const Scalar&
     }
     return self;
 }
-Tensor & _th_histc_out(Tensor & result, const Tensor & self, int64_t bins, const Scalar& min, const Scalar& max) {
-    // DeviceGuard omitted
-    auto dispatch_scalar_type = infer_scalar_type(self);
-
-    switch (dispatch_scalar_type) {
-        case ScalarType::Double: {
-            auto result_ = checked_dense_tensor_unwrap(result, "result", 0, "_th_histc_out", false, DeviceType::CPU, dispatch_scalar_type);
-            auto self_ = checked_dense_tensor_unwrap(self, "self", 1, "_th_histc_out", false, DeviceType::CPU, dispatch_scalar_type);
-            auto min_ = min.toDouble();
-            auto max_ = max.toDouble();
-            THDoubleTensor_histc(result_, self_, bins, min_, max_);
-            break;
-        }
-        case ScalarType::Float: {
-            auto result_ = checked_dense_tensor_unwrap(result, "result", 0, "_th_histc_out", false, DeviceType::CPU, dispatch_scalar_type);
-            auto self_ = checked_dense_tensor_unwrap(self, "self", 1, "_th_histc_out", false, DeviceType::CPU, dispatch_scalar_type);
-            auto min_ = min.toFloat();
-            auto max_ = max.toFloat();
-            THFloatTensor_histc(result_, self_, bins, min_, max_);
-            break;
-        }
-        default:
-            AT_ERROR("_th_histc_out not supported on CPUType for ", dispatch_scalar_type);
-    }
-    return result;
-}
-Tensor _th_histc(const Tensor & self, int64_t bins, const Scalar& min, const Scalar& max) {
-    // DeviceGuard omitted
-    auto dispatch_scalar_type = infer_scalar_type(self);
-    auto result_ = c10::make_intrusive<TensorImpl, UndefinedTensorImpl>(c10::Storage(c10::Storage::use_byte_size_t(), 0, allocator(), true),DispatchKey::CPU, scalarTypeToTypeMeta(dispatch_scalar_type)).release();
-    auto result = Tensor(c10::intrusive_ptr<TensorImpl, UndefinedTensorImpl>::reclaim(result_));
-    switch (dispatch_scalar_type) {
-        case ScalarType::Double: {
-            auto self_ = checked_dense_tensor_unwrap(self, "self", 1, "_th_histc", false, DeviceType::CPU, dispatch_scalar_type);
-            auto min_ = min.toDouble();
-            auto max_ = max.toDouble();
-            THDoubleTensor_histc(result_, self_, bins, min_, max_);
-            break;
-        }
-        case ScalarType::Float: {
-            auto self_ = checked_dense_tensor_unwrap(self, "self", 1, "_th_histc", false, DeviceType::CPU, dispatch_scalar_type);
-            auto min_ = min.toFloat();
-            auto max_ = max.toFloat();
-            THFloatTensor_histc(result_, self_, bins, min_, max_);
-            break;
-        }
-        default:
-            AT_ERROR("_th_histc not supported on CPUType for ", dispatch_scalar_type);
-    }
-    return result;
-}
-
 std::tuple<Tensor &,Tensor &> _th_gels_out(Tensor & res1, Tensor & res2, const Tensor & self, const Tensor & A) {
     // DeviceGuard omitted
     auto dispatch_scalar_type = infer_scalar_type(self);
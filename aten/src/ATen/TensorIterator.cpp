@@ -7,6 +7,11 @@
 #include <ATen/MemoryOverlap.h>
 #include <ATen/native/Resize.h>
 #include <ATen/TensorOperators.h>
+#include <ATen/Context.h>
+#include <c10/util/hash.h>
+
+#include <atomic>
+#include <unordered_map>
 
 namespace at {
 
@@ -1062,11 +1067,10 @@ int TensorIteratorBase::get_dim_to_split() const {
   return dim_to_split;
 }
 
-bool TensorIteratorBase::fast_set_up(const TensorIteratorConfig& config) {
+bool TensorIteratorBase::fast_set_up(FastSetupType setup_type) {
   // This function tries to do a fast setup to avoid needless reordering of dimensions and tracking output strides
   // Return true if it can do fast setup or false otherwise
   // TODO enable fast handling for reductions
-  FastSetupType setup_type = compute_fast_setup_type(config);
   if (setup_type == FastSetupType::NONE) {
     return false;
   }
@@ -1185,6 +1189,145 @@ FastSetupType TensorIteratorBase::compute_fast_setup_type(const TensorIteratorCo
   return FastSetupType::NONE;
 }
 
+// NOTE: [TensorIterator plan cache]
+// For small elementwise ops, building the TensorIterator can cost more than
+// running the kernel: compute_shape broadcasts the operands, and unless fast
+// setup applies the strides are broadcast, the dimensions sorted by stride
+// and then coalesced. Our serving workloads call the same ops on the same
+// shapes over and over, so with at::globalContext().setCacheTensorIteratorPlans(true)
+// the outcome of these steps is cached as a TensorIteratorPlan.
+//
+// The plan is a pure function of the configuration flags and of the dtype,
+// device, sizes and strides of the operands (which also captures the memory
+// format), so that is what it is keyed on. It does not depend on the op: all
+// the ops built from the same configuration share their plans. A hit skips
+// straight to allocating the outputs with the cached permutation and then
+// installs the cached shape and strides. The steps that look at the tensors
+// themselves (memory overlap checks, type checks, allocating the outputs)
+// still run on every build.
+//
+// Only plain elementwise builds are cached: no reductions, static shapes,
+// named or meta tensors, and nothing that needed temporaries for type
+// promotion. Plans are cached per thread, so lookups need no lock.
+struct TensorIteratorPlan {
+  // Broadcast shape computed by compute_shape.
+  DimVector shape;
+  FastSetupType setup_type = FastSetupType::NONE;
+  // The rest is only used when setup_type is NONE: perm_ and shape_ as
+  // reorder_dimensions left them, which allocate_or_resize_outputs needs,
+  // and shape_ and the stride_bytes of every operand after coalescing.
+  DimVector perm;
+  DimVector permuted_shape;
+  DimVector coalesced_shape;
+  SmallVector<StrideVector, 4> stride_bytes;
+  bool has_coalesced_dimensions = false;
+};
+
+namespace {
+
+using PlanKey = std::vector<int64_t>;
+
+struct PlanKeyHash {
+  size_t operator()(const PlanKey& key) const {
+    size_t hash = 0;
+    for (int64_t value : key) {
+      hash = c10::hash_combine(hash, static_cast<size_t>(value));
+    }
+    return hash;
+  }
+};
+
+// Bound on the plans of a thread, the cache starts over once it is reached.
+constexpr size_t kMaxPlansPerThread = 4096;
+
+// Clearing bumps the epoch, and each thread drops its plans on its next
+// lookup.
+std::atomic<int64_t> plan_cache_epoch{0};
+std::atomic<int64_t> plan_cache_hits{0};
+std::atomic<int64_t> plan_cache_misses{0};
+
+struct PlanCache {
+  int64_t epoch = 0;
+  std::unordered_map<PlanKey, TensorIteratorPlan, PlanKeyHash> plans;
+  // Reused for every lookup so that a hit does not allocate.
+  PlanKey key;
+};
+
+PlanCache& thread_plan_cache() {
+  thread_local PlanCache cache;
+  int64_t epoch = plan_cache_epoch.load(std::memory_order_relaxed);
+  if (cache.epoch != epoch) {
+    cache.plans.clear();
+    cache.epoch = epoch;
+  }
+  return cache;
+}
+
+} // namespace
+
+TensorIteratorPlanCacheStats tensor_iterator_plan_cache_stats() {
+  TensorIteratorPlanCacheStats stats;
+  stats.hits = plan_cache_hits.load(std::memory_order_relaxed);
+  stats.misses = plan_cache_misses.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void clear_tensor_iterator_plan_cache() {
+  plan_cache_epoch.fetch_add(1, std::memory_order_relaxed);
+  plan_cache_hits.store(0, std::memory_order_relaxed);
+  plan_cache_misses.store(0, std::memory_order_relaxed);
+}
+
+void TensorIteratorBase::compute_plan_key(const TensorIteratorConfig& config, PlanKey& key) const {
+  key.clear();
+  key.push_back(
+      (config.resize_outputs_ << 0) |
+      (config.check_all_same_dtype_ << 1) |
+      (config.check_all_same_device_ << 2) |
+      (config.enforce_safe_casting_to_output_ << 3) |
+      (config.promote_inputs_to_common_dtype_ << 4) |
+      (config.promote_integer_inputs_to_float_ << 5) |
+      (config.cast_common_dtype_to_outputs_ << 6) |
+      (config.allow_cpu_scalars_ << 7));
+  if (config.static_dtype_and_device_.has_value()) {
+    key.push_back(static_cast<int64_t>(config.static_dtype_and_device_->first));
+    key.push_back(static_cast<int64_t>(config.static_dtype_and_device_->second.type()));
+    key.push_back(config.static_dtype_and_device_->second.index());
+  } else {
+    key.push_back(-1);
+  }
+  key.push_back(num_outputs_);
+  for (const auto& op : operands_) {
+    if (!op.tensor.defined()) {
+      key.push_back(-1);
+      continue;
+    }
+    key.push_back(static_cast<int64_t>(op.current_dtype));
+    key.push_back(static_cast<int64_t>(op.device.type()));
+    key.push_back(op.device.index());
+    key.push_back(op.is_read_write);
+    key.push_back(op.tensor.dim());
+    auto sizes = op.tensor.sizes();
+    key.insert(key.end(), sizes.begin(), sizes.end());
+    auto strides = op.tensor.strides();
+    key.insert(key.end(), strides.begin(), strides.end());
+  }
+}
+
+void TensorIteratorBase::apply_plan(const TensorIteratorPlan& plan) {
+  if (fast_set_up(plan.setup_type)) {
+    return;
+  }
+  perm_ = plan.perm;
+  shape_ = plan.permuted_shape;
+  allocate_or_resize_outputs();
+  shape_ = plan.coalesced_shape;
+  for (int i = 0; i < ntensors(); i++) {
+    operands_[i].stride_bytes = plan.stride_bytes[i];
+  }
+  has_coalesced_dimensions_ = plan.has_coalesced_dimensions;
+}
+
 TensorIteratorBase::TensorIteratorBase() {}
 
 void TensorIteratorBase::build(TensorIteratorConfig& config) {
@@ -1200,22 +1343,74 @@ void TensorIteratorBase::build(TensorIteratorConfig& config) {
   compute_mem_overlaps(config);
   // Check that input dimensions are aligned correctly & compute outnames.
   compute_names(config);
+  // look up the cached geometry, see NOTE: [TensorIterator plan cache]
+  PlanCache* plan_cache = nullptr;
+  const TensorIteratorPlan* plan = nullptr;
+  if (globalContext().cacheTensorIteratorPlans() && !is_reduction_ &&
+      !config.static_shape_.has_value() && !is_meta_ && names_.empty()) {
+    plan_cache = &thread_plan_cache();
+    compute_plan_key(config, plan_cache->key);
+    auto it = plan_cache->plans.find(plan_cache->key);
+    if (it != plan_cache->plans.end()) {
+      plan = &it->second;
+    }
+  }
   // compute the broadcasted shape
-  compute_shape(config);
+  if (plan) {
+    shape_ = plan->shape;
+  } else {
+    compute_shape(config);
+  }
   // mark outputs for resizing if necessary
   mark_resize_outputs(config);
   // compute the result dtype and device
   compute_types(config);
-  // try fast setup output tensor, if failed, fallback to normal setup
-  if (!fast_set_up(config)) {
-    // compute each tensor's stride after broadcasting
-    compute_strides(config);
-    // re-order dimensions to improve coalescing
-    reorder_dimensions();
-    // allocate the output tensor if it's not provided
-    allocate_or_resize_outputs();
-    // coalesce adjacent dimensions when possible
-    if (!is_meta_) coalesce_dimensions();
+  // temporaries for type promotion are not part of the plan
+  if (plan_cache && std::any_of(operands_.begin(), operands_.end(),
+                                [](const OperandInfo& op) { return op.original_tensor.defined(); })) {
+    plan_cache = nullptr;
+    plan = nullptr;
+  }
+
+  if (plan) {
+    apply_plan(*plan);
+    plan_cache_hits.fetch_add(1, std::memory_order_relaxed);
+  } else {
+    TensorIteratorPlan new_plan;
+    if (plan_cache) {
+      new_plan.shape = shape_;
+    }
+    // try fast setup output tensor, if failed, fallback to normal setup
+    FastSetupType setup_type = compute_fast_setup_type(config);
+    if (!fast_set_up(setup_type)) {
+      // compute each tensor's stride after broadcasting
+      compute_strides(config);
+      // re-order dimensions to improve coalescing
+      reorder_dimensions();
+      if (plan_cache) {
+        new_plan.perm = perm_;
+        new_plan.permuted_shape = shape_;
+      }
+      // allocate the output tensor if it's not provided
+      allocate_or_resize_outputs();
+      // coalesce adjacent dimensions when possible
+      if (!is_meta_) coalesce_dimensions();
+      if (plan_cache) {
+        new_plan.coalesced_shape = shape_;
+        for (const auto& op : operands_) {
+          new_plan.stride_bytes.push_back(op.stride_bytes);
+        }
+        new_plan.has_coalesced_dimensions = has_coalesced_dimensions_;
+      }
+    }
+    if (plan_cache) {
+      new_plan.setup_type = setup_type;
+      if (plan_cache->plans.size() >= kMaxPlansPerThread) {
+        plan_cache->plans.clear();
+      }
+      plan_cache->plans.emplace(plan_cache->key, std::move(new_plan));
+      plan_cache_misses.fetch_add(1, std::memory_order_relaxed);
+    }
   }
 
   if (is_meta_) return;
@@ -140,6 +140,18 @@ enum class FastSetupType : uint8_t {
 
 class TensorIteratorConfig;
 struct TensorIterator;
+struct TensorIteratorPlan;
+
+/// Counters of the TensorIterator plan cache since it was last cleared.
+/// See NOTE: [TensorIterator plan cache].
+struct TensorIteratorPlanCacheStats {
+  int64_t hits = 0;
+  int64_t misses = 0;
+};
+
+TORCH_API TensorIteratorPlanCacheStats tensor_iterator_plan_cache_stats();
+/// Drops the cached plans of every thread and resets the counters.
+TORCH_API void clear_tensor_iterator_plan_cache();
 
 struct TORCH_API TensorIteratorBase : public impl::MetaBase {
   using DimMask = std::bitset<64>;
@@ -348,8 +360,10 @@ protected:
   void compute_types(const TensorIteratorConfig&);
   ScalarType compute_common_dtype();
   void allocate_or_resize_outputs();
-  bool fast_set_up(const TensorIteratorConfig&);
+  bool fast_set_up(FastSetupType setup_type);
   FastSetupType compute_fast_setup_type(const TensorIteratorConfig&);
+  void compute_plan_key(const TensorIteratorConfig&, std::vector<int64_t>& key) const;
+  void apply_plan(const TensorIteratorPlan&);
   void compute_names(const TensorIteratorConfig&);
   void propagate_names_to_outputs();
   void coalesce_dimensions();
@@ -138,6 +138,20 @@ void avg_pool2d_out_cpu_template(
     inputHeight, inputWidth,
     outputHeight, outputWidth, input_.suggest_memory_format());
 
+  /* channels last inputs are pooled in place of their memory format */
+  if (input_.ndimension() == 4
+      && input_.suggest_memory_format() == at::MemoryFormat::ChannelsLast
+      && at::isFloatingType(input_.scalar_type())) {
+    output.resize_({nbatch, nInputPlane, outputHeight, outputWidth}, at::MemoryFormat::ChannelsLast);
+    avg_pool2d_channels_last_kernel(
+      kCPU, output, input_,
+      kW, kH, dW, dH,
+      padW, padH,
+      count_include_pad,
+      divisor_override);
+    return;
+  }
+
   if (input_.ndimension() == 3) {
     output.resize_({nInputPlane, outputHeight, outputWidth});
   }
@@ -421,5 +435,7 @@ Tensor avg_pool2d_backward_cpu(
   return gradInput;
 }
 
+DEFINE_DISPATCH(avg_pool2d_channels_last_kernel);
+
 } // at::native
 } // at
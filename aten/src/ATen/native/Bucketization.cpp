@@ -1,7 +1,10 @@
 #include <ATen/Dispatch.h>
+#include <ATen/NumericUtils.h>
 #include <ATen/Parallel.h>
 #include <ATen/native/BucketizationUtils.h>
 
+#include <algorithm>
+
 /* Implement a TF like searchsorted and a bucketize function running on cpu
  *
  * - torch.searchsorted(sorted_sequence, values, right=False, out_int32=False)
@@ -43,8 +46,68 @@ const input_t* cus_lower_bound(const input_t* start, const input_t* end, input_t
   return start;
 }
 
+// number of values searched in lock step by searchsorted_cpu_1d_boundaries
+constexpr int64_t SEARCHSORTED_BLOCK_SIZE = 16;
+
+// The comparisons of cus_lower_bound (right = false) and std::upper_bound
+// (right = true): true when the search must go past bd.
+template<bool right, typename input_t>
+inline bool searchsorted_goes_right(input_t bd, input_t val) {
+  return right ? !(val < bd) : !(bd >= val);
+}
+
+// All the values are searched in the same 1d boundaries. Every search is
+// branchless and takes the same ceil(log2(idim_bd)) steps whatever its value,
+// so a block of values is searched in lock step: the loads of one step are
+// independent of each other and overlap in the memory system instead of
+// stalling one search at a time, and no branch is mispredicted.
+template<typename input_t, typename output_t, bool right>
+void searchsorted_cpu_1d_boundaries(Tensor& result, const Tensor& input, const Tensor& boundaries) {
+  const int64_t numel_in = input.numel();
+  const int64_t idim_bd = boundaries.numel();
+  const input_t *data_in = input.data_ptr<input_t>();
+  const input_t *data_bd = boundaries.data_ptr<input_t>();
+  output_t *data_out = result.data_ptr<output_t>();
+
+  at::parallel_for(0, numel_in, SEARCHSORTED_GRAIN_SIZE, [&](int64_t start, int64_t end) {
+    int64_t base[SEARCHSORTED_BLOCK_SIZE];
+    for (int64_t i = start; i < end; i += SEARCHSORTED_BLOCK_SIZE) {
+      const int64_t n = std::min(SEARCHSORTED_BLOCK_SIZE, end - i);
+      const input_t *block_in = data_in + i;
+      std::fill_n(base, n, 0);
+      // the answer of value k is in [base[k], base[k] + len]
+      for (int64_t len = idim_bd; len > 1; len -= len / 2) {
+        const int64_t half = len / 2;
+        for (int64_t k = 0; k < n; ++k) {
+          base[k] += searchsorted_goes_right<right>(data_bd[base[k] + half], block_in[k]) ? half : 0;
+        }
+      }
+      for (int64_t k = 0; k < n; ++k) {
+        // type conversion might happen here
+        data_out[i + k] = base[k] + searchsorted_goes_right<right>(data_bd[base[k]], block_in[k]);
+      }
+    }
+  });
+}
+
 template<typename input_t, typename output_t>
 void searchsorted_cpu_contiguous(Tensor& result, const Tensor& input, const Tensor& boundaries, const bool& right) {
+  // The lock step search relies on the boundaries being ordered, which nan
+  // boundaries are not: keep the results of the plain binary search for them.
+  if (boundaries.dim() == 1 && boundaries.numel() > 0) {
+    const input_t *data_bd = boundaries.data_ptr<input_t>();
+    const bool has_nan = std::any_of(data_bd, data_bd + boundaries.numel(),
+                                     [](input_t bd) { return _isnan(bd); });
+    if (!has_nan) {
+      if (right) {
+        searchsorted_cpu_1d_boundaries<input_t, output_t, true>(result, input, boundaries);
+      } else {
+        searchsorted_cpu_1d_boundaries<input_t, output_t, false>(result, input, boundaries);
+      }
+      return;
+    }
+  }
+
   int64_t numel_in = input.numel();
   bool is_scalar_input = input.dim() == 0 && numel_in == 1;
   // inner most dim size of input and boundaries
@@ -1,6 +1,7 @@
 #include <ATen/ATen.h>
 #include <ATen/Parallel.h>
 #include <ATen/native/ConvUtils.h>
+#include <ATen/native/cpu/ConvChannelsLastKernel.h>
 #include <ATen/native/cpu/DepthwiseConvKernel.h>
 #include <ATen/native/utils/ParamUtils.h>
 #include <ATen/native/xnnpack/Engine.h>
@@ -22,6 +23,7 @@ constexpr int MIOPEN_DIM_MAX = 5;
 namespace at { namespace native {
 
 DEFINE_DISPATCH(convolution_depthwise3x3_winograd_stub);
+DEFINE_DISPATCH(convolution_channels_last_stub);
 
 struct ConvParams {
   std::vector<int64_t> stride;
@@ -44,6 +46,7 @@ struct ConvParams {
   bool is_stride_nonpos() const;
   void view1d_as_2d();
   bool use_cpu_depthwise3x3_winograd(const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const;
+  bool use_cpu_channels_last(const at::Tensor& input, const at::Tensor& weight, const at::Tensor& bias) const;
   bool needs_64bit_indexing_no_split(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_cudnn(const at::Tensor& input, const at::Tensor& weight) const;
   bool use_cudnn_depthwise(const at::Tensor& input, const at::Tensor& weight) const;
@@ -164,6 +167,31 @@ auto ConvParams::use_cpu_depthwise3x3_winograd(
 #endif
 }
 
+// The direct channels last kernel reads the input in place instead of
+// unfolding it, so it has no columns buffer to hand to the backward of the
+// slow convolutions; it is only used when no gradient is needed.
+auto ConvParams::use_cpu_channels_last(
+    const at::Tensor& input,
+    const at::Tensor& weight,
+    const at::Tensor& bias) const -> bool {
+  const bool requires_grad = input.requires_grad() || weight.requires_grad() ||
+      (bias.defined() && bias.requires_grad());
+  return (input.ndimension() == 4) &&
+         (weight.ndimension() == 4) &&
+         (input.device().is_cpu()) &&
+         (input.layout() == at::kStrided) &&
+         (weight.device().is_cpu()) &&
+         (weight.layout() == at::kStrided) &&
+         (input.scalar_type() == at::kFloat || input.scalar_type() == at::kDouble) &&
+         (weight.scalar_type() == input.scalar_type()) &&
+         (!bias.defined() ||
+            ((bias.device().is_cpu()) &&
+             (bias.scalar_type() == input.scalar_type()))) &&
+         (input.suggest_memory_format() == at::MemoryFormat::ChannelsLast) &&
+         !transposed &&
+         !(requires_grad && at::GradMode::is_enabled());
+}
+
 auto ConvParams::needs_64bit_indexing_no_split(const at::Tensor& input, const at::Tensor& weight) const -> bool {
   constexpr int64_t int_max = std::numeric_limits<int>::max();
   int64_t numel_input = input.numel();
@@ -791,6 +819,16 @@ at::Tensor _convolution(
         params.stride,
         params.padding,
         params.groups);
+  } else if (params.use_cpu_channels_last(input, weight, bias)) {
+    output = convolution_channels_last_stub(
+        input.device().type(),
+        input,
+        weight,
+        bias,
+        params.stride,
+        params.padding,
+        params.dilation,
+        params.groups);
   } else if (
         !params.transposed && (input.ndimension() == 5) &&
         (input.device().is_cpu()) &&
@@ -755,6 +755,215 @@ Tensor grid_sampler_2d_cpu(const Tensor& input, const Tensor& grid,
 DEFINE_DISPATCH(grid_sampler_2d_cpu_kernel);
 
 
+/**  NOTE [ Grid Sample Plans ]
+ *
+ *   When the same grid is applied to many inputs, the source locations,
+ *   interpolation weights and bounds checks only depend on the grid and on
+ *   the input spatial size. `_grid_sampler_2d_plan` computes them once into
+ *   two [N, H_out, W_out, K] tensors:
+ *     + `indices`, the offsets iy * W_in + ix of the K input pixels that an
+ *       output pixel is interpolated from, and
+ *     + `weights`, their interpolation weights,
+ *   with K = 4 for bilinear, 1 for nearest and 16 for bicubic interpolation,
+ *   and records [H_in, W_in] in `input_hw` so that the plan is only applied
+ *   to inputs of that spatial size.
+ *   Padding is resolved while planning: taps out of the input get index 0 and
+ *   weight 0, border and reflection taps point to the pixel they read.
+ *
+ *   `_grid_sampler_2d_apply_plan` then computes, for every channel,
+ *       output[n, c, p] = sum_k weights[n, p, k] * input[n, c, indices[n, p, k]]
+ *   skipping the taps of weight 0, and its backward scatters the gradient
+ *   with the same weights. A plan of batch size 1 is shared by all the inputs
+ *   of the batch. Channels last inputs are interpolated a vector of channels
+ *   at a time. The result only differs from grid_sampler_2d by the order of
+ *   the floating point operations, and the plan has no gradient w.r.t. grid.
+ */
+namespace {
+
+  int64_t grid_sampler_2d_plan_taps(GridSamplerInterpolation interpolation_mode) {
+    switch (interpolation_mode) {
+      case GridSamplerInterpolation::Bilinear:
+        return 4;
+      case GridSamplerInterpolation::Nearest:
+        return 1;
+      case GridSamplerInterpolation::Bicubic:
+        return 16;
+    }
+    TORCH_CHECK(false, "_grid_sampler_2d_plan(): unknown interpolation mode ",
+                static_cast<int64_t>(interpolation_mode));
+  }
+
+  template<typename scalar_t>
+  std::tuple<Tensor, Tensor, Tensor>
+  grid_sampler_2d_plan_cpu_impl(const Tensor& grid, int64_t inp_H, int64_t inp_W,
+                                GridSamplerInterpolation interpolation_mode,
+                                GridSamplerPadding padding_mode,
+                                bool align_corners) {
+    int64_t N = grid.size(0);
+    int64_t out_H = grid.size(1);
+    int64_t out_W = grid.size(2);
+    int64_t K = grid_sampler_2d_plan_taps(interpolation_mode);
+    auto indices = at::zeros({N, out_H, out_W, K}, grid.options().dtype(kLong));
+    auto weights = at::zeros({N, out_H, out_W, K}, grid.options());
+    int64_t *idx_ptr = indices.data_ptr<int64_t>();
+    scalar_t *w_ptr = weights.data_ptr<scalar_t>();
+    auto grid_acc = grid.accessor<scalar_t, 4>();
+
+    at::parallel_for(0, N * out_H * out_W, at::internal::GRAIN_SIZE / K, [&](int64_t start, int64_t end) {
+      for (int64_t p = start; p < end; ++p) {
+        int64_t n = p / (out_H * out_W);
+        int64_t h = p / out_W % out_H;
+        int64_t w = p % out_W;
+        scalar_t x = grid_acc[n][h][w][0];
+        scalar_t y = grid_acc[n][h][w][1];
+        int64_t *idx_ptr_p = idx_ptr + p * K;
+        scalar_t *w_ptr_p = w_ptr + p * K;
+        // taps out of the input keep index 0 and weight 0
+        auto set_tap = [&](int64_t k, int64_t iy, int64_t ix, scalar_t weight) {
+          if (within_bounds_2d(iy, ix, inp_H, inp_W)) {
+            idx_ptr_p[k] = iy * inp_W + ix;
+            w_ptr_p[k] = weight;
+          }
+        };
+
+        if (interpolation_mode == GridSamplerInterpolation::Bilinear) {
+          scalar_t ix = grid_sampler_compute_source_index(x, inp_W, padding_mode, align_corners);
+          scalar_t iy = grid_sampler_compute_source_index(y, inp_H, padding_mode, align_corners);
+          int64_t ix_nw = static_cast<int64_t>(std::floor(ix));
+          int64_t iy_nw = static_cast<int64_t>(std::floor(iy));
+          int64_t ix_se = ix_nw + 1;
+          int64_t iy_se = iy_nw + 1;
+          set_tap(0, iy_nw, ix_nw, (ix_se - ix) * (iy_se - iy));
+          set_tap(1, iy_nw, ix_se, (ix - ix_nw) * (iy_se - iy));
+          set_tap(2, iy_se, ix_nw, (ix_se - ix) * (iy - iy_nw));
+          set_tap(3, iy_se, ix_se, (ix - ix_nw) * (iy - iy_nw));
+        } else if (interpolation_mode == GridSamplerInterpolation::Nearest) {
+          scalar_t ix = grid_sampler_compute_source_index(x, inp_W, padding_mode, align_corners);
+          scalar_t iy = grid_sampler_compute_source_index(y, inp_H, padding_mode, align_corners);
+          set_tap(0, static_cast<int64_t>(std::nearbyint(iy)),
+                  static_cast<int64_t>(std::nearbyint(ix)), static_cast<scalar_t>(1));
+        } else if (interpolation_mode == GridSamplerInterpolation::Bicubic) {
+          // as in _grid_sampler_2d_cpu_fallback, the padding is applied to
+          // every tap rather than to the unnormalized location
+          scalar_t ix = grid_sampler_unnormalize(x, inp_W, align_corners);
+          scalar_t iy = grid_sampler_unnormalize(y, inp_H, align_corners);
+          scalar_t ix_nw = std::floor(ix);
+          scalar_t iy_nw = std::floor(iy);
+          scalar_t x_coeffs[4];
+          scalar_t y_coeffs[4];
+          get_cubic_upsample_coefficients<scalar_t>(x_coeffs, ix - ix_nw);
+          get_cubic_upsample_coefficients<scalar_t>(y_coeffs, iy - iy_nw);
+          for (int64_t i = 0; i < 4; ++i) {
+            scalar_t tap_y = compute_coordinates(iy_nw - 1 + i, inp_H, padding_mode, align_corners);
+            for (int64_t j = 0; j < 4; ++j) {
+              scalar_t tap_x = compute_coordinates(ix_nw - 1 + j, inp_W, padding_mode, align_corners);
+              set_tap(i * 4 + j, static_cast<int64_t>(tap_y), static_cast<int64_t>(tap_x),
+                      y_coeffs[i] * x_coeffs[j]);
+            }
+          }
+        }
+      }
+    });
+    auto input_hw = at::tensor({inp_H, inp_W}, grid.options().dtype(kLong));
+    return std::make_tuple(indices, weights, input_hw);
+  }
+
+  void check_grid_sampler_2d_plan(const Tensor& indices, const Tensor& weights,
+                                  const Tensor& input_hw, IntArrayRef input_size,
+                                  const char* fn_name) {
+    TORCH_CHECK(
+      indices.dim() == 4 && indices.scalar_type() == kLong && weights.sizes() == indices.sizes(),
+      fn_name, ": expected a plan of _grid_sampler_2d_plan(), but got indices with sizes ",
+      indices.sizes(), " and dtype ", indices.scalar_type(), ", and weights with sizes ", weights.sizes());
+    TORCH_CHECK(
+      input_size.size() == 4 && (indices.size(0) == 1 || indices.size(0) == input_size[0]),
+      fn_name, ": expected a 4D input with the batch size of the plan, or a plan of batch size 1, "
+      "but got input with sizes ", input_size, " and a plan of batch size ", indices.size(0));
+    TORCH_CHECK(
+      input_hw.device().is_cpu() && input_hw.scalar_type() == kLong && input_hw.sizes() == IntArrayRef{2},
+      fn_name, ": expected input_hw of _grid_sampler_2d_plan(), but got a tensor with sizes ",
+      input_hw.sizes(), " and dtype ", input_hw.scalar_type());
+    auto plan_H = input_hw[0].item<int64_t>();
+    auto plan_W = input_hw[1].item<int64_t>();
+    TORCH_CHECK(
+      input_size[2] == plan_H && input_size[3] == plan_W,
+      fn_name, ": the plan was made for an input of spatial size [", plan_H, ", ", plan_W,
+      "], but got input with sizes ", input_size);
+  }
+
+  // A [N, C, 1, 1] tensor is both contiguous and channels last, so the layout
+  // is picked once for the allocation and the kernel.
+  MemoryFormat grid_sampler_2d_plan_memory_format(const Tensor& t) {
+    return t.suggest_memory_format() == MemoryFormat::ChannelsLast
+        ? MemoryFormat::ChannelsLast : MemoryFormat::Contiguous;
+  }
+
+}  // namespace
+
+std::tuple<Tensor, Tensor, Tensor>
+grid_sampler_2d_plan_cpu(const Tensor& grid, IntArrayRef input_size,
+                         int64_t interpolation_mode, int64_t padding_mode,
+                         bool align_corners) {
+  TORCH_CHECK(
+    grid.dim() == 4 && grid.size(3) == 2,
+    "_grid_sampler_2d_plan(): expected grid with sizes [N, H_out, W_out, 2], but got grid with sizes ",
+    grid.sizes());
+  TORCH_CHECK(
+    input_size.size() == 2 && input_size[0] > 0 && input_size[1] > 0,
+    "_grid_sampler_2d_plan(): expected a non-empty input_size [H_in, W_in], but got ", input_size);
+  return AT_DISPATCH_FLOATING_TYPES(grid.scalar_type(), "grid_sampler_2d_plan_cpu", [&] {
+    return grid_sampler_2d_plan_cpu_impl<scalar_t>(
+      grid, input_size[0], input_size[1],
+      static_cast<GridSamplerInterpolation>(interpolation_mode),
+      static_cast<GridSamplerPadding>(padding_mode), align_corners);
+  });
+}
+
+Tensor grid_sampler_2d_apply_plan_cpu(const Tensor& input, const Tensor& indices,
+                                      const Tensor& weights, const Tensor& input_hw) {
+  check_grid_sampler_2d_plan(indices, weights, input_hw, input.sizes(), "_grid_sampler_2d_apply_plan()");
+  TORCH_CHECK(
+    input.scalar_type() == weights.scalar_type(),
+    "_grid_sampler_2d_apply_plan(): expected input and weights to have same dtype, but input has ",
+    input.scalar_type(), " and weights has ", weights.scalar_type());
+  auto memory_format = grid_sampler_2d_plan_memory_format(input);
+  auto output = at::empty(
+    {input.size(0), input.size(1), indices.size(1), indices.size(2)},
+    input.options().memory_format(memory_format));
+  if (output.numel() == 0) {
+    return output;
+  }
+  grid_sampler_2d_apply_plan_cpu_kernel(
+    kCPU, output, input.contiguous(memory_format), indices.contiguous(), weights.contiguous(),
+    memory_format);
+  return output;
+}
+
+Tensor grid_sampler_2d_apply_plan_backward_cpu(const Tensor& grad_output, const Tensor& indices,
+                                               const Tensor& weights, const Tensor& input_hw,
+                                               IntArrayRef input_size) {
+  check_grid_sampler_2d_plan(indices, weights, input_hw, input_size, "_grid_sampler_2d_apply_plan_backward()");
+  TORCH_CHECK(
+    grad_output.dim() == 4 && grad_output.size(0) == input_size[0] &&
+    grad_output.size(1) == input_size[1] && grad_output.size(2) == indices.size(1) &&
+    grad_output.size(3) == indices.size(2),
+    "_grid_sampler_2d_apply_plan_backward(): expected grad_output with sizes [",
+    input_size[0], ", ", input_size[1], ", ", indices.size(1), ", ", indices.size(2),
+    "], but got grad_output with sizes ", grad_output.sizes());
+  auto memory_format = grid_sampler_2d_plan_memory_format(grad_output);
+  auto grad_input = at::zeros(input_size, grad_output.options().memory_format(memory_format));
+  if (grad_output.numel() == 0) {
+    return grad_input;
+  }
+  grid_sampler_2d_apply_plan_backward_cpu_kernel(
+    kCPU, grad_input, grad_output.contiguous(memory_format), indices.contiguous(), weights.contiguous(),
+    memory_format);
+  return grad_input;
+}
+
+DEFINE_DISPATCH(grid_sampler_2d_apply_plan_cpu_kernel);
+DEFINE_DISPATCH(grid_sampler_2d_apply_plan_backward_cpu_kernel);
+
 // No shape checking needed here. See # NOTE [ grid_sampler Native Functions ].
 Tensor grid_sampler_3d_cpu(const Tensor& input, const Tensor& grid,
                            int64_t interpolation_mode, int64_t padding_mode,
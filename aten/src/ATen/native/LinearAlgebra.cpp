@@ -28,6 +28,7 @@ namespace at {
 namespace native {
 
 DEFINE_DISPATCH(addr_stub);
+DEFINE_DISPATCH(small_bgemm_stub);
 
 // Helper function for det methods.
 // For pivoted LU factorization A = P * L * U. Since we always have det(L) = 1,
@@ -452,6 +453,42 @@ Tensor outer(const Tensor& self, const Tensor& vec2) {
   return self.reshape({self.size(0), 1}) * vec2;
 }
 
+// The register-blocked kernel behind small_bgemm_stub (cpu/SmallGemmKernel.cpp)
+// replaces the naive loops of baddbmm_cpu_kernel and, for tiny operands, the
+// BLAS call of addmm. The bounds on m * n * k are provisional: they have not
+// been measured yet, and are to be set from
+// benchmarks/operator_benchmark/pt/small_gemm_test.py, which times the shapes
+// on either side of each bound against the paths the kernel replaces. They
+// are picked so that:
+// - below 100 the naive loops keep the shapes with too little to vectorize;
+// - mm and addmm only take the tiniest shapes, where the layout handling
+//   around the BLAS call dominates;
+// - bmm, whose fallback runs one naive loop nest per batch, takes shapes up
+//   to 64^3, but only up to 4096 when MKL batch gemm is available.
+constexpr int64_t kSmallGemmMinMNK = 100;
+constexpr int64_t kSmallGemmMaxMNKForMM = 2048;
+constexpr int64_t kSmallGemmMaxMNKForBmm = 65536;
+constexpr int64_t kSmallGemmMaxMNKForBmmWithMKL = 4096;
+
+// Works for both matrices and batches of matrices.
+static inline bool use_small_gemm(const Tensor& result, const Tensor& mat1, const Tensor& mat2, int64_t max_mnk) {
+  const auto dtype = result.scalar_type();
+  if ((dtype != kFloat && dtype != kDouble) ||
+      mat1.scalar_type() != dtype || mat2.scalar_type() != dtype) {
+    return false;
+  }
+  const int64_t dim = result.dim();
+  const int64_t m = result.size(dim - 2);
+  const int64_t n = result.size(dim - 1);
+  const int64_t k = mat1.size(dim - 1);
+  const int64_t mnk = m * n * k;
+  if (mnk < kSmallGemmMinMNK || mnk > max_mnk) {
+    return false;
+  }
+  // The kernel vectorizes along the rows of result and mat2.
+  return n == 1 || (result.stride(dim - 1) == 1 && mat2.stride(dim - 1) == 1);
+}
+
 static void addmm_impl_cpu_(
     Tensor &result, const Tensor &self, Tensor m1, Tensor m2, const Scalar& beta, const Scalar& alpha) {
   TORCH_INTERNAL_ASSERT(self.dim() == 2 && m1.dim() == 2 && m2.dim() == 2);
@@ -485,6 +522,11 @@ static void addmm_impl_cpu_(
     result.copy_(self);
   }
 
+  if (use_small_gemm(result, m1, m2, kSmallGemmMaxMNKForMM)) {
+    small_bgemm_stub(kCPU, result.unsqueeze(0), m1.unsqueeze(0), m2.unsqueeze(0), beta, alpha);
+    return;
+  }
+
   bool transpose_c = false;
   Tensor c;
 
@@ -707,10 +749,12 @@ inline void baddbmm_cpu_kernel(const Tensor& result, const Tensor& self, const T
 
 // This tries to apply some optimizations to bmm/baddbmm:
 // - When the operand size is small, computation are parallelized over the batch
-//   dimension using OMP and naive matrix multiplication is applied.
+//   dimension using OMP. Float and double operands with a suitable layout go
+//   through the register-blocked small GEMM kernel (see use_small_gemm for
+//   the size bounds), other types use naive matrix multiplication.
 // - When the operand size is larger than the threshold, if compiled with MKL, MKL's batch gemm is used.
 // - Otherwise, we use a series of matrix multiplications.
-// The threshold of 400 for the first has not been thoroughly benchmarked yet and may have room for further
+// The threshold of 400 for the naive kernel has not been thoroughly benchmarked yet and may have room for further
 // optimization, it likely depends on the characteristics of the CPU, MKL will be different from non-MKL etc.,
 // but this seems to be a first starting point.
 
@@ -770,7 +814,10 @@ static inline Tensor& bmm_out_or_baddbmm_(Tensor& self_or_result, const Tensor&
             || (strides[1] == 1 && strides[2] >= sizes[1]);
   };
 
-  if (contraction_size * res_rows * res_cols < 400) {
+  const int64_t small_gemm_max_mnk = at::hasMKL() ? kSmallGemmMaxMNKForBmmWithMKL : kSmallGemmMaxMNKForBmm;
+  if (use_small_gemm(self_or_result, batch1, batch2, small_gemm_max_mnk)) {
+    small_bgemm_stub(kCPU, self_or_result, batch1, batch2, beta, alpha);
+  } else if (contraction_size * res_rows * res_cols < 400) {
     if (is_bmm_out) {
       AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND2(kHalf, kBFloat16, batch1.scalar_type(), "bmm", [&] {
           baddbmm_cpu_kernel<scalar_t, true>(self_or_result, batch1, batch2, beta, alpha);
@@ -10,4 +10,10 @@ namespace at { namespace native {
 using addr_fn = void (*)(TensorIterator &, const Scalar& beta, const Scalar& alpha);
 DECLARE_DISPATCH(addr_fn, addr_stub);
 
+// result[b] = beta * result[b] + alpha * batch1[b] @ batch2[b] for small 3-D
+// float / double operands. result and batch2 must have unit stride in their
+// last dimension.
+using small_bgemm_fn = void (*)(const Tensor& result, const Tensor& batch1, const Tensor& batch2, const Scalar& beta, const Scalar& alpha);
+DECLARE_DISPATCH(small_bgemm_fn, small_bgemm_stub);
+
 }} // namespace at::native
@@ -2,6 +2,7 @@
 #include <ATen/Parallel.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/div_rtn.h>
+#include <ATen/native/DispatchStub.h>
 #include <tuple>
 
 #pragma once
@@ -9,6 +10,20 @@
 namespace at {
 namespace native {
 
+// Channels last (NHWC) forward kernels for max_pool2d and avg_pool2d. input
+// and output are 4D and contiguous in ChannelsLast; indices has the layout of
+// output and holds the same flattened h * width + w positions as in the
+// contiguous case.
+using max_pool2d_channels_last_fn = void(*)(const Tensor& output, const Tensor& indices,
+    const Tensor& input, int kW, int kH, int dW, int dH, int padW, int padH,
+    int dilationW, int dilationH);
+using avg_pool2d_channels_last_fn = void(*)(const Tensor& output, const Tensor& input,
+    int kW, int kH, int dW, int dH, int padW, int padH,
+    bool count_include_pad, c10::optional<int64_t> divisor_override);
+
+DECLARE_DISPATCH(max_pool2d_channels_last_fn, max_pool2d_channels_last_kernel);
+DECLARE_DISPATCH(avg_pool2d_channels_last_fn, avg_pool2d_channels_last_kernel);
+
 namespace {
 
 template <typename dest_t, typename src_t>
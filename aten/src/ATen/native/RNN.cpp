@@ -2,6 +2,7 @@
 
 #include <ATen/ATen.h>
 #include <ATen/NativeFunctions.h>
+#include <ATen/core/grad_mode.h>
 #include <ATen/core/op_registration/op_registration.h>
 #include <ATen/cpp_custom_type_hack.h>
 #include <ATen/native/quantized/cpu/packed_params.h>
@@ -1172,6 +1173,125 @@ std::tuple<io_type, Tensor, Tensor> _lstm_impl(
   return std::make_tuple(std::move(result.outputs), at::stack(hy, 0), at::stack(cy, 0));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// FUSED CPU IMPLEMENTATION
+//
+// For float inference on CPU the layers above are dominated by op overhead,
+// since every step runs a handful of small ATen ops and allocates their
+// results. The fused path computes the input projection of a whole layer with
+// a single GEMM and leaves the recurrence to rnn_fused_layer_stub, which works
+// in place on preallocated buffers. It is not differentiable, so it is only
+// taken when no gradient is needed.
+
+template <typename CellType>
+struct FusedCPUMode;
+
+template <>
+struct FusedCPUMode<GRUCell<CellParams>> {
+  static constexpr FusedRNNMode value = FusedRNNMode::GRU;
+};
+
+template <>
+struct FusedCPUMode<SimpleCell<tanh_f, CellParams>> {
+  static constexpr FusedRNNMode value = FusedRNNMode::RNN_TANH;
+};
+
+template <>
+struct FusedCPUMode<SimpleCell<relu_f, CellParams>> {
+  static constexpr FusedRNNMode value = FusedRNNMode::RNN_RELU;
+};
+
+bool use_fused_rnn_cpu(const Tensor& input, TensorList hx, TensorList params, bool has_projections = false) {
+  auto is_usable = [](const Tensor& t) {
+    return t.device().is_cpu() && t.layout() == kStrided && t.scalar_type() == kFloat;
+  };
+  if (has_projections || !is_usable(input)) {
+    return false;
+  }
+  bool requires_grad = input.requires_grad();
+  for (const auto& t : hx) {
+    if (!is_usable(t)) {
+      return false;
+    }
+    requires_grad |= t.requires_grad();
+  }
+  for (const auto& t : params) {
+    if (!is_usable(t)) {
+      return false;
+    }
+    requires_grad |= t.requires_grad();
+  }
+  return !(requires_grad && at::GradMode::is_enabled());
+}
+
+// input is a [rows, input_size] matrix laid out like PackedSequence data, with
+// batch_sizes[t] rows for step t. hx (and cx for LSTMs) are
+// [num_layers * num_directions, batch, hidden_size]. Returns the output of the
+// last layer as [rows, num_directions * hidden_size] and the final hidden
+// states in the same layout as hx and cx.
+std::tuple<Tensor, Tensor, Tensor> _fused_rnn_cpu(
+      FusedRNNMode mode, const Tensor& input, IntArrayRef batch_sizes,
+      const Tensor& hx, const Tensor& cx, TensorList _params, bool has_biases,
+      int64_t num_layers, double dropout_p, bool train, bool bidirectional) {
+  const int64_t num_directions = bidirectional ? 2 : 1;
+  auto params = gather_params(_params, has_biases);
+  TORCH_CHECK(num_layers * num_directions == (int64_t)params.size(), "Expected more weights in stacked_rnn");
+  TORCH_CHECK(num_layers * num_directions == hx.size(0), "Expected more hidden states in stacked_rnn");
+  const int64_t hidden_size = hx.size(2);
+
+  // The kernel updates the hidden states in place.
+  Tensor hy = hx.clone(at::MemoryFormat::Contiguous);
+  Tensor cy = cx.defined() ? cx.clone(at::MemoryFormat::Contiguous) : Tensor();
+  Tensor layer_input = input;
+  for (int64_t l = 0; l < num_layers; ++l) {
+    Tensor layer_output = at::empty({layer_input.size(0), num_directions * hidden_size}, input.options());
+    for (int64_t d = 0; d < num_directions; ++d) {
+      const int64_t idx = l * num_directions + d;
+      const auto& p = params[idx];
+      Tensor igates;
+      Tensor b_hh;
+      if (!p.b_ih_.defined()) {
+        igates = at::mm(layer_input, p.w_ih.t());
+      } else if (mode == FusedRNNMode::GRU) {
+        // The GRU applies the reset gate to the recurrent projection including
+        // its bias, so b_hh cannot be folded into the input projection.
+        igates = at::addmm(p.b_ih_, layer_input, p.w_ih.t());
+        b_hh = p.b_hh_.contiguous();
+      } else {
+        igates = at::addmm(p.b_ih_ + p.b_hh_, layer_input, p.w_ih.t());
+      }
+      rnn_fused_layer_stub(
+          kCPU, mode, igates, p.w_hh.contiguous(), b_hh,
+          layer_output.narrow(1, d * hidden_size, hidden_size),
+          hy[idx], cy.defined() ? cy[idx] : Tensor(),
+          batch_sizes, /*reverse=*/d == 1);
+    }
+    layer_input = layer_output;
+
+    if (dropout_p != 0 && train && l < num_layers - 1) {
+      layer_input = dropout(layer_input, dropout_p);
+    }
+  }
+  return std::make_tuple(std::move(layer_input), std::move(hy), std::move(cy));
+}
+
+// Same as above for an unpacked [seq_len, batch, input_size] input.
+std::tuple<Tensor, Tensor, Tensor> _fused_rnn_cpu(
+      FusedRNNMode mode, const Tensor& input,
+      const Tensor& hx, const Tensor& cx, TensorList params, bool has_biases,
+      int64_t num_layers, double dropout_p, bool train, bool bidirectional) {
+  TORCH_CHECK(input.dim() == 3, "input must have 3 dimensions, got ", input.dim());
+  const int64_t seq_len = input.size(0);
+  const int64_t batch = input.size(1);
+  const std::vector<int64_t> batch_sizes(seq_len, batch);
+  auto results = _fused_rnn_cpu(
+      mode, input.reshape({seq_len * batch, input.size(2)}), batch_sizes, hx, cx,
+      params, has_biases, num_layers, dropout_p, train, bidirectional);
+  auto& output = std::get<0>(results);
+  output = output.view({seq_len, batch, output.size(1)});
+  return results;
+}
+
 } // anonymous namespace
 
 bool _use_cudnn_rnn_flatten_weight() {
@@ -1238,6 +1358,23 @@ bool _use_cudnn_rnn_flatten_weight() {
     }                                                                       \
     check_attributes(_input, _params, hx);                                  \
     auto input = batch_first ? _input.transpose(0, 1) : _input;             \
+    if (use_fused_rnn_cpu(_input, {hx}, _params)) {                         \
+      auto fused_results = _fused_rnn_cpu(                                  \
+          FusedCPUMode<CELL>::value,                                        \
+          input,                                                            \
+          hx,                                                               \
+          Tensor(),                                                         \
+          _params,                                                          \
+          has_biases,                                                       \
+          num_layers,                                                       \
+          dropout_p,                                                        \
+          train,                                                            \
+          bidirectional);                                                   \
+      auto& output = std::get<0>(fused_results);                            \
+      return std::make_tuple(                                               \
+          batch_first ? output.transpose(0, 1) : std::move(output),         \
+          std::move(std::get<1>(fused_results)));                           \
+    }                                                                       \
     auto params = gather_params(_params, has_biases);                       \
     auto results =                                                          \
         _rnn_impl_with_concat<CELL, FullLayer, FullBidirectionalLayer>(     \
@@ -1298,6 +1435,24 @@ bool _use_cudnn_rnn_flatten_weight() {
           bidirectional);                                                   \
       return std::make_tuple(std::move(output), std::move(hy));             \
     }                                                                       \
+    if (use_fused_rnn_cpu(data, {hx}, _params)) {                           \
+      auto fused_results = _fused_rnn_cpu(                                  \
+          FusedCPUMode<CELL>::value,                                        \
+          data,                                                             \
+          IntArrayRef(                                                      \
+              batch_sizes.data_ptr<int64_t>(), batch_sizes.size(0)),        \
+          hx,                                                               \
+          Tensor(),                                                         \
+          _params,                                                          \
+          has_biases,                                                       \
+          num_layers,                                                       \
+          dropout_p,                                                        \
+          train,                                                            \
+          bidirectional);                                                   \
+      return std::make_tuple(                                               \
+          std::move(std::get<0>(fused_results)),                            \
+          std::move(std::get<1>(fused_results)));                           \
+    }                                                                       \
     PackedSequence input{data, batch_sizes};                                \
     auto params = gather_params(_params, has_biases);                       \
     auto result =                                                           \
@@ -1437,6 +1592,7 @@ ONE_HIDDEN_RNN(rnn_tanh, tanf_cell_type)
 using relu_cell_type = SimpleCell<relu_f, CellParams>;
 ONE_HIDDEN_RNN(rnn_relu, relu_cell_type);
 
+DEFINE_DISPATCH(rnn_fused_layer_stub);
 DEFINE_DISPATCH(lstm_cudnn_stub);
 DEFINE_DISPATCH(lstm_packed_cudnn_stub);
 DEFINE_DISPATCH(lstm_miopen_stub);
@@ -1468,6 +1624,15 @@ std::tuple<Tensor, Tensor, Tensor> lstm(
   }
   check_attributes(_input, _params, hx);
   auto input = batch_first ? _input.transpose(0, 1) : _input;
+  if (use_fused_rnn_cpu(_input, hx, _params, has_projections)) {
+    auto results = _fused_rnn_cpu(
+        FusedRNNMode::LSTM, input, hx[0], hx[1], _params, has_biases,
+        num_layers, dropout_p, train, bidirectional);
+    if (batch_first) {
+      std::get<0>(results) = std::get<0>(results).transpose(0, 1);
+    }
+    return results;
+  }
   auto params = gather_params(_params, has_biases, has_projections);
   auto results = _lstm_impl<FullLayer, FullBidirectionalLayer>(
       input, params, hx[0], hx[1], num_layers, dropout_p, train, bidirectional);
@@ -1498,6 +1663,14 @@ std::tuple<Tensor, Tensor, Tensor> lstm(
     return std::make_tuple(std::move(output), std::move(hy), std::move(cy));
   }
 
+  if (use_fused_rnn_cpu(data, hx, _params, has_projections)) {
+    return _fused_rnn_cpu(
+        FusedRNNMode::LSTM, data,
+        IntArrayRef(batch_sizes.data_ptr<int64_t>(), batch_sizes.size(0)),
+        hx[0], hx[1], _params, has_biases, num_layers, dropout_p, train,
+        bidirectional);
+  }
+
   PackedSequence input { data, batch_sizes };
   auto params = gather_params(_params, has_biases, has_projections);
   auto result = _lstm_impl<PackedLayer, PackedBidirectionalLayer>(
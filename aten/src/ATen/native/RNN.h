@@ -27,6 +27,16 @@ DECLARE_DISPATCH(rnn_packed_fn, rnn_tanh_packed_miopen_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_cudnn_stub);
 DECLARE_DISPATCH(rnn_packed_fn, rnn_relu_packed_miopen_stub);
 
+// Fused whole-sequence kernel used by the CPU implementation for float
+// inference. It runs one direction of one layer: the input projection of all
+// the steps is computed by the caller as one GEMM and passed in as igates,
+// the kernel then does the recurrent GEMM and the gate math step by step.
+// See cpu/RNNKernel.cpp for the exact layout of the arguments.
+enum class FusedRNNMode { LSTM, GRU, RNN_TANH, RNN_RELU };
+using rnn_fused_layer_fn = void(*)(FusedRNNMode mode, const Tensor& igates, const Tensor& w_hh, const Tensor& b_hh,
+                                   const Tensor& output, const Tensor& hx, const Tensor& cx, IntArrayRef batch_sizes, bool reverse);
+DECLARE_DISPATCH(rnn_fused_layer_fn, rnn_fused_layer_stub);
+
 inline void check_attributes(const Tensor& input, const TensorList& params, const TensorList& hiddens, bool check_dtype=false) {
   auto input_device = input.device();
   auto input_dtype = input.scalar_type();
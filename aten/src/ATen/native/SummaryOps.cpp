@@ -2,14 +2,48 @@
 
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/native/SummaryOps.h>
 
 #include <tuple>
 
 namespace at { namespace native {
 
+DEFINE_DISPATCH(histc_stub);
+
 ///////////////// bincount /////////////////
 namespace {
 
+// Calls update(out, i) for every i in [0, n), out being the data of output.
+// Every thread accumulates its chunks into a private copy of the output, and
+// the copies are summed into output at the end. Small inputs, or inputs with
+// fewer elements than the private copies, are accumulated serially.
+template <typename output_t, typename func_t>
+void bincount_accumulate(Tensor& output, int64_t n, const func_t& update) {
+  output_t* output_p = output.data_ptr<output_t>();
+  const int64_t nbins = output.numel();
+  const int num_threads = at::get_num_threads();
+  if (num_threads == 1 || n < at::internal::GRAIN_SIZE || nbins * num_threads > n) {
+    for (int64_t i = 0; i < n; i++) {
+      update(output_p, i);
+    }
+    return;
+  }
+
+  Tensor buffer = at::zeros({num_threads, nbins}, output.options());
+  output_t* buffer_p = buffer.data_ptr<output_t>();
+  at::parallel_for(0, n, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    const int tid = at::get_thread_num();
+    TORCH_CHECK(tid < num_threads,
+                "expect thread id smaller than ", num_threads, ", got thread id ", tid);
+    output_t* local_p = buffer_p + tid * nbins;
+    for (int64_t i = begin; i < end; i++) {
+      update(local_p, i);
+    }
+  });
+  at::sum_out(output, buffer, 0);
+}
+
 template <typename input_t, typename weights_t>
 Tensor _bincount_cpu_template(
     const Tensor& self,
@@ -21,7 +55,12 @@ Tensor _bincount_cpu_template(
   if (self.dim() == 1 && self.numel() == 0) {
     return native::zeros({minlength}, kLong);
   }
-  if (self.dim() != 1 || *self.min().data_ptr<input_t>() < 0) {
+  if (self.dim() != 1) {
+    AT_ERROR("bincount only supports 1-d non-negative integral inputs.");
+  }
+  // a single pass for both ends of the range
+  auto self_minmax = at::_aminmax(self);
+  if (*std::get<0>(self_minmax).data_ptr<input_t>() < 0) {
     AT_ERROR("bincount only supports 1-d non-negative integral inputs.");
   }
 
@@ -32,23 +71,21 @@ Tensor _bincount_cpu_template(
 
   Tensor output;
   int64_t self_size = self.size(0);
-  int64_t nbins = static_cast<int64_t>(*self.max().data_ptr<input_t>()) + 1L;
+  int64_t nbins = static_cast<int64_t>(*std::get<1>(self_minmax).data_ptr<input_t>()) + 1L;
   nbins = std::max(nbins, minlength); // at least minlength # of bins
 
   const input_t* self_p = self.data_ptr<input_t>();
   if (has_weights) {
     output = native::zeros({nbins}, weights.options());
-    weights_t* output_p = output.data_ptr<weights_t>();
     const weights_t* weights_p = weights.data_ptr<weights_t>();
-    for (int64_t i = 0; i < self_size; i++) {
+    bincount_accumulate<weights_t>(output, self_size, [&](weights_t* output_p, int64_t i) {
       output_p[self_p[i]] += weights_p[i];
-    }
+    });
   } else {
     output = native::zeros({nbins}, kLong);
-    int64_t* output_p = output.data_ptr<int64_t>();
-    for (int64_t i = 0; i < self_size; i++) {
+    bincount_accumulate<int64_t>(output, self_size, [&](int64_t* output_p, int64_t i) {
       output_p[self_p[i]] += 1L;
-    }
+    });
   }
   return output;
 }
@@ -65,4 +102,45 @@ _bincount_cpu(const Tensor& self, const Tensor& weights, int64_t minlength) {
   });
 }
 
+///////////////// histc /////////////////
+Tensor& histc_out_cpu(Tensor& hist, const Tensor& self, int64_t bins, const Scalar& min, const Scalar& max) {
+  TORCH_CHECK(bins > 0, "bins must be > 0");
+  TORCH_CHECK(hist.scalar_type() == self.scalar_type(),
+              "histc: expected the output to have dtype ", self.scalar_type(),
+              ", but got ", hist.scalar_type());
+  hist.resize_({bins});
+  Tensor result = hist.is_contiguous() ? hist : at::empty({bins}, hist.options());
+  result.zero_();
+
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "histc_cpu", [&] {
+    scalar_t minval = min.to<scalar_t>();
+    scalar_t maxval = max.to<scalar_t>();
+    if (minval == maxval) {
+      auto self_minmax = at::_aminmax(self);
+      minval = std::get<0>(self_minmax).item<scalar_t>();
+      maxval = std::get<1>(self_minmax).item<scalar_t>();
+    }
+    if (minval == maxval) {
+      minval = minval - 1;
+      maxval = maxval + 1;
+    }
+    TORCH_CHECK(!(std::isinf(minval) || std::isinf(maxval) || std::isnan(minval) || std::isnan(maxval)),
+                "range of [", minval, ", ", maxval, "] is not finite");
+    TORCH_CHECK(minval < maxval, "max must be larger than min");
+    if (self.numel() > 0) {
+      histc_stub(kCPU, result, self.contiguous(), bins, minval, maxval);
+    }
+  });
+
+  if (!result.is_same(hist)) {
+    hist.copy_(result);
+  }
+  return hist;
+}
+
+Tensor histc_cpu(const Tensor& self, int64_t bins, const Scalar& min, const Scalar& max) {
+  Tensor hist = at::empty({0}, self.options(), MemoryFormat::Contiguous);
+  return native::histc_out_cpu(hist, self, bins, min, max);
+}
+
 }} // namespace at::native
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+namespace at { namespace native {
+
+// hist is zeroed and has nbins elements, self is contiguous and min < max
+// once rounded to the dtype of self.
+using histc_fn = void(*)(Tensor& hist, const Tensor& self, int64_t nbins, double min, double max);
+DECLARE_DISPATCH(histc_fn, histc_stub);
+
+}}  // namespace at::native
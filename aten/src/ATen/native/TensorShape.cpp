@@ -29,6 +29,7 @@ namespace at {
 namespace native {
 
 DEFINE_DISPATCH(cat_serial_stub);
+DEFINE_DISPATCH(cat_contiguous_stub);
 DEFINE_DISPATCH(stack_serial_stub);
 
 Tensor _reshape_from_tensor(const Tensor& self, const Tensor& shape_tensor) {
@@ -209,6 +210,19 @@ Tensor & _cat_out_cpu(Tensor& result, TensorList tensors, int64_t dim) {
     return result;
   }
 
+  // otherwise contiguous inputs are still copied with plain memcpy (or a
+  // fused cast when a dtype differs from the result), in parallel across
+  // inputs and outer slices rather than one input after the other
+  if (allContiguous) {
+    for (auto const &tensor : tensors) {
+      TORCH_CHECK(canCast(tensor.scalar_type(), result.scalar_type()),
+                  "result type ", tensor.scalar_type(),
+                  " can't be cast to the desired output type ", result.scalar_type());
+    }
+    cat_contiguous_stub(kCPU, result, tensors, dim);
+    return result;
+  }
+
   int64_t offset = 0;
   if (reuse_iterator &&
       result.is_contiguous(first_tensor_mem_format) &&
@@ -16,7 +16,7 @@ TORCH_META_FUNC(upsample_bicubic2d) (
       "Non-empty 4D data tensor expected but got a tensor with sizes ",
       input.sizes());
 
-  set_output(full_output_size, input.options());
+  set_output(full_output_size, input.options().memory_format(input.suggest_memory_format()));
 }
 
 TORCH_META_FUNC(upsample_bicubic2d_backward) (
@@ -223,11 +223,20 @@ static void upsample_bicubic2d_kernel(
   int64_t input_height = input_.size(2);
   int64_t input_width = input_.size(3);
 
+  if (input_.is_contiguous(at::MemoryFormat::ChannelsLast) && !input_.is_contiguous()
+      && input_.scalar_type() != at::ScalarType::Half) {
+    upsample_bicubic2d_channels_last_kernel(kCPU, output, input_, align_corners, scales_h, scales_w);
+    return;
+  }
+
   auto input = input_.contiguous();
+  // The output follows the memory format of the input, write into a
+  // contiguous buffer when the kernel below cannot handle it.
+  Tensor output_contiguous = output.is_contiguous() ? output : at::zeros_like(output, at::MemoryFormat::Contiguous);
 
   AT_DISPATCH_FLOATING_TYPES_AND_HALF(input.scalar_type(), "upsample_bicubic2d", [&] {
     auto* idata = input.data_ptr<scalar_t>();
-    auto* odata = output.data_ptr<scalar_t>();
+    auto* odata = output_contiguous.data_ptr<scalar_t>();
 
     upsample_bicubic2d_out_frame<scalar_t>(
         odata,
@@ -242,6 +251,10 @@ static void upsample_bicubic2d_kernel(
         scales_h,
         scales_w);
   });
+
+  if (!output.is_contiguous()) {
+    output.copy_(output_contiguous);
+  }
 }
 
 static void upsample_bicubic2d_backward_kernel(
@@ -337,5 +350,7 @@ Tensor upsample_bicubic2d_backward(
   return at::upsample_bicubic2d_backward(grad_output, osize, input_size, align_corners, scale_h, scale_w);
 }
 
+DEFINE_DISPATCH(upsample_bicubic2d_channels_last_kernel);
+
 } // namespace native
 } // namespace at
@@ -12,6 +12,20 @@ using batch_norm_fn = void (*)(Tensor&, const Tensor&, const Tensor&,
 
 DECLARE_DISPATCH(batch_norm_fn, batch_norm_cpu_inference_contiguous_stub);
 
+// Channels last (NHWC) kernels. The transform applies
+//   output(n, h, w, c) = input(n, h, w, c) * alpha(c) + beta(c)
+// with alpha and beta precomputed by the caller from either the running or
+// the batch statistics, so it serves both inference and training.
+using batch_norm_transform_channels_last_fn = void (*)(Tensor& /* output */,
+    const Tensor& /* input */, const Tensor& /* alpha */, const Tensor& /* beta */);
+// Computes the per channel mean and sum of squared deviations of an NHWC
+// input, both in the accumulate type of the input.
+using batch_norm_collect_stats_channels_last_fn = void (*)(Tensor& /* mean */,
+    Tensor& /* var_sum */, const Tensor& /* input */);
+
+DECLARE_DISPATCH(batch_norm_transform_channels_last_fn, batch_norm_cpu_transform_channels_last_stub);
+DECLARE_DISPATCH(batch_norm_collect_stats_channels_last_fn, batch_norm_cpu_collect_stats_channels_last_stub);
+
 } // namespace native
 
 } // namespace at
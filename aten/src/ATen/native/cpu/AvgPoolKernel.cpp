@@ -0,0 +1,147 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/Pool.h>
+#include <ATen/native/cpu/utils.h>
+
+namespace at { namespace native {
+
+namespace {
+
+using namespace vec256;
+
+// Every output pixel (n, oh, ow) is a row of channels: the rows of the
+// pooling window are summed into it with vector adds, then it is scaled by
+// the divide factor of the window, which is the same for all the channels.
+template <typename scalar_t>
+void cpu_avg_pool2d_channels_last(
+    const Tensor& output_,
+    const Tensor& input_,
+    int kW, int kH,
+    int dW, int dH,
+    int padW, int padH,
+    bool count_include_pad,
+    c10::optional<int64_t> divisor_override) {
+  TORCH_CHECK(input_.ndimension() == 4,
+              "average pooling with channels last format supports tensors with 4 dims");
+  auto memory_format = at::MemoryFormat::ChannelsLast;
+  auto input = input_.contiguous(memory_format);
+  auto output = output_.contiguous(memory_format);
+
+  auto input_data = input.data_ptr<scalar_t>();
+  auto output_data = output.data_ptr<scalar_t>();
+
+  int64_t nbatch = input.size(0);
+  int64_t channels = input.size(1);
+  int64_t input_height = input.size(2);
+  int64_t input_width = input.size(3);
+  int64_t output_height = output.size(2);
+  int64_t output_width = output.size(3);
+
+  using Vec = Vec256<scalar_t>;
+  at::parallel_for(0, nbatch * output_height * output_width, 0, [&](int64_t begin, int64_t end) {
+    int64_t n = 0;
+    int64_t oh = 0;
+    int64_t ow = 0;
+    data_index_init(begin, n, nbatch, oh, output_height, ow, output_width);
+
+    int64_t size = channels;
+    int64_t len = size - (size % Vec::size());
+    for (int64_t i = begin; i < end; i++) {
+      // compute the mean of the input image...
+      int64_t hstart = oh * dH - padH;
+      int64_t wstart = ow * dW - padW;
+      int64_t hend = std::min(hstart + kH, input_height + padH);
+      int64_t wend = std::min(wstart + kW, input_width + padW);
+      int64_t pool_size = (hend - hstart) * (wend - wstart);
+      hstart = std::max(hstart, (int64_t) 0);
+      wstart = std::max(wstart, (int64_t) 0);
+      hend = std::min(hend, input_height);
+      wend = std::min(wend, input_width);
+
+      int64_t divide_factor;
+      if (divisor_override.has_value()) {
+        divide_factor = divisor_override.value();
+      } else {
+        if(count_include_pad) {
+          divide_factor = pool_size;
+        } else {
+          divide_factor = (hend - hstart) * (wend - wstart);
+        }
+      }
+
+      scalar_t* out = output_data + i * channels;
+
+      // Pass I: zero the out lane
+      int64_t d1 = 0;
+      for (; d1 < len; d1 += Vec::size()) {
+        Vec out_vec = Vec(scalar_t(0));
+        out_vec.store(out + d1);
+      }
+      for (; d1 < size; d1++) {
+        out[d1] = scalar_t(0);
+      }
+
+      if (hstart >= hend || wstart >= wend) {
+        // move on to next output index
+        data_index_step(n, nbatch, oh, output_height, ow, output_width);
+        continue;
+      }
+
+      // Pass II: compute local sum
+      for (int64_t ih = hstart; ih < hend; ih++) {
+        for (int64_t iw = wstart; iw < wend; iw++) {
+          scalar_t* in = input_data + n * input_height * input_width * channels +
+              ih * input_width * channels + iw * channels;
+
+          int64_t d2 = 0;
+          for (; d2 < len; d2 += Vec::size()) {
+            Vec out_vec = Vec::loadu(out + d2) + Vec::loadu(in + d2);
+            out_vec.store(out + d2);
+          }
+          for (; d2 < size; d2++) {
+            out[d2] += in[d2];
+          }
+        }
+      }
+
+      // Pass III: compute local average
+      int64_t d3 = 0;
+      for (; d3 < len; d3 += Vec::size()) {
+        Vec out_vec = Vec::loadu(out + d3) / Vec(scalar_t(divide_factor));
+        out_vec.store(out + d3);
+      }
+      for (; d3 < size; d3++) {
+        out[d3] = out[d3] / divide_factor;
+      }
+
+      // move on to next output index
+      data_index_step(n, nbatch, oh, output_height, ow, output_width);
+    }
+  });
+
+  if (!output_.is_contiguous(memory_format)) {
+    output_.copy_(output);
+  }
+}
+
+void avg_pool2d_channels_last_kernel_impl(
+    const Tensor& output,
+    const Tensor& input,
+    int kW, int kH,
+    int dW, int dH,
+    int padW, int padH,
+    bool count_include_pad,
+    c10::optional<int64_t> divisor_override) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "avg_pool2d_channels_last", [&] {
+    cpu_avg_pool2d_channels_last<scalar_t>(
+        output, input, kW, kH, dW, dH, padW, padH, count_include_pad, divisor_override);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(avg_pool2d_channels_last_kernel, &avg_pool2d_channels_last_kernel_impl);
+
+}} // at::native
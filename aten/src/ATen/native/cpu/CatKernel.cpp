@@ -1,9 +1,14 @@
 #include <ATen/ATen.h>
 
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/cpu/CatKernel.h>
 #include <ATen/cpu/vec256/functional.h>
 #include <ATen/cpu/vec256/vec256.h>
+#include <c10/util/TypeCast.h>
+
+#include <algorithm>
+#include <cstring>
 
 namespace at { namespace native {
 
@@ -62,8 +67,107 @@ void cat_serial_kernel(Tensor& result, TensorList tensors, int64_t dim) {
   });
 }
 
+using cat_copy_fn = void (*)(char* dst, const char* src, int64_t n);
+
+template <typename dst_t, typename src_t>
+void cat_cast_copy(char* dst, const char* src, int64_t n) {
+  auto dst_ptr = reinterpret_cast<dst_t*>(dst);
+  auto src_ptr = reinterpret_cast<const src_t*>(src);
+  for (int64_t k = 0; k < n; k++) {
+    dst_ptr[k] = c10::convert<dst_t>(src_ptr[k]);
+  }
+}
+
+cat_copy_fn get_cat_copy_fn(ScalarType dst_type, ScalarType src_type) {
+  cat_copy_fn fn = nullptr;
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(
+      ScalarType::Bool, ScalarType::Half, ScalarType::BFloat16, dst_type, "cat_contiguous", [&]() {
+    using dst_t = scalar_t;
+    AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND3(
+        ScalarType::Bool, ScalarType::Half, ScalarType::BFloat16, src_type, "cat_contiguous", [&]() {
+      fn = &cat_cast_copy<dst_t, scalar_t>;
+    });
+  });
+  return fn;
+}
+
+struct CatContiguousInput {
+  const char* data_ptr;
+  int64_t inner_size;
+  int64_t element_size;
+  // nullptr when the input has the dtype of the result and is memcpy-ed
+  cat_copy_fn cast_copy;
+};
+
+// The output is seen as `outer` rows, each of them being the concatenation
+// of one slice of every input. The offsets of the slices within a row are
+// planned once, then the rows are split into chunks of elements: every
+// thread locates the input of its first element and copies segment after
+// segment from there. This balances the work whether there are a few large
+// inputs or hundreds of tiny ones.
+void cat_contiguous_kernel(Tensor& result, TensorList tensors, int64_t dim) {
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(
+      dim >= 0 && dim < result.dim(), "dim out of range in cat_contiguous_kernel");
+  const int64_t row_size = result.sizes()[dim] * result.strides()[dim];
+  const int64_t outer = result.numel() / row_size;
+  const int64_t result_element_size = result.element_size();
+  char* result_data = static_cast<char*>(result.data_ptr());
+
+  const int64_t ninputs = tensors.size();
+  std::vector<CatContiguousInput> inputs;
+  // row_offsets[j] is the offset of the slice of input j within a row
+  std::vector<int64_t> row_offsets;
+  inputs.reserve(ninputs);
+  row_offsets.reserve(ninputs + 1);
+  row_offsets.push_back(0);
+  for (auto const &tensor : tensors) {
+    const int64_t inner_size = tensor.sizes()[dim] * result.strides()[dim];
+    const auto src_type = tensor.scalar_type();
+    inputs.push_back({
+        static_cast<const char*>(tensor.data_ptr()),
+        inner_size,
+        static_cast<int64_t>(tensor.element_size()),
+        src_type == result.scalar_type()
+            ? nullptr : get_cat_copy_fn(result.scalar_type(), src_type)});
+    row_offsets.push_back(row_offsets.back() + inner_size);
+  }
+  TORCH_INTERNAL_ASSERT_DEBUG_ONLY(row_offsets.back() == row_size);
+
+  at::parallel_for(0, outer * row_size, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    int64_t i = begin / row_size;
+    int64_t pos = begin % row_size;
+    int64_t j = std::upper_bound(row_offsets.begin(), row_offsets.end(), pos) -
+        row_offsets.begin() - 1;
+    char* result_ptr = result_data + begin * result_element_size;
+    while (begin < end) {
+      // skip the inputs that are empty along dim
+      while (row_offsets[j + 1] <= pos) {
+        j++;
+      }
+      const auto& input = inputs[j];
+      const int64_t k = pos - row_offsets[j];
+      const int64_t n = std::min(row_offsets[j + 1] - pos, end - begin);
+      const char* input_ptr = input.data_ptr + (i * input.inner_size + k) * input.element_size;
+      if (input.cast_copy == nullptr) {
+        std::memcpy(result_ptr, input_ptr, n * result_element_size);
+      } else {
+        input.cast_copy(result_ptr, input_ptr, n);
+      }
+      result_ptr += n * result_element_size;
+      begin += n;
+      pos += n;
+      if (pos == row_size) {
+        i++;
+        pos = 0;
+        j = 0;
+      }
+    }
+  });
+}
+
 } // anonymous namespace
 
 REGISTER_DISPATCH(cat_serial_stub, &cat_serial_kernel);
+REGISTER_DISPATCH(cat_contiguous_stub, &cat_contiguous_kernel);
 
 }} // at::native
@@ -7,5 +7,8 @@ namespace at { namespace native {
 
 using cat_serial_fn = void(*)(Tensor &, TensorList, int64_t);
 DECLARE_DISPATCH(cat_serial_fn, cat_serial_stub);
+// Same layout requirements as cat_serial_stub, but for any dtype, with the
+// inputs cast to the dtype of the result, and parallel.
+DECLARE_DISPATCH(cat_serial_fn, cat_contiguous_stub);
 
 }}  // namespace at::native
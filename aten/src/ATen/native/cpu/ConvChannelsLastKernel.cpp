@@ -0,0 +1,346 @@
+#include <ATen/native/cpu/ConvChannelsLastKernel.h>
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/ConvUtils.h>
+#include <ATen/native/cpu/utils.h>
+
+namespace at {
+namespace native {
+namespace {
+
+using namespace vec256;
+
+// Direct convolution of NHWC tensors, computed as an implicit GEMM: every
+// output pixel is a row of output channels, and the reduction runs over the
+// kernel taps and the input channels of the group. Since the input channels
+// of a pixel are contiguous in NHWC, the rows of the "column matrix" are read
+// straight from the input, so nothing is unfolded.
+//
+// The output is computed in tiles of kConvMR consecutive pixels of one output
+// row by kConvNV vectors of output channels. The accumulators of a tile stay
+// in registers for the whole reduction; each step loads kConvNV vectors of
+// the packed weight and broadcasts one input value per pixel, like the small
+// GEMM kernel. Pixels of the tile that read from the padding point to a row
+// of zeros instead, so the inner loop has no bounds checks.
+//
+// The weight is repacked on every call into [groups][kh][kw][ic][oc] with the
+// output channels of a group padded to a whole number of vectors, so that
+// weight loads are always full vectors. Depthwise convolutions have a single
+// output channel per group and use their own kernel vectorized over the
+// channels instead.
+constexpr int64_t kConvMR = 6;
+constexpr int64_t kConvNV = 2;
+
+struct ConvShape {
+  int64_t batch;
+  int64_t in_channels;
+  int64_t in_height;
+  int64_t in_width;
+  int64_t out_channels;
+  int64_t out_height;
+  int64_t out_width;
+  int64_t kernel_height;
+  int64_t kernel_width;
+  int64_t stride_height;
+  int64_t stride_width;
+  int64_t pad_height;
+  int64_t pad_width;
+  int64_t dilation_height;
+  int64_t dilation_width;
+  int64_t groups;
+  int64_t in_channels_per_group;
+  int64_t out_channels_per_group;
+};
+
+// a holds the input row of every pixel of the tile for every tap, with a
+// stride of kConvMR pointers between taps; a_offset selects the group.
+template <typename scalar_t, int64_t MR, int64_t NV>
+inline void conv_micro_kernel(
+    const scalar_t* const* a,
+    int64_t a_offset,
+    int64_t taps,
+    int64_t ic_per_group,
+    const scalar_t* w,
+    int64_t ldw,
+    const scalar_t* bias,
+    scalar_t* out,
+    int64_t ldo,
+    int64_t n_tail) {
+  using Vec = Vec256<scalar_t>;
+  constexpr int64_t kVecSize = Vec::size();
+
+  Vec acc[MR][NV];
+  for (int64_t v = 0; v < NV; v++) {
+    const Vec b = Vec::loadu(bias + v * kVecSize);
+    for (int64_t r = 0; r < MR; r++) {
+      acc[r][v] = b;
+    }
+  }
+
+  for (int64_t t = 0; t < taps; t++) {
+    const scalar_t* const* a_t = a + t * kConvMR;
+    const scalar_t* w_t = w + t * ic_per_group * ldw;
+    for (int64_t ic = 0; ic < ic_per_group; ic++) {
+      Vec w_vec[NV];
+      for (int64_t v = 0; v < NV; v++) {
+        w_vec[v] = Vec::loadu(w_t + ic * ldw + v * kVecSize);
+      }
+      for (int64_t r = 0; r < MR; r++) {
+        const Vec a_vec(a_t[r][a_offset + ic]);
+        for (int64_t v = 0; v < NV; v++) {
+          acc[r][v] = fmadd(a_vec, w_vec[v], acc[r][v]);
+        }
+      }
+    }
+  }
+
+  for (int64_t r = 0; r < MR; r++) {
+    for (int64_t v = 0; v < NV; v++) {
+      const int64_t count = (v == NV - 1) ? n_tail : kVecSize;
+      acc[r][v].store(out + r * ldo + v * kVecSize, count);
+    }
+  }
+}
+
+template <typename scalar_t, int64_t NV>
+inline void conv_tile(
+    int64_t rows,
+    const scalar_t* const* a,
+    int64_t a_offset,
+    int64_t taps,
+    int64_t ic_per_group,
+    const scalar_t* w,
+    int64_t ldw,
+    const scalar_t* bias,
+    scalar_t* out,
+    int64_t ldo,
+    int64_t n_tail) {
+  static_assert(kConvMR == 6, "update the row switch");
+  switch (rows) {
+#define CONV_TILE_ROWS(MR)                                              \
+    case MR:                                                            \
+      conv_micro_kernel<scalar_t, MR, NV>(                              \
+          a, a_offset, taps, ic_per_group, w, ldw, bias, out, ldo, n_tail); \
+      break;
+    CONV_TILE_ROWS(1)
+    CONV_TILE_ROWS(2)
+    CONV_TILE_ROWS(3)
+    CONV_TILE_ROWS(4)
+    CONV_TILE_ROWS(5)
+    CONV_TILE_ROWS(6)
+#undef CONV_TILE_ROWS
+    default:
+      TORCH_INTERNAL_ASSERT(false, "conv_channels_last: unexpected tile rows");
+  }
+}
+
+// packed_weight is [groups][taps][ic_per_group][ldw] and packed_bias
+// [groups][ldw], both zero padded past out_channels_per_group.
+template <typename scalar_t>
+void conv_channels_last_gemm(
+    const ConvShape& s,
+    const scalar_t* input,
+    const scalar_t* packed_weight,
+    const scalar_t* packed_bias,
+    int64_t ldw,
+    scalar_t* output) {
+  constexpr int64_t kVecSize = Vec256<scalar_t>::size();
+  constexpr int64_t kNR = kConvNV * kVecSize;
+  const int64_t taps = s.kernel_height * s.kernel_width;
+  const int64_t ic_per_group = s.in_channels_per_group;
+  const int64_t oc_per_group = s.out_channels_per_group;
+  const int64_t ow_tiles = divup(s.out_width, kConvMR);
+  // Stands in for the input rows of the padding.
+  const std::vector<scalar_t> zeros(s.in_channels, scalar_t(0));
+
+  // Zero with empty channels, so the divisor is clamped.
+  const int64_t work_per_tile = kConvMR * taps * ic_per_group * s.out_channels;
+  const int64_t grain_size = std::max<int64_t>(
+      internal::GRAIN_SIZE / std::max<int64_t>(work_per_tile, 1), 1);
+  at::parallel_for(0, s.batch * s.out_height * ow_tiles, grain_size, [&](int64_t begin, int64_t end) {
+    std::vector<const scalar_t*> a(taps * kConvMR);
+    int64_t n = 0;
+    int64_t oh = 0;
+    int64_t tile = 0;
+    data_index_init(begin, n, s.batch, oh, s.out_height, tile, ow_tiles);
+
+    for (int64_t i = begin; i < end; i++) {
+      const int64_t ow0 = tile * kConvMR;
+      const int64_t rows = std::min(kConvMR, s.out_width - ow0);
+      for (int64_t kh = 0; kh < s.kernel_height; kh++) {
+        const int64_t ih = oh * s.stride_height - s.pad_height + kh * s.dilation_height;
+        for (int64_t kw = 0; kw < s.kernel_width; kw++) {
+          const scalar_t** a_t = a.data() + (kh * s.kernel_width + kw) * kConvMR;
+          for (int64_t r = 0; r < rows; r++) {
+            const int64_t iw = (ow0 + r) * s.stride_width - s.pad_width + kw * s.dilation_width;
+            if (ih >= 0 && ih < s.in_height && iw >= 0 && iw < s.in_width) {
+              a_t[r] = input + ((n * s.in_height + ih) * s.in_width + iw) * s.in_channels;
+            } else {
+              a_t[r] = zeros.data();
+            }
+          }
+        }
+      }
+
+      scalar_t* out = output + ((n * s.out_height + oh) * s.out_width + ow0) * s.out_channels;
+      for (int64_t g = 0; g < s.groups; g++) {
+        const scalar_t* w_g = packed_weight + g * taps * ic_per_group * ldw;
+        const scalar_t* b_g = packed_bias + g * ldw;
+        scalar_t* out_g = out + g * oc_per_group;
+        const int64_t a_offset = g * ic_per_group;
+        int64_t oc = 0;
+        for (; oc + kNR <= oc_per_group; oc += kNR) {
+          conv_tile<scalar_t, kConvNV>(
+              rows, a.data(), a_offset, taps, ic_per_group,
+              w_g + oc, ldw, b_g + oc, out_g + oc, s.out_channels, kVecSize);
+        }
+        const int64_t oc_rem = oc_per_group - oc;
+        if (oc_rem > kVecSize) {
+          conv_tile<scalar_t, 2>(
+              rows, a.data(), a_offset, taps, ic_per_group,
+              w_g + oc, ldw, b_g + oc, out_g + oc, s.out_channels, oc_rem - kVecSize);
+        } else if (oc_rem > 0) {
+          conv_tile<scalar_t, 1>(
+              rows, a.data(), a_offset, taps, ic_per_group,
+              w_g + oc, ldw, b_g + oc, out_g + oc, s.out_channels, oc_rem);
+        }
+      }
+
+      data_index_step(n, s.batch, oh, s.out_height, tile, ow_tiles);
+    }
+  });
+}
+
+// One input and one output channel per group: every output pixel is the sum
+// over the taps of input row times weight row, vectorized over the channels.
+// packed_weight is [taps][channels], bias may be null.
+template <typename scalar_t>
+void conv_channels_last_depthwise(
+    const ConvShape& s,
+    const scalar_t* input,
+    const scalar_t* packed_weight,
+    const scalar_t* bias,
+    scalar_t* output) {
+  using Vec = Vec256<scalar_t>;
+  const int64_t channels = s.out_channels;
+  const int64_t taps = s.kernel_height * s.kernel_width;
+
+  const int64_t grain_size = std::max<int64_t>(internal::GRAIN_SIZE / (taps * channels), 1);
+  at::parallel_for(0, s.batch * s.out_height * s.out_width, grain_size, [&](int64_t begin, int64_t end) {
+    int64_t n = 0;
+    int64_t oh = 0;
+    int64_t ow = 0;
+    data_index_init(begin, n, s.batch, oh, s.out_height, ow, s.out_width);
+
+    for (int64_t i = begin; i < end; i++) {
+      const int64_t ih0 = oh * s.stride_height - s.pad_height;
+      const int64_t iw0 = ow * s.stride_width - s.pad_width;
+      scalar_t* out = output + i * channels;
+      for (int64_t c = 0; c < channels; c += Vec::size()) {
+        const int64_t count = std::min<int64_t>(Vec::size(), channels - c);
+        Vec acc = bias != nullptr ? Vec::loadu(bias + c, count) : Vec(scalar_t(0));
+        for (int64_t kh = 0; kh < s.kernel_height; kh++) {
+          const int64_t ih = ih0 + kh * s.dilation_height;
+          if (ih < 0 || ih >= s.in_height) {
+            continue;
+          }
+          for (int64_t kw = 0; kw < s.kernel_width; kw++) {
+            const int64_t iw = iw0 + kw * s.dilation_width;
+            if (iw < 0 || iw >= s.in_width) {
+              continue;
+            }
+            const scalar_t* in = input + ((n * s.in_height + ih) * s.in_width + iw) * channels;
+            const scalar_t* w = packed_weight + (kh * s.kernel_width + kw) * channels;
+            acc = fmadd(Vec::loadu(in + c, count), Vec::loadu(w + c, count), acc);
+          }
+        }
+        acc.store(out + c, count);
+      }
+
+      data_index_step(n, s.batch, oh, s.out_height, ow, s.out_width);
+    }
+  });
+}
+
+Tensor convolution_channels_last_kernel(
+    const Tensor& input_,
+    const Tensor& weight_,
+    const Tensor& bias,
+    IntArrayRef stride,
+    IntArrayRef padding,
+    IntArrayRef dilation,
+    int64_t groups) {
+  const Tensor input = input_.contiguous(at::MemoryFormat::ChannelsLast);
+  const Tensor weight = weight_.contiguous();
+
+  ConvShape s;
+  s.batch = input.size(0);
+  s.in_channels = input.size(1);
+  s.in_height = input.size(2);
+  s.in_width = input.size(3);
+  s.out_channels = weight.size(0);
+  s.kernel_height = weight.size(2);
+  s.kernel_width = weight.size(3);
+  s.stride_height = stride[0];
+  s.stride_width = stride[1];
+  s.pad_height = padding[0];
+  s.pad_width = padding[1];
+  s.dilation_height = dilation[0];
+  s.dilation_width = dilation[1];
+  s.groups = groups;
+  s.in_channels_per_group = s.in_channels / groups;
+  s.out_channels_per_group = s.out_channels / groups;
+
+  auto output_size = conv_output_size(input.sizes(), weight.sizes(), padding, stride, dilation);
+  s.out_height = output_size[2];
+  s.out_width = output_size[3];
+  Tensor output = at::empty(output_size, input.options().memory_format(at::MemoryFormat::ChannelsLast));
+  if (output.numel() == 0) {
+    return output;
+  }
+
+  const int64_t taps = s.kernel_height * s.kernel_width;
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "convolution_channels_last", [&] {
+    if (s.in_channels_per_group == 1 && s.out_channels_per_group == 1) {
+      // [channels, 1, kh, kw] -> [kh, kw, channels]
+      const Tensor packed_weight = weight.view({s.out_channels, taps}).t().contiguous();
+      const Tensor bias_contig = bias.defined() ? bias.contiguous() : Tensor();
+      conv_channels_last_depthwise<scalar_t>(
+          s,
+          input.data_ptr<scalar_t>(),
+          packed_weight.data_ptr<scalar_t>(),
+          bias_contig.defined() ? bias_contig.data_ptr<scalar_t>() : nullptr,
+          output.data_ptr<scalar_t>());
+    } else {
+      // [groups * oc, ic, kh, kw] -> [groups, kh * kw, ic, ldw]
+      constexpr int64_t kVecSize = Vec256<scalar_t>::size();
+      const int64_t ldw = divup(s.out_channels_per_group, kVecSize) * kVecSize;
+      Tensor packed_weight = at::zeros({groups, taps, s.in_channels_per_group, ldw}, weight.options());
+      packed_weight.narrow(3, 0, s.out_channels_per_group).copy_(
+          weight.view({groups, s.out_channels_per_group, s.in_channels_per_group, taps})
+              .permute({0, 3, 2, 1}));
+      Tensor packed_bias = at::zeros({groups, ldw}, weight.options());
+      if (bias.defined()) {
+        packed_bias.narrow(1, 0, s.out_channels_per_group).copy_(
+            bias.view({groups, s.out_channels_per_group}));
+      }
+      conv_channels_last_gemm<scalar_t>(
+          s,
+          input.data_ptr<scalar_t>(),
+          packed_weight.data_ptr<scalar_t>(),
+          packed_bias.data_ptr<scalar_t>(),
+          ldw,
+          output.data_ptr<scalar_t>());
+    }
+  });
+  return output;
+}
+
+}  // namespace
+
+REGISTER_DISPATCH(convolution_channels_last_stub, &convolution_channels_last_kernel);
+
+}  // namespace native
+}  // namespace at
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/native/DispatchStub.h>
+
+/*
+  Direct convolution of channels last (NHWC) tensors, without im2col
+*/
+
+namespace at {
+namespace native {
+
+using convolution_channels_last_fn =
+    Tensor (*)(const Tensor &, const Tensor &, const Tensor &, IntArrayRef, IntArrayRef, IntArrayRef, int64_t);
+
+DECLARE_DISPATCH(convolution_channels_last_fn, convolution_channels_last_stub);
+
+}  // namespace native
+}  // namespace at
@@ -1242,10 +1242,207 @@ grid_sampler_2d_backward_cpu_kernel_impl(const Tensor& grad_output_,
   return std::make_tuple(grad_input, grad_grid);
 }
 
+// Kernels applying a plan of _grid_sampler_2d_plan, see
+// NOTE [ Grid Sample Plans ] in GridSampler.cpp. `input` and `output` are
+// both in `memory_format`, contiguous or channels last, and `indices` and
+// `weights` are contiguous with a batch size of 1 or of the input.
+template<typename scalar_t>
+void grid_sampler_2d_apply_plan_channels_last(
+    Tensor& output, const Tensor& input, const Tensor& indices, const Tensor& weights) {
+  using Vec = Vec256<scalar_t>;
+  int64_t N = input.size(0);
+  int64_t C = input.size(1);
+  int64_t inp_HW = input.size(2) * input.size(3);
+  int64_t out_HW = output.size(2) * output.size(3);
+  int64_t K = indices.size(3);
+  int64_t plan_sN = indices.size(0) == 1 ? 0 : out_HW * K;
+  const scalar_t *inp_ptr = input.data_ptr<scalar_t>();
+  scalar_t *out_ptr = output.data_ptr<scalar_t>();
+  const int64_t *idx_ptr = indices.data_ptr<int64_t>();
+  const scalar_t *w_ptr = weights.data_ptr<scalar_t>();
+
+  // every output pixel is a row of C channels, interpolated from the rows of
+  // its K taps
+  at::parallel_for(0, N * out_HW, at::internal::GRAIN_SIZE / (C * K) + 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      int64_t n = i / out_HW;
+      const int64_t *idx_ptr_p = idx_ptr + n * plan_sN + (i % out_HW) * K;
+      const scalar_t *w_ptr_p = w_ptr + n * plan_sN + (i % out_HW) * K;
+      const scalar_t *inp_ptr_n = inp_ptr + n * inp_HW * C;
+      scalar_t *out_ptr_p = out_ptr + i * C;
+      std::fill(out_ptr_p, out_ptr_p + C, scalar_t(0));
+      for (int64_t k = 0; k < K; ++k) {
+        scalar_t w = w_ptr_p[k];
+        if (w == 0) {
+          continue;
+        }
+        const scalar_t *inp_ptr_k = inp_ptr_n + idx_ptr_p[k] * C;
+        int64_t c = 0;
+        for (; c < C - (C % Vec::size()); c += Vec::size()) {
+          vec256::fmadd(Vec(w), Vec::loadu(inp_ptr_k + c), Vec::loadu(out_ptr_p + c))
+            .store(out_ptr_p + c);
+        }
+        for (; c < C; ++c) {
+          out_ptr_p[c] += w * inp_ptr_k[c];
+        }
+      }
+    }
+  });
+}
+
+template<typename scalar_t>
+void grid_sampler_2d_apply_plan_contiguous(
+    Tensor& output, const Tensor& input, const Tensor& indices, const Tensor& weights) {
+  int64_t N = input.size(0);
+  int64_t C = input.size(1);
+  int64_t inp_HW = input.size(2) * input.size(3);
+  int64_t out_HW = output.size(2) * output.size(3);
+  int64_t K = indices.size(3);
+  int64_t plan_sN = indices.size(0) == 1 ? 0 : out_HW * K;
+  const scalar_t *inp_ptr = input.data_ptr<scalar_t>();
+  scalar_t *out_ptr = output.data_ptr<scalar_t>();
+  const int64_t *idx_ptr = indices.data_ptr<int64_t>();
+  const scalar_t *w_ptr = weights.data_ptr<scalar_t>();
+
+  // every (n, c) plane is interpolated on its own
+  at::parallel_for(0, N * C, at::internal::GRAIN_SIZE / (out_HW * K) + 1, [&](int64_t start, int64_t end) {
+    for (int64_t nc = start; nc < end; ++nc) {
+      int64_t n = nc / C;
+      const int64_t *idx_ptr_n = idx_ptr + n * plan_sN;
+      const scalar_t *w_ptr_n = w_ptr + n * plan_sN;
+      const scalar_t *inp_ptr_nc = inp_ptr + nc * inp_HW;
+      scalar_t *out_ptr_nc = out_ptr + nc * out_HW;
+      for (int64_t p = 0; p < out_HW; ++p) {
+        scalar_t val = 0;
+        for (int64_t k = p * K; k < (p + 1) * K; ++k) {
+          // skipped rather than multiplied, as in grid_sampler_2d the zero
+          // padding does not read the input
+          if (w_ptr_n[k] != 0) {
+            val += w_ptr_n[k] * inp_ptr_nc[idx_ptr_n[k]];
+          }
+        }
+        out_ptr_nc[p] = val;
+      }
+    }
+  });
+}
+
+void grid_sampler_2d_apply_plan_cpu_kernel_impl(
+    Tensor& output, const Tensor& input, const Tensor& indices, const Tensor& weights,
+    MemoryFormat memory_format) {
+  // picked by the caller, since e.g. a [N, C, 1, 1] tensor is both contiguous
+  // and channels last
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "grid_sampler_2d_apply_plan_cpu_kernel_impl", [&] {
+    if (memory_format == MemoryFormat::Contiguous) {
+      grid_sampler_2d_apply_plan_contiguous<scalar_t>(output, input, indices, weights);
+    } else {
+      grid_sampler_2d_apply_plan_channels_last<scalar_t>(output, input, indices, weights);
+    }
+  });
+}
+
+// The gradient is scattered to the taps. Each thread owns whole planes, or
+// whole blocks of channels for channels last, so no two threads write to the
+// same grad_input element.
+template<typename scalar_t>
+void grid_sampler_2d_apply_plan_backward_channels_last(
+    Tensor& grad_input, const Tensor& grad_output, const Tensor& indices, const Tensor& weights) {
+  using Vec = Vec256<scalar_t>;
+  int64_t N = grad_input.size(0);
+  int64_t C = grad_input.size(1);
+  int64_t inp_HW = grad_input.size(2) * grad_input.size(3);
+  int64_t out_HW = grad_output.size(2) * grad_output.size(3);
+  int64_t K = indices.size(3);
+  int64_t plan_sN = indices.size(0) == 1 ? 0 : out_HW * K;
+  scalar_t *gInp_ptr = grad_input.data_ptr<scalar_t>();
+  const scalar_t *gOut_ptr = grad_output.data_ptr<scalar_t>();
+  const int64_t *idx_ptr = indices.data_ptr<int64_t>();
+  const scalar_t *w_ptr = weights.data_ptr<scalar_t>();
+
+  constexpr int64_t block_size = Vec::size() * 4;
+  int64_t num_blocks = (C + block_size - 1) / block_size;
+  at::parallel_for(0, N * num_blocks, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      int64_t n = i / num_blocks;
+      int64_t c_begin = (i % num_blocks) * block_size;
+      int64_t c_end = std::min(c_begin + block_size, C);
+      const int64_t *idx_ptr_n = idx_ptr + n * plan_sN;
+      const scalar_t *w_ptr_n = w_ptr + n * plan_sN;
+      scalar_t *gInp_ptr_n = gInp_ptr + n * inp_HW * C;
+      const scalar_t *gOut_ptr_n = gOut_ptr + n * out_HW * C;
+      for (int64_t p = 0; p < out_HW; ++p) {
+        const scalar_t *gOut_ptr_p = gOut_ptr_n + p * C;
+        for (int64_t k = p * K; k < (p + 1) * K; ++k) {
+          scalar_t w = w_ptr_n[k];
+          if (w == 0) {
+            continue;
+          }
+          scalar_t *gInp_ptr_k = gInp_ptr_n + idx_ptr_n[k] * C;
+          int64_t c = c_begin;
+          for (; c < c_end - ((c_end - c_begin) % Vec::size()); c += Vec::size()) {
+            vec256::fmadd(Vec(w), Vec::loadu(gOut_ptr_p + c), Vec::loadu(gInp_ptr_k + c))
+              .store(gInp_ptr_k + c);
+          }
+          for (; c < c_end; ++c) {
+            gInp_ptr_k[c] += w * gOut_ptr_p[c];
+          }
+        }
+      }
+    }
+  });
+}
+
+template<typename scalar_t>
+void grid_sampler_2d_apply_plan_backward_contiguous(
+    Tensor& grad_input, const Tensor& grad_output, const Tensor& indices, const Tensor& weights) {
+  int64_t N = grad_input.size(0);
+  int64_t C = grad_input.size(1);
+  int64_t inp_HW = grad_input.size(2) * grad_input.size(3);
+  int64_t out_HW = grad_output.size(2) * grad_output.size(3);
+  int64_t K = indices.size(3);
+  int64_t plan_sN = indices.size(0) == 1 ? 0 : out_HW * K;
+  scalar_t *gInp_ptr = grad_input.data_ptr<scalar_t>();
+  const scalar_t *gOut_ptr = grad_output.data_ptr<scalar_t>();
+  const int64_t *idx_ptr = indices.data_ptr<int64_t>();
+  const scalar_t *w_ptr = weights.data_ptr<scalar_t>();
+
+  at::parallel_for(0, N * C, at::internal::GRAIN_SIZE / (out_HW * K) + 1, [&](int64_t start, int64_t end) {
+    for (int64_t nc = start; nc < end; ++nc) {
+      int64_t n = nc / C;
+      const int64_t *idx_ptr_n = idx_ptr + n * plan_sN;
+      const scalar_t *w_ptr_n = w_ptr + n * plan_sN;
+      scalar_t *gInp_ptr_nc = gInp_ptr + nc * inp_HW;
+      const scalar_t *gOut_ptr_nc = gOut_ptr + nc * out_HW;
+      for (int64_t p = 0; p < out_HW; ++p) {
+        scalar_t gOut = gOut_ptr_nc[p];
+        for (int64_t k = p * K; k < (p + 1) * K; ++k) {
+          if (w_ptr_n[k] != 0) {
+            gInp_ptr_nc[idx_ptr_n[k]] += w_ptr_n[k] * gOut;
+          }
+        }
+      }
+    }
+  });
+}
+
+void grid_sampler_2d_apply_plan_backward_cpu_kernel_impl(
+    Tensor& grad_input, const Tensor& grad_output, const Tensor& indices, const Tensor& weights,
+    MemoryFormat memory_format) {
+  AT_DISPATCH_FLOATING_TYPES(grad_output.scalar_type(), "grid_sampler_2d_apply_plan_backward_cpu_kernel_impl", [&] {
+    if (memory_format == MemoryFormat::Contiguous) {
+      grid_sampler_2d_apply_plan_backward_contiguous<scalar_t>(grad_input, grad_output, indices, weights);
+    } else {
+      grid_sampler_2d_apply_plan_backward_channels_last<scalar_t>(grad_input, grad_output, indices, weights);
+    }
+  });
+}
+
 }
 
 REGISTER_DISPATCH(grid_sampler_2d_cpu_kernel, &grid_sampler_2d_cpu_kernel_impl);
 REGISTER_DISPATCH(grid_sampler_2d_backward_cpu_kernel, &grid_sampler_2d_backward_cpu_kernel_impl);
+REGISTER_DISPATCH(grid_sampler_2d_apply_plan_cpu_kernel, &grid_sampler_2d_apply_plan_cpu_kernel_impl);
+REGISTER_DISPATCH(grid_sampler_2d_apply_plan_backward_cpu_kernel, &grid_sampler_2d_apply_plan_backward_cpu_kernel_impl);
 
 
 }}  // namespace at::native
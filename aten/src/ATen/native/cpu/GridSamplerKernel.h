@@ -15,4 +15,10 @@ using backward_2d_fn = std::tuple<Tensor, Tensor>(*)(const Tensor &, const Tenso
 DECLARE_DISPATCH(forward_2d_fn, grid_sampler_2d_cpu_kernel);
 DECLARE_DISPATCH(backward_2d_fn, grid_sampler_2d_backward_cpu_kernel);
 
+// Interpolation with a plan of _grid_sampler_2d_plan, see
+// NOTE [ Grid Sample Plans ] in GridSampler.cpp
+using apply_plan_2d_fn = void(*)(Tensor &, const Tensor &, const Tensor &, const Tensor &, MemoryFormat);
+DECLARE_DISPATCH(apply_plan_2d_fn, grid_sampler_2d_apply_plan_cpu_kernel);
+DECLARE_DISPATCH(apply_plan_2d_fn, grid_sampler_2d_apply_plan_backward_cpu_kernel);
+
 }}  // namespace at::native
@@ -0,0 +1,93 @@
+#include <ATen/ATen.h>
+
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/SummaryOps.h>
+
+namespace at { namespace native {
+
+namespace {
+
+// Counts self_data[begin:end] into hist_data. The bins are computed a vector
+// at a time, with the same operations as the scalar tail so that the values
+// on the edge of two bins land in the same bin either way.
+template <typename scalar_t>
+void histc_chunk(
+    scalar_t* hist_data,
+    const scalar_t* self_data,
+    int64_t begin,
+    int64_t end,
+    int64_t nbins,
+    scalar_t minval,
+    scalar_t maxval) {
+  using Vec = vec256::Vec256<scalar_t>;
+  const scalar_t range = maxval - minval;
+  const scalar_t nbins_val = static_cast<scalar_t>(nbins);
+  const Vec min_vec(minval);
+  const Vec range_vec(range);
+  const Vec nbins_vec(nbins_val);
+  scalar_t bins[Vec::size()];
+
+  auto add_to_bin = [&](scalar_t val, scalar_t bin) {
+    // values out of [minval, maxval], nan included, are ignored
+    if (val >= minval && val <= maxval) {
+      hist_data[std::min(static_cast<int64_t>(bin), nbins - 1)] += 1;
+    }
+  };
+
+  int64_t i = begin;
+  for (; i + Vec::size() <= end; i += Vec::size()) {
+    ((Vec::loadu(self_data + i) - min_vec) / range_vec * nbins_vec).store(bins);
+    for (int64_t k = 0; k < Vec::size(); k++) {
+      add_to_bin(self_data[i + k], bins[k]);
+    }
+  }
+  for (; i < end; i++) {
+    add_to_bin(self_data[i], (self_data[i] - minval) / range * nbins_val);
+  }
+}
+
+// Every thread counts its chunks into a private histogram, and the private
+// histograms are summed into hist at the end. Small inputs, or inputs with
+// fewer elements than the private histograms, are counted serially.
+template <typename scalar_t>
+void histc_kernel_impl(
+    Tensor& hist,
+    const Tensor& self,
+    int64_t nbins,
+    scalar_t minval,
+    scalar_t maxval) {
+  const int64_t numel = self.numel();
+  const scalar_t* self_data = self.data_ptr<scalar_t>();
+  scalar_t* hist_data = hist.data_ptr<scalar_t>();
+
+  const int num_threads = at::get_num_threads();
+  if (num_threads == 1 || numel < at::internal::GRAIN_SIZE || nbins * num_threads > numel) {
+    histc_chunk<scalar_t>(hist_data, self_data, 0, numel, nbins, minval, maxval);
+    return;
+  }
+
+  Tensor buffer = at::zeros({num_threads, nbins}, hist.options());
+  scalar_t* buffer_data = buffer.data_ptr<scalar_t>();
+  at::parallel_for(0, numel, at::internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+    const int tid = at::get_thread_num();
+    TORCH_CHECK(tid < num_threads,
+                "expect thread id smaller than ", num_threads, ", got thread id ", tid);
+    histc_chunk<scalar_t>(buffer_data + tid * nbins, self_data, begin, end, nbins, minval, maxval);
+  });
+  at::sum_out(hist, buffer, 0);
+}
+
+void histc_kernel(Tensor& hist, const Tensor& self, int64_t nbins, double min, double max) {
+  AT_DISPATCH_FLOATING_TYPES(self.scalar_type(), "histc_cpu", [&]() {
+    histc_kernel_impl<scalar_t>(
+        hist, self, nbins, static_cast<scalar_t>(min), static_cast<scalar_t>(max));
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(histc_stub, &histc_kernel);
+
+}} // at::native
@@ -0,0 +1,158 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/Pool.h>
+#include <ATen/native/cpu/utils.h>
+
+namespace at { namespace native {
+
+namespace {
+
+using namespace vec256;
+
+// Every output pixel (n, oh, ow) is a row of channels that is reduced from
+// the rows of the pooling window, so the whole kernel is vectorized over the
+// channels. The running argmax is kept in an integer vector of the same width
+// as the values, which lets the comparison mask select the new index with a
+// plain blend; it is widened to int64 once the window is done.
+template <typename scalar_t>
+void cpu_max_pool2d_channels_last(
+    const Tensor& output_,
+    const Tensor& indices_,
+    const Tensor& input_,
+    int kW, int kH,
+    int dW, int dH,
+    int padW, int padH,
+    int dilationW, int dilationH) {
+  TORCH_CHECK(input_.ndimension() == 4,
+              "max pooling with channels last format supports tensors with 4 dims");
+  auto memory_format = at::MemoryFormat::ChannelsLast;
+  auto input = input_.contiguous(memory_format);
+  auto output = output_.contiguous(memory_format);
+  auto indices = indices_.contiguous(memory_format);
+
+  auto input_data = input.data_ptr<scalar_t>();
+  auto output_data = output.data_ptr<scalar_t>();
+  auto indices_data = indices.data_ptr<int64_t>();
+
+  int64_t nbatch = input.size(0);
+  int64_t channels = input.size(1);
+  int64_t input_height = input.size(2);
+  int64_t input_width = input.size(3);
+  int64_t output_height = output.size(2);
+  int64_t output_width = output.size(3);
+
+  using Vec = Vec256<scalar_t>;
+  using integer_t = int_same_size_t<scalar_t>;
+  using iVec = Vec256<integer_t>;
+  TORCH_CHECK(input_height * input_width <= std::numeric_limits<integer_t>::max(),
+              "max_pool2d: input spatial size is too large for channels last format");
+
+  at::parallel_for(0, nbatch * output_height * output_width, 0, [&](int64_t begin, int64_t end) {
+    int64_t n = 0;
+    int64_t oh = 0;
+    int64_t ow = 0;
+    data_index_init(begin, n, nbatch, oh, output_height, ow, output_width);
+
+    // Argmax of the current output row, in the integer type matching scalar_t.
+    std::unique_ptr<integer_t[]> index_buffer(new integer_t[channels]);
+
+    for (int64_t i = begin; i < end; i++) {
+      int64_t hstart = oh * dH - padH;
+      int64_t wstart = ow * dW - padW;
+      int64_t hend = std::min(hstart + (kH - 1) * dilationH + 1, input_height);
+      int64_t wend = std::min(wstart + (kW - 1) * dilationW + 1, input_width);
+      while (hstart < 0)
+        hstart += dilationH;
+      while (wstart < 0)
+        wstart += dilationW;
+
+      scalar_t* out = output_data + i * channels;
+      int64_t* ind = indices_data + i * channels;
+      const scalar_t* input_ptr = input_data + n * input_height * input_width * channels;
+
+      // Pass I: init the output row with -inf and the argmax with the window
+      // start, as in the contiguous kernel.
+      const integer_t start_index = hstart * input_width + wstart;
+      int64_t d1 = 0;
+      for (; d1 < channels - (channels % Vec::size()); d1 += Vec::size()) {
+        Vec(-std::numeric_limits<scalar_t>::infinity()).store(out + d1);
+        iVec(start_index).store(index_buffer.get() + d1);
+      }
+      for (; d1 < channels; d1++) {
+        out[d1] = -std::numeric_limits<scalar_t>::infinity();
+        index_buffer[d1] = start_index;
+      }
+
+      // Pass II: compute the max of every channel over the window.
+      for (int64_t ih = hstart; ih < hend; ih += dilationH) {
+        for (int64_t iw = wstart; iw < wend; iw += dilationW) {
+          const scalar_t* in = input_ptr + ih * input_width * channels + iw * channels;
+          const integer_t index = ih * input_width + iw;
+
+          int64_t d2 = 0;
+          for (; d2 < channels - (channels % Vec::size()); d2 += Vec::size()) {
+            Vec val_vec = Vec::loadu(in + d2);
+            Vec maxval_vec = Vec::loadu(out + d2);
+            iVec maxindex_vec = iVec::loadu(index_buffer.get() + d2);
+
+            // The comparison masks are all ones when true. NaN propagates
+            // like in the contiguous kernel: a NaN value always replaces the
+            // current max. The two masks are applied one after the other
+            // rather than or-ed, as the bitwise operators of the DEFAULT
+            // Vec256 go through type punning.
+            Vec mask = val_vec > maxval_vec;
+            Vec nan_mask = val_vec != val_vec;
+            maxval_vec = Vec::blendv(maxval_vec, val_vec, mask);
+            maxindex_vec = iVec::blendv(maxindex_vec, iVec(index), cast<integer_t>(mask));
+            Vec::blendv(maxval_vec, val_vec, nan_mask).store(out + d2);
+            iVec::blendv(maxindex_vec, iVec(index), cast<integer_t>(nan_mask))
+                .store(index_buffer.get() + d2);
+          }
+          for (; d2 < channels; d2++) {
+            scalar_t val = in[d2];
+            if ((val > out[d2]) || std::isnan(val)) {
+              out[d2] = val;
+              index_buffer[d2] = index;
+            }
+          }
+        }
+      }
+
+      // Pass III: widen the argmax to int64.
+      for (int64_t d3 = 0; d3 < channels; d3++) {
+        ind[d3] = index_buffer[d3];
+      }
+
+      data_index_step(n, nbatch, oh, output_height, ow, output_width);
+    }
+  });
+
+  if (!output_.is_contiguous(memory_format)) {
+    output_.copy_(output);
+  }
+  if (!indices_.is_contiguous(memory_format)) {
+    indices_.copy_(indices);
+  }
+}
+
+void max_pool2d_channels_last_kernel_impl(
+    const Tensor& output,
+    const Tensor& indices,
+    const Tensor& input,
+    int kW, int kH,
+    int dW, int dH,
+    int padW, int padH,
+    int dilationW, int dilationH) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "max_pool2d_channels_last", [&] {
+    cpu_max_pool2d_channels_last<scalar_t>(
+        output, indices, input, kW, kH, dW, dH, padW, padH, dilationW, dilationH);
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(max_pool2d_channels_last_kernel, &max_pool2d_channels_last_kernel_impl);
+
+}} // at::native
@@ -0,0 +1,299 @@
+#pragma once
+
+#include <ATen/ATen.h>
+#include <ATen/CPUGeneratorImpl.h>
+#include <ATen/Dispatch.h>
+#include <ATen/ExpandUtils.h>
+#include <ATen/Parallel.h>
+#include <ATen/core/TransformationHelper.h>
+#include <ATen/native/TensorIterator.h>
+#include <ATen/native/cpu/DistributionTemplates.h>
+#include <mutex>
+
+#ifdef CPU_CAPABILITY_AVX2
+#include <ATen/cpu/vec256/intrinsics.h>
+#endif
+
+/**
+ * Note [Philox CPU RNG]
+ * ~~~~~~~~~~~~~~~~~~~~~
+ * With at::globalContext().setUsePhiloxCPURNG(true), uniform_, normal_ and
+ * bernoulli_ (and so dropout) on CPU draw their randoms from the counter based
+ * Philox engine (see Note [Philox Engine implementation]) instead of
+ * mt19937. The randoms of a call are the sequence of
+ * at::philox_engine(seed, 0, offset / 4), where seed and offset come from
+ * CPUGeneratorImpl::philox_engine_inputs, and element i of the output uses
+ * the randoms [i * words, (i + 1) * words) of that sequence. Since any
+ * position of the sequence can be computed directly from its counter, the
+ * output is split with parallel_for and every chunk computes its own
+ * randoms; the result only depends on the state of the generator, never
+ * on the number of threads. The generator mutex is only held to reserve the
+ * offsets.
+ *
+ * The engine is run for kPhiloxLanes consecutive counters at once, which is
+ * an AVX2 register of 32 bit lanes.
+ */
+
+namespace at {
+namespace native {
+namespace philox {
+namespace {
+
+constexpr int64_t kPhiloxLanes = 8;
+// Number of 32 bit randoms produced by one call of philox_block.
+constexpr int64_t kPhiloxBlockSize = 4 * kPhiloxLanes;
+
+constexpr uint32_t kPhilox10A = 0x9E3779B9;
+constexpr uint32_t kPhilox10B = 0xBB67AE85;
+constexpr uint32_t kPhiloxSA = 0xD2511F53;
+constexpr uint32_t kPhiloxSB = 0xCD9E8D57;
+
+// Writes the randoms of the counters [counter, counter + kPhiloxLanes) of
+// subsequence 0 to out, in the order at::philox_engine returns them:
+// out[4 * l + j] is the j-th output of counter + l.
+#ifdef CPU_CAPABILITY_AVX2
+inline void philox_mulhilo_avx2(__m256i a, __m256i b, __m256i* lo, __m256i* hi) {
+  // _mm256_mul_epu32 multiplies the even 32 bit lanes into 64 bit products.
+  const __m256i even = _mm256_mul_epu32(a, b);
+  const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+  *lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+  *hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+inline void philox_block(uint64_t seed, uint64_t counter, uint32_t* out) {
+  alignas(32) uint32_t ctr_lo[kPhiloxLanes];
+  alignas(32) uint32_t ctr_hi[kPhiloxLanes];
+  for (int64_t l = 0; l < kPhiloxLanes; l++) {
+    ctr_lo[l] = static_cast<uint32_t>(counter + l);
+    ctr_hi[l] = static_cast<uint32_t>((counter + l) >> 32);
+  }
+  __m256i c0 = _mm256_load_si256(reinterpret_cast<const __m256i*>(ctr_lo));
+  __m256i c1 = _mm256_load_si256(reinterpret_cast<const __m256i*>(ctr_hi));
+  __m256i c2 = _mm256_setzero_si256();
+  __m256i c3 = _mm256_setzero_si256();
+  uint32_t k0 = static_cast<uint32_t>(seed);
+  uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+  const __m256i sa = _mm256_set1_epi32(static_cast<int32_t>(kPhiloxSA));
+  const __m256i sb = _mm256_set1_epi32(static_cast<int32_t>(kPhiloxSB));
+  for (int round = 0; round < 10; round++) {
+    __m256i lo0, hi0, lo1, hi1;
+    philox_mulhilo_avx2(c0, sa, &lo0, &hi0);
+    philox_mulhilo_avx2(c2, sb, &lo1, &hi1);
+    c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32(static_cast<int32_t>(k0)));
+    c1 = lo1;
+    c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32(static_cast<int32_t>(k1)));
+    c3 = lo0;
+    k0 += kPhilox10A;
+    k1 += kPhilox10B;
+  }
+  alignas(32) uint32_t res[4][kPhiloxLanes];
+  _mm256_store_si256(reinterpret_cast<__m256i*>(res[0]), c0);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(res[1]), c1);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(res[2]), c2);
+  _mm256_store_si256(reinterpret_cast<__m256i*>(res[3]), c3);
+  for (int64_t l = 0; l < kPhiloxLanes; l++) {
+    for (int64_t j = 0; j < 4; j++) {
+      out[4 * l + j] = res[j][l];
+    }
+  }
+}
+#else
+inline void philox_block(uint64_t seed, uint64_t counter, uint32_t* out) {
+  uint32_t c0[kPhiloxLanes];
+  uint32_t c1[kPhiloxLanes];
+  uint32_t c2[kPhiloxLanes];
+  uint32_t c3[kPhiloxLanes];
+  for (int64_t l = 0; l < kPhiloxLanes; l++) {
+    c0[l] = static_cast<uint32_t>(counter + l);
+    c1[l] = static_cast<uint32_t>((counter + l) >> 32);
+    c2[l] = 0;
+    c3[l] = 0;
+  }
+  uint32_t k0 = static_cast<uint32_t>(seed);
+  uint32_t k1 = static_cast<uint32_t>(seed >> 32);
+  for (int round = 0; round < 10; round++) {
+    for (int64_t l = 0; l < kPhiloxLanes; l++) {
+      const uint64_t p0 = static_cast<uint64_t>(kPhiloxSA) * c0[l];
+      const uint64_t p1 = static_cast<uint64_t>(kPhiloxSB) * c2[l];
+      c0[l] = static_cast<uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+      c1[l] = static_cast<uint32_t>(p1);
+      c2[l] = static_cast<uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+      c3[l] = static_cast<uint32_t>(p0);
+    }
+    k0 += kPhilox10A;
+    k1 += kPhilox10B;
+  }
+  for (int64_t l = 0; l < kPhiloxLanes; l++) {
+    out[4 * l] = c0[l];
+    out[4 * l + 1] = c1[l];
+    out[4 * l + 2] = c2[l];
+    out[4 * l + 3] = c3[l];
+  }
+}
+#endif
+
+// Calls f(i, randoms) for every element i in [begin, end), where randoms
+// points at the kWords 32 bit randoms of element i.
+template <int64_t kWords, typename func_t>
+inline void philox_for_each(uint64_t seed, uint64_t offset, int64_t begin, int64_t end, const func_t& f) {
+  static_assert(kPhiloxBlockSize % kWords == 0, "elements can't straddle Philox blocks");
+  constexpr int64_t kElementsPerBlock = kPhiloxBlockSize / kWords;
+  uint32_t block[kPhiloxBlockSize];
+  int64_t i = begin;
+  while (i < end) {
+    const int64_t b = i / kElementsPerBlock;
+    philox_block(seed, offset / 4 + b * kPhiloxLanes, block);
+    const int64_t block_begin = b * kElementsPerBlock;
+    const int64_t block_end = std::min(end, block_begin + kElementsPerBlock);
+    for (; i < block_end; i++) {
+      f(i, block + (i - block_begin) * kWords);
+    }
+  }
+}
+
+// A double takes 64 random bits, every other type 32.
+template <typename scalar_t>
+struct PhiloxWords {
+  static constexpr int64_t value = std::is_same<scalar_t, double>::value ? 2 : 1;
+};
+
+template <typename scalar_t, int64_t kWords>
+inline dist_acctype<scalar_t> philox_uniform(const uint32_t* randoms, scalar_t from, scalar_t to) {
+  if (kWords == 2) {
+    const uint64_t val = (static_cast<uint64_t>(randoms[0]) << 32) | randoms[kWords - 1];
+    return transformation::uniform_real<scalar_t>(val, from, to);
+  }
+  return transformation::uniform_real<scalar_t>(randoms[0], from, to);
+}
+
+// Reserves the randoms of a call. See Note [Acquire lock when using random generators]
+inline std::pair<uint64_t, uint64_t> philox_reserve(CPUGeneratorImpl* generator, int64_t numel, int64_t words) {
+  std::lock_guard<std::mutex> lock(generator->mutex_);
+  return generator->philox_engine_inputs(numel * words);
+}
+
+// The kernels below write to a contiguous tensor and copy back if self is not.
+inline Tensor contiguous_output(const Tensor& self) {
+  return self.is_contiguous() ? self : at::empty_like(self, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+}
+
+// ==================================================== Uniform =======================================================
+
+void uniform_kernel(TensorIterator& iter, double from_, double to_, CPUGeneratorImpl* generator) {
+  Tensor self = iter.output();
+  Tensor out = contiguous_output(self);
+  const int64_t numel = out.numel();
+  AT_DISPATCH_FLOATING_TYPES_AND2(kHalf, kBFloat16, out.scalar_type(), "uniform_kernel_cpu_philox", [&]() {
+    constexpr int64_t kWords = PhiloxWords<scalar_t>::value;
+    const auto from = static_cast<scalar_t>(from_);
+    const auto to = static_cast<scalar_t>(to_);
+    const auto inputs = philox_reserve(generator, numel, kWords);
+    scalar_t* data = out.data_ptr<scalar_t>();
+    at::parallel_for(0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+      philox_for_each<kWords>(inputs.first, inputs.second, begin, end, [&](int64_t i, const uint32_t* randoms) {
+        data[i] = static_cast<scalar_t>(philox_uniform<scalar_t, kWords>(randoms, from, to));
+      });
+    });
+  });
+  if (!self.is_same(out)) {
+    self.copy_(out);
+  }
+}
+
+// ==================================================== Normal ========================================================
+
+// Box-Muller on blocks of 16 elements, with the layout of normal_fill_16:
+// the first 8 uniforms give the radii and the next 8 the angles. The element
+// count is rounded up to whole blocks, and the randoms of the last block are
+// drawn for all of its 16 elements even if only some are written.
+void normal_kernel(Tensor& self, double mean_, double std_, CPUGeneratorImpl* generator) {
+  Tensor out = contiguous_output(self);
+  const int64_t numel = out.numel();
+  const int64_t num_blocks = divup(numel, 16);
+  AT_DISPATCH_FLOATING_TYPES_AND2(kHalf, kBFloat16, out.scalar_type(), "normal_kernel_cpu_philox", [&]() {
+    constexpr int64_t kWords = PhiloxWords<scalar_t>::value;
+    const auto mean = static_cast<scalar_t>(mean_);
+    const auto stddev = static_cast<scalar_t>(std_);
+    const auto inputs = philox_reserve(generator, num_blocks * 16, kWords);
+    scalar_t* data = out.data_ptr<scalar_t>();
+    at::parallel_for(0, num_blocks, internal::GRAIN_SIZE / 16, [&](int64_t begin, int64_t end) {
+#ifdef CPU_CAPABILITY_AVX2
+      const __m256 two_pi = _mm256_set1_ps(2.0f * c10::pi<double>);
+      const __m256 one = _mm256_set1_ps(1.0f);
+      const __m256 minus_two = _mm256_set1_ps(-2.0f);
+      const __m256 mean_v = _mm256_set1_ps(static_cast<float>(mean));
+      const __m256 std_v = _mm256_set1_ps(static_cast<float>(stddev));
+#endif
+      scalar_t buffer[16];
+      for (int64_t b = begin; b < end; b++) {
+        philox_for_each<kWords>(inputs.first, inputs.second, b * 16, (b + 1) * 16, [&](int64_t i, const uint32_t* randoms) {
+          buffer[i - b * 16] = static_cast<scalar_t>(
+              philox_uniform<scalar_t, kWords>(randoms, static_cast<scalar_t>(0), static_cast<scalar_t>(1)));
+        });
+#ifdef CPU_CAPABILITY_AVX2
+        if (std::is_same<scalar_t, float>::value) {
+          templates::cpu::normal_fill_16_AVX2(
+              reinterpret_cast<float*>(buffer), &two_pi, &one, &minus_two, &mean_v, &std_v);
+        } else {
+          templates::cpu::normal_fill_16<scalar_t>(buffer, mean, stddev);
+        }
+#else
+        templates::cpu::normal_fill_16<scalar_t>(buffer, mean, stddev);
+#endif
+        const int64_t len = std::min<int64_t>(16, numel - b * 16);
+        std::copy(buffer, buffer + len, data + b * 16);
+      }
+    });
+  });
+  if (!self.is_same(out)) {
+    self.copy_(out);
+  }
+}
+
+// ================================================== Bernoulli =======================================================
+
+// Every element takes one 32 bit random u and is 1 iff u * 2^-32 < p, which
+// resolves p to 2^-32 whatever the dtypes.
+constexpr double kPhiloxBernoulliScale = 1.0 / 4294967296.0;
+
+void bernoulli_kernel(Tensor& self, double p, CPUGeneratorImpl* generator) {
+  Tensor out = contiguous_output(self);
+  const int64_t numel = out.numel();
+  AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, out.scalar_type(), "bernoulli_scalar_cpu_philox", [&] {
+    const auto inputs = philox_reserve(generator, numel, 1);
+    scalar_t* data = out.data_ptr<scalar_t>();
+    at::parallel_for(0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+      philox_for_each<1>(inputs.first, inputs.second, begin, end, [&](int64_t i, const uint32_t* randoms) {
+        data[i] = static_cast<scalar_t>(randoms[0] * kPhiloxBernoulliScale < p);
+      });
+    });
+  });
+  if (!self.is_same(out)) {
+    self.copy_(out);
+  }
+}
+
+void bernoulli_kernel(Tensor& self, const Tensor& p_, CPUGeneratorImpl* generator) {
+  Tensor out = contiguous_output(self);
+  const int64_t numel = out.numel();
+  const Tensor p = std::get<0>(expand_inplace(self, p_.to(kCPU))).contiguous();
+  AT_DISPATCH_ALL_TYPES_AND(at::ScalarType::Bool, out.scalar_type(), "bernoulli_tensor_cpu_self_philox", [&] {
+    using self_t = scalar_t;
+    AT_DISPATCH_FLOATING_TYPES(p.scalar_type(), "bernoulli_tensor_cpu_p_philox", [&] {
+      using p_t = scalar_t;
+      const auto inputs = philox_reserve(generator, numel, 1);
+      self_t* data = out.data_ptr<self_t>();
+      const p_t* p_data = p.data_ptr<p_t>();
+      at::parallel_for(0, numel, internal::GRAIN_SIZE, [&](int64_t begin, int64_t end) {
+        philox_for_each<1>(inputs.first, inputs.second, begin, end, [&](int64_t i, const uint32_t* randoms) {
+          data[i] = static_cast<self_t>(randoms[0] * kPhiloxBernoulliScale < static_cast<double>(p_data[i]));
+        });
+      });
+    });
+  });
+  if (!self.is_same(out)) {
+    self.copy_(out);
+  }
+}
+
+}}}} // namespace at::native::philox::<anonymous>
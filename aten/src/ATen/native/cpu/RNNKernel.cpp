@@ -0,0 +1,184 @@
+#include <ATen/ATen.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/CPUBlas.h>
+#include <ATen/native/RNN.h>
+
+namespace at { namespace native { namespace {
+
+using namespace vec256;
+using Vec = Vec256<float>;
+
+inline Vec sigmoid(const Vec& x) {
+  return (Vec(1.f) + x.neg().exp()).reciprocal();
+}
+
+// The gate math below works on one row of the batch at a time. The last
+// vector of a row goes through the partial loadu / store of Vec256, so the
+// hidden size does not need to be a multiple of the vector size.
+
+// gates holds [i, f, g, o] for the row, already including h @ w_hh^T and
+// both biases.
+inline void lstm_row(
+    const float* gates, float* h, float* c, float* out, int64_t hidden_size) {
+  const float* ig = gates;
+  const float* fg = gates + hidden_size;
+  const float* gg = gates + 2 * hidden_size;
+  const float* og = gates + 3 * hidden_size;
+  for (int64_t j = 0; j < hidden_size; j += Vec::size()) {
+    const int64_t count = std::min<int64_t>(Vec::size(), hidden_size - j);
+    const Vec i = sigmoid(Vec::loadu(ig + j, count));
+    const Vec f = sigmoid(Vec::loadu(fg + j, count));
+    const Vec g = Vec::loadu(gg + j, count).tanh();
+    const Vec o = sigmoid(Vec::loadu(og + j, count));
+    const Vec cy = fmadd(f, Vec::loadu(c + j, count), i * g);
+    const Vec hy = o * cy.tanh();
+    cy.store(c + j, count);
+    hy.store(h + j, count);
+    hy.store(out + j, count);
+  }
+}
+
+// igates holds [r, z, n] of x @ w_ih^T + b_ih, hgates the same for
+// h @ w_hh^T. b_hh is only added here because the n gate applies r to
+// (h @ w_hh^T + b_hh) as a whole.
+inline void gru_row(
+    const float* igates, const float* hgates, const float* b_hh,
+    float* h, float* out, int64_t hidden_size) {
+  for (int64_t j = 0; j < hidden_size; j += Vec::size()) {
+    const int64_t count = std::min<int64_t>(Vec::size(), hidden_size - j);
+    Vec hr = Vec::loadu(hgates + j, count);
+    Vec hz = Vec::loadu(hgates + hidden_size + j, count);
+    Vec hn = Vec::loadu(hgates + 2 * hidden_size + j, count);
+    if (b_hh != nullptr) {
+      hr = hr + Vec::loadu(b_hh + j, count);
+      hz = hz + Vec::loadu(b_hh + hidden_size + j, count);
+      hn = hn + Vec::loadu(b_hh + 2 * hidden_size + j, count);
+    }
+    const Vec r = sigmoid(Vec::loadu(igates + j, count) + hr);
+    const Vec z = sigmoid(Vec::loadu(igates + hidden_size + j, count) + hz);
+    const Vec n = fmadd(r, hn, Vec::loadu(igates + 2 * hidden_size + j, count)).tanh();
+    const Vec hy = fmadd(z, Vec::loadu(h + j, count) - n, n);
+    hy.store(h + j, count);
+    hy.store(out + j, count);
+  }
+}
+
+template <bool kTanh>
+inline void simple_rnn_row(const float* gates, float* h, float* out, int64_t hidden_size) {
+  for (int64_t j = 0; j < hidden_size; j += Vec::size()) {
+    const int64_t count = std::min<int64_t>(Vec::size(), hidden_size - j);
+    const Vec x = Vec::loadu(gates + j, count);
+    const Vec hy = kTanh ? x.tanh() : maximum(x, Vec(0.f));
+    hy.store(h + j, count);
+    hy.store(out + j, count);
+  }
+}
+
+// Runs one direction of one layer over the whole sequence. For every step
+// the recurrent GEMM is a single BLAS call on the rows of the batch that are
+// still active, followed by the gate math; nothing is allocated per step.
+//
+// igates is [rows, gates * hidden_size] and holds the input projection of
+// every step, computed up front as one GEMM. For LSTM and the simple RNNs it
+// is used as the accumulator of the recurrent GEMM, so it is overwritten.
+// output is [rows, hidden_size] with an arbitrary row stride. hx / cx are
+// [batch, hidden_size], hold the initial state and are updated in place to
+// the final one. batch_sizes follows the PackedSequence convention; rows of
+// the state past the current batch size are left alone, which gives the
+// right final state for sequences that ended early (forward) or have not
+// started yet (reverse).
+void rnn_fused_layer_kernel(
+    FusedRNNMode mode,
+    const Tensor& igates,
+    const Tensor& w_hh,
+    const Tensor& b_hh,
+    const Tensor& output,
+    const Tensor& hx,
+    const Tensor& cx,
+    IntArrayRef batch_sizes,
+    bool reverse) {
+  const int64_t hidden_size = hx.size(1);
+  const int64_t gate_size = w_hh.size(0);
+  const int64_t num_steps = batch_sizes.size();
+  TORCH_INTERNAL_ASSERT(igates.is_contiguous() && w_hh.is_contiguous() && hx.is_contiguous());
+  TORCH_INTERNAL_ASSERT(igates.size(1) == gate_size && output.stride(1) == 1);
+  if (num_steps == 0 || hidden_size == 0) {
+    return;
+  }
+
+  std::vector<int64_t> offsets(num_steps);
+  int64_t rows = 0;
+  for (int64_t t = 0; t < num_steps; t++) {
+    offsets[t] = rows;
+    rows += batch_sizes[t];
+  }
+  TORCH_INTERNAL_ASSERT(rows == igates.size(0));
+
+  float* igates_data = igates.data_ptr<float>();
+  const float* w_hh_data = w_hh.data_ptr<float>();
+  const float* b_hh_data = b_hh.defined() ? b_hh.data_ptr<float>() : nullptr;
+  float* output_data = output.data_ptr<float>();
+  const int64_t output_stride = output.stride(0);
+  float* h = hx.data_ptr<float>();
+  float* c = nullptr;
+  if (mode == FusedRNNMode::LSTM) {
+    TORCH_INTERNAL_ASSERT(cx.is_contiguous());
+    c = cx.data_ptr<float>();
+  }
+  // Preallocated workspace for the recurrent half of the GRU gates.
+  Tensor hgates;
+  float* hgates_data = nullptr;
+  if (mode == FusedRNNMode::GRU) {
+    hgates = at::empty({hx.size(0), gate_size}, igates.options());
+    hgates_data = hgates.data_ptr<float>();
+  }
+
+  const int64_t grain_size = std::max<int64_t>(internal::GRAIN_SIZE / gate_size, 1);
+  for (int64_t s = 0; s < num_steps; s++) {
+    const int64_t t = reverse ? num_steps - 1 - s : s;
+    const int64_t batch_size = batch_sizes[t];
+    float* step_igates = igates_data + offsets[t] * gate_size;
+    float* step_output = output_data + offsets[t] * output_stride;
+
+    // Row-major gates[b, g] (+)= h[b, :] . w_hh[g, :], written for the
+    // column-major BLAS interface as gates^T = w_hh * h^T.
+    const bool accumulate = mode != FusedRNNMode::GRU;
+    cpublas::gemm(
+        cpublas::Transpose, cpublas::NoTranspose,
+        gate_size, batch_size, hidden_size,
+        1.f,
+        w_hh_data, hidden_size,
+        h, hidden_size,
+        accumulate ? 1.f : 0.f,
+        accumulate ? step_igates : hgates_data, gate_size);
+
+    parallel_for(0, batch_size, grain_size, [&](int64_t begin, int64_t end) {
+      for (int64_t b = begin; b < end; b++) {
+        float* h_b = h + b * hidden_size;
+        float* out_b = step_output + b * output_stride;
+        const float* igates_b = step_igates + b * gate_size;
+        switch (mode) {
+          case FusedRNNMode::LSTM:
+            lstm_row(igates_b, h_b, c + b * hidden_size, out_b, hidden_size);
+            break;
+          case FusedRNNMode::GRU:
+            gru_row(igates_b, hgates_data + b * gate_size, b_hh_data, h_b, out_b, hidden_size);
+            break;
+          case FusedRNNMode::RNN_TANH:
+            simple_rnn_row<true>(igates_b, h_b, out_b, hidden_size);
+            break;
+          case FusedRNNMode::RNN_RELU:
+            simple_rnn_row<false>(igates_b, h_b, out_b, hidden_size);
+            break;
+        }
+      }
+    });
+  }
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(rnn_fused_layer_stub, &rnn_fused_layer_kernel);
+
+}} // namespace at::native
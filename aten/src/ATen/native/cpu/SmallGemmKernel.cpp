@@ -0,0 +1,239 @@
+#include <ATen/ATen.h>
+#include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/vec256.h>
+#include <ATen/native/LinearAlgebra.h>
+
+namespace at { namespace native { namespace {
+
+using namespace vec256;
+
+// Register-blocked GEMM for operands that are too small for BLAS to pay off.
+//
+// C is computed in tiles of MR rows by NV vectors of columns. The accumulators
+// of a tile stay in registers for the whole k loop: each step loads NV vectors
+// from one row of B, broadcasts one element of A per row of the tile and
+// issues MR * NV fused multiply-adds. With Vec256<float> on AVX2 the largest
+// tile is 6 x 16, which keeps 12 accumulators, 2 B vectors and one broadcast
+// live out of the 16 ymm registers.
+//
+// All tile shapes are instantiated at compile time. Columns that do not fill
+// a whole vector are copied into a zero padded panel first, so the inner loop
+// only ever does full vector loads; only the C accesses of the last tile are
+// partial.
+constexpr int64_t kSmallGemmMR = 6;
+constexpr int64_t kSmallGemmNV = 2;
+// Depth of the padded panel used for the column tail.
+constexpr int64_t kSmallGemmPanelK = 64;
+
+template <typename scalar_t, int64_t MR, int64_t NV, bool kTail>
+inline void small_gemm_micro_kernel(
+    int64_t k,
+    scalar_t alpha,
+    const scalar_t* a, int64_t a_row_stride, int64_t a_col_stride,
+    const scalar_t* b, int64_t ldb,
+    scalar_t beta,
+    scalar_t* c, int64_t ldc,
+    int64_t n_tail) {
+  using Vec = Vec256<scalar_t>;
+  constexpr int64_t kVecSize = Vec::size();
+
+  Vec acc[MR][NV];
+  for (int64_t r = 0; r < MR; r++) {
+    for (int64_t v = 0; v < NV; v++) {
+      acc[r][v] = Vec(scalar_t(0));
+    }
+  }
+
+  for (int64_t p = 0; p < k; p++) {
+    const scalar_t* b_p = b + p * ldb;
+    Vec b_vec[NV];
+    for (int64_t v = 0; v < NV; v++) {
+      b_vec[v] = Vec::loadu(b_p + v * kVecSize);
+    }
+    const scalar_t* a_p = a + p * a_col_stride;
+    for (int64_t r = 0; r < MR; r++) {
+      const Vec a_vec(a_p[r * a_row_stride]);
+      for (int64_t v = 0; v < NV; v++) {
+        acc[r][v] = fmadd(a_vec, b_vec[v], acc[r][v]);
+      }
+    }
+  }
+
+  // As in BLAS, C is not read when beta is zero so that NaNs in the output
+  // buffer do not leak into the result.
+  const Vec alpha_vec(alpha);
+  const Vec beta_vec(beta);
+  for (int64_t r = 0; r < MR; r++) {
+    for (int64_t v = 0; v < NV; v++) {
+      scalar_t* c_rv = c + r * ldc + v * kVecSize;
+      const int64_t count = (kTail && v == NV - 1) ? n_tail : kVecSize;
+      Vec out = acc[r][v] * alpha_vec;
+      if (beta != scalar_t(0)) {
+        out = fmadd(beta_vec, Vec::loadu(c_rv, count), out);
+      }
+      out.store(c_rv, count);
+    }
+  }
+}
+
+template <typename scalar_t, int64_t NV, bool kTail>
+inline void small_gemm_column_block(
+    int64_t m, int64_t k,
+    scalar_t alpha,
+    const scalar_t* a, int64_t a_row_stride, int64_t a_col_stride,
+    const scalar_t* b, int64_t ldb,
+    scalar_t beta,
+    scalar_t* c, int64_t ldc,
+    int64_t n_tail) {
+  int64_t i = 0;
+  for (; i + kSmallGemmMR <= m; i += kSmallGemmMR) {
+    small_gemm_micro_kernel<scalar_t, kSmallGemmMR, NV, kTail>(
+        k, alpha, a + i * a_row_stride, a_row_stride, a_col_stride, b, ldb,
+        beta, c + i * ldc, ldc, n_tail);
+  }
+  const scalar_t* a_i = a + i * a_row_stride;
+  scalar_t* c_i = c + i * ldc;
+  switch (m - i) {
+    case 0:
+      break;
+#define SMALL_GEMM_ROW_TAIL(MR)                                       \
+    case MR:                                                          \
+      small_gemm_micro_kernel<scalar_t, MR, NV, kTail>(               \
+          k, alpha, a_i, a_row_stride, a_col_stride, b, ldb, beta,    \
+          c_i, ldc, n_tail);                                          \
+      break;
+    SMALL_GEMM_ROW_TAIL(1)
+    SMALL_GEMM_ROW_TAIL(2)
+    SMALL_GEMM_ROW_TAIL(3)
+    SMALL_GEMM_ROW_TAIL(4)
+    SMALL_GEMM_ROW_TAIL(5)
+#undef SMALL_GEMM_ROW_TAIL
+    default:
+      TORCH_INTERNAL_ASSERT(false, "small_gemm: unexpected row tail");
+  }
+}
+
+// Handles the last n_rem < NV * kVecSize columns of C by copying the matching
+// columns of B into a zero padded panel, kSmallGemmPanelK rows at a time.
+template <typename scalar_t, int64_t NV>
+inline void small_gemm_column_tail(
+    int64_t m, int64_t k,
+    scalar_t alpha,
+    const scalar_t* a, int64_t a_row_stride, int64_t a_col_stride,
+    const scalar_t* b, int64_t ldb,
+    scalar_t beta,
+    scalar_t* c, int64_t ldc,
+    int64_t n_rem) {
+  constexpr int64_t kVecSize = Vec256<scalar_t>::size();
+  constexpr int64_t kPanelN = NV * kVecSize;
+  __at_align32__ scalar_t panel[kSmallGemmPanelK * kPanelN];
+  // Runs at least once so that C is still scaled by beta when k == 0.
+  int64_t p0 = 0;
+  do {
+    const int64_t kc = std::min(kSmallGemmPanelK, k - p0);
+    for (int64_t p = 0; p < kc; p++) {
+      const scalar_t* b_p = b + (p0 + p) * ldb;
+      scalar_t* panel_p = panel + p * kPanelN;
+      for (int64_t j = 0; j < n_rem; j++) {
+        panel_p[j] = b_p[j];
+      }
+      for (int64_t j = n_rem; j < kPanelN; j++) {
+        panel_p[j] = scalar_t(0);
+      }
+    }
+    // Later panels accumulate into what the earlier ones wrote.
+    small_gemm_column_block<scalar_t, NV, true>(
+        m, kc, alpha, a + p0 * a_col_stride, a_row_stride, a_col_stride,
+        panel, kPanelN, p0 == 0 ? beta : scalar_t(1), c, ldc,
+        n_rem - (NV - 1) * kVecSize);
+    p0 += kSmallGemmPanelK;
+  } while (p0 < k);
+}
+
+// C = beta * C + alpha * A @ B where C (m x n) and B (k x n) have unit column
+// stride and A (m x k) may be strided arbitrarily, so a transposed A is
+// handled without a copy.
+template <typename scalar_t>
+void small_gemm(
+    int64_t m, int64_t n, int64_t k,
+    scalar_t alpha,
+    const scalar_t* a, int64_t a_row_stride, int64_t a_col_stride,
+    const scalar_t* b, int64_t ldb,
+    scalar_t beta,
+    scalar_t* c, int64_t ldc) {
+  static_assert(kSmallGemmMR == 6, "update the row tail switch");
+  static_assert(kSmallGemmNV == 2, "update the column tail dispatch");
+  constexpr int64_t kVecSize = Vec256<scalar_t>::size();
+  constexpr int64_t kNR = kSmallGemmNV * kVecSize;
+
+  // Columns are the outer loop so that one k x kNR panel of B stays in L1
+  // while all the rows of A stream past it.
+  int64_t j = 0;
+  for (; j + kNR <= n; j += kNR) {
+    small_gemm_column_block<scalar_t, kSmallGemmNV, false>(
+        m, k, alpha, a, a_row_stride, a_col_stride, b + j, ldb, beta, c + j, ldc, 0);
+  }
+  const int64_t n_rem = n - j;
+  if (n_rem == 0) {
+    return;
+  } else if (n_rem == kVecSize) {
+    small_gemm_column_block<scalar_t, 1, false>(
+        m, k, alpha, a, a_row_stride, a_col_stride, b + j, ldb, beta, c + j, ldc, 0);
+  } else if (n_rem < kVecSize) {
+    small_gemm_column_tail<scalar_t, 1>(
+        m, k, alpha, a, a_row_stride, a_col_stride, b + j, ldb, beta, c + j, ldc, n_rem);
+  } else {
+    small_gemm_column_tail<scalar_t, 2>(
+        m, k, alpha, a, a_row_stride, a_col_stride, b + j, ldb, beta, c + j, ldc, n_rem);
+  }
+}
+
+void small_bgemm_kernel(
+    const Tensor& result,
+    const Tensor& batch1,
+    const Tensor& batch2,
+    const Scalar& beta_,
+    const Scalar& alpha_) {
+  const int64_t bs = result.size(0);
+  const int64_t m = result.size(1);
+  const int64_t n = result.size(2);
+  const int64_t k = batch1.size(2);
+  TORCH_INTERNAL_ASSERT(result.stride(2) == 1 || n == 1);
+  TORCH_INTERNAL_ASSERT(batch2.stride(2) == 1 || n == 1);
+
+  AT_DISPATCH_FLOATING_TYPES(result.scalar_type(), "small_bgemm", [&] {
+    const scalar_t alpha = alpha_.to<scalar_t>();
+    const scalar_t beta = beta_.to<scalar_t>();
+    const scalar_t* a = batch1.data_ptr<scalar_t>();
+    const scalar_t* b = batch2.data_ptr<scalar_t>();
+    scalar_t* c = result.data_ptr<scalar_t>();
+    const int64_t a_batch_stride = batch1.stride(0);
+    const int64_t a_row_stride = batch1.stride(1);
+    const int64_t a_col_stride = batch1.stride(2);
+    const int64_t b_batch_stride = batch2.stride(0);
+    const int64_t ldb = batch2.stride(1);
+    const int64_t c_batch_stride = result.stride(0);
+    const int64_t ldc = result.stride(1);
+
+    const int64_t grain_size =
+        std::max(internal::GRAIN_SIZE / std::max(m * n * k, int64_t{1}), int64_t{1});
+    parallel_for(0, bs, grain_size, [&](int64_t b_begin, int64_t b_end) {
+      for (int64_t i = b_begin; i < b_end; i++) {
+        small_gemm<scalar_t>(
+            m, n, k,
+            alpha,
+            a + i * a_batch_stride, a_row_stride, a_col_stride,
+            b + i * b_batch_stride, ldb,
+            beta,
+            c + i * c_batch_stride, ldc);
+      }
+    });
+  });
+}
+
+} // anonymous namespace
+
+REGISTER_DISPATCH(small_bgemm_stub, &small_bgemm_kernel);
+
+}} // namespace at::native
@@ -19,6 +19,7 @@
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/DistributionTemplates.h>
 #include <ATen/native/cpu/Loops.h>
+#include <ATen/native/cpu/PhiloxDistributions.h>
 #include <ATen/native/cpu/zmath.h>
 #include <c10/util/MathConstants.h>
 
@@ -472,13 +473,22 @@ static void cauchy_kernel(TensorIterator& iter, double median, double sigma, c10
   templates::cpu::cauchy_kernel(iter, median, sigma, generator);
 }
 
+// See Note [Philox CPU RNG]
 void bernoulli_tensor_kernel(Tensor& self, const Tensor& p_, c10::optional<Generator> gen) {
   CPUGeneratorImpl* generator = get_generator_or_default<CPUGeneratorImpl>(gen, detail::getDefaultCPUGenerator());
+  if (at::globalContext().usePhiloxCPURNG()) {
+    philox::bernoulli_kernel(self, p_, generator);
+    return;
+  }
   templates::cpu::bernoulli_kernel(self, p_, generator);
 }
 
 void bernoulli_scalar_kernel_default(Tensor& self, double p, c10::optional<Generator> gen) {
   CPUGeneratorImpl* generator = get_generator_or_default<CPUGeneratorImpl>(gen, detail::getDefaultCPUGenerator());
+  if (at::globalContext().usePhiloxCPURNG()) {
+    philox::bernoulli_kernel(self, p, generator);
+    return;
+  }
   templates::cpu::bernoulli_kernel(self, p, generator);
 }
 
@@ -488,7 +498,8 @@ void bernoulli_scalar_kernel(Tensor& self, double p, c10::optional<Generator> ge
 }
 #else
 void bernoulli_scalar_kernel(Tensor &self, double p, c10::optional<Generator> gen) {
-  if (cpuinfo_initialize() && cpuinfo_vendor_intel == cpuinfo_get_processor(0)->core->vendor) {
+  if (!at::globalContext().usePhiloxCPURNG() &&
+      cpuinfo_initialize() && cpuinfo_vendor_intel == cpuinfo_get_processor(0)->core->vendor) {
     CPUGeneratorImpl* generator = get_generator_or_default<CPUGeneratorImpl>(gen, detail::getDefaultCPUGenerator());
     int64_t seed;
     {
@@ -538,7 +549,7 @@ void bernoulli_scalar_kernel(Tensor &self, double p, c10::optional<Generator> ge
       }
     });
   } else {
-    // The situation of AMD, move to using the default version
+    // The situation of AMD or of the Philox engine, move to using the default version
     bernoulli_scalar_kernel_default(self, p, gen);
   }
 }
@@ -561,11 +572,19 @@ static void log_normal_kernel(TensorIterator& iter, double mean, double std, c10
 
 void uniform_kernel(TensorIterator& iter, double from, double to, c10::optional<Generator> gen) {
   CPUGeneratorImpl* generator = get_generator_or_default<CPUGeneratorImpl>(gen, detail::getDefaultCPUGenerator());
+  if (at::globalContext().usePhiloxCPURNG()) {
+    philox::uniform_kernel(iter, from, to, generator);
+    return;
+  }
   templates::cpu::uniform_kernel(iter, from, to, generator);
 }
 
 void normal_kernel(Tensor& self, double mean, double std, c10::optional<Generator> gen) {
   CPUGeneratorImpl* generator = get_generator_or_default<CPUGeneratorImpl>(gen, detail::getDefaultCPUGenerator());
+  if (at::globalContext().usePhiloxCPURNG()) {
+    philox::normal_kernel(self, mean, std, generator);
+    return;
+  }
   templates::cpu::normal_kernel(self, mean, std, generator);
 }
 
@@ -231,40 +231,42 @@ void cpu_upsample_linear_channels_last(
           h * input_width * channels + w * channels;
     };
 
+    // begin and end index rows of the output, i.e. n * output_height + oh,
+    // so that a single image is still split between the threads.
     int64_t ih0, ih1, iw0, iw1;
     scalar_t h0lambda, h1lambda, w0lambda, w1lambda;
-    for (int64_t n = begin; n < end; n++) {
-      for (int64_t oh = 0; oh < output_height; oh++) {
+    for (int64_t i = begin; i < end; i++) {
+      const int64_t n = i / output_height;
+      const int64_t oh = i % output_height;
+      compute_source_index_and_lambda(
+          ih0, ih1, h0lambda, h1lambda, height_scale, oh, input_height, output_height, align_corners);
+      for (int64_t ow = 0; ow < output_width; ow++) {
         compute_source_index_and_lambda(
-            ih0, ih1, h0lambda, h1lambda, height_scale, oh, input_height, output_height, align_corners);
-        for (int64_t ow = 0; ow < output_width; ow++) {
-          compute_source_index_and_lambda(
-              iw0, iw1, w0lambda, w1lambda, width_scale, ow, input_width, output_width, align_corners);
-
-          scalar_t* out = output_data + n * output_slice_size +
-              oh * output_width * channels + ow * channels;
-          scalar_t* i00 = input_indexr(n, ih0, iw0);
-          scalar_t* i01 = input_indexr(n, ih0, iw1);
-          scalar_t* i10 = input_indexr(n, ih1, iw0);
-          scalar_t* i11 = input_indexr(n, ih1, iw1);
+            iw0, iw1, w0lambda, w1lambda, width_scale, ow, input_width, output_width, align_corners);
 
-          int64_t size = channels;
-          int64_t d = 0;
-          for (; d < size - (size % Vec::size()); d += Vec::size()) {
-            Vec out_vec =
-                Vec(h0lambda * w0lambda) * Vec::loadu(i00 + d) + /* h0 * w0 * i00 */
-                Vec(h0lambda * w1lambda) * Vec::loadu(i01 + d) + /* h0 * w1 * i01 */
-                Vec(h1lambda * w0lambda) * Vec::loadu(i10 + d) + /* h1 * w0 * i10 */
-                Vec(h1lambda * w1lambda) * Vec::loadu(i11 + d);  /* h1 * w1 * i11 */
-            out_vec.store(out + d);
-          }
-          for (; d < size; d++) {
-            out[d] =
-                h0lambda * w0lambda * i00[d] + /* h0 * w0 * i00 */
-                h0lambda * w1lambda * i01[d] + /* h0 * w1 * i01 */
-                h1lambda * w0lambda * i10[d] + /* h1 * w0 * i10 */
-                h1lambda * w1lambda * i11[d];  /* h1 * w1 * i11 */
-          }
+        scalar_t* out = output_data + n * output_slice_size +
+            oh * output_width * channels + ow * channels;
+        scalar_t* i00 = input_indexr(n, ih0, iw0);
+        scalar_t* i01 = input_indexr(n, ih0, iw1);
+        scalar_t* i10 = input_indexr(n, ih1, iw0);
+        scalar_t* i11 = input_indexr(n, ih1, iw1);
+
+        int64_t size = channels;
+        int64_t d = 0;
+        for (; d < size - (size % Vec::size()); d += Vec::size()) {
+          Vec out_vec =
+              Vec(h0lambda * w0lambda) * Vec::loadu(i00 + d) + /* h0 * w0 * i00 */
+              Vec(h0lambda * w1lambda) * Vec::loadu(i01 + d) + /* h0 * w1 * i01 */
+              Vec(h1lambda * w0lambda) * Vec::loadu(i10 + d) + /* h1 * w0 * i10 */
+              Vec(h1lambda * w1lambda) * Vec::loadu(i11 + d);  /* h1 * w1 * i11 */
+          out_vec.store(out + d);
+        }
+        for (; d < size; d++) {
+          out[d] =
+              h0lambda * w0lambda * i00[d] + /* h0 * w0 * i00 */
+              h0lambda * w1lambda * i01[d] + /* h0 * w1 * i01 */
+              h1lambda * w0lambda * i10[d] + /* h1 * w0 * i10 */
+              h1lambda * w1lambda * i11[d];  /* h1 * w1 * i11 */
         }
       }
     }
@@ -341,8 +343,9 @@ void cpu_upsample_linear_channels_last(
   };
 
   if (ndim == 4) {
-    // upsample nearest 2d
-    at::parallel_for(0, num_batches, at::internal::GRAIN_SIZE / output_slice_size / 4, loop2d);
+    // upsample bilinear 2d
+    at::parallel_for(0, num_batches * output_height,
+        at::internal::GRAIN_SIZE / (output_width * channels) / 4, loop2d);
   } else {
     // upsample nearest 3d
     TORCH_INTERNAL_ASSERT(ndim == 5);
@@ -492,6 +495,111 @@ void cpu_upsample_linear_backward(
 }
 
 
+// Bicubic counterpart of cpu_upsample_linear_channels_last for 4D inputs.
+// Every output pixel is a weighted sum of the channel rows of a 4 x 4 input
+// window, with the weights shared by all the channels, so the sum is
+// vectorized over the channels.
+template <typename scalar_t, typename scale_type>
+void cpu_upsample_bicubic2d_channels_last(
+    const Tensor& output_,
+    const Tensor& input_,
+    bool align_corners,
+    const scale_type& scales) {
+  TORCH_CHECK(input_.dtype() == output_.dtype(), "expected dtype ", input_.dtype(),
+              " for `output` but got dtype ", output_.dtype());
+  TORCH_CHECK(input_.dim() == 4, "Upsample bicubic with NHWC format supports tensors with 4 dims.")
+
+  auto input = input_.contiguous(at::MemoryFormat::ChannelsLast);
+  auto output = output_.contiguous(at::MemoryFormat::ChannelsLast);
+
+  int64_t num_batches = input.size(0);
+  int64_t channels = input.size(1);
+  int64_t input_height = input.size(2);
+  int64_t input_width = input.size(3);
+  int64_t output_height = output.size(2);
+  int64_t output_width = output.size(3);
+  TORCH_CHECK(channels > 0, "expected input and output channels greater than 0 but got ", channels);
+
+  if (input_height == output_height && input_width == output_width) {
+    // Special case: input/output same size, just copy
+    output.copy_(input);
+  } else {
+    auto input_data = input.data_ptr<scalar_t>();
+    auto output_data = output.data_ptr<scalar_t>();
+    const scalar_t height_scale = area_pixel_compute_scale<scalar_t>(
+        input_height, output_height, align_corners, scales[0]);
+    const scalar_t width_scale = area_pixel_compute_scale<scalar_t>(
+        input_width, output_width, align_corners, scales[1]);
+
+    using Vec = vec256::Vec256<scalar_t>;
+    auto clamp = [](int64_t idx, int64_t size) {
+      return std::max(std::min(idx, size - 1), static_cast<int64_t>(0));
+    };
+
+    // Parallel over the output rows, n * output_height + oh.
+    auto loop = [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; i++) {
+        const int64_t n = i / output_height;
+        const int64_t oh = i % output_height;
+
+        const scalar_t real_y = area_pixel_compute_source_index(height_scale, oh, align_corners, /*cubic=*/true);
+        int64_t input_y = floorf(real_y);
+        scalar_t y_coeffs[4];
+        get_cubic_upsample_coefficients<scalar_t>(y_coeffs, real_y - input_y);
+
+        const scalar_t* input_n = input_data + n * input_height * input_width * channels;
+        for (int64_t ow = 0; ow < output_width; ow++) {
+          const scalar_t real_x = area_pixel_compute_source_index(width_scale, ow, align_corners, /*cubic=*/true);
+          int64_t input_x = floorf(real_x);
+          scalar_t x_coeffs[4];
+          get_cubic_upsample_coefficients<scalar_t>(x_coeffs, real_x - input_x);
+
+          // The 16 rows of the window, with out of bounds accesses clamped
+          // to the border like upsample_get_value_bounded does.
+          const scalar_t* in[4][4];
+          scalar_t weights[4][4];
+          for (int64_t r = 0; r < 4; r++) {
+            const int64_t ih = clamp(input_y - 1 + r, input_height);
+            for (int64_t c = 0; c < 4; c++) {
+              const int64_t iw = clamp(input_x - 1 + c, input_width);
+              in[r][c] = input_n + (ih * input_width + iw) * channels;
+              weights[r][c] = y_coeffs[r] * x_coeffs[c];
+            }
+          }
+
+          scalar_t* out = output_data + (i * output_width + ow) * channels;
+          int64_t d = 0;
+          for (; d < channels - (channels % Vec::size()); d += Vec::size()) {
+            Vec out_vec(scalar_t(0));
+            for (int64_t r = 0; r < 4; r++) {
+              for (int64_t c = 0; c < 4; c++) {
+                out_vec = out_vec + Vec(weights[r][c]) * Vec::loadu(in[r][c] + d);
+              }
+            }
+            out_vec.store(out + d);
+          }
+          for (; d < channels; d++) {
+            scalar_t out_val = 0;
+            for (int64_t r = 0; r < 4; r++) {
+              for (int64_t c = 0; c < 4; c++) {
+                out_val += weights[r][c] * in[r][c][d];
+              }
+            }
+            out[d] = out_val;
+          }
+        }
+      }
+    };
+
+    at::parallel_for(0, num_batches * output_height,
+        at::internal::GRAIN_SIZE / (output_width * channels) / 16, loop);
+  }
+
+  if (!output_.is_contiguous(at::MemoryFormat::ChannelsLast)) {
+    output_.copy_(output);
+  }
+}
+
 // Method to compute indices and weights for each interpolated dimension
 // indices_weights = {
 //      {indices_0, weights_0, indices_1, weights_1},  // dim -n
@@ -628,6 +736,17 @@ void upsample_bilinear2d_kernel_impl(
   }
 }
 
+void upsample_bicubic2d_channels_last_kernel_impl(
+    const Tensor& output,
+    const Tensor& input,
+    bool align_corners,
+    c10::optional<double> scales_h,
+    c10::optional<double> scales_w) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "upsample_bicubic2d_channels_last", [&] {
+    cpu_upsample_bicubic2d_channels_last<scalar_t, scale_t>(output, input, align_corners, {scales_h, scales_w});
+  });
+}
+
 void upsample_trilinear3d_kernel_impl(
     const Tensor& output,
     const Tensor& input,
@@ -681,6 +800,7 @@ void upsample_trilinear3d_backward_kernel_impl(
 
 REGISTER_DISPATCH(upsample_linear1d_kernel, &upsample_linear1d_kernel_impl);
 REGISTER_DISPATCH(upsample_bilinear2d_kernel, &upsample_bilinear2d_kernel_impl);
+REGISTER_DISPATCH(upsample_bicubic2d_channels_last_kernel, &upsample_bicubic2d_channels_last_kernel_impl);
 REGISTER_DISPATCH(upsample_trilinear3d_kernel, &upsample_trilinear3d_kernel_impl);
 REGISTER_DISPATCH(upsample_linear1d_backward_kernel, &upsample_linear1d_backward_kernel_impl);
 REGISTER_DISPATCH(upsample_bilinear2d_backward_kernel, &upsample_bilinear2d_backward_kernel_impl);
@@ -1,8 +1,10 @@
 #include <ATen/native/batch_norm.h>
 
 #include <ATen/ATen.h>
+#include <ATen/AccumulateType.h>
 #include <ATen/CPUApplyUtils.h>
 #include <ATen/Dispatch.h>
+#include <ATen/Parallel.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/cpu/Loops.h>
 
@@ -107,8 +109,125 @@ void batch_norm_cpu_inference_contiguous_kernel(Tensor& output, const Tensor& in
   });
 }
 
+/// Applies output(n, h, w, c) = input(n, h, w, c) * alpha(c) + beta(c) on
+/// channels last tensors. Every (n, h, w) position is a contiguous row of
+/// n_channel elements, so alpha and beta are loaded as vectors along with it.
+template<typename scalar_t>
+void batch_norm_cpu_transform_channels_last_impl(Tensor& output,
+    const Tensor& input, const Tensor& alpha, const Tensor& beta) {
+
+  using Vec = Vec256<scalar_t>;
+  if (input.numel() == 0) {
+    return;
+  }
+  const int64_t n_channel = input.size(1);
+  const int64_t n_rows = input.numel() / n_channel;
+
+  scalar_t* output_data = output.data_ptr<scalar_t>();
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+  const scalar_t* alpha_data = alpha.data_ptr<scalar_t>();
+  const scalar_t* beta_data = beta.data_ptr<scalar_t>();
+
+  const int64_t loop_size = n_channel - (n_channel % Vec::size());
+  at::parallel_for(0, n_rows, internal::GRAIN_SIZE / n_channel, [&](int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; i++) {
+      const scalar_t* input_ptr = input_data + i * n_channel;
+      scalar_t* output_ptr = output_data + i * n_channel;
+      int64_t d = 0;
+      for (; d < loop_size; d += Vec::size()) {
+        Vec output_vec = Vec::loadu(input_ptr + d) * Vec::loadu(alpha_data + d) + Vec::loadu(beta_data + d);
+        output_vec.store(output_ptr + d);
+      }
+      for (; d < n_channel; d++) {
+        output_ptr[d] = input_ptr[d] * alpha_data[d] + beta_data[d];
+      }
+    }
+  });
+}
+
+void batch_norm_cpu_transform_channels_last_kernel(Tensor& output, const Tensor& input,
+    const Tensor& alpha, const Tensor& beta) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "batch_norm_cpu_transform_channels_last", [&] {
+    batch_norm_cpu_transform_channels_last_impl<scalar_t>(output, input, alpha, beta);
+  });
+}
+
+/// Per channel statistics of a channels last input. Instead of walking one
+/// channel at a time with a stride of n_channel, every thread reduces whole
+/// rows into its own slice of a {num_threads, n_channel} buffer, which are
+/// summed up at the end. The mean and the sum of squared deviations are
+/// computed in two passes, like the contiguous implementation does.
+template<typename scalar_t>
+void batch_norm_cpu_collect_stats_channels_last_impl(Tensor& mean, Tensor& var_sum,
+    const Tensor& input) {
+
+  using accscalar_t = at::acc_type<scalar_t, false>;
+  const int64_t n_channel = input.size(1);
+  if (n_channel == 0) {
+    return;
+  }
+  const int64_t n_rows = input.numel() / n_channel;
+  const scalar_t* input_data = input.data_ptr<scalar_t>();
+  accscalar_t* mean_data = mean.data_ptr<accscalar_t>();
+  accscalar_t* var_sum_data = var_sum.data_ptr<accscalar_t>();
+
+  const int num_threads = at::get_num_threads();
+  Tensor buffer = at::empty({num_threads, n_channel}, mean.options());
+  accscalar_t* buffer_data = buffer.data_ptr<accscalar_t>();
+  const int64_t grain_size = internal::GRAIN_SIZE / n_channel;
+
+  // Sums into buffer one thread slice at a time, then folds the slices into
+  // result. The inner loops run over contiguous channels and are left to the
+  // compiler to vectorize.
+  auto reduce_rows = [&](accscalar_t* result, auto row_op) {
+    buffer.zero_();
+    at::parallel_for(0, n_rows, grain_size, [&](int64_t begin, int64_t end) {
+      int tid = at::get_thread_num();
+      TORCH_CHECK(tid < num_threads,
+                  "expect thread id smaller than ", num_threads, ", got thread id ", tid);
+      accscalar_t* buffer_ptr = buffer_data + tid * n_channel;
+      for (int64_t i = begin; i < end; i++) {
+        row_op(buffer_ptr, input_data + i * n_channel);
+      }
+    });
+    for (int64_t c = 0; c < n_channel; c++) {
+      result[c] = 0;
+    }
+    for (int t = 0; t < num_threads; t++) {
+      const accscalar_t* buffer_ptr = buffer_data + t * n_channel;
+      for (int64_t c = 0; c < n_channel; c++) {
+        result[c] += buffer_ptr[c];
+      }
+    }
+  };
+
+  reduce_rows(mean_data, [&](accscalar_t* sum, const scalar_t* x) {
+    for (int64_t c = 0; c < n_channel; c++) {
+      sum[c] += x[c];
+    }
+  });
+  for (int64_t c = 0; c < n_channel; c++) {
+    mean_data[c] /= n_rows;
+  }
+  reduce_rows(var_sum_data, [&](accscalar_t* sum, const scalar_t* x) {
+    for (int64_t c = 0; c < n_channel; c++) {
+      const accscalar_t diff = x[c] - mean_data[c];
+      sum[c] += diff * diff;
+    }
+  });
+}
+
+void batch_norm_cpu_collect_stats_channels_last_kernel(Tensor& mean, Tensor& var_sum,
+    const Tensor& input) {
+  AT_DISPATCH_FLOATING_TYPES(input.scalar_type(), "batch_norm_cpu_collect_stats_channels_last", [&] {
+    batch_norm_cpu_collect_stats_channels_last_impl<scalar_t>(mean, var_sum, input);
+  });
+}
+
 }// anonymous namespace
 
 REGISTER_DISPATCH(batch_norm_cpu_inference_contiguous_stub, &batch_norm_cpu_inference_contiguous_kernel);
+REGISTER_DISPATCH(batch_norm_cpu_transform_channels_last_stub, &batch_norm_cpu_transform_channels_last_kernel);
+REGISTER_DISPATCH(batch_norm_cpu_collect_stats_channels_last_stub, &batch_norm_cpu_collect_stats_channels_last_kernel);
 
 }} // namespace at::native
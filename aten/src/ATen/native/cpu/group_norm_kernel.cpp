@@ -85,6 +85,117 @@ void GroupNormKernelImplInternal(
   });
 }
 
+// Channels last (NHWC) version of the kernel above. A group is not a
+// contiguous block of memory here, so the statistics are gathered per channel
+// first: the N * HxW rows of C elements are split between the threads, each
+// thread accumulating sum(x) and sum(x^2) of its rows into its own
+// {N, 2 * C} slice of a buffer. The slices are then reduced into the group
+// statistics, which are folded with gamma and beta into one scale and bias per
+// (n, c). The normalization is a second parallel sweep over the rows. Both
+// sweeps are vectorized over the channels regardless of the group size.
+template <typename T>
+void GroupNormKernelImplChannelsLastInternal(
+    const Tensor& X,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t N,
+    int64_t C,
+    int64_t HxW,
+    int64_t group,
+    T eps,
+    Tensor& Y,
+    Tensor& mean,
+    Tensor& rstd) {
+  TORCH_CHECK(X.numel() == N * C * HxW);
+  TORCH_CHECK(!gamma.defined() || gamma.numel() == C);
+  TORCH_CHECK(!beta.defined() || beta.numel() == C);
+  using Vec = vec256::Vec256<T>;
+  const int64_t G = group;
+  const int64_t D = C / G;
+  const T* X_data = X.data_ptr<T>();
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  const T* beta_data = beta.defined() ? beta.data_ptr<T>() : nullptr;
+  T* Y_data = Y.data_ptr<T>();
+  T* mean_data = mean.data_ptr<T>();
+  T* rstd_data = rstd.data_ptr<T>();
+  const T s = T(1) / static_cast<T>(D * HxW);
+  const int64_t inner_size = C / Vec::size() * Vec::size();
+  const int64_t grain_size = std::max<int64_t>(at::internal::GRAIN_SIZE / C, 1);
+
+  const int num_threads = at::get_num_threads();
+  Tensor buffer = at::zeros({num_threads, N, 2 * C}, X.options());
+  T* buffer_data = buffer.data_ptr<T>();
+  at::parallel_for(0, N * HxW, grain_size, [&](int64_t start, int64_t end) {
+    const int tid = at::get_thread_num();
+    TORCH_CHECK(tid < num_threads,
+                "expect thread id smaller than ", num_threads, ", got thread id ", tid);
+    for (int64_t i = start; i < end; ++i) {
+      const int64_t n = i / HxW;
+      const T* X_ptr = X_data + i * C;
+      T* sum_ptr = buffer_data + (tid * N + n) * 2 * C;
+      T* sq_ptr = sum_ptr + C;
+      int64_t j = 0;
+      for (; j < inner_size; j += Vec::size()) {
+        const Vec x_vec = Vec::loadu(X_ptr + j);
+        (Vec::loadu(sum_ptr + j) + x_vec).store(sum_ptr + j);
+        (Vec::loadu(sq_ptr + j) + x_vec * x_vec).store(sq_ptr + j);
+      }
+      for (; j < C; ++j) {
+        sum_ptr[j] += X_ptr[j];
+        sq_ptr[j] += X_ptr[j] * X_ptr[j];
+      }
+    }
+  });
+
+  // scale and bias per (n, c), such that Y = scale * X + bias.
+  Tensor scale_bias = at::empty({N, 2 * C}, X.options());
+  T* scale_bias_data = scale_bias.data_ptr<T>();
+  for (int64_t n = 0; n < N; ++n) {
+    T* scale_ptr = scale_bias_data + n * 2 * C;
+    T* bias_ptr = scale_ptr + C;
+    for (int64_t g = 0; g < G; ++g) {
+      T mean_val = 0;
+      T rstd_val = 0;
+      for (int t = 0; t < num_threads; ++t) {
+        const T* sum_ptr = buffer_data + (t * N + n) * 2 * C + g * D;
+        const T* sq_ptr = sum_ptr + C;
+        for (int64_t j = 0; j < D; ++j) {
+          mean_val += sum_ptr[j];
+          rstd_val += sq_ptr[j];
+        }
+      }
+      mean_val *= s;
+      rstd_val = std::max(rstd_val * s - mean_val * mean_val, T(0));
+      rstd_val = T(1) / std::sqrt(rstd_val + eps);
+      for (int64_t j = 0; j < D; ++j) {
+        const int64_t c = g * D + j;
+        scale_ptr[c] = rstd_val * (gamma_data == nullptr ? T(1) : gamma_data[c]);
+        bias_ptr[c] = -scale_ptr[c] * mean_val + (beta_data == nullptr ? T(0) : beta_data[c]);
+      }
+      mean_data[n * G + g] = mean_val;
+      rstd_data[n * G + g] = rstd_val;
+    }
+  }
+
+  at::parallel_for(0, N * HxW, grain_size, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      const T* scale_ptr = scale_bias_data + (i / HxW) * 2 * C;
+      const T* bias_ptr = scale_ptr + C;
+      const T* X_ptr = X_data + i * C;
+      T* Y_ptr = Y_data + i * C;
+      int64_t j = 0;
+      for (; j < inner_size; j += Vec::size()) {
+        const Vec y_vec = Vec::loadu(X_ptr + j) * Vec::loadu(scale_ptr + j) +
+            Vec::loadu(bias_ptr + j);
+        y_vec.store(Y_ptr + j);
+      }
+      for (; j < C; ++j) {
+        Y_ptr[j] = scale_ptr[j] * X_ptr[j] + bias_ptr[j];
+      }
+    }
+  });
+}
+
 void GroupNormKernelImpl(
     const Tensor& X,
     const Tensor& gamma,
@@ -97,6 +208,23 @@ void GroupNormKernelImpl(
     Tensor& Y,
     Tensor& mean,
     Tensor& rstd) {
+  if (X.is_contiguous(at::MemoryFormat::ChannelsLast) && !X.is_contiguous()) {
+    AT_DISPATCH_FLOATING_TYPES(X.scalar_type(), "GroupNormKernelImpl", [&]() {
+      GroupNormKernelImplChannelsLastInternal<scalar_t>(
+          X,
+          gamma,
+          beta,
+          N,
+          C,
+          HxW,
+          group,
+          static_cast<scalar_t>(eps),
+          Y,
+          mean,
+          rstd);
+    });
+    return;
+  }
   AT_DISPATCH_FLOATING_TYPES(X.scalar_type(), "GroupNormKernelImpl", [&]() {
     GroupNormKernelImplInternal<scalar_t>(
         X,
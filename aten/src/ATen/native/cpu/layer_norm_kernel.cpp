@@ -284,10 +284,122 @@ void LayerNormBackwardKernelImpl(
       });
 }
 
+template <typename T, LayerNormActivation kActivation>
+inline vec256::Vec256<T> LayerNormActivationVec(vec256::Vec256<T> x) {
+  using Vec = vec256::Vec256<T>;
+  if (kActivation == LayerNormActivation::Relu) {
+    return vec256::maximum(x, Vec(T(0)));
+  } else if (kActivation == LayerNormActivation::Gelu) {
+    return x * Vec(T(0.5)) * (Vec(T(1)) + (x * Vec(T(M_SQRT1_2))).erf());
+  }
+  return x;
+}
+
+// Every row takes two passes: the first one reads X and R once, writes the
+// sum to Y and accumulates its moments; the second one normalizes Y in place
+// and applies the activation while the row is still in cache. Compared to
+// add + layer_norm + activation, the activations are read from memory once.
+template <typename T, LayerNormActivation kActivation>
+void AddLayerNormKernelImplInternal(
+    const Tensor& X,
+    const Tensor& R,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    T eps,
+    Tensor* Y) {
+  using Vec = vec256::Vec256<T>;
+  DCHECK_EQ(X.numel(), M * N);
+  DCHECK_EQ(R.numel(), M * N);
+  DCHECK(!gamma.defined() || gamma.numel() == N);
+  DCHECK(!beta.defined() || beta.numel() == N);
+  const T* X_data = X.data_ptr<T>();
+  const T* R_data = R.data_ptr<T>();
+  const T* gamma_data = gamma.defined() ? gamma.data_ptr<T>() : nullptr;
+  const T* beta_data = beta.defined() ? beta.data_ptr<T>() : nullptr;
+  T* Y_data = Y->data_ptr<T>();
+  const T c = T(1) / static_cast<T>(N);
+  at::parallel_for(0, M, 1, [&](int64_t start, int64_t end) {
+    for (int64_t i = start; i < end; ++i) {
+      const T* X_ptr = X_data + i * N;
+      const T* R_ptr = R_data + i * N;
+      T* Y_ptr = Y_data + i * N;
+
+      Vec sum_vec(T(0));
+      Vec sum_sq_vec(T(0));
+      int64_t j = 0;
+      for (; j + Vec::size() <= N; j += Vec::size()) {
+        const Vec x = Vec::loadu(X_ptr + j) + Vec::loadu(R_ptr + j);
+        x.store(Y_ptr + j);
+        sum_vec = sum_vec + x;
+        sum_sq_vec = vec256::fmadd(x, x, sum_sq_vec);
+      }
+      T mean_val = vec256::vec_reduce_all<T>(
+          [](Vec& x, Vec& y) { return x + y; }, sum_vec, Vec::size());
+      T rstd_val = vec256::vec_reduce_all<T>(
+          [](Vec& x, Vec& y) { return x + y; }, sum_sq_vec, Vec::size());
+      for (; j < N; ++j) {
+        const T x = X_ptr[j] + R_ptr[j];
+        Y_ptr[j] = x;
+        mean_val += x;
+        rstd_val += x * x;
+      }
+      mean_val *= c;
+      rstd_val = std::max(rstd_val * c - mean_val * mean_val, T(0));
+      rstd_val = T(1) / std::sqrt(rstd_val + eps);
+      const Vec scale(rstd_val);
+      const Vec bias(-rstd_val * mean_val);
+
+      for (j = 0; j < N; j += Vec::size()) {
+        const int64_t count = std::min<int64_t>(Vec::size(), N - j);
+        Vec y = Vec::loadu(Y_ptr + j, count) * scale + bias;
+        if (gamma_data != nullptr) {
+          y = y * Vec::loadu(gamma_data + j, count);
+        }
+        if (beta_data != nullptr) {
+          y = y + Vec::loadu(beta_data + j, count);
+        }
+        LayerNormActivationVec<T, kActivation>(y).store(Y_ptr + j, count);
+      }
+    }
+  });
+}
+
+void AddLayerNormKernelImpl(
+    const Tensor& X,
+    const Tensor& R,
+    const Tensor& gamma,
+    const Tensor& beta,
+    int64_t M,
+    int64_t N,
+    double eps,
+    LayerNormActivation activation,
+    Tensor* Y) {
+  AT_DISPATCH_FLOATING_TYPES(X.scalar_type(), "AddLayerNormKernelImpl", [&]() {
+    const auto eps_val = static_cast<scalar_t>(eps);
+    switch (activation) {
+      case LayerNormActivation::None:
+        AddLayerNormKernelImplInternal<scalar_t, LayerNormActivation::None>(
+            X, R, gamma, beta, M, N, eps_val, Y);
+        break;
+      case LayerNormActivation::Relu:
+        AddLayerNormKernelImplInternal<scalar_t, LayerNormActivation::Relu>(
+            X, R, gamma, beta, M, N, eps_val, Y);
+        break;
+      case LayerNormActivation::Gelu:
+        AddLayerNormKernelImplInternal<scalar_t, LayerNormActivation::Gelu>(
+            X, R, gamma, beta, M, N, eps_val, Y);
+        break;
+    }
+  });
+}
+
 } // namespace
 
 REGISTER_DISPATCH(LayerNormKernel, &LayerNormKernelImpl);
 REGISTER_DISPATCH(LayerNormBackwardKernel, &LayerNormBackwardKernelImpl);
+REGISTER_DISPATCH(AddLayerNormKernel, &AddLayerNormKernelImpl);
 
 } // namespace native
 } // namespace at
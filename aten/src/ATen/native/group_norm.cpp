@@ -17,8 +17,22 @@
 namespace at {
 namespace native {
 
+namespace {
+
+// The CPU kernel has an NHWC path for 4-d channels last inputs only; every
+// other layout, including channels_last_3d, is normalized on a contiguous copy.
+at::MemoryFormat group_norm_memory_format(const Tensor& X) {
+  if (X.device().is_cpu() && X.dim() == 4 &&
+      X.suggest_memory_format() == at::MemoryFormat::ChannelsLast) {
+    return at::MemoryFormat::ChannelsLast;
+  }
+  return at::MemoryFormat::Contiguous;
+}
+
+} // namespace
+
 std::tuple<Tensor, Tensor, Tensor> native_group_norm(
-    const Tensor& X,
+    const Tensor& X_,
     const Tensor& gamma /* optional */,
     const Tensor& beta /* optional */,
     int64_t N,
@@ -26,7 +40,9 @@ std::tuple<Tensor, Tensor, Tensor> native_group_norm(
     int64_t HxW,
     int64_t group,
     double eps) {
-  Tensor Y = at::native::empty_like(X, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  const auto memory_format = group_norm_memory_format(X_);
+  const Tensor X = X_.contiguous(memory_format);
+  Tensor Y = at::native::empty_like(X, memory_format);
   Tensor mean = at::empty({N, group}, X.options());
   Tensor rstd = at::empty({N, group}, X.options());
   GroupNormKernel(
@@ -57,10 +73,12 @@ std::tuple<Tensor, Tensor, Tensor> native_group_norm_backward(
   if (grad_input_mask[2]) {
     dbeta = at::native::empty_like(gamma, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
   }
+  // The backward kernels expect contiguous inputs, while the forward may
+  // have saved a channels last X.
   GroupNormBackwardKernel(
       X.device().type(),
-      dY,
-      X,
+      dY.contiguous(),
+      X.contiguous(),
       mean,
       rstd,
       gamma,
@@ -111,7 +129,8 @@ Tensor group_norm(
       c10::multiply_integers(input_shape.cbegin() + 2, input_shape.cend());
 
   const Tensor kEmpty;
-  const auto& X = input.is_contiguous() ? input : input.contiguous();
+  const auto memory_format = group_norm_memory_format(input);
+  const auto& X = input.is_contiguous(memory_format) ? input : input.contiguous(memory_format);
   const auto& gamma = weight.defined() ? weight.contiguous() : kEmpty;
   const auto& beta = bias.defined() ? bias.contiguous() : kEmpty;
   TORCH_CHECK(!gamma.defined() || gamma.numel() == C);
@@ -101,8 +101,80 @@ Tensor layer_norm(
   return std::get<0>(at::native_layer_norm(input, normalized_shape, weight, bias, eps));
 }
 
+namespace {
+
+LayerNormActivation parse_layer_norm_activation(const std::string& activation) {
+  if (activation == "none") {
+    return LayerNormActivation::None;
+  } else if (activation == "relu") {
+    return LayerNormActivation::Relu;
+  } else if (activation == "gelu") {
+    return LayerNormActivation::Gelu;
+  }
+  TORCH_CHECK(false, "_add_layer_norm: expected activation to be one of ",
+              "'none', 'relu' or 'gelu', but got '", activation, "'");
+}
+
+} // namespace
+
+// Unfused activation(layer_norm(input + residual)), for the backends without
+// a fused kernel and for inputs the fused kernel does not take.
+Tensor add_layer_norm(
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const Tensor& weight /* optional */,
+    const Tensor& bias /* optional */,
+    double eps,
+    std::string activation) {
+  const auto activation_kind = parse_layer_norm_activation(activation);
+  auto out = at::layer_norm(input + residual, normalized_shape, weight, bias, eps);
+  switch (activation_kind) {
+    case LayerNormActivation::Relu:
+      return at::relu(out);
+    case LayerNormActivation::Gelu:
+      return at::gelu(out);
+    case LayerNormActivation::None:
+      break;
+  }
+  return out;
+}
+
+Tensor add_layer_norm_cpu(
+    const Tensor& input,
+    const Tensor& residual,
+    IntArrayRef normalized_shape,
+    const Tensor& weight /* optional */,
+    const Tensor& bias /* optional */,
+    double eps,
+    std::string activation) {
+  const auto activation_kind = parse_layer_norm_activation(activation);
+  // The fused kernel reads the residual row by row along with the input, so
+  // broadcasting and type promotion are left to the unfused ops.
+  if (!input.sizes().equals(residual.sizes()) ||
+      input.scalar_type() != residual.scalar_type() ||
+      !residual.device().is_cpu()) {
+    return add_layer_norm(input, residual, normalized_shape, weight, bias, eps, activation);
+  }
+
+  auto inputs = _prepare_layer_norm_inputs(input, normalized_shape, weight, bias);
+  auto X = std::get<0>(inputs);
+  auto gamma = std::get<1>(inputs);
+  auto beta = std::get<2>(inputs);
+  auto M = std::get<3>(inputs);
+  auto N = std::get<4>(inputs);
+  auto R = residual.contiguous();
+
+  Tensor Y = at::native::empty_like(X, at::MemoryFormat::Contiguous);
+  if (M > 0) {
+    AddLayerNormKernel(kCPU, X, R, gamma, beta, M, N, eps, activation_kind, &Y);
+  }
+  return Y;
+}
+
 DEFINE_DISPATCH(LayerNormKernel);
 DEFINE_DISPATCH(LayerNormBackwardKernel);
+DEFINE_DISPATCH(AddLayerNormKernel);
 
 // Ported from pytorch/xla repo
 std::tuple<Tensor, Tensor, Tensor> math_native_layer_norm(
@@ -90,8 +90,28 @@ using backward_fn = void (*)(
     Tensor* /* dgamma */,
     Tensor* /* dbeta */);
 
+// Elementwise op applied to the output of _add_layer_norm.
+enum class LayerNormActivation : int64_t {
+  None,
+  Relu,
+  Gelu,
+};
+
+// Y = activation(layer_norm(X + R)), in a single pass over X and R.
+using add_forward_fn = void (*)(
+    const Tensor& /* X */,
+    const Tensor& /* R */,
+    const Tensor& /* gamma */,
+    const Tensor& /* beta */,
+    int64_t /* M */,
+    int64_t /* N */,
+    double /* eps */,
+    LayerNormActivation /* activation */,
+    Tensor* /* Y */);
+
 DECLARE_DISPATCH(forward_fn, LayerNormKernel);
 DECLARE_DISPATCH(backward_fn, LayerNormBackwardKernel);
+DECLARE_DISPATCH(add_forward_fn, AddLayerNormKernel);
 
 } // namespace native
 } // namespace at
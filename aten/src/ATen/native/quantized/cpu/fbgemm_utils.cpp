@@ -4,6 +4,7 @@
 #include <ATen/native/quantized/cpu/embedding_packed_params.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 #include <ATen/native/quantized/cpu/packed_params.h>
+#include <ATen/native/quantized/cpu/portable_utils.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
 #include <ATen/native/TensorFactories.h>
 #include <ATen/quantized/QTensorImpl.h>
@@ -446,6 +447,15 @@ torch::class_<LinearPackedParamsBase> register_linear_params() {
                       std::move(weight), std::move(bias));
                 }
 #endif // USE_PYTORCH_QNNPACK
+                if (at::globalContext().qEngine() == at::QEngine::NoQEngine) {
+                  TORCH_CHECK(
+                      weight.scalar_type() == at::kQInt8,
+                      "Only INT8 weights are supported without a quantized "
+                      "engine. Got ",
+                      c10::toString(weight.scalar_type()));
+                  return PackedLinearWeightPortable::prepack(
+                      std::move(weight), std::move(bias));
+                }
                 TORCH_CHECK(false, "Unknown qengine");
               });
   return register_linear_params;
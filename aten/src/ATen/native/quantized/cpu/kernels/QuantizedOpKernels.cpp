@@ -1,14 +1,18 @@
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
 #include <ATen/Parallel.h>
+#include <ATen/cpu/vec256/functional.h>
 #include <ATen/native/SortingUtils.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/UpSample.h>
 #include <ATen/native/cpu/Loops.h>
 #include <ATen/native/quantized/affine_quantizer.h>
+#include <ATen/native/quantized/cpu/portable_utils.h>
+#include <ATen/native/quantized/cpu/quant_utils.h>
 #include <ATen/native/quantized/cpu/quantized_ops.h>
 
 #include <cmath>
+#include <cstring>
 #ifdef USE_FBGEMM
 #include <fbgemm/QuantUtils.h>
 #endif
@@ -3034,6 +3038,233 @@ void dequantize_tensor_per_tensor_affine_sub_byte_cpu(
 
 }
 
+// Quantizes one row of the dynamic linear input to uint8 with its own scale
+// and zero point and writes it as int16 into the packed A buffer, zero padded
+// to K_pad. Returns the sum of the quantized values.
+int32_t quantize_and_pack_row(
+    const float* x,
+    int64_t K,
+    int64_t K_pad,
+    bool reduce_range,
+    int16_t* out,
+    float* scale,
+    int32_t* zero_point) {
+  using Vec = vec256::Vec256<float>;
+  float x_min = 0;
+  float x_max = 0;
+  if (K > 0) {
+    std::tie(x_min, x_max) = vec256::reduce2_all<float>(
+        [](const Vec& a, const Vec& b) { return vec256::minimum(a, b); },
+        [](const Vec& a, const Vec& b) { return vec256::maximum(a, b); },
+        x,
+        K);
+  }
+  auto q_params = quant_utils::ChooseQuantizationParams(
+      /*min=*/x_min,
+      /*max=*/x_max,
+      /*qmin=*/0,
+      /*qmax=*/255,
+      /*preserve_sparsity=*/false,
+      /*force_scale_power_of_two=*/false,
+      /*reduce_range=*/reduce_range);
+  *scale = static_cast<float>(q_params.scale);
+  *zero_point = q_params.zero_point;
+
+  const float inv_scale = 1.0f / static_cast<float>(q_params.scale);
+  const float qmax = reduce_range ? 127 : 255;
+  const Vec inv_scale_vec(inv_scale);
+  const Vec zero_point_vec(static_cast<float>(q_params.zero_point));
+  const Vec qmin_vec(0.0f);
+  const Vec qmax_vec(qmax);
+  int32_t sum = 0;
+  int64_t k = 0;
+  for (; k + Vec::size() <= K; k += Vec::size()) {
+    Vec q = (Vec::loadu(x + k) * inv_scale_vec).round() + zero_point_vec;
+    q = vec256::minimum(vec256::maximum(q, qmin_vec), qmax_vec);
+    int32_t q_int[Vec::size()];
+    vec256::convert_to_int_of_same_size(q).store(q_int);
+    for (int64_t j = 0; j < Vec::size(); ++j) {
+      out[k + j] = static_cast<int16_t>(q_int[j]);
+      sum += q_int[j];
+    }
+  }
+  for (; k < K; ++k) {
+    float q = std::nearbyint(x[k] * inv_scale) + q_params.zero_point;
+    int32_t q_int = static_cast<int32_t>(std::min(std::max(q, 0.0f), qmax));
+    out[k] = static_cast<int16_t>(q_int);
+    sum += q_int;
+  }
+  for (; k < K_pad; ++k) {
+    out[k] = 0;
+  }
+  return sum;
+}
+
+// acc[MR][NR] = A[MR][K_pad] * panel, where A rows are int16 holding uint8
+// values and the panel is laid out as [K_pad / 2][NR][2] int8 (see
+// portable_utils.h). Rows past `mr` alias row 0 and their results are junk.
+void qlinear_int8_microkernel(
+    int64_t mr,
+    const int16_t* a,
+    int64_t lda,
+    const int8_t* panel,
+    int64_t K_pad,
+    int32_t* acc) {
+  constexpr int64_t MR = kPortableLinearMR;
+  constexpr int64_t NR = kPortableLinearNR;
+  static_assert(MR == 4 && NR == 8, "micro-kernel is written for a 4x8 tile");
+  const int16_t* a_rows[MR];
+  for (int64_t r = 0; r < MR; ++r) {
+    a_rows[r] = a + (r < mr ? r : 0) * lda;
+  }
+#ifdef CPU_CAPABILITY_AVX2
+  __m256i c[MR];
+  for (int64_t r = 0; r < MR; ++r) {
+    c[r] = _mm256_setzero_si256();
+  }
+  for (int64_t k = 0; k < K_pad; k += 2) {
+    // 8 output channels x 2 consecutive k, widened to int16.
+    const __m256i w = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(panel + k * NR)));
+    for (int64_t r = 0; r < MR; ++r) {
+      int32_t a_pair;
+      std::memcpy(&a_pair, a_rows[r] + k, sizeof(a_pair));
+      c[r] = _mm256_add_epi32(
+          c[r], _mm256_madd_epi16(_mm256_set1_epi32(a_pair), w));
+    }
+  }
+  for (int64_t r = 0; r < MR; ++r) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + r * NR), c[r]);
+  }
+#elif defined(__ARM_NEON__) || defined(__aarch64__)
+  int32x4_t c_lo[MR];
+  int32x4_t c_hi[MR];
+  for (int64_t r = 0; r < MR; ++r) {
+    c_lo[r] = vdupq_n_s32(0);
+    c_hi[r] = vdupq_n_s32(0);
+  }
+  for (int64_t k = 0; k < K_pad; k += 2) {
+    // De-interleave into the even and odd k of the 8 output channels.
+    const int8x8x2_t w = vld2_s8(panel + k * NR);
+    const int16x8_t w0 = vmovl_s8(w.val[0]);
+    const int16x8_t w1 = vmovl_s8(w.val[1]);
+    for (int64_t r = 0; r < MR; ++r) {
+      const int16_t a0 = a_rows[r][k];
+      const int16_t a1 = a_rows[r][k + 1];
+      c_lo[r] = vmlal_n_s16(c_lo[r], vget_low_s16(w0), a0);
+      c_lo[r] = vmlal_n_s16(c_lo[r], vget_low_s16(w1), a1);
+      c_hi[r] = vmlal_n_s16(c_hi[r], vget_high_s16(w0), a0);
+      c_hi[r] = vmlal_n_s16(c_hi[r], vget_high_s16(w1), a1);
+    }
+  }
+  for (int64_t r = 0; r < MR; ++r) {
+    vst1q_s32(acc + r * NR, c_lo[r]);
+    vst1q_s32(acc + r * NR + 4, c_hi[r]);
+  }
+#else
+  for (int64_t i = 0; i < MR * NR; ++i) {
+    acc[i] = 0;
+  }
+  for (int64_t k = 0; k < K_pad; k += 2) {
+    const int8_t* w = panel + k * NR;
+    for (int64_t r = 0; r < MR; ++r) {
+      const int32_t a0 = a_rows[r][k];
+      const int32_t a1 = a_rows[r][k + 1];
+      for (int64_t n = 0; n < NR; ++n) {
+        acc[r * NR + n] += a0 * w[2 * n] + a1 * w[2 * n + 1];
+      }
+    }
+  }
+#endif
+}
+
+void qlinear_dynamic_int8_kernel(
+    const Tensor& input,
+    const PackedLinearWeightPortable& packed,
+    bool reduce_range,
+    bool relu_fused,
+    Tensor& output) {
+  constexpr int64_t MR = kPortableLinearMR;
+  constexpr int64_t NR = kPortableLinearNR;
+  const int64_t M = input.size(0);
+  const int64_t K = packed.K;
+  const int64_t N = packed.N;
+  const int64_t K_pad = packed.K_padded();
+
+  // Quantize the activations row by row straight into the packed A buffer.
+  std::vector<int16_t> a_packed(M * K_pad);
+  std::vector<float> a_scale(M);
+  std::vector<int32_t> a_zero_point(M);
+  std::vector<int32_t> a_sum(M);
+  const float* x = input.data_ptr<float>();
+  at::parallel_for(
+      0, M, 1 + at::internal::GRAIN_SIZE / K, [&](int64_t begin, int64_t end) {
+        for (int64_t m = begin; m < end; ++m) {
+          a_sum[m] = quantize_and_pack_row(
+              x + m * K,
+              K,
+              K_pad,
+              reduce_range,
+              a_packed.data() + m * K_pad,
+              &a_scale[m],
+              &a_zero_point[m]);
+        }
+      });
+
+  const int8_t* w = packed.packed_weight.data_ptr<int8_t>();
+  const int32_t* col_sums = packed.col_sums.data();
+  const float* w_scale = packed.w_scale.data();
+  const int32_t* w_zero_point = packed.w_zp.data();
+  const float* bias =
+      packed.bias_.has_value() ? packed.bias_->data_ptr<float>() : nullptr;
+  float* y = output.data_ptr<float>();
+
+  // Walk the output in MR x NR tiles. Consecutive tiles share a weight panel
+  // so each thread keeps reusing the same panel from cache.
+  const int64_t row_blocks = (M + MR - 1) / MR;
+  const int64_t panels = (N + NR - 1) / NR;
+  at::parallel_for(
+      0,
+      row_blocks * panels,
+      1 + at::internal::GRAIN_SIZE / (MR * NR * K_pad),
+      [&](int64_t begin, int64_t end) {
+        int32_t acc[MR * NR];
+        for (int64_t t = begin; t < end; ++t) {
+          const int64_t p = t / row_blocks;
+          const int64_t m0 = (t % row_blocks) * MR;
+          const int64_t n0 = p * NR;
+          const int64_t mr = std::min(MR, M - m0);
+          const int64_t nr = std::min(NR, N - n0);
+          qlinear_int8_microkernel(
+              mr,
+              a_packed.data() + m0 * K_pad,
+              K_pad,
+              w + p * K_pad * NR,
+              K_pad,
+              acc);
+          for (int64_t r = 0; r < mr; ++r) {
+            const int64_t m = m0 + r;
+            const int32_t a_zp = a_zero_point[m];
+            float* y_row = y + m * N;
+            for (int64_t c = 0; c < nr; ++c) {
+              const int64_t n = n0 + c;
+              // sum_k (a - a_zp) * (w - w_zp), expanded.
+              const int32_t v = acc[r * NR + c] - a_zp * col_sums[n] -
+                  w_zero_point[n] * a_sum[m] + K * a_zp * w_zero_point[n];
+              float out = a_scale[m] * w_scale[n] * static_cast<float>(v);
+              if (bias != nullptr) {
+                out += bias[n];
+              }
+              if (relu_fused) {
+                out = std::max(out, 0.0f);
+              }
+              y_row[n] = out;
+            }
+          }
+        }
+      });
+}
+
 } // namespace
 
 REGISTER_DISPATCH(dequantize_tensor_per_channel_affine_stub,
@@ -3067,6 +3298,7 @@ REGISTER_DISPATCH(qclamp_max_stub, &qclamp_max_kernel);
 REGISTER_DISPATCH(qelu_stub, &qelu_kernel);
 REGISTER_DISPATCH(qhardsigmoid_stub, &qhardsigmoid_kernel);
 REGISTER_DISPATCH(qhardswish_stub, &qhardswish_kernel);
+REGISTER_DISPATCH(qlinear_dynamic_int8_stub, &qlinear_dynamic_int8_kernel);
 REGISTER_DISPATCH(qmaxpool_2d_nhwc_stub, &qmaxpool_2d_nhwc_kernel);
 REGISTER_DISPATCH(qmul_relu_stub, &qmul_kernel<true>);
 REGISTER_DISPATCH(qmul_stub, &qmul_kernel<false>);
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <ATen/Tensor.h>
+#include <ATen/native/quantized/cpu/packed_params.h>
+#include <c10/core/QScheme.h>
+
+// Portable int8 linear, used when the quantized engine is "none" (which is the
+// default on server builds without FBGEMM). It only needs Vec256 / NEON, so it
+// is available on every CPU build.
+//
+// The qint8 weight is packed once at prepack time into panels of
+// kPortableLinearNR output channels. K is padded to an even length and every
+// pair of consecutive k values is stored next to each other:
+//
+//   packed[n / NR][k / 2][n % NR][k % 2] = W[n][k]
+//
+// With this layout the GEMM micro-kernel reads each panel contiguously and
+// can feed the k pairs straight into 16-bit multiply-add instructions. The
+// weight row sums needed for the zero point corrections are also computed at
+// prepack time. At run time only the activations are quantized: each row gets
+// its own scale and zero point, and is written into the GEMM's packed A
+// buffer in the same pass.
+constexpr int64_t kPortableLinearMR = 4;
+constexpr int64_t kPortableLinearNR = 8;
+
+struct TORCH_API PackedLinearWeightPortable : public LinearPackedParamsBase {
+  PackedLinearWeightPortable(
+      at::Tensor packed_weight,
+      c10::optional<at::Tensor> bias,
+      std::vector<int32_t> col_sums,
+      std::vector<float> w_scale,
+      std::vector<int32_t> w_zp,
+      c10::QScheme q_scheme,
+      int64_t N,
+      int64_t K)
+      : packed_weight(std::move(packed_weight)),
+        bias_(std::move(bias)),
+        col_sums(std::move(col_sums)),
+        w_scale(std::move(w_scale)),
+        w_zp(std::move(w_zp)),
+        q_scheme(q_scheme),
+        N(N),
+        K(K) {}
+  // int8, laid out as described above.
+  at::Tensor packed_weight;
+  c10::optional<at::Tensor> bias_;
+  // sum_k W[n][k] for every output channel.
+  std::vector<int32_t> col_sums;
+  // One entry per output channel, per-tensor parameters are broadcast.
+  std::vector<float> w_scale;
+  std::vector<int32_t> w_zp;
+  c10::QScheme q_scheme;
+  int64_t N;
+  int64_t K;
+
+  at::Tensor apply(
+      at::Tensor input,
+      double output_scale,
+      int64_t output_zero_point) override;
+  at::Tensor apply_relu(
+      at::Tensor input,
+      double output_scale,
+      int64_t output_zero_point) override;
+
+  at::Tensor apply_dynamic(at::Tensor input, bool reduce_range=false) override;
+  at::Tensor apply_dynamic_relu(at::Tensor input, bool reduce_range=false) override;
+
+  std::tuple<at::Tensor, c10::optional<at::Tensor>> unpack() override;
+
+  c10::optional<at::Tensor> bias() override {
+    return bias_;
+  }
+
+  void set_bias(c10::optional<at::Tensor> bias) override;
+
+  static c10::intrusive_ptr<LinearPackedParamsBase> prepack(
+      at::Tensor weight,
+      c10::optional<at::Tensor> bias);
+
+  int64_t K_padded() const {
+    return K + (K & 1);
+  }
+
+ private:
+  template <bool ReluFused>
+  at::Tensor apply_dynamic_impl(at::Tensor input, bool reduce_range);
+};
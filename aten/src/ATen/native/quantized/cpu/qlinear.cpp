@@ -3,6 +3,7 @@
 #include <ATen/core/op_registration/op_registration.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 #include <ATen/native/quantized/cpu/packed_params.h>
+#include <ATen/native/quantized/cpu/portable_utils.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
 #include <caffe2/utils/threadpool/pthreadpool-cpp.h>
 #include <torch/custom_class.h>
@@ -374,6 +375,26 @@ at::Tensor PackedLinearWeightsQnnp::apply_relu(
 
 #endif // USE_PYTORCH_QNNPACK
 
+at::Tensor PackedLinearWeightPortable::apply(
+    at::Tensor /* input */,
+    double /* output_scale */,
+    int64_t /* output_zero_point */) {
+  TORCH_CHECK(
+      false,
+      "quantized::linear is not supported when no quantized engine is "
+      "selected, only quantized::linear_dynamic is");
+}
+
+at::Tensor PackedLinearWeightPortable::apply_relu(
+    at::Tensor /* input */,
+    double /* output_scale */,
+    int64_t /* output_zero_point */) {
+  TORCH_CHECK(
+      false,
+      "quantized::linear_relu is not supported when no quantized engine is "
+      "selected, only quantized::linear_relu_dynamic is");
+}
+
 namespace at {
 namespace native {
 namespace {
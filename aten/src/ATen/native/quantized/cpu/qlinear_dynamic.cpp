@@ -3,8 +3,10 @@
 #include <ATen/core/op_registration/op_registration.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 #include <ATen/native/quantized/cpu/packed_params.h>
+#include <ATen/native/quantized/cpu/portable_utils.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
 #include <ATen/native/quantized/cpu/quant_utils.h>
+#include <ATen/native/quantized/cpu/quantized_ops.h>
 #include <caffe2/utils/threadpool/pthreadpool-cpp.h>
 #include <torch/library.h>
 
@@ -404,6 +406,71 @@ void PackedLinearWeightFp16::set_bias(c10::optional<at::Tensor> bias) {
 
 #endif // USE_FBGEMM
 
+namespace at {
+namespace native {
+
+DEFINE_DISPATCH(qlinear_dynamic_int8_stub);
+
+} // namespace native
+} // namespace at
+
+template <bool ReluFused>
+at::Tensor PackedLinearWeightPortable::apply_dynamic_impl(
+    at::Tensor input,
+    bool reduce_range) {
+  TORCH_CHECK(
+      input.scalar_type() == at::kFloat,
+      "qlinear_dynamic: input must be a float tensor");
+  TORCH_CHECK(
+      input.dim() >= 2,
+      "The dimension of input tensor should be larger than or equal to 2");
+  TORCH_CHECK(
+      input.size(input.dim() - 1) == K,
+      "The last dimension of the input should be equal to K: " +
+          std::to_string(K));
+
+  // C(output) = A(input) x B(weight), where C, A, B are M x N, M x K, K x N
+  // matrices, respectively.
+  const int64_t M = size_to_dim_(input.dim() - 1, input.sizes());
+  std::vector<int64_t> output_size = input.sizes().vec();
+  output_size.back() = N;
+  if (M == 0 || K == 0) {
+    at::Tensor output = bias_.has_value()
+        ? bias_->expand(output_size).contiguous()
+        : at::zeros(output_size, input.options().dtype(at::kFloat));
+    return ReluFused ? output.clamp_min_(0) : output;
+  }
+
+  const at::Tensor input_2d = input.reshape({M, K}).contiguous();
+  at::Tensor output = at::empty({M, N}, input.options().dtype(at::kFloat));
+  at::native::qlinear_dynamic_int8_stub(
+      at::kCPU, input_2d, *this, reduce_range, ReluFused, output);
+  return output.view(output_size);
+}
+
+at::Tensor PackedLinearWeightPortable::apply_dynamic(
+    at::Tensor input,
+    bool reduce_range) {
+  return apply_dynamic_impl</*ReluFused=*/false>(std::move(input), reduce_range);
+}
+
+at::Tensor PackedLinearWeightPortable::apply_dynamic_relu(
+    at::Tensor input,
+    bool reduce_range) {
+  return apply_dynamic_impl</*ReluFused=*/true>(std::move(input), reduce_range);
+}
+
+void PackedLinearWeightPortable::set_bias(c10::optional<at::Tensor> bias) {
+  if (bias.has_value()) {
+    TORCH_CHECK(
+        bias->dim() == 1 && bias->size(0) == N,
+        "bias should be a vector of size ",
+        N);
+    bias = bias->to(at::kFloat).contiguous();
+  }
+  bias_ = std::move(bias);
+}
+
 namespace at {
 namespace native {
 namespace {
@@ -3,6 +3,7 @@
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 #include <ATen/native/quantized/cpu/init_qnnpack.h>
 #include <ATen/native/quantized/cpu/packed_params.h>
+#include <ATen/native/quantized/cpu/portable_utils.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
 #include <ATen/native/quantized/cpu/quant_utils.h>
 #include <ATen/quantized/Quantizer.h>
@@ -191,6 +192,84 @@ c10::intrusive_ptr<LinearPackedParamsBase> PackedLinearWeightFp16::prepack(
 }
 #endif // USE_FBGEMM
 
+c10::intrusive_ptr<LinearPackedParamsBase> PackedLinearWeightPortable::prepack(
+    at::Tensor weight,
+    c10::optional<at::Tensor> bias) {
+  TORCH_CHECK(
+      weight.dim() == 2,
+      "The weight tensor for quantized::linear_prepack should be "
+      "2-dimensional.");
+  TORCH_CHECK(
+      weight.scalar_type() == c10::kQInt8,
+      "quantized::linear_prepack only supports qint8 weights when no "
+      "quantized engine is selected");
+  const auto qtype = weight.qscheme();
+  TORCH_CHECK(
+      qtype == c10::kPerTensorAffine || qtype == c10::kPerChannelAffine,
+      "Unsupported qscheme: ",
+      toString(qtype));
+
+  const int64_t N = weight.size(0);
+  const int64_t K = weight.size(1);
+  const int64_t K_pad = K + (K & 1);
+  constexpr int64_t NR = kPortableLinearNR;
+  const int64_t panels = (N + NR - 1) / NR;
+
+  std::vector<float> w_scale(N);
+  std::vector<int32_t> w_zp(N);
+  if (qtype == c10::kPerTensorAffine) {
+    std::fill(w_scale.begin(), w_scale.end(), weight.q_scale());
+    std::fill(w_zp.begin(), w_zp.end(), weight.q_zero_point());
+  } else {
+    TORCH_CHECK(
+        weight.q_per_channel_axis() == 0,
+        "quantized::linear_prepack only supports per-channel weights quantized "
+        "along the output channels (axis 0), got axis ",
+        weight.q_per_channel_axis());
+    const at::Tensor scales =
+        weight.q_per_channel_scales().to(at::kFloat).contiguous();
+    const at::Tensor zero_points =
+        weight.q_per_channel_zero_points().to(at::kInt).contiguous();
+    std::copy_n(scales.data_ptr<float>(), N, w_scale.begin());
+    std::copy_n(zero_points.data_ptr<int32_t>(), N, w_zp.begin());
+  }
+
+  // Pad N up to whole panels and K to an even length; the padding stays zero
+  // and never reaches the output.
+  const at::Tensor weight_contig = weight.contiguous();
+  const int8_t* w =
+      reinterpret_cast<const int8_t*>(weight_contig.data_ptr<c10::qint8>());
+  at::Tensor packed = at::zeros({panels * K_pad * NR}, at::kChar);
+  int8_t* packed_ptr = packed.data_ptr<int8_t>();
+  std::vector<int32_t> col_sums(N, 0);
+  for (int64_t n = 0; n < N; ++n) {
+    int8_t* panel = packed_ptr + (n / NR) * K_pad * NR;
+    const int64_t c = n % NR;
+    for (int64_t k = 0; k < K; ++k) {
+      panel[(k / 2) * NR * 2 + c * 2 + (k % 2)] = w[n * K + k];
+      col_sums[n] += w[n * K + k];
+    }
+  }
+
+  c10::optional<at::Tensor> bias_contig;
+  if (bias.has_value()) {
+    TORCH_CHECK(bias->dim() == 1, "bias should be a vector (1D Tensor)");
+    TORCH_CHECK(
+        bias->size(0) == N,
+        "bias should have N elements: " + std::to_string(N));
+    bias_contig = bias->to(at::kFloat).contiguous();
+  }
+  return c10::make_intrusive<PackedLinearWeightPortable>(
+      std::move(packed),
+      std::move(bias_contig),
+      std::move(col_sums),
+      std::move(w_scale),
+      std::move(w_zp),
+      qtype,
+      N,
+      K);
+}
+
 namespace at {
 namespace native {
 
@@ -220,6 +299,10 @@ class QLinearPackWeightInt8 final {
           std::move(weight), std::move(bias));
     }
 #endif
+    if (ctx.qEngine() == at::QEngine::NoQEngine) {
+      return PackedLinearWeightPortable::prepack(
+          std::move(weight), std::move(bias));
+    }
     TORCH_CHECK(
         false,
         "Didn't find engine for operation quantized::linear_prepack ",
@@ -280,6 +363,14 @@ class QLinearPackWeightInt8Legacy final {
       return cpp_custom_type_hack::create(std::move(wrapped), options);
     }
 #endif // USE_PYTORCH_QNNPACK
+    if (ctx.qEngine() == at::QEngine::NoQEngine) {
+      auto prepacked = PackedLinearWeightPortable::prepack(
+          std::move(weight), std::move(bias));
+      auto wrapped =
+          std::make_unique<c10::intrusive_ptr<LinearPackedParamsBase>>(
+              std::move(prepacked));
+      return cpp_custom_type_hack::create(std::move(wrapped), options);
+    }
     TORCH_CHECK(
         false,
         "Didn't find engine for operation quantized::linear_prepack ",
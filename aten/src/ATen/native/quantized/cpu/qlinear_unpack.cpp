@@ -2,6 +2,7 @@
 #include <ATen/cpp_custom_type_hack.h>
 #include <ATen/native/quantized/cpu/fbgemm_utils.h>
 #include <ATen/native/quantized/cpu/packed_params.h>
+#include <ATen/native/quantized/cpu/portable_utils.h>
 #include <ATen/native/quantized/cpu/qnnpack_utils.h>
 #include <torch/custom_class.h>
 #include <torch/library.h>
@@ -74,6 +75,44 @@ std::tuple<at::Tensor, c10::optional<at::Tensor>> PackedLinearWeightFp16::
 }
 #endif // USE_FBGEMM
 
+std::tuple<at::Tensor, c10::optional<at::Tensor>> PackedLinearWeightPortable::
+    unpack() {
+  at::Tensor weight_origin;
+  if (q_scheme == c10::kPerTensorAffine) {
+    weight_origin = at::_empty_affine_quantized(
+        {N, K}, at::device(c10::kCPU).dtype(c10::kQInt8), w_scale[0], w_zp[0]);
+  } else {
+    auto scales = at::from_blob(
+        w_scale.data(), w_scale.size(), device(c10::kCPU).dtype(c10::kFloat));
+    auto zero_points = at::from_blob(
+        w_zp.data(), w_zp.size(), device(c10::kCPU).dtype(c10::kInt));
+
+    weight_origin = at::_empty_per_channel_affine_quantized(
+        {N, K},
+        scales.toType(c10::kDouble),
+        zero_points.toType(c10::kLong),
+        0, // The output channel axis is 0
+        device(c10::kCPU).dtype(c10::kQInt8));
+  }
+
+  // Undo the panel layout described in portable_utils.h.
+  int8_t* weight_ptr_int8 =
+      reinterpret_cast<int8_t*>(weight_origin.data_ptr<c10::qint8>());
+  const int8_t* packed = packed_weight.data_ptr<int8_t>();
+  constexpr int64_t NR = kPortableLinearNR;
+  const int64_t K_pad = K_padded();
+  for (int64_t n = 0; n < N; ++n) {
+    const int8_t* panel = packed + (n / NR) * K_pad * NR;
+    const int64_t c = n % NR;
+    for (int64_t k = 0; k < K; ++k) {
+      weight_ptr_int8[n * K + k] = panel[(k / 2) * NR * 2 + c * 2 + (k % 2)];
+    }
+  }
+
+  return std::tuple<at::Tensor, c10::optional<at::Tensor>>(
+      weight_origin, bias_);
+}
+
 namespace at {
 namespace native {
 namespace {
@@ -4,6 +4,7 @@
 #include <ATen/Utils.h>
 #include <ATen/CPUGeneratorImpl.h>
 #include <ATen/core/PhiloxRNGEngine.h>
+#include <ATen/core/TransformationHelper.h>
 #include <thread>
 #include <limits>
 #include <random>
@@ -200,6 +201,74 @@ TEST(CPUGeneratorImpl, TestPhiloxEngineIndex) {
   ASSERT_NE(engine1(), engine2());
 }
 
+TEST(CPUGeneratorImpl, TestPhiloxEngineInputs) {
+  // Test Description:
+  //   Tests that the Philox offset of CPUGeneratorImpl advances by whole
+  //   counters, is reset by reseeding and is kept by clone and get/set_state.
+  auto gen = at::detail::createCPUGenerator(123);
+  auto cpu_gen = check_generator<CPUGeneratorImpl>(gen);
+  std::lock_guard<std::mutex> lock(gen.mutex());
+  auto initial_state = gen.get_state();
+  auto inputs = cpu_gen->philox_engine_inputs(5);
+  ASSERT_EQ(inputs.first, 123);
+  ASSERT_EQ(inputs.second, 0);
+  inputs = cpu_gen->philox_engine_inputs(8);
+  ASSERT_EQ(inputs.second, 8);
+  ASSERT_EQ(cpu_gen->philox_offset(), 16);
+
+  auto state = gen.get_state();
+  ASSERT_GT(state.numel(), initial_state.numel());
+  auto clone_gen = gen.clone();
+  auto clone = check_generator<CPUGeneratorImpl>(clone_gen);
+  ASSERT_EQ(clone->philox_offset(), 16);
+  ASSERT_EQ(clone->random(), cpu_gen->random());
+
+  gen.set_state(initial_state);
+  ASSERT_EQ(cpu_gen->philox_offset(), 0);
+  gen.set_state(state);
+  ASSERT_EQ(cpu_gen->philox_offset(), 16);
+
+  gen.set_current_seed(7);
+  ASSERT_EQ(cpu_gen->philox_offset(), 0);
+  ASSERT_EQ(gen.get_state().numel(), initial_state.numel());
+}
+
+TEST(CPUGeneratorImpl, TestPhiloxDistributions) {
+  // Test Description:
+  //   Tests that with the Philox CPU RNG, parallel uniform_ and bernoulli_
+  //   give the serial Philox sequence, and that normal_ is reproducible.
+  //   See Note [Philox CPU RNG]
+  const bool prev = at::globalContext().usePhiloxCPURNG();
+  at::globalContext().setUsePhiloxCPURNG(true);
+  auto gen = at::detail::createCPUGenerator(42);
+  const int64_t numel = 100003;
+
+  auto uniform = at::empty({numel}, kFloat).uniform_(0, 1, gen);
+  auto bernoulli = at::empty({numel}, kFloat).bernoulli_(0.3, gen);
+  at::Philox4_32_10 engine(42, 0, 0);
+  auto uniform_a = uniform.accessor<float, 1>();
+  for (int64_t i = 0; i < numel; i++) {
+    ASSERT_EQ(uniform_a[i], at::transformation::uniform_real<float>(engine(), 0.f, 1.f));
+  }
+  // bernoulli_ starts at the next Philox counter
+  engine = at::Philox4_32_10(42, 0, (numel + 3) / 4);
+  auto bernoulli_a = bernoulli.accessor<float, 1>();
+  for (int64_t i = 0; i < numel; i++) {
+    ASSERT_EQ(bernoulli_a[i], engine() * (1.0 / 4294967296.0) < 0.3 ? 1.f : 0.f);
+  }
+
+  gen.set_current_seed(42);
+  auto normal1 = at::empty({numel}, kDouble).normal_(0, 1, gen);
+  auto normal2 = at::empty({2, numel}, kDouble).t().normal_(0, 1, gen);
+  gen.set_current_seed(42);
+  ASSERT_TRUE(at::equal(normal1, at::empty({numel}, kDouble).normal_(0, 1, gen)));
+  ASSERT_TRUE(at::equal(normal2, at::empty({2, numel}, kDouble).t().normal_(0, 1, gen)));
+  ASSERT_NEAR(normal1.mean().item<double>(), 0, 0.02);
+  ASSERT_NEAR(normal1.std().item<double>(), 1, 0.02);
+
+  at::globalContext().setUsePhiloxCPURNG(prev);
+}
+
 /**
  * MT19937 CPU Engine Tests
  */
@@ -211,6 +211,69 @@ TEST(TensorIteratorTest, FailNonPromotingBinaryOp) {
   ASSERT_ANY_THROW(config.build());
 }
 
+// Only the builds under test run with the cache enabled, so that the
+// counters are not affected by the ops the test itself calls.
+TEST(TensorIteratorTest, PlanCache) {
+  auto& ctx = at::globalContext();
+  bool prev = ctx.cacheTensorIteratorPlans();
+  ctx.setCacheTensorIteratorPlans(false);
+  auto add = [](float x, float y) -> float { return x + y; };
+
+  // contiguous, channels last, transposed, broadcast and sliced inputs
+  // cover both the fast setup and the permuted and coalesced geometry
+  std::vector<std::pair<Tensor, Tensor>> inputs = {
+    {at::randn({4, 5}), at::randn({4, 5})},
+    {at::randn({2, 3, 4, 5}).contiguous(at::MemoryFormat::ChannelsLast),
+     at::randn({2, 3, 4, 5}).contiguous(at::MemoryFormat::ChannelsLast)},
+    {at::randn({5, 4}).t(), at::randn({4, 5})},
+    {at::randn({3, 1, 5}), at::randn({4, 1})},
+    {at::randn({6, 8}).slice(1, 0, 8, 2), at::randn({6, 1})},
+  };
+  at::clear_tensor_iterator_plan_cache();
+  for (int run = 0; run < 2; run++) {
+    for (const auto& pair : inputs) {
+      Tensor undefined;
+      auto ref_iter = TensorIterator::binary_op(undefined, pair.first, pair.second);
+      at::native::cpu_kernel(ref_iter, add);
+      Tensor ref = ref_iter.output();
+
+      ctx.setCacheTensorIteratorPlans(true);
+      auto iter = TensorIterator::binary_op(undefined, pair.first, pair.second);
+      ctx.setCacheTensorIteratorPlans(false);
+      at::native::cpu_kernel(iter, add);
+      Tensor out = iter.output();
+
+      EXPECT_TRUE(out.equal(ref));
+      EXPECT_EQ(out.strides(), ref.strides());
+      EXPECT_EQ(iter.shape(), ref_iter.shape());
+    }
+  }
+  auto stats = at::tensor_iterator_plan_cache_stats();
+  EXPECT_EQ(stats.misses, static_cast<int64_t>(inputs.size()));
+  EXPECT_EQ(stats.hits, static_cast<int64_t>(inputs.size()));
+
+  // in-place builds are keyed on the output aliasing an input
+  Tensor x = at::randn({3, 4});
+  Tensor y = at::randn({4});
+  Tensor expected = x + y;
+  for (int run = 0; run < 2; run++) {
+    Tensor z = x.clone();
+    ctx.setCacheTensorIteratorPlans(true);
+    auto iter = TensorIterator::binary_op(z, z, y);
+    ctx.setCacheTensorIteratorPlans(false);
+    at::native::cpu_kernel(iter, add);
+    EXPECT_TRUE(z.equal(expected));
+  }
+  stats = at::tensor_iterator_plan_cache_stats();
+  EXPECT_EQ(stats.hits, static_cast<int64_t>(inputs.size()) + 1);
+
+  at::clear_tensor_iterator_plan_cache();
+  stats = at::tensor_iterator_plan_cache_stats();
+  EXPECT_EQ(stats.hits, 0);
+  EXPECT_EQ(stats.misses, 0);
+  ctx.setCacheTensorIteratorPlans(prev);
+}
+
 #define MULTIPLE_OUTPUTS_TEST_ITER_FOR_TYPE(ctype,name)                                             \
 TEST(TensorIteratorTest, CpuKernelMultipleOutputs_##name) {                                         \
   auto in1 = random_tensor_for_type(k##name);                                                       \
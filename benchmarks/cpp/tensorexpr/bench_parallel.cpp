@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+#include <torch/csrc/jit/ir/irparser.h>
+#include <torch/csrc/jit/tensorexpr/kernel.h>
+#include <torch/torch.h>
+
+using namespace torch::jit;
+using namespace torch::jit::tensorexpr;
+
+namespace {
+
+// A fused pointwise + row-wise sum, as produced by the fuser for
+// `(x * y).sum(-1)`.
+static const std::string kMulSumGraph = R"IR(
+    graph(%x : Float(${M}, ${N}, strides=[${N}, 1], device=cpu),
+          %y : Float(${M}, ${N}, strides=[${N}, 1], device=cpu)):
+      %z : Float(${M}, ${N}, strides=[${N}, 1]) = aten::mul(%x, %y)
+      %dims : int[] = prim::Constant[value=[1]]()
+      %keepdim : bool = prim::Constant[value=0]()
+      %dtype : NoneType = prim::Constant()
+      %r : Float(${M}, strides=[1], device=cpu) = aten::sum(%z, %dims, %keepdim, %dtype)
+      return (%r))IR";
+
+static const std::string kMulAddGraph = R"IR(
+    graph(%x : Float(${M}, ${N}, strides=[${N}, 1], device=cpu),
+          %y : Float(${M}, ${N}, strides=[${N}, 1], device=cpu)):
+      %z : Float(${M}, ${N}, strides=[${N}, 1]) = aten::mul(%x, %y)
+      %one : int = prim::Constant[value=1]()
+      %r : Float(${M}, ${N}, strides=[${N}, 1]) = aten::add(%z, %x, %one)
+      return (%r))IR";
+
+std::string formatGraph(const std::string& templ, int64_t M, int64_t N) {
+  std::string result = templ;
+  auto replace_all = [&](const std::string& key, const std::string& value) {
+    size_t pos = 0;
+    while ((pos = result.find(key, pos)) != std::string::npos) {
+      result.replace(pos, key.size(), value);
+      pos += value.size();
+    }
+  };
+  replace_all("${M}", std::to_string(M));
+  replace_all("${N}", std::to_string(N));
+  return result;
+}
+
+class ParallelFusion : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State& state) override {
+    at::set_num_threads(state.range(2));
+    M = state.range(0);
+    N = state.range(1);
+    x = torch::randn({M, N});
+    y = torch::randn({M, N});
+  }
+
+  void TearDown(benchmark::State& state) override {
+    state.counters["GB/s"] = benchmark::Counter(
+        uint64_t(state.iterations()) * 2 * M * N * sizeof(float),
+        benchmark::Counter::kIsRate);
+  }
+
+  void runKernel(
+      benchmark::State& state,
+      const std::string& graph_template,
+      bool parallel) {
+    bool old_parallel = getTEParallelizeOnCPU();
+    getTEParallelizeOnCPU() = parallel;
+    KernelScope kernel_scope;
+    auto graph = std::make_shared<Graph>();
+    parseIR(formatGraph(graph_template, M, N), &*graph);
+    TensorExprKernel k(graph);
+    getTEParallelizeOnCPU() = old_parallel;
+
+    std::vector<IValue> stack;
+    for (auto _ : state) {
+      stack = {x, y};
+      k.run(stack);
+    }
+  }
+
+  int64_t M;
+  int64_t N;
+  at::Tensor x;
+  at::Tensor y;
+};
+
+} // namespace
+
+BENCHMARK_DEFINE_F(ParallelFusion, MulSumEager)(benchmark::State& state) {
+  for (auto _ : state) {
+    auto r = (x * y).sum({1});
+  }
+}
+
+BENCHMARK_DEFINE_F(ParallelFusion, MulSumTESerial)(benchmark::State& state) {
+  runKernel(state, kMulSumGraph, /*parallel=*/false);
+}
+
+BENCHMARK_DEFINE_F(ParallelFusion, MulSumTEParallel)(benchmark::State& state) {
+  runKernel(state, kMulSumGraph, /*parallel=*/true);
+}
+
+BENCHMARK_DEFINE_F(ParallelFusion, MulAddEager)(benchmark::State& state) {
+  for (auto _ : state) {
+    auto r = x * y + x;
+  }
+}
+
+BENCHMARK_DEFINE_F(ParallelFusion, MulAddTESerial)(benchmark::State& state) {
+  runKernel(state, kMulAddGraph, /*parallel=*/false);
+}
+
+BENCHMARK_DEFINE_F(ParallelFusion, MulAddTEParallel)(benchmark::State& state) {
+  runKernel(state, kMulAddGraph, /*parallel=*/true);
+}
+
+static void ParallelFusionArgs(benchmark::internal::Benchmark* b) {
+  for (int threads : {1, 4, 16}) {
+    for (auto const& shape : std::vector<std::pair<int, int>>{
+             {64, 1024}, {1024, 1024}, {8192, 512}, {32, 1 << 16}}) {
+      b->Args({shape.first, shape.second, threads});
+    }
+  }
+  b->ArgNames({"M", "N", "threads"});
+}
+
+BENCHMARK_REGISTER_F(ParallelFusion, MulSumEager)->Apply(ParallelFusionArgs);
+BENCHMARK_REGISTER_F(ParallelFusion, MulSumTESerial)->Apply(ParallelFusionArgs);
+BENCHMARK_REGISTER_F(ParallelFusion, MulSumTEParallel)
+    ->Apply(ParallelFusionArgs);
+BENCHMARK_REGISTER_F(ParallelFusion, MulAddEager)->Apply(ParallelFusionArgs);
+BENCHMARK_REGISTER_F(ParallelFusion, MulAddTESerial)->Apply(ParallelFusionArgs);
+BENCHMARK_REGISTER_F(ParallelFusion, MulAddTEParallel)
+    ->Apply(ParallelFusionArgs);
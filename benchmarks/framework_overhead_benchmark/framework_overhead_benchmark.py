@@ -1,5 +1,6 @@
 from utils import ms_to_us, benchmark_module, BenchmarkConfig, ModuleConfig
 import argparse
+import torch
 from C2Module import C2SimpleNet
 
 from SimpleAddModule import SimpleAddModule, add_tensors_loop
@@ -21,6 +22,9 @@ buck run @mode/opt <path-to-framework_overhead_benchmark>:framework_overhead_ben
 To run C2 benchmark:
 buck run @mode/opt <path-to-framework_overhead_benchmark>:framework_overhead_benchmark --
  --add_op --benchmark_c2_net
+To compare eager mode with and without the TensorIterator plan cache:
+buck run @mode/opt <path-to-framework_overhead_benchmark>:framework_overhead_benchmark --
+ --add_op --eager_mode --cache_tensor_iterator_plans
 """
 
 SUPPORTED_OPS = {"add_op"}
@@ -61,6 +65,28 @@ def benchmark_simple_fn(args, config, module_config, module_type, result):
         latency_per_iter_ms = benchmark_module(config, module, args.use_throughput_benchmark)
         result[result_key] = latency_per_iter_ms
 
+def benchmark_tensor_iterator_plan_cache(args, config, module_config, module_type, result):
+    """ Runs benchmark_simple_fn with the TensorIterator plan cache disabled and then
+    enabled, and reports the per-op difference and the hit rate of the cache.
+    """
+    prev = torch._C._get_cache_tensor_iterator_plans()
+    try:
+        for enabled in (False, True):
+            torch._C._set_cache_tensor_iterator_plans(enabled)
+            torch._C._clear_tensor_iterator_plan_cache()
+            run_result = {}
+            benchmark_simple_fn(args, config, module_config, module_type, run_result)
+            for key, value in run_result.items():
+                result[key + ",TensorIterator plan cache:" + str(enabled)] = value
+        hits, misses = torch._C._tensor_iterator_plan_cache_stats()
+    finally:
+        torch._C._set_cache_tensor_iterator_plans(prev)
+    latencies = list(result.values())
+    print("TensorIterator plan cache: {} hits, {} misses, hit rate {:.4f}".format(
+        hits, misses, hits / max(hits + misses, 1)))
+    print("TensorIterator plan cache saves {:.3f} us per op".format(
+        ms_to_us(latencies[-2] - latencies[-1])))
+
 def main():
     parser = argparse.ArgumentParser()
     parser.add_argument("--op", default="add_op", dest="op", type=str)
@@ -69,6 +95,8 @@ def main():
     parser.add_argument("--debug", default=False, dest="debug", action="store_true")
     parser.add_argument("--save", default=False, dest="save", action="store_true")
     parser.add_argument("--eager_mode", default=False, dest="eager_mode", action="store_true")
+    parser.add_argument("--cache_tensor_iterator_plans", default=False, dest="cache_tensor_iterator_plans",
+                        action="store_true")
     parser.add_argument("--num_warmup_iters", type=int, default=100)
     parser.add_argument("--num_iters", type=int, default=1000)
     args = parser.parse_args()
@@ -92,7 +120,10 @@ def main():
             module_config = ModuleConfig(None, 'Sum', num_params, None)
         else:
             module_config = ModuleConfig(add_tensors_loop, None, num_params, graph_mode)
-        benchmark_simple_fn(args, config, module_config, SimpleAddModule, result)
+        if args.cache_tensor_iterator_plans and not args.benchmark_c2_net:
+            benchmark_tensor_iterator_plan_cache(args, config, module_config, SimpleAddModule, result)
+        else:
+            benchmark_simple_fn(args, config, module_config, SimpleAddModule, result)
     print_results(result)
 
 if __name__ == "__main__":
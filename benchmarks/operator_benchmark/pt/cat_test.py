@@ -86,6 +86,23 @@ cat_configs_manyinputs = op_bench.config_list(
     tags=['manyinputs'],
 )
 
+# Feature assembly: hundreds of narrow per-feature tensors concatenated along
+# the feature dim, some of them in a different dtype than the others
+cat_configs_feature_assembly = op_bench.config_list(
+    attr_names=['sizes', 'N', 'dim'],
+    attrs=[
+        [[1,    lambda: random.randint(1, 16)], 300, 1], # noqa
+        [[64,   lambda: random.randint(1, 16)], 300, 1], # noqa
+        [[512,  lambda: random.randint(1, 16)], 300, 1], # noqa
+        [[512,  lambda: random.randint(1, 16)], 1000, 1], # noqa
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+    },
+    tags=['feature_assembly'],
+)
+
+
 class CatBenchmark(op_bench.TorchBenchmarkBase):
     def init(self, sizes, N, dim, device):
         random.seed(42)
@@ -118,5 +135,28 @@ op_bench.generate_pt_test(cat_configs_short +
                           cat_configs_static_runtime,
                           CatBenchmark)
 
+
+class CatMixedDtypeBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, sizes, N, dim, device):
+        random.seed(42)
+        inputs = []
+        for i in range(N):
+            size = [old_size() if callable(old_size) else old_size for old_size in sizes]
+            # one input in four is an integer feature, cast while copying
+            dtype = torch.int64 if i % 4 == 0 else torch.float
+            inputs.append(torch.rand(size, device=device).to(dtype))
+        self.inputs = {
+            "inputs": inputs,
+            "dim": dim
+        }
+        self.set_module_name('cat_mixed_dtype')
+
+    def forward(self, inputs: List[torch.Tensor], dim: int):
+        return torch.cat(inputs, dim=dim)
+
+
+op_bench.generate_pt_test(cat_configs_feature_assembly, CatBenchmark)
+op_bench.generate_pt_test(cat_configs_feature_assembly, CatMixedDtypeBenchmark)
+
 if __name__ == "__main__":
     op_bench.benchmark_runner.main()
@@ -76,6 +76,58 @@ op_bench.generate_pt_test(configs.conv_2d_configs_short + configs.conv_2d_config
                           ConvTranspose2dBenchmark)
 
 
+"""
+Microbenchmarks for inference Conv2d on CPU: the direct channels last kernel
+against the im2col based slow path and MKLDNN, on ResNet-50 and MobileNetV2
+layers.
+"""
+
+conv_2d_configs_channels_last = op_bench.config_list(
+    attr_names=[
+        'IC', 'OC', 'kernel', 'stride', 'N', 'H', 'W', 'G', 'pad',
+    ],
+    attrs=[
+        # ResNet-50
+        [64, 64, 1, 1, 1, 56, 56, 1, 0],
+        [64, 64, 3, 1, 1, 56, 56, 1, 1],
+        [128, 128, 3, 2, 1, 56, 56, 1, 1],
+        [256, 256, 3, 1, 1, 14, 14, 1, 1],
+        [512, 2048, 1, 1, 1, 7, 7, 1, 0],
+        # MobileNetV2
+        [32, 32, 3, 1, 1, 112, 112, 32, 1],
+        [144, 144, 3, 2, 1, 56, 56, 144, 1],
+        [144, 24, 1, 1, 1, 56, 56, 1, 0],
+        [960, 960, 3, 1, 1, 7, 7, 960, 1],
+    ],
+    cross_product_configs={
+        'device': ['cpu'],
+        'impl': ['direct', 'slow', 'mkldnn'],
+    },
+    tags=['channels_last']
+)
+
+
+class Conv2dChannelsLastBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, IC, OC, kernel, stride, N, H, W, G, pad, device, impl):
+        input = torch.rand(N, IC, H, W, device=device)
+        if impl == 'direct':
+            input = input.contiguous(memory_format=torch.channels_last)
+        self.inputs = {
+            "input": input
+        }
+        self.conv2d = nn.Conv2d(
+            IC, OC, kernel, stride=stride, groups=G, padding=pad).to(device=device)
+        self.mkldnn_enabled = impl == 'mkldnn'
+        self.set_module_name('Conv2dChannelsLast')
+
+    def forward(self, input):
+        with torch.no_grad(), torch.backends.mkldnn.flags(enabled=self.mkldnn_enabled):
+            return self.conv2d(input)
+
+
+op_bench.generate_pt_test(conv_2d_configs_channels_last, Conv2dChannelsLastBenchmark)
+
+
 """
 Microbenchmarks for Conv3d and ConvTranspose3d operators.
 """
@@ -15,12 +15,24 @@ groupnorm_configs_short = op_bench.cross_product_configs(
     tags=["short"],
 )
 
+groupnorm_configs_channels_last = op_bench.cross_product_configs(
+    dims=(
+        (32, 64, 56, 56),
+    ),
+    num_groups=(8, 32),
+    channels_last=(True, False),
+    tags=["long"],
+)
+
 
 class GroupNormBenchmark(op_bench.TorchBenchmarkBase):
-    def init(self, dims, num_groups):
+    def init(self, dims, num_groups, channels_last=False):
         num_channels = dims[1]
+        input = (torch.rand(*dims) - 0.5) * 256
+        if channels_last:
+            input = input.contiguous(memory_format=torch.channels_last)
         self.inputs = {
-            "input": (torch.rand(*dims) - 0.5) * 256,
+            "input": input,
             "num_groups": num_groups,
             "weight": torch.rand(num_channels, dtype=torch.float),
             "bias": torch.rand(num_channels, dtype=torch.float),
@@ -32,7 +44,7 @@ class GroupNormBenchmark(op_bench.TorchBenchmarkBase):
             input, num_groups, weight=weight, bias=bias, eps=eps)
 
 
-op_bench.generate_pt_test(groupnorm_configs_short, GroupNormBenchmark)
+op_bench.generate_pt_test(groupnorm_configs_short + groupnorm_configs_channels_last, GroupNormBenchmark)
 
 
 if __name__ == "__main__":
@@ -35,5 +35,42 @@ class LayerNormBenchmark(op_bench.TorchBenchmarkBase):
 op_bench.generate_pt_test(layernorm_configs_short, LayerNormBenchmark)
 
 
+# Residual add + layer_norm (+ activation) of transformer encoders, at the
+# hidden sizes of BERT base and large. 'fused' is the op emitted by
+# torch.jit.freeze, 'unfused' the separate add, layer_norm and activation.
+add_layernorm_configs_long = op_bench.cross_product_configs(
+    M=[128, 512, 4096],
+    N=[768, 1024],
+    activation=["none", "gelu"],
+    impl=["fused", "unfused"],
+    tags=["long"],
+)
+
+
+class AddLayerNormBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, M, N, activation, impl):
+        self.inputs = {
+            "input": torch.randn(M, N),
+            "residual": torch.randn(M, N),
+            "weight": torch.rand(N),
+            "bias": torch.rand(N),
+        }
+        self.activation = activation
+        self.fused = impl == "fused"
+        self.set_module_name("add_layer_norm")
+
+    def forward(self, input, residual, weight, bias):
+        if self.fused:
+            return torch._add_layer_norm(
+                input, residual, [input.size(-1)], weight, bias, 1e-5, self.activation)
+        out = F.layer_norm(input + residual, [input.size(-1)], weight=weight, bias=bias, eps=1e-5)
+        if self.activation == "gelu":
+            out = F.gelu(out)
+        return out
+
+
+op_bench.generate_pt_test(add_layernorm_configs_long, AddLayerNormBenchmark)
+
+
 if __name__ == "__main__":
     op_bench.benchmark_runner.main()
@@ -2,6 +2,8 @@
 import operator_benchmark as op_bench
 import torch
 import torch.nn as nn
+import torch.nn.functional as F
+from typing import List
 
 from pt import configs
 
@@ -25,5 +27,41 @@ op_bench.generate_pt_test(configs.linear_configs_short + configs.linear_configs_
                           LinearBenchmark)
 
 
+# Independent same-shape linears on different weights, as in the heads of a
+# multi-head model. 'batched' is what torch.jit.freeze emits for them
+# (prim::BatchedLinear: stack the inputs, one baddbmm, split), 'separate' one
+# linear per head.
+multi_linear_configs_long = op_bench.cross_product_configs(
+    heads=[8, 32],
+    N=[1, 16, 128],
+    IN=[64, 256],
+    OUT=[64, 256],
+    impl=["batched", "separate"],
+    tags=["long"],
+)
+
+
+class MultiLinearBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, heads, N, IN, OUT, impl):
+        self.inputs = {
+            "inputs": [torch.rand(N, IN) for _ in range(heads)],
+        }
+        self.weights = [torch.rand(OUT, IN) for _ in range(heads)]
+        self.biases = [torch.rand(OUT) for _ in range(heads)]
+        self.stacked_weight = torch.stack([w.t() for w in self.weights])
+        self.stacked_bias = torch.stack(self.biases).unsqueeze(1)
+        self.batched = impl == "batched"
+        self.set_module_name("multi_linear")
+
+    def forward(self, inputs: List[torch.Tensor]):
+        if self.batched:
+            out = torch.baddbmm(self.stacked_bias, torch.stack(inputs), self.stacked_weight)
+            return out.unbind(0)
+        return [F.linear(x, w, b) for x, w, b in zip(inputs, self.weights, self.biases)]
+
+
+op_bench.generate_pt_test(multi_linear_configs_long, MultiLinearBenchmark)
+
+
 if __name__ == "__main__":
     op_bench.benchmark_runner.main()
@@ -85,6 +85,18 @@ pool_2d_configs_long = op_bench.cross_product_configs(
     tags=['long']
 )
 
+pool_2d_configs_channels_last = op_bench.cross_product_configs(
+    kernel=[[3, 3]],
+    stride=[[1, 1], [2, 2]],
+    N=[8],
+    C=[64, 256],
+    H=[56],
+    W=[56],
+    device=['cpu'],
+    channels_last=[True, False],
+    tags=['long']
+)
+
 pool_2d_ops_list = op_bench.op_list(
     attr_names=['op_name', 'op_func'],
     attrs=[
@@ -97,9 +109,12 @@ pool_2d_ops_list = op_bench.op_list(
 
 
 class Pool2dBenchmark(op_bench.TorchBenchmarkBase):
-    def init(self, kernel, stride, N, C, H, W, device, op_func):
+    def init(self, kernel, stride, N, C, H, W, device, op_func, channels_last=False):
+        input = torch.rand(N, C, H, W, device=device)
+        if channels_last:
+            input = input.contiguous(memory_format=torch.channels_last)
         self.inputs = {
-            "input": torch.rand(N, C, H, W, device=device)
+            "input": input
         }
         self.op_func = op_func(kernel, stride=stride)
 
@@ -111,6 +126,9 @@ class Pool2dBenchmark(op_bench.TorchBenchmarkBase):
 op_bench.generate_pt_tests_from_op_list(pool_2d_ops_list,
                                         pool_2d_configs_short + pool_2d_configs_long,
                                         Pool2dBenchmark)
+op_bench.generate_pt_tests_from_op_list(pool_2d_ops_list[:2],
+                                        pool_2d_configs_channels_last,
+                                        Pool2dBenchmark)
 
 
 """
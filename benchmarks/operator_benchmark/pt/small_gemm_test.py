@@ -0,0 +1,79 @@
+import operator_benchmark as op_bench
+import torch
+
+"""Microbenchmarks for mm and bmm on small CPU operands.
+
+These time the shapes on either side of the kSmallGemm* bounds in
+aten/src/ATen/native/LinearAlgebra.cpp. The register-blocked small GEMM
+kernel only takes a mat2 with unit column stride, so with trans_b the same
+shapes go through the paths it replaces: BLAS for mm, and the naive loops
+(or MKL batch gemm) for bmm. Compare them single threaded:
+
+$ python -m pt.small_gemm_test --omp_num_threads 1 --mkl_num_threads 1
+"""
+
+# Cubes with m * n * k on both sides of each bound:
+# 64 | 125 (kSmallGemmMinMNK = 100), 1728 | 2197 (kSmallGemmMaxMNKForMM = 2048),
+# 4096 | 4913 (kSmallGemmMaxMNKForBmmWithMKL = 4096),
+# 64000 | 68921 (kSmallGemmMaxMNKForBmm = 65536)
+small_gemm_long_configs = op_bench.cross_product_configs(
+    S=[4, 5, 8, 12, 13, 16, 17, 32, 40, 41],
+    trans_b=[False, True],
+    dtype=[torch.float, torch.double],
+    device=['cpu'],
+    tags=["long"]
+)
+
+
+small_gemm_short_configs = op_bench.config_list(
+    attr_names=["S", "trans_b"],
+    attrs=[
+        [8, False],
+        [8, True],
+        [32, False],
+        [32, True],
+    ],
+    cross_product_configs={
+        'dtype': [torch.float],
+        'device': ['cpu'],
+    },
+    tags=["short"],
+)
+
+
+def _mat2(batch, S, trans_b, dtype, device):
+    if trans_b:
+        return torch.rand(batch + [S, S], dtype=dtype, device=device).transpose(-1, -2)
+    return torch.rand(batch + [S, S], dtype=dtype, device=device)
+
+
+class SmallMMBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, S, trans_b, dtype, device):
+        self.inputs = {
+            "mat1": torch.rand(S, S, dtype=dtype, device=device),
+            "mat2": _mat2([], S, trans_b, dtype, device),
+        }
+        self.set_module_name("small_mm")
+
+    def forward(self, mat1, mat2):
+        return torch.mm(mat1, mat2)
+
+
+class SmallBmmBenchmark(op_bench.TorchBenchmarkBase):
+    def init(self, S, trans_b, dtype, device):
+        self.inputs = {
+            "batch1": torch.rand(64, S, S, dtype=dtype, device=device),
+            "batch2": _mat2([64], S, trans_b, dtype, device),
+        }
+        self.set_module_name("small_bmm")
+
+    def forward(self, batch1, batch2):
+        return torch.bmm(batch1, batch2)
+
+
+op_bench.generate_pt_test(small_gemm_long_configs + small_gemm_short_configs, SmallMMBenchmark)
+op_bench.generate_pt_test(small_gemm_long_configs + small_gemm_short_configs, SmallBmmBenchmark)
+
+
+if __name__ == "__main__":
+    op_bench.benchmark_runner.main()
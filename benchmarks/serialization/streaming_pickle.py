@@ -0,0 +1,111 @@
+"""Time and peak memory of torch.jit.save / torch.jit.load on pickle heavy models.
+
+Each size is saved twice: with the default buffered pickles, and with
+data.pkl / constants.pkl streamed through PyTorchStreamWriter
+(torch._C._jit_set_export_stream_pickles(True)). Both archives are then
+loaded, which always reads the pickles incrementally. With streaming, the
+extra peak RSS of save should stay roughly flat as the pickle grows instead
+of scaling with its size.
+
+Each measurement runs in a fresh process. The model is built and scripted
+first, then the peak RSS of the process (VmHWM) is reset through
+/proc/self/clear_refs, so the reported memory is the peak RSS during the
+save/load call minus the RSS right before it. This needs Linux 4.0 or later.
+
+    python streaming_pickle.py --num_entries 100000 1000000
+"""
+import argparse
+import multiprocessing as mp
+import os
+import tempfile
+import time
+from typing import Dict, List
+
+import torch
+
+
+class PickleHeavy(torch.nn.Module):
+    def __init__(self, num_entries: int):
+        super().__init__()
+        # Large non-tensor attributes end up entirely in data.pkl.
+        self.names: List[str] = ["entry_{}".format(i) for i in range(num_entries)]
+        self.ids: Dict[str, int] = {name: i for i, name in enumerate(self.names)}
+        self.weight = torch.nn.Parameter(torch.ones(16, 16))
+
+    def forward(self, x: torch.Tensor) -> torch.Tensor:
+        return x @ self.weight + len(self.names)
+
+
+def _status_kb(field):
+    with open("/proc/self/status") as f:
+        for line in f:
+            if line.startswith(field + ":"):
+                return int(line.split()[1])
+    raise RuntimeError("{} is not in /proc/self/status".format(field))
+
+
+def _reset_peak_rss():
+    # Resets VmHWM to the current RSS.
+    with open("/proc/self/clear_refs", "w") as f:
+        f.write("5")
+
+
+def _measure(fn):
+    _reset_peak_rss()
+    before = _status_kb("VmRSS")
+    start = time.perf_counter()
+    result = fn()
+    elapsed = time.perf_counter() - start
+    return elapsed, _status_kb("VmHWM") - before, result
+
+
+def _save(num_entries, path, stream, queue):
+    m = torch.jit.script(PickleHeavy(num_entries))
+    torch._C._jit_set_export_stream_pickles(stream)
+    elapsed, peak_kb, _ = _measure(lambda: torch.jit.save(m, path))
+    queue.put((elapsed, peak_kb))
+
+
+def _load(path, queue):
+    elapsed, peak_kb, m = _measure(lambda: torch.jit.load(path))
+    queue.put((elapsed, peak_kb))
+    del m
+
+
+def _run_in_subprocess(target, args):
+    ctx = mp.get_context("spawn")
+    queue = ctx.Queue()
+    p = ctx.Process(target=target, args=args + (queue,))
+    p.start()
+    result = queue.get()
+    p.join()
+    return result
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--num_entries", type=int, nargs="+",
+                        default=[10000, 100000, 1000000])
+    parser.add_argument("--repeat", type=int, default=3)
+    args = parser.parse_args()
+
+    print("{:>12} {:>10} {:>12} {:>12} {:>14} {:>12} {:>14}".format(
+        "entries", "streamed", "file (MB)", "save (ms)", "save peak (MB)",
+        "load (ms)", "load peak (MB)"))
+    with tempfile.TemporaryDirectory() as tmp:
+        for n in args.num_entries:
+            for stream in (False, True):
+                path = os.path.join(tmp, "model_{}_{}.pt".format(n, int(stream)))
+                saves = [_run_in_subprocess(_save, (n, path, stream))
+                         for _ in range(args.repeat)]
+                loads = [_run_in_subprocess(_load, (path,)) for _ in range(args.repeat)]
+                save_t, save_m = (min(r) for r in zip(*saves))
+                load_t, load_m = (min(r) for r in zip(*loads))
+                print("{:>12} {:>10} {:>12.1f} {:>12.1f} {:>14.1f} {:>12.1f} {:>14.1f}".format(
+                    n, "yes" if stream else "no", os.path.getsize(path) / 2**20,
+                    save_t * 1e3, save_m / 1024, load_t * 1e3, load_m / 1024))
+
+
+if __name__ == "__main__":
+    main()
@@ -128,3 +128,26 @@ torch::jit::Module getLongScriptModel() {
   module.define(long_model);
   return module;
 }
+
+// num_towers independent towers of two linear layers, concatenated at the end
+torch::jit::Module getWideTowersScriptModel(int num_towers, int tower_size) {
+  std::string towers;
+  std::string outputs;
+  for (int i = 0; i < num_towers; ++i) {
+    const auto t = "t" + c10::to_string(i);
+    const auto w = "w[" + c10::to_string(i) + "]";
+    towers += "      " + t + " = torch.relu(torch.mm(x, " + w + "))\n";
+    towers += "      " + t + " = torch.relu(torch.mm(" + t + ", " + w + "))\n";
+    outputs += (i == 0 ? "" : ", ") + t;
+  }
+  const std::string wide_towers_model = R"JIT(
+  def forward(self, x):
+      w = self.w
+)JIT" + towers + "      return torch.cat([" + outputs + "], 1)\n";
+
+  torch::jit::Module module("wide_towers");
+  module.register_parameter(
+      "w", torch::randn({num_towers, tower_size, tower_size}), false);
+  module.define(wide_towers_model);
+  return module;
+}
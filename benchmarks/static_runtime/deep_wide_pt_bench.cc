@@ -161,6 +161,23 @@ static void BM_long_static_memory_optimization(benchmark::State& state) {
   }
 }
 
+static void BM_wide_towers_static(benchmark::State& state) {
+  const int num_towers = state.range(0);
+  const int tower_size = 128;
+  auto mod = getWideTowersScriptModel(num_towers, tower_size);
+  torch::jit::StaticModuleOptions opts;
+  opts.enable_inter_op_parallelism = state.range(1);
+  torch::jit::StaticModule smod(mod, opts);
+
+  auto x = torch::randn({1, tower_size});
+  std::vector<at::Tensor> inputs({x});
+
+  smod(inputs);
+  for (auto _ : state) {
+    smod(inputs);
+  }
+}
+
 BENCHMARK(BM_deep_wide_base)->RangeMultiplier(8)->Ranges({{1, 20}});
 BENCHMARK(BM_deep_wide_fast)->RangeMultiplier(8)->Ranges({{1, 20}});
 
@@ -185,6 +202,12 @@ BENCHMARK(BM_long_static_memory_optimization)
   ->Args({2<<4, 1})
   ->Args({2<<8, 1});
 
+BENCHMARK(BM_wide_towers_static)
+  ->Args({8, 0})
+  ->Args({8, 1})
+  ->Args({32, 0})
+  ->Args({32, 1});
+
 int main(int argc, char** argv)
 {
   c10::ParseCommandLineFlags(&argc, &argv);
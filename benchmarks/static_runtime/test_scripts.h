@@ -157,6 +157,11 @@ const auto to_script_1 = R"JIT(
       return torch.to(input, dtype, non_blocking, copy)
 )JIT";
 
+const auto cat_script = R"JIT(
+  def forward(self, a: Tensor, b: Tensor, c: Tensor, dim: int):
+      return torch.cat([a, b, c], dim)
+)JIT";
+
 const std::string embedding_bag_default = R"JIT(
   def forward(self, a: Tensor, b: Tensor, c: Tensor):
       return torch.embedding_bag(a, b, c)
@@ -186,3 +191,33 @@ const std::string embedding_bag_max_last_offset = R"JIT(
   def forward(self, a: Tensor, b: Tensor, c: Tensor):
       return torch.embedding_bag(a, b, c, False, 2, False, None, True)
 )JIT";
+
+const auto if_script = R"JIT(
+  def forward(self, a: Tensor, b: Tensor, flag: bool):
+      c = a + b
+      if flag:
+          d = torch.relu(c * a)
+          e = d + 1
+      else:
+          d = c - b
+          e = torch.mul(d, 2)
+      return e + c
+)JIT";
+
+const auto loop_script = R"JIT(
+  def forward(self, a: Tensor, b: Tensor, n: int):
+      c = a + b
+      for i in range(n):
+          c = torch.relu(c * b + a)
+          if i % 2 == 0:
+              c = c - a
+      return c
+)JIT";
+
+const auto while_script = R"JIT(
+  def forward(self, a: Tensor, limit: float):
+      b = a.clone()
+      while bool(b.sum() < limit):
+          b = b * 2 + 1
+      return b
+)JIT";
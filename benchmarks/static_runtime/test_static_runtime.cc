@@ -198,6 +198,98 @@ TEST(StaticRuntime, IndividualOps_to) {
   test_to(at::ScalarType::Half, false, true, c10::MemoryFormat::Preserve);
 }
 
+TEST(StaticRuntime, IndividualOps_cat) {
+  // small inputs, a negative dim and an input that is empty along dim
+  auto a = at::randn({4, 3});
+  auto b = at::randn({4, 1});
+  auto c = at::randn({4, 0});
+  std::vector<IValue> args0{a, b, c, -1};
+  testStaticRuntime(cat_script, args0);
+
+  // inputs of different dtypes are cast to the promoted dtype of the output
+  auto d = at::randint(10, {4, 5}, at::kLong);
+  auto e = at::randn({4, 2}, at::kDouble);
+  std::vector<IValue> args1{a, d, e, 1};
+  testStaticRuntime(cat_script, args1);
+
+  // large enough to be split across threads
+  auto f = at::randn({256, 64, 8});
+  auto g = at::randn({256, 13, 8});
+  auto h = at::randn({256, 51, 8});
+  std::vector<IValue> args2{f, g, h, 1};
+  testStaticRuntime(cat_script, args2);
+}
+
+TEST(StaticRuntime, ControlFlow) {
+  // every script runs several times on the same runtime, so that the blocks
+  // are also run with their memory planners
+  auto test = [](const std::string& jit_script,
+                 const std::vector<std::vector<IValue>>& args_list) {
+    script::Module module("module");
+    module.define(jit_script);
+    torch::jit::StaticModule smodule(module);
+    for (int i = 0; i < 2; ++i) {
+      for (const auto& args : args_list) {
+        auto expect = module.forward(args).toTensor();
+        auto actual = smodule(args, {}).toTensor();
+        smodule.runtime().check_for_memory_leak();
+        EXPECT_TRUE(expect.equal(actual));
+      }
+    }
+  };
+
+  auto a = at::randn({2, 3});
+  auto b = at::randn({2, 3});
+  test(if_script, {{a, b, true}, {a, b, false}});
+  test(loop_script, {{a, b, 0}, {a, b, 1}, {a, b, 4}});
+  test(while_script, {{a, 0.0}, {a, 100.0}});
+}
+
+TEST(StaticRuntime, InterOpParallelism) {
+  torch::jit::StaticModuleOptions opts;
+  opts.enable_inter_op_parallelism = true;
+
+  // towers run concurrently, and their intermediates can only share memory
+  // within a tower
+  auto towers = getWideTowersScriptModel(8, 16);
+  torch::jit::StaticModule smod_towers(towers, opts);
+  for (int i = 0; i < 3; ++i) {
+    auto x = torch::randn({2, 16});
+    auto expect = towers.forward({x}).toTensor();
+    std::vector<at::Tensor> input_tensors({x});
+    auto actual = smod_towers(input_tensors)[0];
+    smod_towers.runtime().check_for_memory_leak();
+    EXPECT_TRUE(expect.equal(actual));
+  }
+
+  torch::jit::Module deep_wide = getDeepAndWideSciptModel();
+  torch::jit::StaticModule smod_deep_wide(deep_wide, opts);
+  for (int batch_size : {1, 8, 32}) {
+    auto ad_emb_packed = torch::randn({batch_size, 1, 32});
+    auto user_emb = torch::randn({batch_size, 1, 32});
+    auto wide = torch::randn({batch_size, 50});
+    auto expect = getTensor(deep_wide.forward({ad_emb_packed, user_emb, wide}));
+    std::vector<at::Tensor> input_tensors({ad_emb_packed, user_emb, wide});
+    auto actual = smod_deep_wide(input_tensors)[0];
+    smod_deep_wide.runtime().check_for_memory_leak();
+    EXPECT_TRUE(torch::allclose(expect, actual, 1e-6));
+  }
+
+  // control flow nodes run as a whole on one thread
+  script::Module module("module");
+  module.define(if_script);
+  torch::jit::StaticModule smod_if(module, opts);
+  auto a = at::randn({2, 3});
+  auto b = at::randn({2, 3});
+  for (bool flag : {true, false, true}) {
+    std::vector<IValue> args{a, b, flag};
+    auto expect = module.forward(args).toTensor();
+    auto actual = smod_if(args, {}).toTensor();
+    smod_if.runtime().check_for_memory_leak();
+    EXPECT_TRUE(expect.equal(actual));
+  }
+}
+
 TEST(StaticRuntime, LongModel) {
   torch::jit::Module mod = getLongScriptModel();
   auto a = torch::randn({2, 2});
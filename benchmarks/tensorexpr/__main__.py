@@ -129,6 +129,18 @@ Works only with Python3.\n A few examples:
         action='store_true',
         help="Enable CAT wo conditionals.",
     )
+    parser.add_argument(
+        "--cpu_parallel",
+        default=False,
+        action='store_true',
+        help="Dispatch the outer loops of CPU kernels onto the intra-op thread pool (off by default).",
+    )
+    parser.add_argument(
+        "--cpu_parallel_threshold",
+        type=int,
+        default=None,
+        help="Minimum number of loop iterations for a CPU kernel to run in parallel",
+    )
 
     args = parser.parse_args()
 
@@ -166,6 +178,10 @@ Works only with Python3.\n A few examples:
         import torch
         torch._C._jit_cat_wo_conditionals(False)
 
+    torch._C._jit_set_te_parallelize_cpu(args.cpu_parallel)
+    if args.cpu_parallel_threshold is not None:
+        torch._C._jit_set_te_cpu_parallel_threshold(args.cpu_parallel_threshold)
+
     def set_global_threads(num_threads):
         os.environ["OMP_NUM_THREADS"] = str(num_threads)
         os.environ["MKL_NUM_THREADS"] = str(num_threads)
@@ -32,12 +32,31 @@ C10_DEFINE_int(
     num_read_threads,
     1,
     "The number of concurrent reading threads.");
+C10_DEFINE_int(
+    prefetch_depth,
+    0,
+    "If positive, the reader reads this many records ahead in a background "
+    "thread. Only used with --use_reader.");
+C10_DEFINE_int(num_shards, 1, "The number of shards, with --use_reader.");
+C10_DEFINE_int(shard_id, 0, "The shard to read, with --use_reader.");
+C10_DEFINE_bool(
+    deserialize,
+    false,
+    "If true, parse every value as TensorProtos, the way "
+    "TensorProtosDBInput does.");
 
 using caffe2::db::Cursor;
 using caffe2::db::DB;
 using caffe2::db::DBReader;
 using caffe2::string;
 
+void MaybeDeserialize(const string& value) {
+  if (FLAGS_deserialize) {
+    caffe2::TensorProtos protos;
+    CAFFE_ENFORCE(protos.ParseFromString(value));
+  }
+}
+
 void TestThroughputWithDB() {
   std::unique_ptr<DB> in_db(caffe2::db::CreateDB(
       FLAGS_input_db_type, FLAGS_input_db, caffe2::db::READ));
@@ -47,6 +66,7 @@ void TestThroughputWithDB() {
     for (int i = 0; i < FLAGS_report_interval; ++i) {
       string key = cursor->key();
       string value = cursor->value();
+      MaybeDeserialize(value);
       //VLOG(1) << "Key " << key;
       cursor->Next();
       if (!cursor->Valid()) {
@@ -68,6 +88,7 @@ void TestThroughputWithReaderWorker(const DBReader* reader, int thread_id) {
     caffe2::Timer timer;
     for (int i = 0; i < FLAGS_report_interval; ++i) {
       reader->Read(&key, &value);
+      MaybeDeserialize(value);
     }
     double elapsed_seconds = timer.Seconds();
     printf(
@@ -81,7 +102,9 @@ void TestThroughputWithReaderWorker(const DBReader* reader, int thread_id) {
 }
 
 void TestThroughputWithReader() {
-  caffe2::db::DBReader reader(FLAGS_input_db_type, FLAGS_input_db);
+  caffe2::db::DBReader reader(
+      FLAGS_input_db_type, FLAGS_input_db, FLAGS_num_shards, FLAGS_shard_id);
+  reader.SetPrefetchDepth(FLAGS_prefetch_depth);
   std::vector<std::unique_ptr<std::thread>> reading_threads(
       FLAGS_num_read_threads);
   for (int i = 0; i < reading_threads.size(); ++i) {
@@ -6,14 +6,28 @@
 #include <torch/csrc/jit/serialization/import.h>
 #include "torch/script.h"
 
+#include <chrono>
+#include <limits>
+
 C10_DEFINE_string(model, "", "The given bytecode model to check if it is supported by lite_interpreter.");
+C10_DEFINE_bool(
+    lazy,
+    false,
+    "Look up the operators of a method on its first call instead of at load time.");
+C10_DEFINE_bool(
+    parallel,
+    false,
+    "Look up the operators of all the methods on the intra-op thread pool.");
+C10_DEFINE_int(warmup, 0, "The number of loads to warm up.");
+C10_DEFINE_int(iter, 1, "The number of timed loads.");
 
 int main(int argc, char** argv) {
   c10::SetUsageMessage(
     "Check if exported bytecode model is runnable by lite_interpreter.\n"
     "Example usage:\n"
     "./lite_interpreter_model_load"
-    " --model=<model_file>");
+    " --model=<model_file>"
+    " [--lazy] [--parallel] [--warmup=<n>] [--iter=<n>]");
 
   if (!c10::ParseCommandLineFlags(&argc, &argv)) {
     std::cerr << "Failed to parse command line flags!" << std::endl;
@@ -28,6 +42,34 @@ int main(int argc, char** argv) {
   // TODO: avoid having to set this guard for custom mobile build with mobile
   // interpreter.
   torch::AutoNonVariableTypeMode non_var_guard{true};
-  torch::jit::mobile::Module bc = torch::jit::_load_for_mobile(FLAGS_model);
+  uint64_t options = torch::jit::_default_mobile_module_load_options;
+  if (FLAGS_lazy) {
+    options |= torch::jit::MobileModuleLoadOptions::LAZY_METHODS;
+  }
+  if (FLAGS_parallel) {
+    options |= torch::jit::MobileModuleLoadOptions::PARALLEL_OPERATOR_LOOKUP;
+  }
+  torch::jit::ExtraFilesMap extra_files;
+  for (int i = 0; i < FLAGS_warmup; ++i) {
+    torch::jit::_load_for_mobile(
+        FLAGS_model, c10::nullopt, extra_files, options);
+  }
+
+  double total_ms = 0;
+  double min_ms = std::numeric_limits<double>::max();
+  for (int i = 0; i < FLAGS_iter; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    torch::jit::mobile::Module bc = torch::jit::_load_for_mobile(
+        FLAGS_model, c10::nullopt, extra_files, options);
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    total_ms += elapsed.count();
+    min_ms = std::min(min_ms, elapsed.count());
+  }
+  if (FLAGS_iter > 0) {
+    std::cout << "Loaded " << FLAGS_model << " " << FLAGS_iter
+              << " times, mean " << total_ms / FLAGS_iter << " ms, min "
+              << min_ms << " ms" << std::endl;
+  }
   return 0;
 }
@@ -1,4 +1,5 @@
 #include <climits>
+#include <sstream>
 
 #include <c10/mobile/CPUProfilingAllocator.h>
 
@@ -235,6 +236,42 @@ void AllocationPlan::clear() {
   allocation_offsets.clear();
 }
 
+std::string AllocationPlan::serialize() const {
+  // <num allocations> <total size> then (size lifetime offset) per allocation
+  std::ostringstream ss;
+  ss << allocation_sizes.size() << " " << total_size;
+  for (size_t i = 0; i < allocation_sizes.size(); ++i) {
+    ss << " " << allocation_sizes[i] << " " << allocation_lifetimes[i] << " "
+       << allocation_offsets[i];
+  }
+  return ss.str();
+}
+
+AllocationPlan AllocationPlan::deserialize(const std::string& str) {
+  AllocationPlan plan;
+  std::istringstream ss(str);
+  uint64_t num_allocations = 0;
+  ss >> num_allocations >> plan.total_size;
+  TORCH_CHECK(ss, "ProfilingAllocator: Malformed allocation plan.");
+  for (uint64_t i = 0; i < num_allocations; ++i) {
+    uint64_t size = 0, lifetime = 0, offset = 0;
+    ss >> size >> lifetime >> offset;
+    TORCH_CHECK(ss, "ProfilingAllocator: Malformed allocation plan.");
+    // Managed allocations must fit in the arena and be freed by a later
+    // allocation, as recorded by AllocationPlanner.
+    TORCH_CHECK(
+        lifetime == std::numeric_limits<uint64_t>::max() ||
+            (lifetime > i && lifetime <= num_allocations &&
+             offset <= plan.total_size &&
+             size <= plan.total_size - offset),
+        "ProfilingAllocator: Allocation plan invalid.");
+    plan.allocation_sizes.push_back(size);
+    plan.allocation_lifetimes.push_back(lifetime);
+    plan.allocation_offsets.push_back(offset);
+  }
+  return plan;
+}
+
 void AllocationPlanner::record_allocation(
     const uint64_t size, const void* ptr) {
   if (validation_mode_) {
@@ -266,8 +303,16 @@ void AllocationPlanner::record_free(const void* ptr) {
 
 bool AllocationPlanner::validate_allocation(
     const uint64_t size, const void* ptr) {
-  if (allocation_id_ >= allocation_plan_->allocation_sizes.size() ||
-      allocation_plan_->allocation_sizes[allocation_id_] != size) {
+  if (allocation_id_ >= allocation_plan_->allocation_sizes.size()) {
+    TORCH_WARN(
+        "Allocation request does not match plan:",
+        "Allocation id:",
+        allocation_id_,
+        ", Number of recorded allocations:",
+        allocation_plan_->allocation_sizes.size());
+    return false;
+  }
+  if (allocation_plan_->allocation_sizes[allocation_id_] != size) {
     TORCH_WARN(
         "Allocation request does not match plan:",
         "Allocation id:",
@@ -319,11 +364,17 @@ void AllocationPlanner::clear() {
   allocation_ptr_to_id_.clear();
 }
 
-void CPUProfilingAllocator::set_plan(const AllocationPlan* plan) {
+void CPUProfilingAllocator::set_plan(
+    const AllocationPlan* plan, bool fallback_on_mismatch) {
   TORCH_CHECK(plan != nullptr, "Allocation plan is nullptr.");
   plan_ = plan;
   allocation_id_ = 0;
   allocation_ptr_to_id_.clear();
+  fallback_on_mismatch_ = fallback_on_mismatch;
+  diverged_ = false;
+  // lifetimes go up to the number of allocations
+  live_until_.assign(
+      fallback_on_mismatch ? plan->allocation_sizes.size() + 1 : 0, 0);
   if (current_size_ < plan->total_size) {
     // Free existing memory and reallocate for larger size.
     c10::free_cpu(blob_);
@@ -339,6 +390,19 @@ void CPUProfilingAllocator::unset_plan() {
 }
 
 void* CPUProfilingAllocator::allocate(const size_t bytes) {
+  if (fallback_on_mismatch_) {
+    // An allocation still alive when its memory is due to be reused also
+    // departs from the plan.
+    diverged_ = diverged_ ||
+        allocation_id_ >= plan_->allocation_sizes.size() ||
+        bytes != plan_->allocation_sizes[allocation_id_] ||
+        live_until_[allocation_id_] > 0;
+    if (diverged_) {
+      return c10::alloc_cpu(bytes);
+    }
+  }
+  TORCH_CHECK(allocation_id_ < plan_->allocation_sizes.size(),
+      "Got more allocation requests than recorded in the plan.");
   TORCH_CHECK(bytes == plan_->allocation_sizes[allocation_id_],
       "Got allocation request that does not match with the plan.");
   if (plan_->allocation_lifetimes[allocation_id_] ==
@@ -351,6 +415,9 @@ void* CPUProfilingAllocator::allocate(const size_t bytes) {
     reinterpret_cast<uint8_t*>(blob_) +
     plan_->allocation_offsets[allocation_id_];
   allocation_ptr_to_id_[ptr] = allocation_id_;
+  if (fallback_on_mismatch_) {
+    live_until_[plan_->allocation_lifetimes[allocation_id_]]++;
+  }
   allocation_id_++;
   return ptr;
 }
@@ -378,6 +445,12 @@ void CPUProfilingAllocator::free(void* const ptr) {
   TORCH_CHECK(id < plan_->allocation_lifetimes.size(),
       "Freeing allocation that is not accordingly to the plan.");
   auto lifetime_id = plan_->allocation_lifetimes[id];
+  if (fallback_on_mismatch_) {
+    // Freeing early is fine, freeing late is caught by allocate().
+    live_until_[lifetime_id]--;
+    allocation_ptr_to_id_.erase(it);
+    return;
+  }
   TORCH_CHECK(
       lifetime_id == allocation_id_,
       "Lifetime of allocations do not match: allocation_id ",
@@ -427,12 +500,14 @@ AllocationPlanner* GetThreadLocalAllocationPlanner() {
 }
 
 WithProfilingAllocatorGuard::WithProfilingAllocatorGuard(
-    CPUProfilingAllocator* allocator, const AllocationPlan* plan) {
+    CPUProfilingAllocator* allocator,
+    const AllocationPlan* plan,
+    bool fallback_on_mismatch) {
   // Nesting of profiling allocator is not supported.
   TORCH_CHECK(profiling_allocator == nullptr,
       "Nesting profiling allocators is not supported.");
   profiling_allocator = allocator;
-  profiling_allocator->set_plan(plan);
+  profiling_allocator->set_plan(plan, fallback_on_mismatch);
 }
 
 WithProfilingAllocatorGuard::~WithProfilingAllocatorGuard() {
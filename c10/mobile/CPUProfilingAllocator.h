@@ -4,6 +4,8 @@
 #include <deque>
 #include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include <c10/core/CPUAllocator.h>
 #include <c10/util/Exception.h>
@@ -37,6 +39,16 @@ class C10_API AllocationPlan {
     std::vector<uint64_t> allocation_offsets;
     uint64_t total_size{0};
     void clear();
+  public:
+    uint64_t arena_size() const {
+      return total_size;
+    }
+    // Text form of the plan, so that it can be recorded once and shipped
+    // with a model. deserialize() checks that the plan is self consistent
+    // but not that it matches the model.
+    std::string serialize() const;
+    static AllocationPlan deserialize(const std::string& str);
+  private:
     friend class AllocationPlanner;
     friend class CPUProfilingAllocator;
 };
@@ -77,10 +89,33 @@ class C10_API CPUProfilingAllocator {
     uint64_t current_size_{0};
     void* blob_{nullptr};
     ska::flat_hash_map<const void*, uint64_t> allocation_ptr_to_id_;
+    bool fallback_on_mismatch_{false};
+    bool diverged_{false};
+    // In fallback mode, the number of live allocations from the blob by the
+    // id of the allocation they must be freed before, so that a late free is
+    // caught before its memory is handed out again.
+    std::vector<uint64_t> live_until_;
   public:
     ~CPUProfilingAllocator();
-    void set_plan(const AllocationPlan* plan);
+    // By default, allocations that do not follow the plan throw. With
+    // fallback_on_mismatch, the first one that does not marks the allocator
+    // as diverged, and it and all the following allocations go to malloc.
+    void set_plan(const AllocationPlan* plan, bool fallback_on_mismatch = false);
     void unset_plan();
+    // Since the last set_plan, with fallback_on_mismatch.
+    bool diverged() const {
+      return diverged_;
+    }
+    // Whether allocations from the blob have not been freed yet, with
+    // fallback_on_mismatch.
+    bool has_live_allocations() const {
+      return !allocation_ptr_to_id_.empty();
+    }
+    // Whether ptr points into the memory of the plan.
+    bool owns(const void* ptr) const {
+      return blob_ != nullptr && ptr >= blob_ &&
+          ptr < static_cast<const uint8_t*>(blob_) + current_size_;
+    }
     void* allocate(const size_t bytes);
     void free(void* const ptr);
 };
@@ -140,7 +175,9 @@ AllocationPlanner* GetThreadLocalAllocationPlanner();
 class C10_API WithProfilingAllocatorGuard {
   public:
     WithProfilingAllocatorGuard(
-        CPUProfilingAllocator* allocator, const AllocationPlan* plan);
+        CPUProfilingAllocator* allocator,
+        const AllocationPlan* plan,
+        bool fallback_on_mismatch = false);
     ~WithProfilingAllocatorGuard();
 };
 
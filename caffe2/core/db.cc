@@ -173,6 +173,92 @@ class MiniDB : public DB {
 REGISTER_CAFFE2_DB(MiniDB, MiniDB);
 REGISTER_CAFFE2_DB(minidb, MiniDB);
 
+string DBReader::NextKey() const {
+  std::unique_lock<std::mutex> mutex_lock(reader_mutex_);
+  std::unique_lock<std::mutex> queue_lock(prefetch_mutex_);
+  if (!prefetched_.empty()) {
+    return prefetched_.front().first;
+  }
+  return cursor_->key();
+}
+
+void DBReader::StartPrefetch(int depth) const {
+  CAFFE_ENFORCE(!prefetch_thread_);
+  prefetch_depth_ = depth;
+  stop_prefetch_ = false;
+  prefetch_error_ = nullptr;
+  prefetched_.clear();
+  prefetch_thread_.reset(new std::thread([this] { PrefetchWorker(); }));
+}
+
+void DBReader::StopPrefetch(bool rewind) const {
+  if (!prefetch_thread_) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> queue_lock(prefetch_mutex_);
+    stop_prefetch_ = true;
+  }
+  prefetch_producer_cv_.notify_all();
+  prefetch_thread_->join();
+  prefetch_thread_.reset();
+
+  // Records that were read ahead but never consumed have already moved the
+  // cursor past them, so rewind it to the first one left in the queue to keep
+  // the next Read() where the consumers expect it.
+  std::lock_guard<std::mutex> mutex_lock(reader_mutex_);
+  if (rewind && !prefetched_.empty()) {
+    const string next_key = prefetched_.front().first;
+    if (cursor_->SupportsSeek()) {
+      cursor_->Seek(next_key);
+    } else {
+      MoveToBeginning();
+      while (cursor_->Valid() && cursor_->key() != next_key) {
+        for (uint32_t s = 0; s < num_shards_ && cursor_->Valid(); s++) {
+          cursor_->Next();
+        }
+      }
+      if (!cursor_->Valid()) {
+        MoveToBeginning();
+      }
+    }
+  }
+  prefetched_.clear();
+}
+
+void DBReader::PrefetchWorker() const {
+  string key;
+  string value;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> queue_lock(prefetch_mutex_);
+      prefetch_producer_cv_.wait(queue_lock, [this] {
+        return stop_prefetch_ ||
+            prefetched_.size() < static_cast<size_t>(prefetch_depth_);
+      });
+      if (stop_prefetch_) {
+        return;
+      }
+    }
+    // This is the only producer, so the free slot found above is still free
+    // once the record has been read.
+    std::lock_guard<std::mutex> mutex_lock(reader_mutex_);
+    try {
+      ReadAndAdvance(&key, &value);
+    } catch (...) {
+      std::lock_guard<std::mutex> queue_lock(prefetch_mutex_);
+      prefetch_error_ = std::current_exception();
+      prefetch_consumer_cv_.notify_all();
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> queue_lock(prefetch_mutex_);
+      prefetched_.emplace_back(std::move(key), std::move(value));
+    }
+    prefetch_consumer_cv_.notify_one();
+  }
+}
+
 void DBReaderSerializer::Serialize(
     const void* pointer,
     TypeMeta typeMeta,
@@ -184,8 +270,8 @@ void DBReaderSerializer::Serialize(
   proto.set_name(name);
   proto.set_source(reader.source_);
   proto.set_db_type(reader.db_type_);
-  if (reader.cursor() && reader.cursor()->SupportsSeek()) {
-    proto.set_key(reader.cursor()->key());
+  if (reader.cursor_ && reader.cursor_->SupportsSeek()) {
+    proto.set_key(reader.NextKey());
   }
   BlobProto blob_proto;
   blob_proto.set_name(name);
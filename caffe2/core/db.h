@@ -1,7 +1,11 @@
 #ifndef CAFFE2_CORE_DB_H_
 #define CAFFE2_CORE_DB_H_
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <mutex>
+#include <thread>
 
 #include "c10/util/Registry.h"
 #include "caffe2/core/blob_serialization.h"
@@ -177,11 +181,16 @@ class TORCH_API DBReader {
     cursor_ = db_->NewCursor();
   }
 
+  ~DBReader() {
+    StopPrefetch();
+  }
+
   void Open(
       const string& db_type,
       const string& source,
       const int32_t num_shards = 1,
       const int32_t shard_id = 0) {
+    StopPrefetch();
     // Note(jiayq): resetting is needed when we re-open e.g. leveldb where no
     // concurrent access is allowed.
     cursor_.reset();
@@ -203,6 +212,7 @@ class TORCH_API DBReader {
       unique_ptr<DB>&& db,
       const int32_t num_shards = 1,
       const int32_t shard_id = 0) {
+    StopPrefetch();
     cursor_.reset();
     db_.reset();
     db_ = std::move(db);
@@ -229,18 +239,23 @@ class TORCH_API DBReader {
    */
   void Read(string* key, string* value) const {
     CAFFE_ENFORCE(cursor_ != nullptr, "Reader not initialized.");
-    std::unique_lock<std::mutex> mutex_lock(reader_mutex_);
-    *key = cursor_->key();
-    *value = cursor_->value();
-
-    // In sharded mode, each read skips num_shards_ records
-    for (uint32_t s = 0; s < num_shards_; s++) {
-      cursor_->Next();
-      if (!cursor_->Valid()) {
-        MoveToBeginning();
-        break;
+    if (prefetch_thread_) {
+      std::unique_lock<std::mutex> queue_lock(prefetch_mutex_);
+      prefetch_consumer_cv_.wait(queue_lock, [this] {
+        return !prefetched_.empty() || prefetch_error_;
+      });
+      if (prefetched_.empty()) {
+        std::rethrow_exception(prefetch_error_);
       }
+      *key = std::move(prefetched_.front().first);
+      *value = std::move(prefetched_.front().second);
+      prefetched_.pop_front();
+      queue_lock.unlock();
+      prefetch_producer_cv_.notify_one();
+      return;
     }
+    std::unique_lock<std::mutex> mutex_lock(reader_mutex_);
+    ReadAndAdvance(key, value);
   }
 
   /**
@@ -249,7 +264,34 @@ class TORCH_API DBReader {
   void SeekToFirst() const {
     CAFFE_ENFORCE(cursor_ != nullptr, "Reader not initialized.");
     std::unique_lock<std::mutex> mutex_lock(reader_mutex_);
+    std::unique_lock<std::mutex> queue_lock(prefetch_mutex_);
+    // Drop whatever was read ahead from the old position.
+    prefetched_.clear();
     MoveToBeginning();
+    queue_lock.unlock();
+    prefetch_producer_cv_.notify_one();
+  }
+
+  /**
+   * Starts a background thread that keeps up to `depth` records of this
+   * reader's shard read ahead, so that Read() only has to wait for the db
+   * when the consumers are faster than the storage. The records come out in
+   * the same order as without prefetching. A depth of 0 stops prefetching.
+   *
+   * Not thread safe with respect to concurrent Read() calls; call it right
+   * after opening the reader.
+   */
+  void SetPrefetchDepth(int depth) {
+    CAFFE_ENFORCE(cursor_ != nullptr, "Reader not initialized.");
+    CAFFE_ENFORCE_GE(depth, 0);
+    StopPrefetch(/*rewind=*/true);
+    if (depth > 0) {
+      StartPrefetch(depth);
+    }
+  }
+
+  int prefetch_depth() const {
+    return prefetch_thread_ ? prefetch_depth_ : 0;
   }
 
   /**
@@ -285,6 +327,31 @@ class TORCH_API DBReader {
     }
   }
 
+  // Reads the current record and moves the cursor to the next record of this
+  // shard. Must be called with reader_mutex_ held.
+  void ReadAndAdvance(string* key, string* value) const {
+    *key = cursor_->key();
+    *value = cursor_->value();
+
+    // In sharded mode, each read skips num_shards_ records
+    for (uint32_t s = 0; s < num_shards_; s++) {
+      cursor_->Next();
+      if (!cursor_->Valid()) {
+        MoveToBeginning();
+        break;
+      }
+    }
+  }
+
+  // Key of the record the next Read() returns.
+  string NextKey() const;
+
+  void StartPrefetch(int depth) const;
+  // With `rewind`, the cursor is moved back to the first record that was read
+  // ahead but not consumed.
+  void StopPrefetch(bool rewind = false) const;
+  void PrefetchWorker() const;
+
   string db_type_;
   string source_;
   unique_ptr<DB> db_;
@@ -293,6 +360,18 @@ class TORCH_API DBReader {
   uint32_t num_shards_{};
   uint32_t shard_id_{};
 
+  // Read-ahead state, see SetPrefetchDepth(). When both mutexes are needed,
+  // reader_mutex_ is always taken first. The worker never waits for queue
+  // space while holding reader_mutex_.
+  mutable int prefetch_depth_{0};
+  mutable unique_ptr<std::thread> prefetch_thread_;
+  mutable std::mutex prefetch_mutex_;
+  mutable std::condition_variable prefetch_producer_cv_;
+  mutable std::condition_variable prefetch_consumer_cv_;
+  mutable std::deque<std::pair<string, string>> prefetched_;
+  mutable bool stop_prefetch_{false};
+  mutable std::exception_ptr prefetch_error_;
+
   C10_DISABLE_COPY_AND_ASSIGN(DBReader);
 };
 
@@ -3,7 +3,13 @@
 namespace caffe2 {
 REGISTER_CPU_OPERATOR(CreateDB, CreateDBOp<CPUContext>);
 
-OPERATOR_SCHEMA(CreateDB).NumInputs(0).NumOutputs(1);
+OPERATOR_SCHEMA(CreateDB)
+    .NumInputs(0)
+    .NumOutputs(1)
+    .Arg(
+        "prefetch_depth",
+        "(int, default 0) if positive, a background thread keeps up to this "
+        "many records of the shard read ahead");
 
 NO_GRADIENT(CreateDB);
 }  // namespace caffe2
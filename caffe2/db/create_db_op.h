@@ -19,13 +19,20 @@ class CreateDBOp final : public Operator<Context> {
         num_shards_(
             OperatorBase::template GetSingleArgument<int>("num_shards", 1)),
         shard_id_(
-            OperatorBase::template GetSingleArgument<int>("shard_id", 0)) {
+            OperatorBase::template GetSingleArgument<int>("shard_id", 0)),
+        prefetch_depth_(OperatorBase::template GetSingleArgument<int>(
+            "prefetch_depth",
+            0)) {
     CAFFE_ENFORCE_GT(db_name_.size(), 0, "Must specify a db name.");
+    CAFFE_ENFORCE_GE(prefetch_depth_, 0);
   }
 
   bool RunOnDevice() final {
-    OperatorBase::Output<db::DBReader>(0)->Open(
-        db_type_, db_name_, num_shards_, shard_id_);
+    auto* reader = OperatorBase::Output<db::DBReader>(0);
+    reader->Open(db_type_, db_name_, num_shards_, shard_id_);
+    if (prefetch_depth_ > 0) {
+      reader->SetPrefetchDepth(prefetch_depth_);
+    }
     return true;
   }
 
@@ -34,6 +41,7 @@ class CreateDBOp final : public Operator<Context> {
   string db_name_;
   uint32_t num_shards_;
   uint32_t shard_id_;
+  int prefetch_depth_;
   C10_DISABLE_COPY_AND_ASSIGN(CreateDBOp);
 };
 
@@ -200,5 +200,48 @@ TEST(DBReaderShardedTest, Reader) {
   EXPECT_EQ(value, "05");
 }
 
+TEST(DBReaderPrefetchTest, Reader) {
+  // leveldb does not allow two readers on the same db, so the prefetching
+  // reader gets its own copy.
+  std::string name = std::tmpnam(nullptr);
+  CreateAndFill("leveldb", name);
+  CreateAndFill("leveldb", name + "1");
+
+  // A prefetching reader returns the same records, in the same order, as a
+  // plain one, also across wrap-around and in sharded mode.
+  for (int num_shards : {1, 3}) {
+    const int shard_id = num_shards - 1;
+    std::unique_ptr<DBReader> reader(
+        new DBReader("leveldb", name, num_shards, shard_id));
+    std::unique_ptr<DBReader> prefetching(
+        new DBReader("leveldb", name + "1", num_shards, shard_id));
+    prefetching->SetPrefetchDepth(4);
+    EXPECT_EQ(prefetching->prefetch_depth(), 4);
+    string key, value, expected_key, expected_value;
+    for (int i = 0; i < 2 * kMaxItems; ++i) {
+      reader->Read(&expected_key, &expected_value);
+      prefetching->Read(&key, &value);
+      EXPECT_EQ(key, expected_key);
+      EXPECT_EQ(value, expected_value);
+    }
+
+    // Turning prefetching off continues right after the last record read.
+    prefetching->SetPrefetchDepth(0);
+    EXPECT_EQ(prefetching->prefetch_depth(), 0);
+    reader->Read(&expected_key, &expected_value);
+    prefetching->Read(&key, &value);
+    EXPECT_EQ(key, expected_key);
+
+    prefetching->SetPrefetchDepth(2);
+    reader->SeekToFirst();
+    prefetching->SeekToFirst();
+    for (int i = 0; i < 3; ++i) {
+      reader->Read(&expected_key, &expected_value);
+      prefetching->Read(&key, &value);
+      EXPECT_EQ(key, expected_key);
+    }
+  }
+}
+
 } // namespace db
 } // namespace caffe2
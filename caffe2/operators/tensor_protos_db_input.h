@@ -1,9 +1,11 @@
 #ifndef CAFFE2_OPERATORS_TENSOR_PROTOS_DB_INPUT_H_
 #define CAFFE2_OPERATORS_TENSOR_PROTOS_DB_INPUT_H_
 
+#include <exception>
 #include <iostream>
 #include <mutex>
 
+#include "c10/core/thread_pool.h"
 #include "caffe2/core/db.h"
 #include "caffe2/operators/prefetch_op.h"
 
@@ -23,12 +25,22 @@ class TensorProtosDBInput final : public PrefetchOperator<Context> {
   bool CopyPrefetched() override;
 
  private:
+  // Deserializes the item_id-th record of the batch into its slot of the
+  // output tensors. Item 0 also allocates them, so it has to be decoded before
+  // the others.
+  void DecodeItem(int item_id, vector<Tensor*>* dst);
+
   // Prefetch will always just happen on the CPU side.
   vector<Blob> prefetched_blobs_;
   int batch_size_;
   bool shape_inferred_ = false;
   string key_;
   string value_;
+  // Serialized records of the current batch.
+  vector<string> values_;
+  // Used to deserialize the records of a batch in parallel when
+  // decode_threads > 1.
+  std::unique_ptr<TaskThreadPool> thread_pool_;
 };
 
 template <class Context>
@@ -38,7 +50,14 @@ TensorProtosDBInput<Context>::TensorProtosDBInput(
     : PrefetchOperator<Context>(operator_def, ws),
       prefetched_blobs_(operator_def.output_size()),
       batch_size_(
-          this->template GetSingleArgument<int>("batch_size", 0)) {}
+          this->template GetSingleArgument<int>("batch_size", 0)) {
+  const int num_decode_threads =
+      this->template GetSingleArgument<int>("decode_threads", 1);
+  CAFFE_ENFORCE_GE(num_decode_threads, 1);
+  if (num_decode_threads > 1 && batch_size_ > 1) {
+    thread_pool_ = make_unique<TaskThreadPool>(num_decode_threads);
+  }
+}
 
 template <class Context>
 bool TensorProtosDBInput<Context>::Prefetch() {
@@ -62,36 +81,85 @@ bool TensorProtosDBInput<Context>::Prefetch() {
       //     CPU));
     }
   } else {
+    // Read the raw records first. With a prefetching reader this mostly takes
+    // them off its queue, and leaves the parsing to be spread over the decode
+    // threads below.
+    values_.resize(batch_size_);
     for (int item_id = 0; item_id < batch_size_; ++item_id) {
-      reader.Read(&key_, &value_);
-      TensorProtos protos;
-      CAFFE_ENFORCE(protos.ParseFromString(value_));
-      CAFFE_ENFORCE(protos.protos_size() == OutputSize());
-      // Note: shape_inferred_ is ignored, we'll always get dimensions from
-      // proto
-      for (int i = 0; i < protos.protos_size(); ++i) {
-        vector<int64_t> dims(
-            protos.protos(i).dims().begin(), protos.protos(i).dims().end());
-        dims.insert(dims.begin(), batch_size_);
-        if (protos.protos(i).has_device_detail()) {
-          protos.mutable_protos(i)->clear_device_detail();
-        }
-        Tensor src = deserializer.Deserialize(protos.protos(i));
-        Tensor* dst = BlobGetMutableTensor(
-            &prefetched_blobs_[i], dims, at::dtype(src.dtype()).device(CPU));
-        DCHECK_EQ(src.numel() * batch_size_, dst->numel());
-        this->context_.CopyItemsSameDevice(
-            src.dtype(),
-            src.numel(),
-            src.raw_data(),
-            static_cast<char*>(dst->raw_mutable_data(src.dtype())) +
-                src.nbytes() * item_id);
+      reader.Read(&key_, &values_[item_id]);
+    }
+    // The first item determines the output shapes and types.
+    vector<Tensor*> dst(OutputSize());
+    DecodeItem(0, &dst);
+    if (!thread_pool_) {
+      for (int item_id = 1; item_id < batch_size_; ++item_id) {
+        DecodeItem(item_id, &dst);
+      }
+    } else {
+      std::mutex error_mutex;
+      std::exception_ptr error;
+      for (int item_id = 1; item_id < batch_size_; ++item_id) {
+        thread_pool_->run([this, item_id, &dst, &error_mutex, &error] {
+          try {
+            DecodeItem(item_id, &dst);
+          } catch (...) {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) {
+              error = std::current_exception();
+            }
+          }
+        });
+      }
+      thread_pool_->waitWorkComplete();
+      if (error) {
+        std::rethrow_exception(error);
       }
     }
   }
   return true;
 }
 
+template <class Context>
+void TensorProtosDBInput<Context>::DecodeItem(
+    int item_id,
+    vector<Tensor*>* dst) {
+  TensorDeserializer deserializer;
+  TensorProtos protos;
+  CAFFE_ENFORCE(protos.ParseFromString(values_[item_id]));
+  CAFFE_ENFORCE(protos.protos_size() == OutputSize());
+  CPUContext context;
+  for (int i = 0; i < protos.protos_size(); ++i) {
+    if (protos.protos(i).has_device_detail()) {
+      protos.mutable_protos(i)->clear_device_detail();
+    }
+    Tensor src = deserializer.Deserialize(protos.protos(i));
+    if (item_id == 0) {
+      // Note: shape_inferred_ is ignored, we'll always get dimensions from
+      // proto
+      vector<int64_t> dims(
+          protos.protos(i).dims().begin(), protos.protos(i).dims().end());
+      dims.insert(dims.begin(), batch_size_);
+      (*dst)[i] = BlobGetMutableTensor(
+          &prefetched_blobs_[i], dims, at::dtype(src.dtype()).device(CPU));
+      (*dst)[i]->raw_mutable_data(src.dtype());
+    }
+    Tensor* out = (*dst)[i];
+    CAFFE_ENFORCE(
+        src.dtype() == out->dtype(),
+        "All records of a batch need to have the same data types.");
+    CAFFE_ENFORCE_EQ(
+        src.numel() * batch_size_,
+        out->numel(),
+        "All records of a batch need to have the same shapes.");
+    context.CopyItemsSameDevice(
+        src.dtype(),
+        src.numel(),
+        src.raw_data(),
+        static_cast<char*>(out->raw_mutable_data(src.dtype())) +
+            src.nbytes() * item_id);
+  }
+}
+
 template <class Context>
 bool TensorProtosDBInput<Context>::CopyPrefetched() {
   for (int i = 0; i < OutputSize(); ++i) {
@@ -0,0 +1,493 @@
+#include "caffe2/perfkernels/sparse_optimizers.h"
+
+#include "caffe2/perfkernels/common.h"
+
+namespace caffe2 {
+
+void adam_update_prefetch__base(
+    int N,
+    const float* w,
+    const float* /* w_n */, // prefetch ptr
+    const float* g,
+    const float* m,
+    const float* /* m_n */, // prefetch ptr
+    const float* v,
+    const float* /* v_n */, // prefetch ptr
+    float* nw,
+    float* nm,
+    float* nv,
+    float beta1,
+    float beta2,
+    float epsilon,
+    float lr_correction) {
+  internal::adam_update_base_inlined(
+      N, w, g, m, v, nw, nm, nv, beta1, beta2, epsilon, lr_correction);
+}
+
+decltype(adam_update_prefetch__base) adam_update_prefetch__avx2_fma;
+decltype(adam_update_prefetch__base) adam_update_prefetch__avx512;
+void adam_update_prefetch(
+    int N,
+    const float* w,
+    const float* w_n, // prefetch ptr
+    const float* g,
+    const float* m,
+    const float* m_n, // prefetch ptr
+    const float* v,
+    const float* v_n, // prefetch ptr
+    float* nw,
+    float* nm,
+    float* nv,
+    float beta1,
+    float beta2,
+    float epsilon,
+    float lr_correction) {
+  AVX512_DO(
+      adam_update_prefetch,
+      N,
+      w,
+      w_n,
+      g,
+      m,
+      m_n,
+      v,
+      v_n,
+      nw,
+      nm,
+      nv,
+      beta1,
+      beta2,
+      epsilon,
+      lr_correction);
+  AVX2_FMA_DO(
+      adam_update_prefetch,
+      N,
+      w,
+      w_n,
+      g,
+      m,
+      m_n,
+      v,
+      v_n,
+      nw,
+      nm,
+      nv,
+      beta1,
+      beta2,
+      epsilon,
+      lr_correction);
+  BASE_DO(
+      adam_update_prefetch,
+      N,
+      w,
+      w_n,
+      g,
+      m,
+      m_n,
+      v,
+      v_n,
+      nw,
+      nm,
+      nv,
+      beta1,
+      beta2,
+      epsilon,
+      lr_correction);
+}
+
+void adam_fp16_update_prefetch__base(
+    int N,
+    const float* w,
+    const float* /* w_n */, // prefetch ptr
+    const float* g,
+    const at::Half* m,
+    const at::Half* /* m_n */, // prefetch ptr
+    const at::Half* v,
+    const at::Half* /* v_n */, // prefetch ptr
+    float* nw,
+    at::Half* nm,
+    at::Half* nv,
+    float beta1,
+    float beta2,
+    float epsilon,
+    float lr_correction) {
+  internal::adam_update_base_inlined(
+      N, w, g, m, v, nw, nm, nv, beta1, beta2, epsilon, lr_correction);
+}
+
+decltype(adam_fp16_update_prefetch__base) adam_fp16_update_prefetch__avx2_fma;
+decltype(adam_fp16_update_prefetch__base) adam_fp16_update_prefetch__avx512;
+void adam_fp16_update_prefetch(
+    int N,
+    const float* w,
+    const float* w_n, // prefetch ptr
+    const float* g,
+    const at::Half* m,
+    const at::Half* m_n, // prefetch ptr
+    const at::Half* v,
+    const at::Half* v_n, // prefetch ptr
+    float* nw,
+    at::Half* nm,
+    at::Half* nv,
+    float beta1,
+    float beta2,
+    float epsilon,
+    float lr_correction) {
+  AVX512_DO(
+      adam_fp16_update_prefetch,
+      N,
+      w,
+      w_n,
+      g,
+      m,
+      m_n,
+      v,
+      v_n,
+      nw,
+      nm,
+      nv,
+      beta1,
+      beta2,
+      epsilon,
+      lr_correction);
+  AVX2_FMA_DO(
+      adam_fp16_update_prefetch,
+      N,
+      w,
+      w_n,
+      g,
+      m,
+      m_n,
+      v,
+      v_n,
+      nw,
+      nm,
+      nv,
+      beta1,
+      beta2,
+      epsilon,
+      lr_correction);
+  BASE_DO(
+      adam_fp16_update_prefetch,
+      N,
+      w,
+      w_n,
+      g,
+      m,
+      m_n,
+      v,
+      v_n,
+      nw,
+      nm,
+      nv,
+      beta1,
+      beta2,
+      epsilon,
+      lr_correction);
+}
+
+void rmsprop_update_prefetch__base(
+    int N,
+    const float* g,
+    const float* ms,
+    const float* /* ms_n */, // prefetch ptr
+    const float* mom,
+    const float* /* mom_n */, // prefetch ptr
+    float* ng,
+    float* nms,
+    float* nmom,
+    float decay,
+    float momentum,
+    float epsilon,
+    float lr) {
+  internal::rmsprop_update_base_inlined(
+      N, g, ms, mom, ng, nms, nmom, decay, momentum, epsilon, lr);
+}
+
+decltype(rmsprop_update_prefetch__base) rmsprop_update_prefetch__avx2_fma;
+decltype(rmsprop_update_prefetch__base) rmsprop_update_prefetch__avx512;
+void rmsprop_update_prefetch(
+    int N,
+    const float* g,
+    const float* ms,
+    const float* ms_n, // prefetch ptr
+    const float* mom,
+    const float* mom_n, // prefetch ptr
+    float* ng,
+    float* nms,
+    float* nmom,
+    float decay,
+    float momentum,
+    float epsilon,
+    float lr) {
+  AVX512_DO(
+      rmsprop_update_prefetch,
+      N,
+      g,
+      ms,
+      ms_n,
+      mom,
+      mom_n,
+      ng,
+      nms,
+      nmom,
+      decay,
+      momentum,
+      epsilon,
+      lr);
+  AVX2_FMA_DO(
+      rmsprop_update_prefetch,
+      N,
+      g,
+      ms,
+      ms_n,
+      mom,
+      mom_n,
+      ng,
+      nms,
+      nmom,
+      decay,
+      momentum,
+      epsilon,
+      lr);
+  BASE_DO(
+      rmsprop_update_prefetch,
+      N,
+      g,
+      ms,
+      ms_n,
+      mom,
+      mom_n,
+      ng,
+      nms,
+      nmom,
+      decay,
+      momentum,
+      epsilon,
+      lr);
+}
+
+void rmsprop_fp16_update_prefetch__base(
+    int N,
+    const float* g,
+    const at::Half* ms,
+    const at::Half* /* ms_n */, // prefetch ptr
+    const at::Half* mom,
+    const at::Half* /* mom_n */, // prefetch ptr
+    float* ng,
+    at::Half* nms,
+    at::Half* nmom,
+    float decay,
+    float momentum,
+    float epsilon,
+    float lr) {
+  internal::rmsprop_update_base_inlined(
+      N, g, ms, mom, ng, nms, nmom, decay, momentum, epsilon, lr);
+}
+
+decltype(rmsprop_fp16_update_prefetch__base) rmsprop_fp16_update_prefetch__avx2_fma;
+decltype(rmsprop_fp16_update_prefetch__base) rmsprop_fp16_update_prefetch__avx512;
+void rmsprop_fp16_update_prefetch(
+    int N,
+    const float* g,
+    const at::Half* ms,
+    const at::Half* ms_n, // prefetch ptr
+    const at::Half* mom,
+    const at::Half* mom_n, // prefetch ptr
+    float* ng,
+    at::Half* nms,
+    at::Half* nmom,
+    float decay,
+    float momentum,
+    float epsilon,
+    float lr) {
+  AVX512_DO(
+      rmsprop_fp16_update_prefetch,
+      N,
+      g,
+      ms,
+      ms_n,
+      mom,
+      mom_n,
+      ng,
+      nms,
+      nmom,
+      decay,
+      momentum,
+      epsilon,
+      lr);
+  AVX2_FMA_DO(
+      rmsprop_fp16_update_prefetch,
+      N,
+      g,
+      ms,
+      ms_n,
+      mom,
+      mom_n,
+      ng,
+      nms,
+      nmom,
+      decay,
+      momentum,
+      epsilon,
+      lr);
+  BASE_DO(
+      rmsprop_fp16_update_prefetch,
+      N,
+      g,
+      ms,
+      ms_n,
+      mom,
+      mom_n,
+      ng,
+      nms,
+      nmom,
+      decay,
+      momentum,
+      epsilon,
+      lr);
+}
+
+void momentum_sgd_update_prefetch__base(
+    int N,
+    const float* g,
+    const float* m,
+    const float* /* m_n */, // prefetch ptr
+    float* ng,
+    float* nm,
+    float* param,
+    float* /* param_n */, // prefetch ptr
+    float lr,
+    float momentum,
+    bool nesterov) {
+  internal::momentum_sgd_update_base_inlined(
+      N, g, m, ng, nm, param, lr, momentum, nesterov);
+}
+
+decltype(momentum_sgd_update_prefetch__base) momentum_sgd_update_prefetch__avx2_fma;
+decltype(momentum_sgd_update_prefetch__base) momentum_sgd_update_prefetch__avx512;
+void momentum_sgd_update_prefetch(
+    int N,
+    const float* g,
+    const float* m,
+    const float* m_n, // prefetch ptr
+    float* ng,
+    float* nm,
+    float* param,
+    float* param_n, // prefetch ptr
+    float lr,
+    float momentum,
+    bool nesterov) {
+  AVX512_DO(
+      momentum_sgd_update_prefetch,
+      N,
+      g,
+      m,
+      m_n,
+      ng,
+      nm,
+      param,
+      param_n,
+      lr,
+      momentum,
+      nesterov);
+  AVX2_FMA_DO(
+      momentum_sgd_update_prefetch,
+      N,
+      g,
+      m,
+      m_n,
+      ng,
+      nm,
+      param,
+      param_n,
+      lr,
+      momentum,
+      nesterov);
+  BASE_DO(
+      momentum_sgd_update_prefetch,
+      N,
+      g,
+      m,
+      m_n,
+      ng,
+      nm,
+      param,
+      param_n,
+      lr,
+      momentum,
+      nesterov);
+}
+
+void momentum_sgd_fp16_update_prefetch__base(
+    int N,
+    const float* g,
+    const at::Half* m,
+    const at::Half* /* m_n */, // prefetch ptr
+    float* ng,
+    at::Half* nm,
+    float* param,
+    float* /* param_n */, // prefetch ptr
+    float lr,
+    float momentum,
+    bool nesterov) {
+  internal::momentum_sgd_update_base_inlined(
+      N, g, m, ng, nm, param, lr, momentum, nesterov);
+}
+
+decltype(momentum_sgd_fp16_update_prefetch__base) momentum_sgd_fp16_update_prefetch__avx2_fma;
+decltype(momentum_sgd_fp16_update_prefetch__base) momentum_sgd_fp16_update_prefetch__avx512;
+void momentum_sgd_fp16_update_prefetch(
+    int N,
+    const float* g,
+    const at::Half* m,
+    const at::Half* m_n, // prefetch ptr
+    float* ng,
+    at::Half* nm,
+    float* param,
+    float* param_n, // prefetch ptr
+    float lr,
+    float momentum,
+    bool nesterov) {
+  AVX512_DO(
+      momentum_sgd_fp16_update_prefetch,
+      N,
+      g,
+      m,
+      m_n,
+      ng,
+      nm,
+      param,
+      param_n,
+      lr,
+      momentum,
+      nesterov);
+  AVX2_FMA_DO(
+      momentum_sgd_fp16_update_prefetch,
+      N,
+      g,
+      m,
+      m_n,
+      ng,
+      nm,
+      param,
+      param_n,
+      lr,
+      momentum,
+      nesterov);
+  BASE_DO(
+      momentum_sgd_fp16_update_prefetch,
+      N,
+      g,
+      m,
+      m_n,
+      ng,
+      nm,
+      param,
+      param_n,
+      lr,
+      momentum,
+      nesterov);
+}
+
+} // namespace caffe2
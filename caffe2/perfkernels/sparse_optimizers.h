@@ -0,0 +1,202 @@
+#pragma once
+
+#include <cmath>
+
+#include <c10/util/Half.h>
+
+namespace caffe2 {
+
+// Fused row updates for the sparse Adam, RMSProp and momentum SGD operators.
+// Each function updates one row of N elements in a single pass. The *_n
+// pointers point to the row that will be updated next and are only used to
+// prefetch it, like in adagrad_update_prefetch. The optimizer state (moments,
+// mean squares, momentum) can be kept in fp32 or fp16; all arithmetic is done
+// in fp32.
+
+namespace internal {
+
+// The following functions inside internal namespace are inlined because they
+// are the reference for the vectorized versions and are used for their tails.
+
+template <typename TState>
+inline void adam_update_base_inlined(
+    int N,
+    const float* w,
+    const float* g,
+    const TState* m,
+    const TState* v,
+    float* nw,
+    TState* nm,
+    TState* nv,
+    float beta1,
+    float beta2,
+    float epsilon,
+    float lr_correction) {
+  for (auto i = 0; i < N; ++i) {
+    float gi = g[i];
+    float mi = m[i] * beta1 + gi * (1 - beta1);
+    float vi = v[i] * beta2 + gi * gi * (1 - beta2);
+    nm[i] = mi;
+    nv[i] = vi;
+    nw[i] = w[i] + lr_correction * mi / (std::sqrt(vi) + epsilon);
+  }
+}
+
+template <typename TState>
+inline void rmsprop_update_base_inlined(
+    int N,
+    const float* g,
+    const TState* ms,
+    const TState* mom,
+    float* ng,
+    TState* nms,
+    TState* nmom,
+    float decay,
+    float momentum,
+    float epsilon,
+    float lr) {
+  for (auto i = 0; i < N; ++i) {
+    float gi = g[i];
+    float msi = ms[i] + (1.0f - decay) * (gi * gi - ms[i]);
+    float momi = mom[i] * momentum + lr * gi / std::sqrt(epsilon + msi);
+    nms[i] = msi;
+    nmom[i] = momi;
+    ng[i] = momi;
+  }
+}
+
+template <typename TState>
+inline void momentum_sgd_update_base_inlined(
+    int N,
+    const float* g,
+    const TState* m,
+    float* ng,
+    TState* nm,
+    float* param,
+    float lr,
+    float momentum,
+    bool nesterov) {
+  for (auto i = 0; i < N; ++i) {
+    float ngi;
+    if (!nesterov) {
+      ngi = lr * g[i] + momentum * m[i];
+      nm[i] = ngi;
+    } else {
+      const float mi = m[i];
+      const float mi_new = momentum * mi + lr * g[i];
+      nm[i] = mi_new;
+      ngi = (1 + momentum) * mi_new - momentum * mi;
+    }
+    ng[i] = ngi;
+    if (param) {
+      param[i] -= ngi;
+    }
+  }
+}
+
+} // namespace internal
+
+// Adam, with lr_correction = lr * sqrt(1 - beta2^t) / (1 - beta1^t):
+//   nm = beta1 * m + (1 - beta1) * g
+//   nv = beta2 * v + (1 - beta2) * g^2
+//   nw = w + lr_correction * nm / (sqrt(nv) + epsilon)
+void adam_update_prefetch(
+    int N,
+    const float* w,
+    const float* w_n, // prefetch ptr
+    const float* g,
+    const float* m,
+    const float* m_n, // prefetch ptr
+    const float* v,
+    const float* v_n, // prefetch ptr
+    float* nw,
+    float* nm,
+    float* nv,
+    float beta1,
+    float beta2,
+    float epsilon,
+    float lr_correction);
+
+// Same as above with the moments stored in fp16
+void adam_fp16_update_prefetch(
+    int N,
+    const float* w,
+    const float* w_n, // prefetch ptr
+    const float* g,
+    const at::Half* m,
+    const at::Half* m_n, // prefetch ptr
+    const at::Half* v,
+    const at::Half* v_n, // prefetch ptr
+    float* nw,
+    at::Half* nm,
+    at::Half* nv,
+    float beta1,
+    float beta2,
+    float epsilon,
+    float lr_correction);
+
+// RMSProp, as computed by the RmsProp operator:
+//   nms = ms + (1 - decay) * (g^2 - ms)
+//   nmom = momentum * mom + lr * g / sqrt(epsilon + nms)
+//   ng = nmom
+void rmsprop_update_prefetch(
+    int N,
+    const float* g,
+    const float* ms,
+    const float* ms_n, // prefetch ptr
+    const float* mom,
+    const float* mom_n, // prefetch ptr
+    float* ng,
+    float* nms,
+    float* nmom,
+    float decay,
+    float momentum,
+    float epsilon,
+    float lr);
+
+// Same as above with the mean squares and momentum stored in fp16
+void rmsprop_fp16_update_prefetch(
+    int N,
+    const float* g,
+    const at::Half* ms,
+    const at::Half* ms_n, // prefetch ptr
+    const at::Half* mom,
+    const at::Half* mom_n, // prefetch ptr
+    float* ng,
+    at::Half* nms,
+    at::Half* nmom,
+    float decay,
+    float momentum,
+    float epsilon,
+    float lr);
+
+// Momentum SGD, as computed by the MomentumSGDUpdate operator. param and
+// param_n may be null, in which case only ng and nm are written.
+void momentum_sgd_update_prefetch(
+    int N,
+    const float* g,
+    const float* m,
+    const float* m_n, // prefetch ptr
+    float* ng,
+    float* nm,
+    float* param,
+    float* param_n, // prefetch ptr
+    float lr,
+    float momentum,
+    bool nesterov);
+
+// Same as above with the momentum stored in fp16
+void momentum_sgd_fp16_update_prefetch(
+    int N,
+    const float* g,
+    const at::Half* m,
+    const at::Half* m_n, // prefetch ptr
+    float* ng,
+    at::Half* nm,
+    float* param,
+    float* param_n, // prefetch ptr
+    float lr,
+    float momentum,
+    bool nesterov);
+
+} // namespace caffe2
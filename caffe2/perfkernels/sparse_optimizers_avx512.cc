@@ -0,0 +1,316 @@
+#include "caffe2/perfkernels/sparse_optimizers.h"
+
+#include <emmintrin.h>
+#include <immintrin.h>
+
+namespace caffe2 {
+
+namespace {
+
+constexpr int kSize = 16;
+
+inline __m512 load16(const float* p) {
+  return _mm512_loadu_ps(p);
+}
+
+inline __m512 load16(const at::Half* p) {
+  return _mm512_cvtph_ps(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+}
+
+inline void store16(float* p, __m512 v) {
+  _mm512_storeu_ps(p, v);
+}
+
+inline void store16(at::Half* p, __m512 v) {
+  _mm256_storeu_si256(
+      reinterpret_cast<__m256i*>(p), _mm512_cvtps_ph(v, 0));
+}
+
+// Prefetch one vector worth of elements, i.e. one cache line for fp32 and half
+// of one for fp16 rows.
+template <typename T>
+inline void prefetch16(const T* p) {
+  _mm_prefetch(reinterpret_cast<const char*>(p), _MM_HINT_T0);
+}
+
+template <typename TState>
+void adam_update_prefetch_avx512(
+    int N,
+    const float* w,
+    const float* w_n,
+    const float* g,
+    const TState* m,
+    const TState* m_n,
+    const TState* v,
+    const TState* v_n,
+    float* nw,
+    TState* nm,
+    TState* nv,
+    float beta1,
+    float beta2,
+    float epsilon,
+    float lr_correction) {
+  const __m512 beta1_v = _mm512_set1_ps(beta1);
+  const __m512 one_minus_beta1_v = _mm512_set1_ps(1.0f - beta1);
+  const __m512 beta2_v = _mm512_set1_ps(beta2);
+  const __m512 one_minus_beta2_v = _mm512_set1_ps(1.0f - beta2);
+  const __m512 epsilon_v = _mm512_set1_ps(epsilon);
+  const __m512 lr_correction_v = _mm512_set1_ps(lr_correction);
+  int i = 0;
+  for (; i + kSize <= N; i += kSize) {
+    prefetch16(w_n + i);
+    prefetch16(m_n + i);
+    prefetch16(v_n + i);
+
+    __m512 gi = _mm512_loadu_ps(g + i);
+    __m512 mi = _mm512_fmadd_ps(
+        beta1_v, load16(m + i), _mm512_mul_ps(one_minus_beta1_v, gi));
+    __m512 vi = _mm512_fmadd_ps(
+        beta2_v,
+        load16(v + i),
+        _mm512_mul_ps(one_minus_beta2_v, _mm512_mul_ps(gi, gi)));
+    store16(nm + i, mi);
+    store16(nv + i, vi);
+    __m512 wi = _mm512_fmadd_ps(
+        lr_correction_v,
+        _mm512_div_ps(mi, _mm512_add_ps(_mm512_sqrt_ps(vi), epsilon_v)),
+        _mm512_loadu_ps(w + i));
+    _mm512_storeu_ps(nw + i, wi);
+  }
+  internal::adam_update_base_inlined(
+      N - i,
+      w + i,
+      g + i,
+      m + i,
+      v + i,
+      nw + i,
+      nm + i,
+      nv + i,
+      beta1,
+      beta2,
+      epsilon,
+      lr_correction);
+}
+
+template <typename TState>
+void rmsprop_update_prefetch_avx512(
+    int N,
+    const float* g,
+    const TState* ms,
+    const TState* ms_n,
+    const TState* mom,
+    const TState* mom_n,
+    float* ng,
+    TState* nms,
+    TState* nmom,
+    float decay,
+    float momentum,
+    float epsilon,
+    float lr) {
+  const __m512 one_minus_decay_v = _mm512_set1_ps(1.0f - decay);
+  const __m512 momentum_v = _mm512_set1_ps(momentum);
+  const __m512 epsilon_v = _mm512_set1_ps(epsilon);
+  const __m512 lr_v = _mm512_set1_ps(lr);
+  int i = 0;
+  for (; i + kSize <= N; i += kSize) {
+    prefetch16(ms_n + i);
+    prefetch16(mom_n + i);
+
+    __m512 gi = _mm512_loadu_ps(g + i);
+    __m512 msi = load16(ms + i);
+    msi = _mm512_fmadd_ps(
+        one_minus_decay_v, _mm512_fmsub_ps(gi, gi, msi), msi);
+    store16(nms + i, msi);
+    __m512 momi = _mm512_fmadd_ps(
+        momentum_v,
+        load16(mom + i),
+        _mm512_div_ps(
+            _mm512_mul_ps(lr_v, gi),
+            _mm512_sqrt_ps(_mm512_add_ps(epsilon_v, msi))));
+    store16(nmom + i, momi);
+    _mm512_storeu_ps(ng + i, momi);
+  }
+  internal::rmsprop_update_base_inlined(
+      N - i,
+      g + i,
+      ms + i,
+      mom + i,
+      ng + i,
+      nms + i,
+      nmom + i,
+      decay,
+      momentum,
+      epsilon,
+      lr);
+}
+
+template <typename TState>
+void momentum_sgd_update_prefetch_avx512(
+    int N,
+    const float* g,
+    const TState* m,
+    const TState* m_n,
+    float* ng,
+    TState* nm,
+    float* param,
+    float* param_n,
+    float lr,
+    float momentum,
+    bool nesterov) {
+  const __m512 lr_v = _mm512_set1_ps(lr);
+  const __m512 momentum_v = _mm512_set1_ps(momentum);
+  const __m512 one_plus_momentum_v = _mm512_set1_ps(1.0f + momentum);
+  int i = 0;
+  for (; i + kSize <= N; i += kSize) {
+    prefetch16(m_n + i);
+    if (param_n) {
+      prefetch16(param_n + i);
+    }
+
+    __m512 gi = _mm512_loadu_ps(g + i);
+    __m512 mi = load16(m + i);
+    __m512 ngi;
+    if (!nesterov) {
+      ngi = _mm512_fmadd_ps(momentum_v, mi, _mm512_mul_ps(lr_v, gi));
+      store16(nm + i, ngi);
+    } else {
+      __m512 mi_new =
+          _mm512_fmadd_ps(momentum_v, mi, _mm512_mul_ps(lr_v, gi));
+      store16(nm + i, mi_new);
+      ngi = _mm512_fmsub_ps(
+          one_plus_momentum_v, mi_new, _mm512_mul_ps(momentum_v, mi));
+    }
+    _mm512_storeu_ps(ng + i, ngi);
+    if (param) {
+      _mm512_storeu_ps(
+          param + i, _mm512_sub_ps(_mm512_loadu_ps(param + i), ngi));
+    }
+  }
+  internal::momentum_sgd_update_base_inlined(
+      N - i,
+      g + i,
+      m + i,
+      ng + i,
+      nm + i,
+      param ? param + i : nullptr,
+      lr,
+      momentum,
+      nesterov);
+}
+
+} // namespace
+
+void adam_update_prefetch__avx512(
+    int N,
+    const float* w,
+    const float* w_n, // prefetch ptr
+    const float* g,
+    const float* m,
+    const float* m_n, // prefetch ptr
+    const float* v,
+    const float* v_n, // prefetch ptr
+    float* nw,
+    float* nm,
+    float* nv,
+    float beta1,
+    float beta2,
+    float epsilon,
+    float lr_correction) {
+  adam_update_prefetch_avx512(
+      N, w, w_n, g, m, m_n, v, v_n, nw, nm, nv, beta1, beta2, epsilon,
+      lr_correction);
+}
+
+void adam_fp16_update_prefetch__avx512(
+    int N,
+    const float* w,
+    const float* w_n, // prefetch ptr
+    const float* g,
+    const at::Half* m,
+    const at::Half* m_n, // prefetch ptr
+    const at::Half* v,
+    const at::Half* v_n, // prefetch ptr
+    float* nw,
+    at::Half* nm,
+    at::Half* nv,
+    float beta1,
+    float beta2,
+    float epsilon,
+    float lr_correction) {
+  adam_update_prefetch_avx512(
+      N, w, w_n, g, m, m_n, v, v_n, nw, nm, nv, beta1, beta2, epsilon,
+      lr_correction);
+}
+
+void rmsprop_update_prefetch__avx512(
+    int N,
+    const float* g,
+    const float* ms,
+    const float* ms_n, // prefetch ptr
+    const float* mom,
+    const float* mom_n, // prefetch ptr
+    float* ng,
+    float* nms,
+    float* nmom,
+    float decay,
+    float momentum,
+    float epsilon,
+    float lr) {
+  rmsprop_update_prefetch_avx512(
+      N, g, ms, ms_n, mom, mom_n, ng, nms, nmom, decay, momentum, epsilon,
+      lr);
+}
+
+void rmsprop_fp16_update_prefetch__avx512(
+    int N,
+    const float* g,
+    const at::Half* ms,
+    const at::Half* ms_n, // prefetch ptr
+    const at::Half* mom,
+    const at::Half* mom_n, // prefetch ptr
+    float* ng,
+    at::Half* nms,
+    at::Half* nmom,
+    float decay,
+    float momentum,
+    float epsilon,
+    float lr) {
+  rmsprop_update_prefetch_avx512(
+      N, g, ms, ms_n, mom, mom_n, ng, nms, nmom, decay, momentum, epsilon,
+      lr);
+}
+
+void momentum_sgd_update_prefetch__avx512(
+    int N,
+    const float* g,
+    const float* m,
+    const float* m_n, // prefetch ptr
+    float* ng,
+    float* nm,
+    float* param,
+    float* param_n, // prefetch ptr
+    float lr,
+    float momentum,
+    bool nesterov) {
+  momentum_sgd_update_prefetch_avx512(
+      N, g, m, m_n, ng, nm, param, param_n, lr, momentum, nesterov);
+}
+
+void momentum_sgd_fp16_update_prefetch__avx512(
+    int N,
+    const float* g,
+    const at::Half* m,
+    const at::Half* m_n, // prefetch ptr
+    float* ng,
+    at::Half* nm,
+    float* param,
+    float* param_n, // prefetch ptr
+    float lr,
+    float momentum,
+    bool nesterov) {
+  momentum_sgd_update_prefetch_avx512(
+      N, g, m, m_n, ng, nm, param, param_n, lr, momentum, nesterov);
+}
+
+} // namespace caffe2
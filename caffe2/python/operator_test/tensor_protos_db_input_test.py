@@ -0,0 +1,102 @@
+import os
+import shutil
+import tempfile
+
+import numpy as np
+
+import caffe2.proto.caffe2_pb2 as caffe2_pb2
+from caffe2.python import core, workspace, test_util
+
+
+class TensorProtosDBInputTest(test_util.TestCase):
+    def setUp(self):
+        super(TensorProtosDBInputTest, self).setUp()
+        self.tmp_dir = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.tmp_dir)
+        super(TensorProtosDBInputTest, self).tearDown()
+
+    def _tensor_protos(self, idx, num_values=3, label_type=core.DataType.INT32):
+        item = caffe2_pb2.TensorProtos()
+        data = item.protos.add()
+        data.data_type = core.DataType.FLOAT
+        data.dims.append(num_values)
+        data.float_data.extend(float(idx * 10 + j) for j in range(num_values))
+        label = item.protos.add()
+        label.data_type = label_type
+        if label_type == core.DataType.INT32:
+            label.int32_data.append(idx)
+        else:
+            label.float_data.append(float(idx))
+        return item.SerializeToString()
+
+    def _write_db(self, name, records):
+        path = os.path.join(self.tmp_dir, name)
+        db = workspace.C.create_db("minidb", path, workspace.C.Mode.write)
+        for i, record in enumerate(records):
+            transaction = db.new_transaction()
+            transaction.put("key{:05d}".format(i).encode("ascii"), record)
+            del transaction
+        del db
+        return path
+
+    def _read_batches(self, path, batch_size, num_batches, **kwargs):
+        workspace.ResetWorkspace()
+        workspace.RunOperatorOnce(core.CreateOperator(
+            "CreateDB", [], ["reader"], db=path, db_type="minidb"))
+        net = core.Net("read")
+        net.TensorProtosDBInput(
+            ["reader"], ["data", "label"], batch_size=batch_size, **kwargs)
+        workspace.CreateNet(net)
+        batches = []
+        for _ in range(num_batches):
+            workspace.RunNet(net)
+            batches.append(
+                (workspace.FetchBlob("data"), workspace.FetchBlob("label")))
+        return batches
+
+    def test_parallel_decode_matches_serial(self):
+        batch_size = 16
+        num_batches = 5
+        path = self._write_db(
+            "db", [self._tensor_protos(i) for i in range(batch_size * num_batches)])
+        serial = self._read_batches(path, batch_size, num_batches)
+        parallel = self._read_batches(
+            path, batch_size, num_batches, decode_threads=4)
+        for i, ((data, label), (p_data, p_label)) in enumerate(
+                zip(serial, parallel)):
+            self.assertEqual(data.shape, (batch_size, 3))
+            np.testing.assert_array_equal(
+                label, np.arange(i * batch_size, (i + 1) * batch_size))
+            np.testing.assert_array_equal(data, p_data)
+            np.testing.assert_array_equal(label, p_label)
+            self.assertEqual(label.dtype, p_label.dtype)
+
+    def _check_decode_error(self, bad_record, message):
+        batch_size = 8
+        records = [self._tensor_protos(i) for i in range(batch_size)]
+        # Past item 0, so that it is decoded on the thread pool.
+        records[5] = bad_record
+        path = self._write_db("bad_db", records)
+        with self.assertRaisesRegex(RuntimeError, message):
+            self._read_batches(
+                path, batch_size, 1, decode_threads=4, no_prefetch=True)
+        # On the prefetch thread, the failure makes the op fail.
+        with self.assertRaises(RuntimeError):
+            self._read_batches(path, batch_size, 1, decode_threads=4)
+
+    def test_parallel_decode_shape_mismatch(self):
+        self._check_decode_error(
+            self._tensor_protos(5, num_values=4),
+            "All records of a batch need to have the same shapes.")
+
+    def test_parallel_decode_dtype_mismatch(self):
+        self._check_decode_error(
+            self._tensor_protos(5, label_type=core.DataType.FLOAT),
+            "All records of a batch need to have the same data types.")
+
+
+if __name__ == "__main__":
+    import unittest
+    unittest.main()
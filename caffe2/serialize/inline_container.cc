@@ -5,6 +5,8 @@
 #include <ostream>
 #include <fstream>
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 #include <c10/core/Allocator.h>
 #include <c10/core/CPUAllocator.h>
@@ -271,6 +273,80 @@ size_t PyTorchStreamReader::getRecordOffset(const std::string& name) {
 }
 
 
+std::function<size_t(char*, size_t)> PyTorchStreamReader::getRecordReader(
+    const std::string& name,
+    size_t chunk_size) {
+  TORCH_CHECK(chunk_size > 0, "record read chunk size must be positive");
+  mz_zip_archive_file_stat stat;
+  {
+    std::lock_guard<std::mutex> guard(reader_lock_);
+    mz_zip_reader_file_stat(ar_.get(), getRecordID(name), &stat);
+    valid("retrieving file meta-data for ", name.c_str());
+  }
+
+  if (stat.m_method != 0 || stat.m_comp_size != stat.m_uncomp_size) {
+    // Compressed records have to be inflated as a whole.
+    auto record = std::make_shared<at::DataPtr>();
+    size_t record_size;
+    std::tie(*record, record_size) = getRecord(name);
+    size_t pos = 0;
+    return [record, record_size, pos](char* buf, size_t n) mutable -> size_t {
+      n = std::min(n, record_size - pos);
+      memcpy(buf, static_cast<const char*>(record->get()) + pos, n);
+      pos += n;
+      return n;
+    };
+  }
+
+  struct ChunkState {
+    std::vector<char> buffer;
+    size_t buffer_pos = 0;
+    size_t buffer_end = 0;
+    uint64_t file_pos = 0;
+    uint64_t remaining = 0;
+  };
+  auto state = std::make_shared<ChunkState>();
+  state->buffer.resize(std::min<uint64_t>(chunk_size, stat.m_uncomp_size));
+  state->file_pos = getRecordOffset(name);
+  state->remaining = stat.m_uncomp_size;
+
+  return [this, state](char* buf, size_t n) -> size_t {
+    size_t copied = 0;
+    while (copied < n) {
+      if (state->buffer_pos == state->buffer_end) {
+        if (state->remaining == 0) {
+          break;
+        }
+        size_t want = n - copied;
+        // Large reads bypass the staging buffer entirely.
+        bool direct = want >= state->buffer.size();
+        if (!direct) {
+          want = state->buffer.size();
+        }
+        want = std::min<uint64_t>(want, state->remaining);
+        char* dst = direct ? buf + copied : state->buffer.data();
+        {
+          std::lock_guard<std::mutex> guard(reader_lock_);
+          in_->read(state->file_pos, dst, want, "reading record chunk");
+        }
+        state->file_pos += want;
+        state->remaining -= want;
+        if (direct) {
+          copied += want;
+          continue;
+        }
+        state->buffer_pos = 0;
+        state->buffer_end = want;
+      }
+      size_t len = std::min(n - copied, state->buffer_end - state->buffer_pos);
+      memcpy(buf + copied, state->buffer.data() + state->buffer_pos, len);
+      state->buffer_pos += len;
+      copied += len;
+    }
+    return copied;
+  };
+}
+
 PyTorchStreamReader::~PyTorchStreamReader() {
   mz_zip_clear_last_error(ar_.get());
   mz_zip_reader_end(ar_.get());
@@ -294,6 +370,13 @@ size_t ostream_write_func(
   return ret;
 }
 
+struct PyTorchStreamWriter::StreamingRecord {
+  mz_zip_writer_stream_state state;
+  std::string name;
+  std::string full_name;
+  std::vector<char> buffer;
+};
+
 PyTorchStreamWriter::PyTorchStreamWriter(std::string file_name)
     : archive_name_(basename(file_name)) {
   setup(file_name);
@@ -344,6 +427,13 @@ void PyTorchStreamWriter::writeRecord(
     bool compress) {
   AT_ASSERT(!finalized_);
   AT_ASSERT(!archive_name_plus_slash_.empty());
+  TORCH_CHECK(
+      !streaming_record_,
+      "cannot write record ",
+      name,
+      " while record ",
+      streaming_record_ ? streaming_record_->name : "",
+      " is still being written");
   std::string full_name = archive_name_plus_slash_ + name;
   size_t padding_size =
       detail::getPadding(ar_->m_archive_size, full_name.size(), size, padding_);
@@ -367,7 +457,106 @@ void PyTorchStreamWriter::writeRecord(
   files_written.push_back(name);
 }
 
+void PyTorchStreamWriter::startRecord(const std::string& name) {
+  AT_ASSERT(!finalized_);
+  AT_ASSERT(!archive_name_plus_slash_.empty());
+  TORCH_CHECK(
+      !streaming_record_,
+      "cannot start record ",
+      name,
+      " while record ",
+      streaming_record_ ? streaming_record_->name : "",
+      " is still being written");
+  auto record = std::make_unique<StreamingRecord>();
+  record->name = name;
+  record->full_name = archive_name_plus_slash_ + name;
+  record->buffer.reserve(detail::kStreamChunkSize);
+  // The final size is unknown, so the local header always carries the zip64
+  // sizes, as for a record of at least 4GB.
+  size_t padding_size = detail::getPadding(
+      ar_->m_archive_size, record->full_name.size(), MZ_UINT32_MAX, padding_);
+  mz_zip_writer_add_stream_begin(
+      ar_.get(),
+      &record->state,
+      record->full_name.c_str(),
+      0,
+      padding_.c_str(),
+      padding_size);
+  valid("starting file ", name.c_str());
+  streaming_record_ = std::move(record);
+}
+
+void PyTorchStreamWriter::writeRecordChunk(const void* data, size_t size) {
+  TORCH_CHECK(streaming_record_, "writeRecordChunk called without startRecord");
+  auto& buffer = streaming_record_->buffer;
+  const char* bytes = static_cast<const char*>(data);
+  while (size > 0) {
+    if (buffer.empty() && size >= detail::kStreamChunkSize) {
+      // Nothing staged, hand full chunks straight to the archive.
+      size_t len = size - size % detail::kStreamChunkSize;
+      mz_zip_writer_add_stream_write(
+          ar_.get(), &streaming_record_->state, bytes, len);
+      valid("writing file ", streaming_record_->name.c_str());
+      bytes += len;
+      size -= len;
+      continue;
+    }
+    size_t len = std::min(size, detail::kStreamChunkSize - buffer.size());
+    buffer.insert(buffer.end(), bytes, bytes + len);
+    bytes += len;
+    size -= len;
+    if (buffer.size() == detail::kStreamChunkSize) {
+      flushStreamingRecord();
+    }
+  }
+}
+
+void PyTorchStreamWriter::flushStreamingRecord() {
+  auto& buffer = streaming_record_->buffer;
+  mz_zip_writer_add_stream_write(
+      ar_.get(), &streaming_record_->state, buffer.data(), buffer.size());
+  valid("writing file ", streaming_record_->name.c_str());
+  buffer.clear();
+}
+
+void PyTorchStreamWriter::endRecord() {
+  TORCH_CHECK(streaming_record_, "endRecord called without startRecord");
+  flushStreamingRecord();
+  mz_zip_writer_add_stream_end(
+      ar_.get(),
+      &streaming_record_->state,
+      streaming_record_->full_name.c_str(),
+      nullptr,
+      0);
+  // the record stays open on failure, so that the archive is not finalized
+  valid("writing file ", streaming_record_->name.c_str());
+  files_written.push_back(streaming_record_->name);
+  streaming_record_.reset();
+}
+
+void PyTorchStreamWriter::abandonArchive() {
+  finalized_ = true;
+  streaming_record_.reset();
+  mz_zip_writer_end(ar_.get());
+  if (file_stream_.is_open()) {
+    file_stream_.close();
+  }
+}
+
 void PyTorchStreamWriter::writeEndOfFile() {
+  // A record left open means that its producer or the archive failed midway.
+  // The archive is left without a central directory, so that it fails to
+  // load, rather than finalized with a truncated record.
+  if (streaming_record_) {
+    std::string name = streaming_record_->name;
+    abandonArchive();
+    CAFFE_THROW(
+        "PytorchStreamWriter failed writing file ",
+        name,
+        ": the record was not completed, archive ",
+        archive_name_,
+        " was not finalized.");
+  }
   // Rewrites version info
   std::string version = c10::to_string(version_);
   version.push_back('\n');
@@ -404,7 +593,10 @@ void PyTorchStreamWriter::valid(const char* what, const char* info) {
 }
 
 PyTorchStreamWriter::~PyTorchStreamWriter() {
-  if (!finalized_) {
+  if (streaming_record_) {
+    // unwinding from a failed record
+    abandonArchive();
+  } else if (!finalized_) {
     writeEndOfFile();
   }
 }
@@ -4,6 +4,7 @@
 #include <cstdio>
 #include <cstring>
 #include <fstream>
+#include <functional>
 #include <istream>
 #include <mutex>
 #include <ostream>
@@ -92,6 +93,12 @@ typedef struct mz_zip_archive mz_zip_archive;
 namespace caffe2 {
 namespace serialize {
 
+namespace detail {
+// Size of the staging buffers used by the streaming record APIs.
+constexpr size_t kStreamChunkSize = 64 * 1024;
+constexpr size_t kRecordReadChunkSize = 64 * 1024;
+} // namespace detail
+
 class TORCH_API PyTorchStreamReader final {
  public:
   explicit PyTorchStreamReader(const std::string& file_name);
@@ -101,6 +108,15 @@ class TORCH_API PyTorchStreamReader final {
   // return dataptr, size
   std::tuple<at::DataPtr, size_t> getRecord(const std::string& name);
   size_t getRecordOffset(const std::string& name);
+  // Returns a callback that reads the record sequentially, copying at most the
+  // requested number of bytes per call and returning 0 at the end of the
+  // record. Stored (uncompressed) records are fetched from the underlying
+  // ReadAdapterInterface in chunk_size pieces, so the record is never fully
+  // resident in memory; compressed records fall back to getRecord(). The
+  // callback must not outlive this reader.
+  std::function<size_t(char*, size_t)> getRecordReader(
+      const std::string& name,
+      size_t chunk_size = detail::kRecordReadChunkSize);
   bool hasRecord(const std::string& name);
   std::vector<std::string> getAllRecords();
 
@@ -138,6 +154,21 @@ class TORCH_API PyTorchStreamWriter final {
       const void* data,
       size_t size,
       bool compress = false);
+
+  // Streaming variant of writeRecord() for records whose size is not known up
+  // front, e.g. a pickle that is still being produced. Data passed to
+  // writeRecordChunk() is staged in a kStreamChunkSize buffer and flushed to
+  // the archive one chunk at a time, so the record never has to be
+  // materialized in memory. Streamed records are always stored uncompressed
+  // and 64 byte aligned, and no other record may be written between
+  // startRecord() and endRecord(). If a record is not ended, e.g. because
+  // its producer threw, the archive is not finalized and fails to load.
+  // Readers go through the central directory, so streamed records read back
+  // like any other.
+  void startRecord(const std::string& name);
+  void writeRecordChunk(const void* data, size_t size);
+  void endRecord();
+
   void writeEndOfFile();
 
   const std::vector<std::string>& getAllWrittenRecords();
@@ -153,9 +184,14 @@ class TORCH_API PyTorchStreamWriter final {
   ~PyTorchStreamWriter();
 
  private:
+  struct StreamingRecord;
+
   void setup(const std::string& file_name);
   void valid(const char* what, const char* info = "");
+  void flushStreamingRecord();
+  void abandonArchive();
   size_t current_pos_ = 0;
+  std::unique_ptr<StreamingRecord> streaming_record_;
   std::vector<std::string> files_written;
   std::unique_ptr<mz_zip_archive> ar_;
   std::string archive_name_;
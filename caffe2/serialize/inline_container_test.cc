@@ -1,6 +1,7 @@
 #include <cstdio>
 #include <string>
 #include <array>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -68,6 +69,89 @@ TEST(PyTorchStreamWriterAndReader, SaveAndLoad) {
   ASSERT_EQ(memcmp(the_file.c_str() + off2, data2.data(), data2.size()), 0);
 }
 
+TEST(PyTorchStreamWriterAndReader, StreamingRecord) {
+  int64_t kFieldAlignment = 64L;
+
+  std::ostringstream oss;
+  PyTorchStreamWriter writer([&](const void* b, size_t n) -> size_t {
+    oss.write(static_cast<const char*>(b), n);
+    return oss ? n : 0;
+  });
+  std::array<char, 3> data1 = {1, 2, 3};
+  writer.writeRecord("key1", data1.data(), data1.size());
+
+  // Larger than a single staging chunk, fed in uneven pieces.
+  std::vector<char> data2(3 * detail::kStreamChunkSize + 17);
+  for (size_t i = 0; i < data2.size(); ++i) {
+    data2[i] = static_cast<char>(i * 7);
+  }
+  writer.startRecord("streamed");
+  size_t pos = 0;
+  for (size_t step :
+       std::vector<size_t>{1, 255, 2 * detail::kStreamChunkSize, 4096}) {
+    step = std::min(step, data2.size() - pos);
+    writer.writeRecordChunk(data2.data() + pos, step);
+    pos += step;
+  }
+  writer.writeRecordChunk(data2.data() + pos, data2.size() - pos);
+  ASSERT_ANY_THROW(writer.writeRecord("key2", data1.data(), data1.size()));
+  writer.endRecord();
+  writer.writeRecord("key2", data1.data(), data1.size());
+
+  const std::vector<std::string>& written_records = writer.getAllWrittenRecords();
+  ASSERT_EQ(written_records[1], "streamed");
+  writer.writeEndOfFile();
+
+  std::string the_file = oss.str();
+  std::istringstream iss(the_file);
+  PyTorchStreamReader reader(&iss);
+  at::DataPtr data_ptr;
+  int64_t size;
+  std::tie(data_ptr, size) = reader.getRecord("streamed");
+  ASSERT_EQ(size, data2.size());
+  ASSERT_EQ(memcmp(data_ptr.get(), data2.data(), data2.size()), 0);
+  size_t off = reader.getRecordOffset("streamed");
+  ASSERT_EQ(off % kFieldAlignment, 0);
+  ASSERT_EQ(memcmp(the_file.c_str() + off, data2.data(), data2.size()), 0);
+
+  // Read it back incrementally, mixing reads smaller and larger than the chunk.
+  auto record_reader = reader.getRecordReader("streamed", 1024);
+  std::vector<char> read_back;
+  std::vector<char> buf(3000);
+  size_t request = 1;
+  while (size_t n = record_reader(buf.data(), request)) {
+    read_back.insert(read_back.end(), buf.data(), buf.data() + n);
+    request = (request + 997) % buf.size() + 1;
+  }
+  ASSERT_EQ(read_back, data2);
+
+  std::tie(data_ptr, size) = reader.getRecord("key2");
+  ASSERT_EQ(size, data1.size());
+  ASSERT_EQ(memcmp(data_ptr.get(), data1.data(), data1.size()), 0);
+}
+
+TEST(PyTorchStreamWriterAndReader, UnfinishedStreamingRecord) {
+  std::ostringstream oss;
+  {
+    PyTorchStreamWriter writer([&](const void* b, size_t n) -> size_t {
+      oss.write(static_cast<const char*>(b), n);
+      return oss ? n : 0;
+    });
+    std::array<char, 3> data1 = {1, 2, 3};
+    writer.writeRecord("key1", data1.data(), data1.size());
+    writer.startRecord("streamed");
+    writer.writeRecordChunk(data1.data(), data1.size());
+    // The producer of the record failed before endRecord()
+    ASSERT_ANY_THROW(writer.writeEndOfFile());
+    ASSERT_TRUE(writer.finalized());
+  }
+
+  // Without a central directory the archive is rejected instead of reading
+  // back a truncated record.
+  std::istringstream iss(oss.str());
+  ASSERT_ANY_THROW(PyTorchStreamReader reader(&iss));
+}
+
 } // namespace
 } // namespace serialize
 } // namespace caffe2
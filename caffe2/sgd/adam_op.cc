@@ -69,11 +69,13 @@ OPERATOR_SCHEMA(SparseAdam)
     Adam on (param, moment1[indices], momemnt2[indices], lr, iter) and returns
     (new_param, new_moment1, new_moment2) as in dense case.
     Adam can be customized as Rectified Adam (RAdam) by setting enableRAdam = true.
+    On CPU, both moments can be stored in float16, except with RAdam or the
+    output gradient.
 
     )DOC")
     .Input(0, "param", "Parameters to be updated")
-    .Input(1, "moment_1", "First moment history")
-    .Input(2, "moment_2", "Second moment history")
+    .Input(1, "moment_1", "First moment history, float or float16")
+    .Input(2, "moment_2", "Second moment history, float or float16")
     .Input(3, "indices", "Sparse indices")
     .Input(4, "grad", "Gradient computed")
     .Input(5, "lr", "learning rate")
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "caffe2/core/operator.h"
+#include "caffe2/perfkernels/sparse_optimizers.h"
 
 namespace caffe2 {
 
@@ -277,10 +278,82 @@ class SparseAdamOp final : public Operator<Context> {
         Input(GRAD).size_from_dim(Input(INDICES).dim()));
     CAFFE_ENFORCE_EQ(Input(LR).numel(), 1);
 
+    if (Input(MOMENT_1).template IsType<at::Half>()) {
+      CAFFE_ENFORCE(
+          Input(MOMENT_2).template IsType<at::Half>(),
+          "Both moments must be float16, or neither");
+      CAFFE_ENFORCE(
+          (std::is_same<Context, CPUContext>::value),
+          "float16 moments are only supported on CPU");
+      CAFFE_ENFORCE(
+          !enableRAdam_ && OutputSize() == 3,
+          "float16 moments do not support RAdam or the output gradient");
+      return DispatchHelper<TensorTypes2<int32_t, int64_t>, at::Half>::call(
+          this, Input(INDICES));
+    }
     return DispatchHelper<TensorTypes<int32_t, int64_t>>::call(
         this, Input(INDICES));
   }
 
+  // Adam with the moments stored in TMoment (float16), which halves their
+  // memory while the arithmetic is still done in fp32.
+  template <typename TMoment, typename SIndex>
+  bool DoRunWithType2() {
+    const auto* lr = Input(LR).template data<T>();
+    const auto iter =
+        OperatorBase::Input<Tensor>(ITER, CPU).template data<int64_t>()[0];
+
+    const auto t = iter + 1;
+    const auto beta1_correction = T(1.) / (T(1.) - std::pow(beta1_, t));
+    const auto beta2_correction =
+        T(1.) / std::sqrt(T(1.) - std::pow(beta2_, t));
+    const auto correction = beta1_correction / beta2_correction;
+
+    auto block_size = Input(PARAM).numel() / Input(PARAM).size(0);
+    auto n = Input(GRAD).numel() / block_size;
+
+    const auto* paramIn = Input(PARAM).template data<T>();
+    const auto* indices = Input(INDICES).template data<SIndex>();
+    const auto* gradIn = Input(GRAD).template data<T>();
+    const auto* moment1In = Input(MOMENT_1).template data<TMoment>();
+    const auto* moment2In = Input(MOMENT_2).template data<TMoment>();
+    auto* paramOut = Output(OUTPUT_PARAM)->template mutable_data<T>();
+    auto* moment1Out =
+        Output(OUTPUT_MOMENT_1)->template mutable_data<TMoment>();
+    auto* moment2Out =
+        Output(OUTPUT_MOMENT_2)->template mutable_data<TMoment>();
+
+    for (auto i = 0; i < n; ++i) {
+      auto idx = indices[i];
+      auto offsetI = i * block_size;
+      auto offsetIdx = idx * block_size;
+
+      CAFFE_ENFORCE(offsetIdx + block_size <= Input(PARAM).numel());
+      CAFFE_ENFORCE(offsetI + block_size <= Input(GRAD).numel());
+
+      constexpr auto prefdist_T0 = 16;
+      auto i_pref = (i < n - prefdist_T0) ? i + prefdist_T0 : i;
+      auto offsetIdx_pref = indices[i_pref] * block_size;
+      adam_fp16_update_prefetch(
+          block_size,
+          paramIn + offsetIdx,
+          paramIn + offsetIdx_pref,
+          gradIn + offsetI,
+          moment1In + offsetIdx,
+          moment1In + offsetIdx_pref,
+          moment2In + offsetIdx,
+          moment2In + offsetIdx_pref,
+          paramOut + offsetIdx,
+          moment1Out + offsetIdx,
+          moment2Out + offsetIdx,
+          beta1_,
+          beta2_,
+          epsilon_,
+          lr[0] * correction);
+    }
+    return true;
+  }
+
   template <typename SIndex>
   bool DoRunWithType() {
     const auto* lr = Input(LR).template data<T>();
@@ -366,21 +439,25 @@ class SparseAdamOp final : public Operator<Context> {
               i);
 #endif
           if (!enableRAdam_) {
-            adam_compute(
+            constexpr auto prefdist_T0 = 16;
+            auto i_pref = (i < n - prefdist_T0) ? i + prefdist_T0 : i;
+            auto offsetIdx_pref = indices[i_pref] * block_size;
+            adam_update_prefetch(
                 block_size,
                 paramIn + offsetIdx,
+                paramIn + offsetIdx_pref,
                 gradIn + offsetI,
                 moment1In + offsetIdx,
+                moment1In + offsetIdx_pref,
                 moment2In + offsetIdx,
+                moment2In + offsetIdx_pref,
                 paramOut + offsetIdx,
                 moment1Out + offsetIdx,
                 moment2Out + offsetIdx,
                 beta1_,
                 beta2_,
                 epsilon_,
-                correction,
-                lr,
-                &context_);
+                lr[0] * correction);
           } else {
             radam_compute(
                 block_size,
@@ -95,6 +95,8 @@ GradientSlice and indices into the full param and momentum tables. Both param
 and momentum should be in-place (corresponding inputs and outputs should be the
 same blobs).
 
+On CPU, the momentum can be stored in float16.
+
 
 
 )DOC")
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "caffe2/core/operator.h"
+#include "caffe2/perfkernels/sparse_optimizers.h"
 
 namespace caffe2 {
 
@@ -135,10 +136,60 @@ class SparseMomentumSGDUpdateOp final : public Operator<Context> {
         Input(PARAM).size_from_dim(1),
         Input(GRAD).size_from_dim(Input(INDICES).dim()));
 
+    if (Input(MOMENTUM).template IsType<at::Half>()) {
+      CAFFE_ENFORCE(
+          (std::is_same<Context, CPUContext>::value),
+          "float16 momentum is only supported on CPU");
+      return DispatchHelper<TensorTypes2<int32_t, int64_t>, at::Half>::call(
+          this, Input(INDICES));
+    }
     return DispatchHelper<TensorTypes<int32_t, int64_t>>::call(
         this, Input(INDICES));
   }
 
+  // The momentum stored in TMoment (float16), with the arithmetic in fp32.
+  template <typename TMoment, typename SIndex>
+  bool DoRunWithType2() {
+    auto block_size = Input(PARAM).numel() / Input(PARAM).size(0);
+    auto n = Input(GRAD).numel() / block_size;
+
+    const auto* gradIn = Input(GRAD).template data<T>();
+    const auto* momentumIn = Input(MOMENTUM).template data<TMoment>();
+    const auto* lr = Input(LR).template data<T>();
+    const auto* indices = Input(INDICES).template data<SIndex>();
+
+    auto* gradOut = Output(OUTPUT_GRAD)->template mutable_data<T>();
+    auto* momentumOut =
+        Output(OUTPUT_MOMENTUM)->template mutable_data<TMoment>();
+    auto* paramOut = Output(OUTPUT_PARAM)->template mutable_data<T>();
+
+    for (auto i = 0; i < n; ++i) {
+      auto idx = indices[i];
+      auto offsetI = i * block_size;
+      auto offsetIdx = idx * block_size;
+
+      CAFFE_ENFORCE(offsetIdx + block_size <= Input(PARAM).numel());
+      CAFFE_ENFORCE(offsetI + block_size <= Input(GRAD).numel());
+
+      constexpr auto prefdist_T0 = 16;
+      auto i_pref = (i < n - prefdist_T0) ? i + prefdist_T0 : i;
+      auto offsetIdx_pref = indices[i_pref] * block_size;
+      momentum_sgd_fp16_update_prefetch(
+          block_size,
+          gradIn + offsetI,
+          momentumIn + offsetIdx,
+          momentumIn + offsetIdx_pref,
+          gradOut + offsetI,
+          momentumOut + offsetIdx,
+          paramOut + offsetIdx,
+          paramOut + offsetIdx_pref,
+          lr[0],
+          momentum_,
+          nesterov_);
+    }
+    return true;
+  }
+
   template <typename SIndex>
   bool DoRunWithType() {
     auto block_size = Input(PARAM).numel() / Input(PARAM).size(0);
@@ -162,17 +213,21 @@ class SparseMomentumSGDUpdateOp final : public Operator<Context> {
       CAFFE_ENFORCE(offsetIdx + block_size <= Input(PARAM).numel());
       CAFFE_ENFORCE(offsetI + block_size <= Input(GRAD).numel());
 
-      momentum_sgd_update<Context>(
+      constexpr auto prefdist_T0 = 16;
+      auto i_pref = (i < n - prefdist_T0) ? i + prefdist_T0 : i;
+      auto offsetIdx_pref = indices[i_pref] * block_size;
+      momentum_sgd_update_prefetch(
           block_size,
           gradIn + offsetI,
           momentumIn + offsetIdx,
+          momentumIn + offsetIdx_pref,
           gradOut + offsetI,
           momentumOut + offsetIdx,
-          lr,
-          momentum_,
-          nesterov_,
           paramOut + offsetIdx,
-          &context_);
+          paramOut + offsetIdx_pref,
+          lr[0],
+          momentum_,
+          nesterov_);
     }
     return true;
   }
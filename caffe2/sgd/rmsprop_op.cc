@@ -1,6 +1,6 @@
 #include "rmsprop_op.h"
 
-#include "caffe2/utils/eigen_utils.h"
+#include "caffe2/perfkernels/sparse_optimizers.h"
 #include "caffe2/utils/math.h"
 
 namespace caffe2 {
@@ -19,17 +19,25 @@ void rmsprop_update<CPUContext>(
     float epsilon,
     const float* lr,
     CPUContext* /*context*/) {
-  ConstEigenVectorArrayMap<float> gVec(g, N);
-  ConstEigenVectorArrayMap<float> msVec(ms, N);
-  ConstEigenVectorArrayMap<float> momVec(mom, N);
-  // Update new mean square estimate
-  EigenVectorArrayMap<float> nmsVec(nms, N);
-  nmsVec = msVec + (1.0f - decay) * (gVec * gVec - msVec);
-  // Update momentum estimate
-  EigenVectorArrayMap<float> nmomVec(nmom, N);
-  nmomVec = momVec * momentum + lr[0] * gVec / (epsilon + nmsVec).sqrt();
-  // New gradient is the momentum
-  EigenVectorArrayMap<float>(ng, N) = nmomVec;
+  // Dense update, so there is no next row to prefetch.
+  rmsprop_update_prefetch(
+      N, g, ms, ms, mom, mom, ng, nms, nmom, decay, momentum, epsilon, lr[0]);
+}
+
+void rmsprop_fp16_update(
+    int N,
+    const float* g,
+    const at::Half* ms,
+    const at::Half* mom,
+    float* ng,
+    at::Half* nms,
+    at::Half* nmom,
+    float decay,
+    float momentum,
+    float epsilon,
+    const float* lr) {
+  rmsprop_fp16_update_prefetch(
+      N, g, ms, ms, mom, mom, ng, nms, nmom, decay, momentum, epsilon, lr[0]);
 }
 
 REGISTER_CPU_OPERATOR(RmsProp, RmsPropOp<float, CPUContext>);
@@ -46,7 +54,8 @@ Concretely, given inputs (grad, mean_squares, mom, lr), computes:
     mom_o = momentum * mom + lr * grad / sqrt(epsilon + mean_squares_o)
     grad_o = mom_o
 
-Returns (grad_o, mean_squares_o, mom_o).
+Returns (grad_o, mean_squares_o, mom_o). On CPU, mean_squares and mom can be
+stored in float16.
 )DOC");
 SHOULD_NOT_DO_GRADIENT(RmsProp);
 
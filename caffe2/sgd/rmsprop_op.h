@@ -20,6 +20,20 @@ void rmsprop_update(
     const float* lr,
     Context* context);
 
+// Same as above with the mean squares and momentum stored in float16, on CPU
+void rmsprop_fp16_update(
+    int N,
+    const float* g,
+    const at::Half* ms,
+    const at::Half* mom,
+    float* ng,
+    at::Half* nms,
+    at::Half* nmom,
+    float decay,
+    float momentum,
+    float epsilon,
+    const float* lr);
+
 template <typename T, class Context>
 class RmsPropOp final : public Operator<Context> {
  public:
@@ -37,6 +51,27 @@ class RmsPropOp final : public Operator<Context> {
     Output(OUTPUT_GRAD)->ResizeLike(Input(GRAD));
     Output(OUTPUT_MEAN_SQUARES)->ResizeLike(Input(MEAN_SQUARES));
     Output(OUTPUT_MOMENTUM)->ResizeLike(Input(MOMENTUM));
+    if (Input(MEAN_SQUARES).template IsType<at::Half>()) {
+      CAFFE_ENFORCE(
+          Input(MOMENTUM).template IsType<at::Half>(),
+          "Both mean_squares and mom must be float16, or neither");
+      CAFFE_ENFORCE(
+          (std::is_same<Context, CPUContext>::value),
+          "float16 mean_squares and mom are only supported on CPU");
+      rmsprop_fp16_update(
+          Input(GRAD).numel(),
+          Input(GRAD).template data<T>(),
+          Input(MEAN_SQUARES).template data<at::Half>(),
+          Input(MOMENTUM).template data<at::Half>(),
+          Output(OUTPUT_GRAD)->template mutable_data<T>(),
+          Output(OUTPUT_MEAN_SQUARES)->template mutable_data<at::Half>(),
+          Output(OUTPUT_MOMENTUM)->template mutable_data<at::Half>(),
+          decay_,
+          momentum_,
+          epsilon_,
+          Input(LR).template data<T>());
+      return true;
+    }
     rmsprop_update<Context>(
         Input(GRAD).numel(),
         Input(GRAD).template data<T>(),
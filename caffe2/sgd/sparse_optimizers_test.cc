@@ -0,0 +1,355 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cpuinfo.h>
+#include <gtest/gtest.h>
+
+#include "caffe2/core/macros.h"
+#include "caffe2/perfkernels/sparse_optimizers.h"
+
+namespace caffe2 {
+
+// The per-ISA variants behind the dispatching perfkernels, so that each of
+// them is tested whatever CPU the test runs on.
+decltype(adam_update_prefetch) adam_update_prefetch__base;
+decltype(rmsprop_update_prefetch) rmsprop_update_prefetch__base;
+decltype(momentum_sgd_update_prefetch) momentum_sgd_update_prefetch__base;
+decltype(adam_fp16_update_prefetch) adam_fp16_update_prefetch__base;
+decltype(rmsprop_fp16_update_prefetch) rmsprop_fp16_update_prefetch__base;
+decltype(momentum_sgd_fp16_update_prefetch)
+    momentum_sgd_fp16_update_prefetch__base;
+#ifdef CAFFE2_PERF_WITH_AVX2
+decltype(adam_update_prefetch) adam_update_prefetch__avx2_fma;
+decltype(rmsprop_update_prefetch) rmsprop_update_prefetch__avx2_fma;
+decltype(momentum_sgd_update_prefetch) momentum_sgd_update_prefetch__avx2_fma;
+decltype(adam_fp16_update_prefetch) adam_fp16_update_prefetch__avx2_fma;
+decltype(rmsprop_fp16_update_prefetch) rmsprop_fp16_update_prefetch__avx2_fma;
+decltype(momentum_sgd_fp16_update_prefetch)
+    momentum_sgd_fp16_update_prefetch__avx2_fma;
+#endif
+#ifdef CAFFE2_PERF_WITH_AVX512
+decltype(adam_update_prefetch) adam_update_prefetch__avx512;
+decltype(rmsprop_update_prefetch) rmsprop_update_prefetch__avx512;
+decltype(momentum_sgd_update_prefetch) momentum_sgd_update_prefetch__avx512;
+decltype(adam_fp16_update_prefetch) adam_fp16_update_prefetch__avx512;
+decltype(rmsprop_fp16_update_prefetch) rmsprop_fp16_update_prefetch__avx512;
+decltype(momentum_sgd_fp16_update_prefetch)
+    momentum_sgd_fp16_update_prefetch__avx512;
+#endif
+
+namespace {
+
+// Sizes around the vector widths, so that both the vector loops and their
+// scalar tails are covered.
+const std::vector<int> kSizes = {1, 7, 8, 9, 15, 16, 17, 31, 33, 100};
+
+template <typename Fn>
+std::vector<std::pair<std::string, Fn*>> variants(
+    Fn* dispatched,
+    Fn* base,
+    Fn* avx2_fma,
+    Fn* avx512) {
+  std::vector<std::pair<std::string, Fn*>> result = {
+      {"dispatched", dispatched}, {"base", base}};
+  if (!cpuinfo_initialize()) {
+    return result;
+  }
+  if (avx2_fma && cpuinfo_has_x86_avx2() && cpuinfo_has_x86_fma3()) {
+    result.emplace_back("avx2_fma", avx2_fma);
+  }
+  if (avx512 && cpuinfo_has_x86_avx512f() && cpuinfo_has_x86_avx512dq() &&
+      cpuinfo_has_x86_avx512vl()) {
+    result.emplace_back("avx512", avx512);
+  }
+  return result;
+}
+
+std::vector<float> randomRow(std::mt19937& gen, int N, float lo, float hi) {
+  std::uniform_real_distribution<float> dist(lo, hi);
+  std::vector<float> row(N);
+  std::generate(row.begin(), row.end(), [&] { return dist(gen); });
+  return row;
+}
+
+std::vector<at::Half> randomHalfRow(
+    std::mt19937& gen,
+    int N,
+    float lo,
+    float hi) {
+  auto row = randomRow(gen, N, lo, hi);
+  return std::vector<at::Half>(row.begin(), row.end());
+}
+
+void expectNear(
+    const std::vector<float>& actual,
+    const std::vector<float>& expected,
+    const std::string& what) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    // the vector versions use fused multiply-adds
+    EXPECT_NEAR(actual[i], expected[i], 1e-5 * (1 + std::abs(expected[i])))
+        << what << " differs at " << i;
+  }
+}
+
+void expectNear(
+    const std::vector<at::Half>& actual,
+    const std::vector<at::Half>& expected,
+    const std::string& what) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (size_t i = 0; i < actual.size(); ++i) {
+    // a fused multiply-add can round the other way to fp16
+    float a = actual[i], e = expected[i];
+    EXPECT_NEAR(a, e, 1e-3 * (1 + std::abs(e)))
+        << what << " differs at " << i;
+  }
+}
+
+} // namespace
+
+TEST(SparseOptimizersTest, Adam) {
+  std::mt19937 gen(0);
+  const float beta1 = 0.9f, beta2 = 0.999f, epsilon = 1e-5f;
+  const float lr_correction = -0.01f;
+  for (const auto& variant : variants<decltype(adam_update_prefetch)>(
+           adam_update_prefetch,
+           adam_update_prefetch__base,
+#ifdef CAFFE2_PERF_WITH_AVX2
+           adam_update_prefetch__avx2_fma,
+#else
+           nullptr,
+#endif
+#ifdef CAFFE2_PERF_WITH_AVX512
+           adam_update_prefetch__avx512
+#else
+           nullptr
+#endif
+           )) {
+    for (int N : kSizes) {
+      auto w = randomRow(gen, N, -1, 1);
+      auto g = randomRow(gen, N, -1, 1);
+      auto m = randomRow(gen, N, -1, 1);
+      auto v = randomRow(gen, N, 0, 1);
+      std::vector<float> nw(N), nm(N), nv(N);
+      std::vector<float> nw_ref(N), nm_ref(N), nv_ref(N);
+      internal::adam_update_base_inlined(
+          N, w.data(), g.data(), m.data(), v.data(), nw_ref.data(),
+          nm_ref.data(), nv_ref.data(), beta1, beta2, epsilon, lr_correction);
+      variant.second(
+          N, w.data(), w.data(), g.data(), m.data(), m.data(), v.data(),
+          v.data(), nw.data(), nm.data(), nv.data(), beta1, beta2, epsilon,
+          lr_correction);
+      std::string what = variant.first + " N=" + std::to_string(N);
+      expectNear(nw, nw_ref, what + " w");
+      expectNear(nm, nm_ref, what + " m");
+      expectNear(nv, nv_ref, what + " v");
+    }
+  }
+}
+
+TEST(SparseOptimizersTest, RmsProp) {
+  std::mt19937 gen(0);
+  const float decay = 0.9f, momentum = 0.5f, epsilon = 1e-5f, lr = -0.01f;
+  for (const auto& variant : variants<decltype(rmsprop_update_prefetch)>(
+           rmsprop_update_prefetch,
+           rmsprop_update_prefetch__base,
+#ifdef CAFFE2_PERF_WITH_AVX2
+           rmsprop_update_prefetch__avx2_fma,
+#else
+           nullptr,
+#endif
+#ifdef CAFFE2_PERF_WITH_AVX512
+           rmsprop_update_prefetch__avx512
+#else
+           nullptr
+#endif
+           )) {
+    for (int N : kSizes) {
+      auto g = randomRow(gen, N, -1, 1);
+      auto ms = randomRow(gen, N, 0, 1);
+      auto mom = randomRow(gen, N, -1, 1);
+      std::vector<float> ng(N), nms(N), nmom(N);
+      std::vector<float> ng_ref(N), nms_ref(N), nmom_ref(N);
+      internal::rmsprop_update_base_inlined(
+          N, g.data(), ms.data(), mom.data(), ng_ref.data(), nms_ref.data(),
+          nmom_ref.data(), decay, momentum, epsilon, lr);
+      variant.second(
+          N, g.data(), ms.data(), ms.data(), mom.data(), mom.data(),
+          ng.data(), nms.data(), nmom.data(), decay, momentum, epsilon, lr);
+      std::string what = variant.first + " N=" + std::to_string(N);
+      expectNear(ng, ng_ref, what + " grad");
+      expectNear(nms, nms_ref, what + " ms");
+      expectNear(nmom, nmom_ref, what + " mom");
+    }
+  }
+}
+
+TEST(SparseOptimizersTest, MomentumSGD) {
+  std::mt19937 gen(0);
+  const float lr = 0.01f, momentum = 0.9f;
+  for (const auto& variant : variants<decltype(momentum_sgd_update_prefetch)>(
+           momentum_sgd_update_prefetch,
+           momentum_sgd_update_prefetch__base,
+#ifdef CAFFE2_PERF_WITH_AVX2
+           momentum_sgd_update_prefetch__avx2_fma,
+#else
+           nullptr,
+#endif
+#ifdef CAFFE2_PERF_WITH_AVX512
+           momentum_sgd_update_prefetch__avx512
+#else
+           nullptr
+#endif
+           )) {
+    for (int N : kSizes) {
+      for (bool nesterov : {false, true}) {
+        for (bool with_param : {false, true}) {
+          auto g = randomRow(gen, N, -1, 1);
+          auto m = randomRow(gen, N, -1, 1);
+          auto param = randomRow(gen, N, -1, 1);
+          auto param_ref = param;
+          std::vector<float> ng(N), nm(N), ng_ref(N), nm_ref(N);
+          internal::momentum_sgd_update_base_inlined(
+              N, g.data(), m.data(), ng_ref.data(), nm_ref.data(),
+              with_param ? param_ref.data() : nullptr, lr, momentum,
+              nesterov);
+          float* p = with_param ? param.data() : nullptr;
+          variant.second(
+              N, g.data(), m.data(), m.data(), ng.data(), nm.data(), p, p,
+              lr, momentum, nesterov);
+          std::string what = variant.first + " N=" + std::to_string(N) +
+              (nesterov ? " nesterov" : "");
+          expectNear(ng, ng_ref, what + " grad");
+          expectNear(nm, nm_ref, what + " momentum");
+          expectNear(param, param_ref, what + " param");
+        }
+      }
+    }
+  }
+}
+
+TEST(SparseOptimizersTest, AdamFp16) {
+  std::mt19937 gen(0);
+  const float beta1 = 0.9f, beta2 = 0.999f, epsilon = 1e-5f;
+  const float lr_correction = -0.01f;
+  for (const auto& variant : variants<decltype(adam_fp16_update_prefetch)>(
+           adam_fp16_update_prefetch,
+           adam_fp16_update_prefetch__base,
+#ifdef CAFFE2_PERF_WITH_AVX2
+           adam_fp16_update_prefetch__avx2_fma,
+#else
+           nullptr,
+#endif
+#ifdef CAFFE2_PERF_WITH_AVX512
+           adam_fp16_update_prefetch__avx512
+#else
+           nullptr
+#endif
+           )) {
+    for (int N : kSizes) {
+      auto w = randomRow(gen, N, -1, 1);
+      auto g = randomRow(gen, N, -1, 1);
+      auto m = randomHalfRow(gen, N, -1, 1);
+      auto v = randomHalfRow(gen, N, 0, 1);
+      std::vector<float> nw(N), nw_ref(N);
+      std::vector<at::Half> nm(N), nv(N), nm_ref(N), nv_ref(N);
+      internal::adam_update_base_inlined(
+          N, w.data(), g.data(), m.data(), v.data(), nw_ref.data(),
+          nm_ref.data(), nv_ref.data(), beta1, beta2, epsilon, lr_correction);
+      variant.second(
+          N, w.data(), w.data(), g.data(), m.data(), m.data(), v.data(),
+          v.data(), nw.data(), nm.data(), nv.data(), beta1, beta2, epsilon,
+          lr_correction);
+      std::string what = variant.first + " N=" + std::to_string(N);
+      expectNear(nw, nw_ref, what + " w");
+      expectNear(nm, nm_ref, what + " m");
+      expectNear(nv, nv_ref, what + " v");
+    }
+  }
+}
+
+TEST(SparseOptimizersTest, RmsPropFp16) {
+  std::mt19937 gen(0);
+  const float decay = 0.9f, momentum = 0.5f, epsilon = 1e-5f, lr = -0.01f;
+  for (const auto& variant : variants<decltype(rmsprop_fp16_update_prefetch)>(
+           rmsprop_fp16_update_prefetch,
+           rmsprop_fp16_update_prefetch__base,
+#ifdef CAFFE2_PERF_WITH_AVX2
+           rmsprop_fp16_update_prefetch__avx2_fma,
+#else
+           nullptr,
+#endif
+#ifdef CAFFE2_PERF_WITH_AVX512
+           rmsprop_fp16_update_prefetch__avx512
+#else
+           nullptr
+#endif
+           )) {
+    for (int N : kSizes) {
+      auto g = randomRow(gen, N, -1, 1);
+      auto ms = randomHalfRow(gen, N, 0, 1);
+      auto mom = randomHalfRow(gen, N, -1, 1);
+      std::vector<float> ng(N), ng_ref(N);
+      std::vector<at::Half> nms(N), nmom(N), nms_ref(N), nmom_ref(N);
+      internal::rmsprop_update_base_inlined(
+          N, g.data(), ms.data(), mom.data(), ng_ref.data(), nms_ref.data(),
+          nmom_ref.data(), decay, momentum, epsilon, lr);
+      variant.second(
+          N, g.data(), ms.data(), ms.data(), mom.data(), mom.data(),
+          ng.data(), nms.data(), nmom.data(), decay, momentum, epsilon, lr);
+      std::string what = variant.first + " N=" + std::to_string(N);
+      // ng is the fp32 value of nmom, before it is rounded
+      expectNear(ng, ng_ref, what + " grad");
+      expectNear(nms, nms_ref, what + " ms");
+      expectNear(nmom, nmom_ref, what + " mom");
+    }
+  }
+}
+
+TEST(SparseOptimizersTest, MomentumSGDFp16) {
+  std::mt19937 gen(0);
+  const float lr = 0.01f, momentum = 0.9f;
+  for (const auto& variant :
+       variants<decltype(momentum_sgd_fp16_update_prefetch)>(
+           momentum_sgd_fp16_update_prefetch,
+           momentum_sgd_fp16_update_prefetch__base,
+#ifdef CAFFE2_PERF_WITH_AVX2
+           momentum_sgd_fp16_update_prefetch__avx2_fma,
+#else
+           nullptr,
+#endif
+#ifdef CAFFE2_PERF_WITH_AVX512
+           momentum_sgd_fp16_update_prefetch__avx512
+#else
+           nullptr
+#endif
+           )) {
+    for (int N : kSizes) {
+      for (bool nesterov : {false, true}) {
+        auto g = randomRow(gen, N, -1, 1);
+        auto m = randomHalfRow(gen, N, -1, 1);
+        auto param = randomRow(gen, N, -1, 1);
+        auto param_ref = param;
+        std::vector<float> ng(N), ng_ref(N);
+        std::vector<at::Half> nm(N), nm_ref(N);
+        internal::momentum_sgd_update_base_inlined(
+            N, g.data(), m.data(), ng_ref.data(), nm_ref.data(),
+            param_ref.data(), lr, momentum, nesterov);
+        variant.second(
+            N, g.data(), m.data(), m.data(), ng.data(), nm.data(),
+            param.data(), param.data(), lr, momentum, nesterov);
+        std::string what = variant.first + " N=" + std::to_string(N) +
+            (nesterov ? " nesterov" : "");
+        expectNear(ng, ng_ref, what + " grad");
+        expectNear(nm, nm_ref, what + " momentum");
+        expectNear(param, param_ref, what + " param");
+      }
+    }
+  }
+}
+
+} // namespace caffe2
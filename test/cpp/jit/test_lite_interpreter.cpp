@@ -2,12 +2,14 @@
 
 #include <gtest/gtest.h>
 
+#include <c10/core/CPUAllocator.h>
 #include <c10/core/TensorOptions.h>
 #include <torch/csrc/autograd/generated/variable_factories.h>
 #include <torch/csrc/jit/api/module.h>
 #include <torch/csrc/jit/frontend/resolver.h>
 #include <torch/csrc/jit/mobile/import.h>
 #include <torch/csrc/jit/mobile/module.h>
+#include <torch/csrc/jit/runtime/custom_operator.h>
 #include <torch/csrc/jit/serialization/export.h>
 #include <torch/csrc/jit/serialization/import.h>
 #include <torch/custom_class.h>
@@ -106,6 +108,224 @@ TEST(LiteInterpreterTest, MethodInvocation) { // NOLINT (use =delete in gtest)
   }
 }
 
+TEST(LiteInterpreterTest, LazyAndParallelLoad) {
+  Module m("m");
+  m.register_parameter("foo", torch::ones({}), false);
+  m.define(R"(
+    def add(self, x):
+      return self.foo + x
+    def forward(self, x):
+      b = 4
+      return self.add(x) * b
+  )");
+  std::stringstream ss;
+  m._save_for_mobile(ss);
+
+  auto minput = 5 * torch::ones({});
+  auto ref = m.forward({minput});
+  for (uint64_t options :
+       {_default_mobile_module_load_options |
+            MobileModuleLoadOptions::LAZY_METHODS,
+        _default_mobile_module_load_options |
+            MobileModuleLoadOptions::PARALLEL_OPERATOR_LOOKUP}) {
+    ss.seekg(0);
+    ExtraFilesMap extra_files;
+    mobile::Module bc =
+        _load_for_mobile(ss, c10::nullopt, extra_files, options);
+    IValue res;
+    for (int i = 0; i < 3; ++i) {
+      res = bc.forward({minput});
+    }
+    AT_ASSERT(res.toTensor().equal(ref.toTensor()));
+  }
+}
+
+namespace {
+// Saves a module whose methods a and b each call an operator that is
+// unregistered again before the module is loaded.
+void saveWithUnsupportedOps(std::stringstream& ss) {
+  auto registry =
+      torch::RegisterOperators()
+          .op("_test_mobile::unsupported_a(Tensor x) -> Tensor",
+              [](at::Tensor x) { return x; })
+          .op("_test_mobile::unsupported_b(Tensor x) -> Tensor",
+              [](at::Tensor x) { return x; });
+  Module m("m");
+  m.register_parameter("foo", torch::ones({}), false);
+  m.define(R"(
+    def a(self, x):
+      return torch.ops._test_mobile.unsupported_a(x)
+    def b(self, x):
+      return torch.ops._test_mobile.unsupported_b(x)
+    def forward(self, x):
+      return self.foo + x
+  )");
+  m._save_for_mobile(ss);
+}
+} // namespace
+
+TEST(LiteInterpreterTest, LazyLoadUnsupportedOperator) {
+  std::stringstream ss;
+  saveWithUnsupportedOps(ss);
+  ASSERT_THROWS_WITH_MESSAGE(
+      _load_for_mobile(ss), "Following ops cannot be found");
+
+  // The load succeeds, and only the methods with unsupported operators fail
+  ss.seekg(0);
+  ExtraFilesMap extra_files;
+  mobile::Module bc = _load_for_mobile(
+      ss,
+      c10::nullopt,
+      extra_files,
+      _default_mobile_module_load_options |
+          MobileModuleLoadOptions::LAZY_METHODS);
+  auto minput = 5 * torch::ones({});
+  AT_ASSERT(bc.forward({minput}).toTensor().equal(minput + 1));
+  for (int i = 0; i < 2; ++i) {
+    // Every call raises the error of the first one
+    ASSERT_THROWS_WITH_MESSAGE(
+        bc.get_method("a")({minput}), "_test_mobile::unsupported_a");
+  }
+  ASSERT_THROWS_WITH_MESSAGE(
+      bc.get_method("b")({minput}), "Following ops cannot be found");
+}
+
+TEST(LiteInterpreterTest, ParallelLoadUnsupportedOperators) {
+  std::stringstream ss;
+  saveWithUnsupportedOps(ss);
+  ExtraFilesMap extra_files;
+  try {
+    _load_for_mobile(
+        ss,
+        c10::nullopt,
+        extra_files,
+        _default_mobile_module_load_options |
+            MobileModuleLoadOptions::PARALLEL_OPERATOR_LOOKUP);
+    FAIL() << "expected the load to fail";
+  } catch (const c10::Error& e) {
+    // The operators of both methods are reported in one error
+    const std::string message = e.what();
+    EXPECT_NE(message.find("Following ops cannot be found"), std::string::npos);
+    EXPECT_NE(message.find("_test_mobile::unsupported_a"), std::string::npos);
+    EXPECT_NE(message.find("_test_mobile::unsupported_b"), std::string::npos);
+  }
+}
+
+namespace {
+// Only the mobile CPU allocator is planned
+struct MobileCPUAllocatorGuard {
+  MobileCPUAllocatorGuard() : default_allocator_(c10::GetCPUAllocator()) {
+    c10::SetCPUAllocator(c10::GetDefaultMobileCPUAllocator(), /*priority*/ 100);
+  }
+  ~MobileCPUAllocatorGuard() {
+    c10::SetCPUAllocator(default_allocator_, /*priority*/ 100);
+  }
+
+ private:
+  c10::Allocator* default_allocator_;
+};
+} // namespace
+
+TEST(LiteInterpreterTest, AllocationPlan) {
+  MobileCPUAllocatorGuard allocator_guard;
+
+  Module m("m");
+  m.register_parameter("weight", torch::rand({16, 8}), false);
+  m.define(R"(
+    def forward(self, x):
+      y = torch.relu(torch.mm(x, self.weight))
+      return torch.mm(y.t(), y) + 1
+  )");
+  std::stringstream ss;
+  m._save_for_mobile(ss);
+  mobile::Module bc = _load_for_mobile(ss);
+
+  auto input = torch::rand({4, 16});
+  auto ref = bc.forward({input}).toTensor();
+  bc.record_allocation_plan("forward", {input});
+  auto planned = bc.find_allocation_plan("forward", {input});
+  ASSERT_NE(planned, nullptr);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(bc.forward({input}).toTensor().equal(ref));
+  }
+  // the calls ran in the arena
+  EXPECT_EQ(planned->num_replays, 3u);
+
+  // Other shapes are not planned
+  auto other_input = torch::rand({6, 16});
+  auto other_ref = m.forward({other_input}).toTensor();
+  EXPECT_EQ(bc.find_allocation_plan("forward", {other_input}), nullptr);
+  ASSERT_TRUE(bc.forward({other_input}).toTensor().allclose(other_ref));
+
+  // The plans are imported with the model
+  std::stringstream ss_with_plans;
+  ExtraFilesMap extra_files{
+      {mobile::kAllocationPlansExtraFile, bc.export_allocation_plans()}};
+  m._save_for_mobile(ss_with_plans, extra_files);
+  mobile::Module bc2 = _load_for_mobile(ss_with_plans);
+  ASSERT_EQ(bc2.export_allocation_plans(), bc.export_allocation_plans());
+  ASSERT_TRUE(bc2.forward({input}).toTensor().equal(ref));
+  EXPECT_EQ(bc2.find_allocation_plan("forward", {input})->num_replays, 1u);
+}
+
+TEST(LiteInterpreterTest, AllocationPlanMismatch) {
+  MobileCPUAllocatorGuard allocator_guard;
+
+  // the size of nonzero depends on the values of the input, which are not
+  // part of the key of the plan
+  Module m("m");
+  m.define(R"(
+    def forward(self, x):
+      idx = torch.nonzero(x > 0.5)
+      return idx.sum() * 2 + 1
+  )");
+  std::stringstream ss;
+  m._save_for_mobile(ss);
+  mobile::Module bc = _load_for_mobile(ss);
+
+  auto input = torch::ones({4, 16});
+  bc.record_allocation_plan("forward", {input});
+  ASSERT_NE(bc.find_allocation_plan("forward", {input}), nullptr);
+
+  auto other_input = torch::zeros({4, 16});
+  other_input[0].fill_(1);
+  auto other_ref = m.forward({other_input}).toTensor();
+  ASSERT_TRUE(bc.forward({other_input}).toTensor().equal(other_ref));
+  // the plan is not used anymore
+  EXPECT_EQ(bc.find_allocation_plan("forward", {input}), nullptr);
+  ASSERT_TRUE(
+      bc.forward({input}).toTensor().equal(m.forward({input}).toTensor()));
+}
+
+TEST(LiteInterpreterTest, AllocationPlanMismatchInPlace) {
+  MobileCPUAllocatorGuard allocator_guard;
+
+  // the input is updated before the allocations depart from the plan
+  Module m("m");
+  m.define(R"(
+    def forward(self, x):
+      x.add_(1)
+      idx = torch.nonzero(x > 1.5)
+      return idx.sum() * 2 + 1
+  )");
+  std::stringstream ss;
+  m._save_for_mobile(ss);
+  mobile::Module bc = _load_for_mobile(ss);
+
+  auto input = torch::ones({4, 16});
+  bc.record_allocation_plan("forward", {input});
+  ASSERT_NE(bc.find_allocation_plan("forward", {input}), nullptr);
+
+  auto other_input = torch::zeros({4, 16});
+  other_input[0].fill_(1);
+  auto expected_input = other_input + 1;
+  auto other_ref = m.forward({other_input.clone()}).toTensor();
+  ASSERT_TRUE(bc.forward({other_input}).toTensor().equal(other_ref));
+  // the method ran once
+  ASSERT_TRUE(other_input.equal(expected_input));
+  EXPECT_EQ(bc.find_allocation_plan("forward", {input}), nullptr);
+}
+
 TEST(LiteInterpreterTest, Conv) {
   auto s = std::getenv("PYTORCH_TEST_WITH_TSAN");
   if (s && strcmp(s, "1") == 0)
@@ -1864,6 +1864,52 @@ TEST(ProfilerTest, Basic) {
   checkShape(tanh_n->inputs().at(0)->node()->ty(attr::profiled_type), eltwise);
 }
 
+TEST(ProfilerTest, ExportImportProfile) {
+  static const auto basic_example = R"JIT(
+  def basic(x, y):
+    a = x + y
+    b = x * y
+    return a - b
+  )JIT";
+
+  auto cu = compile(basic_example);
+  auto& fun = cu->get_function("basic");
+  auto pr = ProfilingRecord::instrumentGraph(fun.graph());
+  Code cd(pr->profiled_graph_, "");
+  for (size_t i = 0; i < getNumProfiledRuns(); i++) {
+    auto stack = createStack(
+        {at::randn({2, 3}, at::kCPU), at::randn({2, 3}, at::kCPU)});
+    InterpreterState is{cd};
+    is.run(stack);
+  }
+  ASSERT_TRUE(pr->ready());
+  auto profile = pr->exportProfile();
+
+  // a fresh record of the same graph picks up the profiled types without
+  // running the profiling plan
+  auto imported = ProfilingRecord::instrumentGraph(fun.graph());
+  ASSERT_TRUE(imported->importProfile(profile));
+  ASSERT_TRUE(imported->ready());
+  auto nodes = imported->profiled_graph_->block()->nodes();
+  auto mul_n = std::find_if(nodes.begin(), nodes.end(), [](Node* n) {
+    return n->kind() == aten::mul;
+  });
+  ASSERT_NE(mul_n, nodes.end());
+  checkShape(mul_n->inputs().at(0)->node()->ty(attr::profiled_type), {2, 3});
+  ASSERT_EQ(imported->exportProfile(), profile);
+
+  // profiles of other graphs are rejected
+  static const auto other_example = R"JIT(
+  def other(x, y):
+    return x * y
+  )JIT";
+  auto other_cu = compile(other_example);
+  auto other_pr =
+      ProfilingRecord::instrumentGraph(other_cu->get_function("other").graph());
+  ASSERT_FALSE(other_pr->importProfile(profile));
+  ASSERT_FALSE(other_pr->importProfile("garbage"));
+}
+
 TEST(CallStackTest, Basic) {
   const auto text = R"(
 def ham(x):
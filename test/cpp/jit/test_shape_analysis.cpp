@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <test/cpp/jit/test_utils.h>
+
+#include <torch/csrc/jit/ir/ir.h>
+#include <torch/csrc/jit/ir/irparser.h>
+#include <torch/csrc/jit/passes/symbolic_shape_analysis.h>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+void setSymbolicShape(Value* v, std::vector<c10::ShapeSymbol> sizes) {
+  v->setType(
+      TensorType::get()->withSymbolicShapes(c10::SymbolicShape(sizes)));
+}
+
+std::vector<c10::ShapeSymbol> symbolicSizes(Value* v) {
+  auto sizes = v->type()->expect<TensorType>()->symbolic_sizes().sizes();
+  EXPECT_TRUE(sizes.has_value());
+  return sizes ? *sizes : std::vector<c10::ShapeSymbol>{};
+}
+
+std::vector<c10::ShapeSymbol> staticSizes(std::vector<int64_t> sizes) {
+  return fmap(sizes, [](int64_t size) {
+    return c10::ShapeSymbol::fromStaticSize(size);
+  });
+}
+
+} // namespace
+
+TEST(ShapeAnalysisTest, StaticShapes) {
+  auto graph = std::make_shared<Graph>();
+  parseIR(
+      R"IR(
+graph(%x : Tensor, %conv_w : Tensor, %fc_w : Tensor):
+  %none : None = prim::Constant()
+  %zero : int = prim::Constant[value=0]()
+  %one : int = prim::Constant[value=1]()
+  %minus_one : int = prim::Constant[value=-1]()
+  %ones : int[] = prim::ListConstruct(%one, %one)
+  %conv : Tensor = aten::conv2d(%x, %conv_w, %none, %ones, %ones, %ones, %one)
+  %relu : Tensor = aten::relu(%conv)
+  %pool : Tensor = aten::adaptive_avg_pool2d(%relu, %ones)
+  %flat : Tensor = aten::flatten(%pool, %one, %minus_one)
+  %fc : Tensor = aten::linear(%flat, %fc_w, %none)
+  return (%fc)
+  )IR",
+      graph.get());
+  setSymbolicShape(graph->inputs().at(0), staticSizes({1, 3, 32, 32}));
+  setSymbolicShape(graph->inputs().at(1), staticSizes({8, 3, 3, 3}));
+  setSymbolicShape(graph->inputs().at(2), staticSizes({10, 8}));
+  PropagateShapesOnGraph(graph);
+
+  std::unordered_map<std::string, std::vector<int64_t>> expected = {
+      {"conv", {1, 8, 32, 32}},
+      {"relu", {1, 8, 32, 32}},
+      {"pool", {1, 8, 1, 1}},
+      {"flat", {1, 8}},
+      {"fc", {1, 10}},
+  };
+  for (Node* n : graph->nodes()) {
+    if (n->outputs().size() != 1 || !n->output()->hasDebugName()) {
+      continue;
+    }
+    auto it = expected.find(n->output()->debugName());
+    if (it != expected.end()) {
+      EXPECT_EQ(symbolicSizes(n->output()), staticSizes(it->second))
+          << "unexpected sizes for %" << it->first;
+    }
+  }
+}
+
+TEST(ShapeAnalysisTest, SymbolicShapes) {
+  auto graph = std::make_shared<Graph>();
+  parseIR(
+      R"IR(
+graph(%x : Tensor, %w : Tensor, %b : Tensor, %scale : Tensor):
+  %one : int = prim::Constant[value=1]()
+  %mm : Tensor = aten::mm(%x, %w)
+  %add : Tensor = aten::add(%mm, %b, %one)
+  %mul : Tensor = aten::mul(%add, %scale)
+  %unknown : Tensor = aten::nonzero(%add)
+  %relu : Tensor = aten::relu(%unknown)
+  return (%add, %mul, %relu)
+  )IR",
+      graph.get());
+  auto batch = c10::ShapeSymbol::newSymbol();
+  setSymbolicShape(
+      graph->inputs().at(0), {batch, c10::ShapeSymbol::fromStaticSize(16)});
+  setSymbolicShape(graph->inputs().at(1), staticSizes({16, 32}));
+  setSymbolicShape(graph->inputs().at(2), staticSizes({32}));
+  setSymbolicShape(graph->inputs().at(3), staticSizes({1, 32}));
+  PropagateShapesOnGraph(graph);
+
+  // the batch dim keeps its symbol through mm and the broadcasting add, with
+  // a missing dim, and mul, with a dim of size 1
+  std::vector<c10::ShapeSymbol> expected = {
+      batch, c10::ShapeSymbol::fromStaticSize(32)};
+  EXPECT_EQ(symbolicSizes(graph->outputs().at(0)), expected);
+  EXPECT_EQ(symbolicSizes(graph->outputs().at(1)), expected);
+
+  // nonzero has no shape function, so the rank of %relu stays unknown
+  auto relu_type = graph->outputs().at(2)->type()->expect<TensorType>();
+  EXPECT_FALSE(relu_type->symbolic_sizes().rank().has_value());
+}
+
+TEST(ShapeAnalysisTest, EmptyReductionDims) {
+  auto graph = std::make_shared<Graph>();
+  parseIR(
+      R"IR(
+graph(%x : Tensor):
+  %none : None = prim::Constant()
+  %false : bool = prim::Constant[value=0]()
+  %true : bool = prim::Constant[value=1]()
+  %one : int = prim::Constant[value=1]()
+  %all : int[] = prim::ListConstruct()
+  %dims : int[] = prim::ListConstruct(%one)
+  %sum : Tensor = aten::sum(%x, %all, %false, %none)
+  %mean : Tensor = aten::mean(%x, %all, %true, %none)
+  %sum_dim : Tensor = aten::sum(%x, %dims, %false, %none)
+  return (%sum, %mean, %sum_dim)
+  )IR",
+      graph.get());
+  setSymbolicShape(graph->inputs().at(0), staticSizes({2, 3, 4}));
+  PropagateShapesOnGraph(graph);
+
+  // an empty dim list reduces all the dims
+  EXPECT_EQ(symbolicSizes(graph->outputs().at(0)), staticSizes({}));
+  EXPECT_EQ(symbolicSizes(graph->outputs().at(1)), staticSizes({1, 1, 1}));
+  EXPECT_EQ(symbolicSizes(graph->outputs().at(2)), staticSizes({2, 4}));
+}
+
+} // namespace jit
+} // namespace torch
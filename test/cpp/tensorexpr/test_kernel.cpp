@@ -784,6 +784,88 @@ TEST_F(Kernel, SumMultipleAxes) {
   }
 }
 
+TEST_F(Kernel, SumLargeParallel) {
+  // A reduction over the innermost axis of a large input is vectorized. The
+  // partial sums are allocated per iteration of the outer loop, which is
+  // parallelized.
+  const auto graph_string = R"IR(
+      graph(%0 : Float(64, 1024, strides=[1024, 1], device=cpu),
+            %1 : Float(64, 1024, strides=[1024, 1], device=cpu)):
+        %2 : Float(64, 1024, strides=[1024, 1]) = aten::mul(%0, %1)
+        %3 : int[] = prim::Constant[value=[1]]()
+        %4 : bool = prim::Constant[value=0]()
+        %5 : NoneType = prim::Constant()
+        %6 : Float(64, strides=[1], device=cpu) = aten::sum(%2, %3, %4, %5)
+        return (%6))IR";
+  auto graph = std::make_shared<Graph>();
+  parseIR(graph_string, &*graph);
+
+  auto a = at::rand({64, 1024}, TensorOptions(kCPU).dtype(at::kFloat));
+  auto b = at::rand({64, 1024}, TensorOptions(kCPU).dtype(at::kFloat));
+  auto ref = (a * b).sum({1});
+
+  bool old_parallel = getTEParallelizeOnCPU();
+  getTEParallelizeOnCPU() = true;
+  KernelScope kernel_scope;
+  TensorExprKernel k(graph);
+  getTEParallelizeOnCPU() = old_parallel;
+  Stmt* s = k.getCodeGenStmt();
+  std::ostringstream oss;
+  oss << *s;
+#ifdef TORCH_ENABLE_LLVM
+  torch::jit::testing::FileCheck()
+      .check("parallel")
+      ->check("Allocate(tmp_buf")
+      ->check("tmp_buf[Ramp(")
+      ->check("Free(tmp_buf")
+      ->run(oss.str());
+#endif
+
+  std::vector<at::Tensor> inputs = {a, b};
+  std::vector<IValue> stack = fmap<IValue>(inputs);
+  k.run(stack);
+  auto o = stack[0].toTensor();
+  ASSERT_EQ(o.sizes(), ref.sizes());
+  ASSERT_TRUE(at::allclose(o, ref, 1e-4, 1e-4));
+}
+
+TEST_F(Kernel, ElementwiseLargeParallel) {
+  // Parallelization is off by default. When enabled, the outer loop of a
+  // large elementwise kernel is dispatched onto the intra-op thread pool.
+  const auto graph_string = R"IR(
+      graph(%0 : Float(64, 1024, strides=[1024, 1], device=cpu),
+            %1 : Float(64, 1024, strides=[1024, 1], device=cpu)):
+        %2 : Float(64, 1024, strides=[1024, 1]) = aten::mul(%0, %1)
+        %3 : Float(64, 1024, strides=[1024, 1]) = aten::relu(%2)
+        return (%3))IR";
+  auto graph = std::make_shared<Graph>();
+  parseIR(graph_string, &*graph);
+
+  auto a = at::rand({64, 1024}, TensorOptions(kCPU).dtype(at::kFloat));
+  auto b = at::rand({64, 1024}, TensorOptions(kCPU).dtype(at::kFloat));
+  auto ref = (a * b).relu();
+
+  ASSERT_FALSE(getTEParallelizeOnCPU());
+  bool old_parallel = getTEParallelizeOnCPU();
+  getTEParallelizeOnCPU() = true;
+  KernelScope kernel_scope;
+  TensorExprKernel k(graph);
+  getTEParallelizeOnCPU() = old_parallel;
+  Stmt* s = k.getCodeGenStmt();
+  std::ostringstream oss;
+  oss << *s;
+#ifdef TORCH_ENABLE_LLVM
+  torch::jit::testing::FileCheck().check("parallel")->run(oss.str());
+#endif
+
+  std::vector<at::Tensor> inputs = {a, b};
+  std::vector<IValue> stack = fmap<IValue>(inputs);
+  k.run(stack);
+  auto o = stack[0].toTensor();
+  ASSERT_EQ(o.sizes(), ref.sizes());
+  ASSERT_TRUE(at::allclose(o, ref));
+}
+
 // This test and the following ones testing Softmax only tests with dim set
 // to one of the valid input dimensions. It does not test with dim=None
 // because that is supposed to be deprecated.
@@ -1102,6 +1184,55 @@ TEST_F(Kernel, DISABLED_InlineReductionIntoConsumer) {
   ASSERT_TRUE(at::allclose(o, ref));
 }
 
+TEST_F(Kernel, ExternalCalls) {
+  // conv2d, adaptive_avg_pool2d and matmul have no TE lowering and become
+  // calls into ATen, with the relu in between generated as a loop.
+  KernelScope kernel_scope;
+
+  const auto graph_string = R"IR(
+      graph(%x : Float(1, 3, 8, 8, strides=[192, 64, 8, 1], device=cpu),
+            %w : Float(4, 3, 3, 3, strides=[27, 9, 3, 1], device=cpu),
+            %b : Float(4, strides=[1], device=cpu),
+            %m : Float(1, 5, strides=[5, 1], device=cpu)):
+        %stride : int[] = prim::Constant[value=[1, 1]]()
+        %padding : int[] = prim::Constant[value=[1, 1]]()
+        %dilation : int[] = prim::Constant[value=[1, 1]]()
+        %groups : int = prim::Constant[value=1]()
+        %c : Float(1, 4, 8, 8, strides=[256, 64, 8, 1]) = aten::conv2d(%x, %w, %b, %stride, %padding, %dilation, %groups)
+        %r : Float(1, 4, 8, 8, strides=[256, 64, 8, 1]) = aten::relu(%c)
+        %size : int[] = prim::Constant[value=[1, 1]]()
+        %p : Float(1, 4, 1, 1, strides=[4, 1, 1, 1]) = aten::adaptive_avg_pool2d(%r, %size)
+        %o : Float(1, 4, 1, 5, strides=[20, 5, 5, 1]) = aten::matmul(%p, %m)
+        return (%o))IR";
+  auto graph = std::make_shared<Graph>();
+  parseIR(graph_string, &*graph);
+
+  auto options = TensorOptions(kCPU).dtype(at::kFloat);
+  auto x = at::rand({1, 3, 8, 8}, options);
+  auto w = at::rand({4, 3, 3, 3}, options);
+  auto b = at::rand({4}, options);
+  auto m = at::rand({1, 5}, options);
+  auto ref = at::matmul(
+      at::adaptive_avg_pool2d(at::relu(at::conv2d(x, w, b, 1, 1)), {1, 1}),
+      m);
+
+  TensorExprKernel k(graph);
+  Stmt* s = k.getCodeGenStmt();
+  std::ostringstream oss;
+  oss << *s;
+  const std::string& verification_pattern =
+      R"IR(
+# CHECK: nnc_aten_conv2d
+# CHECK: for
+# CHECK: nnc_aten_adaptive_avg_pool2d
+# CHECK: nnc_aten_matmul)IR";
+  torch::jit::testing::FileCheck().run(verification_pattern, oss.str());
+
+  std::vector<IValue> stack = fmap<IValue>(std::vector<at::Tensor>{x, w, b, m});
+  k.run(stack);
+  ASSERT_TRUE(at::allclose(stack[0].toTensor(), ref));
+}
+
 TEST_F(Kernel, SanitizeNames_CUDA) {
   const auto graph_string = R"IR(
       graph(%0 : Float(5, 3, strides=[3, 1], device=cuda:0),
@@ -12,6 +12,7 @@
 #include <torch/csrc/jit/tensorexpr/llvm_codegen.h>
 #include <torch/csrc/jit/tensorexpr/loopnest.h>
 #include <torch/csrc/jit/tensorexpr/tensor.h>
+#include <torch/csrc/jit/testing/file_check.h>
 
 #include <cmath>
 #include <numeric>
@@ -1698,6 +1699,115 @@ TEST(LLVM, VectorizedGEMM) {
   ExpectAllNear(c_v, c_ref, 1e-5);
 }
 
+TEST(LLVM, ParallelSimple) {
+  KernelScope kernel_scope;
+  const int M = 4;
+  const int N = 6;
+  Placeholder a(BufHandle("a", {M, N}, kFloat));
+  Placeholder b(BufHandle("b", {M, N}, kFloat));
+  Tensor* c = Compute(
+      "c", {{M, "m"}, {N, "n"}}, [&](const VarHandle& m, const VarHandle& n) {
+        return a.load(m, n) + b.load(m, n);
+      });
+  LoopNest l({c});
+  For* outer = l.getLoopStmtsFor(c)[0];
+  ASSERT_TRUE(LoopNest::isParallelizable(outer));
+  LoopNest::setParallel(outer);
+  l.prepareForCodegen();
+  Stmt* s = IRSimplifier::simplify(l.root_stmt());
+
+  std::ostringstream oss;
+  oss << *s;
+  torch::jit::testing::FileCheck().check("parallel")->run(oss.str());
+
+  LLVMCodeGen cg(s, {a, b, c});
+  std::vector<float> aData(M * N, 1.0f);
+  std::vector<float> bData(M * N, 2.0f);
+  std::vector<float> cData(M * N, 0.0f);
+  cg.call({aData, bData, cData});
+  ExpectAllNear(cData, std::vector<float>(M * N, 3.0f), 1e-7);
+}
+
+TEST(LLVM, ParallelizableChecks) {
+  KernelScope kernel_scope;
+  const int N = 16;
+  Placeholder a(BufHandle("a", {N}, kFloat));
+  Placeholder b(BufHandle("b", {N}, kFloat));
+  VarHandle i("i", kInt);
+
+  // Iterations i = 2k and i = 2k + 1 store to the same element.
+  For* halved = For::make(i, 0, N, b.store({i / 2}, a.load(i)));
+  ASSERT_FALSE(LoopNest::isParallelizable(halved));
+
+  // Iteration i reads what iteration i + 1 stores.
+  For* shifted = For::make(
+      i, 0, N - 1, b.store({i}, b.load(i + 1) + a.load(i)));
+  ASSERT_FALSE(LoopNest::isParallelizable(shifted));
+
+  For* independent = For::make(i, 0, N, b.store({i}, a.load(i) * 2.f));
+  ASSERT_TRUE(LoopNest::isParallelizable(independent));
+}
+
+TEST(LLVM, ParallelDynamicShape) {
+  KernelScope kernel_scope;
+  auto testWithSize = [](int32_t M, int32_t N) {
+    VarHandle m("m", kInt);
+    VarHandle n("n", kInt);
+    Placeholder a(BufHandle("a", {m, n}, kFloat));
+    Tensor* c = Compute(
+        "c", {{m, "m"}, {n, "n"}}, [&](const VarHandle& i, const VarHandle& j) {
+          return a.load(i, j) * 2.f + cast<float>(j);
+        });
+    LoopNest l({c});
+    LoopNest::setParallel(l.getLoopStmtsFor(c)[0]);
+    l.prepareForCodegen();
+    Stmt* s = l.root_stmt();
+    LLVMCodeGen cg(s, {a, c, m, n});
+    std::vector<float> aData(M * N, 1.0f);
+    std::vector<float> cData(M * N, 0.0f);
+    std::vector<float> cRef(M * N);
+    for (int i = 0; i < M; i++) {
+      for (int j = 0; j < N; j++) {
+        cRef[i * N + j] = 2.f + j;
+      }
+    }
+    cg.call({aData, cData, M, N});
+    ExpectAllNear(cData, cRef, 1e-7);
+  };
+  testWithSize(1, 8);
+  testWithSize(16, 32);
+  testWithSize(37, 11);
+}
+
+TEST(LLVM, ParallelReduction) {
+  KernelScope kernel_scope;
+  const int M = 64;
+  const int N = 37;
+  Placeholder a(BufHandle("a", {M, N}, kFloat));
+  Tensor* b = Reduce("sum", {{M, "m"}}, Sum(), a, {{N, "n"}});
+  LoopNest l({b});
+  // The outer loop is over the output axis, so its iterations are independent.
+  For* outer = l.getLoopStmtsFor(b)[0];
+  ASSERT_TRUE(LoopNest::isParallelizable(outer));
+  ASSERT_FALSE(LoopNest::isParallelizable(l.getLoopStmtsFor(b)[1]));
+  LoopNest::setParallel(outer);
+  l.prepareForCodegen();
+  Stmt* s = IRSimplifier::simplify(l.root_stmt());
+  LLVMCodeGen cg(s, {a, b});
+
+  std::vector<float> aData(M * N);
+  std::vector<float> bData(M, -1.f);
+  std::vector<float> bRef(M, 0.f);
+  for (int i = 0; i < M; i++) {
+    for (int j = 0; j < N; j++) {
+      aData[i * N + j] = i + j;
+      bRef[i] += i + j;
+    }
+  }
+  cg.call({aData, bData});
+  ExpectAllNear(bData, bRef, 1e-5);
+}
+
 } // namespace jit
 } // namespace torch
 
@@ -1579,6 +1579,158 @@ class TestFrozenOptimizations(JitTestCase):
         output_f = frozen_mod.forward(input)
         self.assertEqual(output_s, output_f)
 
+    def test_freeze_fuse_add_layer_norm(self):
+        class Net(nn.Module):
+            def __init__(self, activation):
+                super(Net, self).__init__()
+                self.linear = nn.Linear(16, 16)
+                self.norm = nn.LayerNorm(16)
+                self.dropout = nn.Dropout(0.1)
+                self.activation = activation
+
+            def forward(self, x):
+                return self.activation(self.norm(x + self.dropout(self.linear(x))))
+
+        for activation, name in [(nn.Identity(), "none"), (nn.ReLU(), "relu"), (nn.GELU(), "gelu")]:
+            mod = torch.jit.script(Net(activation).eval())
+            frozen_mod = torch.jit.freeze(mod)
+            FileCheck().check("aten::_add_layer_norm").check_not("aten::layer_norm") \
+                .run(frozen_mod.graph)
+            self.assertTrue(any(n.kind() == "prim::Constant" and n.output().toIValue() == name
+                                for n in frozen_mod.graph.nodes()))
+
+            input = torch.randn(2, 3, 16)
+            self.assertEqual(mod(input), frozen_mod(input))
+
+    def test_freeze_fuse_add_layer_norm_multiple_uses(self):
+        class Net(nn.Module):
+            def __init__(self):
+                super(Net, self).__init__()
+                self.norm = nn.LayerNorm(16)
+
+            def forward(self, x, y):
+                z = x + y
+                return self.norm(z), z
+
+        mod = torch.jit.script(Net().eval())
+        frozen_mod = torch.jit.freeze(mod)
+        FileCheck().check("aten::add").check("aten::layer_norm").check_not("aten::_add_layer_norm") \
+            .run(frozen_mod.graph)
+
+    def test_freeze_batch_linears(self):
+        class Net(nn.Module):
+            def __init__(self, bias):
+                super(Net, self).__init__()
+                self.heads = nn.ModuleList([nn.Linear(16, 8, bias=bias) for _ in range(6)])
+                self.proj = nn.Parameter(torch.rand(16, 8))
+
+            def forward(self, x):
+                xs = x.chunk(8, dim=-1)
+                outs = []
+                for i, head in enumerate(self.heads):
+                    outs.append(head(xs[i]))
+                outs.append(torch.matmul(xs[6], self.proj))
+                return torch.cat(outs, dim=-1)
+
+        for bias in [True, False]:
+            mod = torch.jit.script(Net(bias).eval())
+            frozen_mod = torch.jit.freeze(mod)
+            FileCheck().check_count("prim::BatchedLinear", 1, exactly=True).check_not("aten::linear") \
+                .run(frozen_mod.graph)
+            # the matmul has no bias, it only joins the batch of linears without one
+            self.assertEqual("aten::matmul" in str(frozen_mod.graph), bias)
+
+            for input in [torch.randn(3, 5, 128), torch.randn(128)]:
+                self.assertEqual(mod(input), frozen_mod(input))
+
+            buffer = io.BytesIO()
+            torch.jit.save(frozen_mod, buffer)
+            buffer.seek(0)
+            loaded_mod = torch.jit.load(buffer)
+            input = torch.randn(4, 128)
+            self.assertEqual(mod(input), loaded_mod(input))
+
+    def test_freeze_batch_linears_different_shapes(self):
+        class Net(nn.Module):
+            def __init__(self):
+                super(Net, self).__init__()
+                self.heads = nn.ModuleList([nn.Linear(16, 16) for _ in range(4)])
+
+            def forward(self, a, b, c, d):
+                inputs = [a, b, c, d]
+                outs = []
+                for i, head in enumerate(self.heads):
+                    outs.append(head(inputs[i]))
+                return outs
+
+        mod = torch.jit.script(Net().eval())
+        frozen_mod = torch.jit.freeze(mod)
+        FileCheck().check("prim::BatchedLinear").run(frozen_mod.graph)
+        # the inputs can't be stacked, every linear runs on its own
+        inputs = [torch.randn(2, 16), torch.randn(3, 16), torch.randn(16), torch.randn(2, 3, 16)]
+        self.assertEqual(mod(*inputs), frozen_mod(*inputs))
+
+    def test_freeze_batch_linears_dependent(self):
+        class Net(nn.Module):
+            def __init__(self):
+                super(Net, self).__init__()
+                self.heads = nn.ModuleList([nn.Linear(16, 16) for _ in range(4)])
+
+            def forward(self, x):
+                # every head runs on the output of the previous one, and x
+                # is written to in between
+                y = x
+                for head in self.heads:
+                    y = head(y)
+                    x.add_(1)
+                return y + x
+
+        mod = torch.jit.script(Net().eval())
+        frozen_mod = torch.jit.freeze(mod)
+        FileCheck().check_not("prim::BatchedLinear").check_count("aten::linear", 4, exactly=True) \
+            .run(frozen_mod.graph)
+        input = torch.randn(2, 16)
+        self.assertEqual(mod(input.clone()), frozen_mod(input.clone()))
+
+    def test_freeze_batch_linears_inplace_outputs(self):
+        class Net(nn.Module):
+            def __init__(self):
+                super(Net, self).__init__()
+                self.heads = nn.ModuleList([nn.Linear(16, 16) for _ in range(4)])
+
+            def forward(self, x):
+                outs = []
+                for head in self.heads:
+                    y = head(x)
+                    y.relu_()
+                    outs.append(y)
+                return outs
+
+        class Heads(nn.Module):
+            def __init__(self):
+                super(Heads, self).__init__()
+                self.heads = nn.ModuleList([nn.Linear(16, 16) for _ in range(4)])
+
+            def forward(self, x):
+                return [head(x) for head in self.heads]
+
+        # outputs written to in the graph are not batched
+        mod = torch.jit.script(Net().eval())
+        frozen_mod = torch.jit.freeze(mod)
+        FileCheck().check_not("prim::BatchedLinear").run(frozen_mod.graph)
+        input = torch.randn(2, 16)
+        self.assertEqual(mod(input), frozen_mod(input))
+
+        # the outputs of a batch can be written to in grad mode
+        mod = torch.jit.script(Heads().eval())
+        frozen_mod = torch.jit.freeze(mod)
+        FileCheck().check("prim::BatchedLinear").run(frozen_mod.graph)
+        expected = [y.relu() for y in mod(input)]
+        outs = frozen_mod(input)
+        for out in outs:
+            out.relu_()
+        self.assertEqual(outs, expected)
+
     def test_freeze_remove_feature_dropout(self):
         class Net(nn.Module):
             def __init__(self):
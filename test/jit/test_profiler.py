@@ -1,3 +1,4 @@
+import io
 import os
 import sys
 
@@ -250,3 +251,98 @@ class TestProfiler(JitTestCase):
 
         g = torch.jit.last_executed_optimized_graph()
         self.assertEqual(len(list(g.findAllNodes("prim::TensorExprGroup"))), 2)
+
+    def test_export_import_profile(self):
+        class M(torch.nn.Module):
+            def forward(self, a, b):
+                return (a + b) * b - 1
+
+        buffer = io.BytesIO()
+        torch.jit.save(torch.jit.script(M()), buffer)
+        archive = buffer.getvalue()
+
+        x = torch.ones(4, 4)
+        warm = torch.jit.load(io.BytesIO(archive))
+        for _ in range(torch._C._jit_get_num_profiled_runs() + 1):
+            warm(x, x)
+        profile = warm.forward._export_profile()
+        expected = warm(x, x)
+
+        # a replica loading the same archive skips the profiling runs
+        fresh = torch.jit.load(io.BytesIO(archive))
+        self.assertTrue(fresh.forward._import_profile(profile))
+        self.assertEqual(fresh(x, x), expected)
+        g = torch.jit.last_executed_optimized_graph()
+        FileCheck().check("prim::TensorExprGroup").run(g)
+
+        # once an executor has started profiling, or for another graph,
+        # the profile is ignored
+        self.assertFalse(fresh.forward._import_profile(profile))
+
+        @torch.jit.script
+        def other(a, b):
+            return a * b
+
+        self.assertFalse(other._import_profile(profile))
+
+        # profiles of another build, or with a dtype that doesn't exist, are
+        # rejected
+        header, body = profile.split('\n', 1)
+        version, _, fingerprint, num_nodes = header.split(' ')
+        lines = body.split('\n')
+        line = next(i for i, l in enumerate(lines) if l.startswith('profile '))
+        tokens = lines[line].split(' ')
+        tokens[2] = '1000'
+        bad_dtype = '\n'.join([header] + lines[:line] + [' '.join(tokens)] + lines[line + 1:])
+        other_build = ' '.join([version, '0.0.0', fingerprint, num_nodes]) + '\n' + body
+        for bad_profile in [bad_dtype, other_build]:
+            replica = torch.jit.load(io.BytesIO(archive))
+            self.assertFalse(replica.forward._import_profile(bad_profile))
+
+    def test_batch_size_buckets(self):
+        old_buckets = torch._C._jit_set_batch_size_buckets([1, 2, 8])
+        try:
+            @torch.jit.script
+            def foo(x):
+                return x * 2 + 1
+
+            # a bucket of a single batch size specializes on it
+            for _ in range(2):
+                self.assertEqual(foo(torch.ones(2, 4)), torch.full((2, 4), 3.))
+            g = torch.jit.last_executed_optimized_graph()
+            FileCheck().check("prim::TensorExprGroup").run(g)
+
+            # a wider bucket runs one plan for all the batch sizes it covers
+            for batch in [3, 5, 8, 3, 6]:
+                self.assertEqual(foo(torch.ones(batch, 4)), torch.full((batch, 4), 3.))
+            g = torch.jit.last_executed_optimized_graph()
+            FileCheck().check_not("prim::TypeCheck").check("aten::mul").run(g)
+
+            # profiles are kept per bucket
+            with self.assertRaisesRegex(RuntimeError, "batch size buckets"):
+                foo._import_profile("")
+        finally:
+            torch._C._jit_set_batch_size_buckets(old_buckets)
+
+    def test_batch_size_buckets_derived_size(self):
+        old_buckets = torch._C._jit_set_batch_size_buckets([1, 2, 8])
+        try:
+            @torch.jit.script
+            def foo(x):
+                y = x.repeat(2, 1)
+                return y * 2 + 1
+
+            # 2 * B isn't a profiled batch size, so it stays static in the
+            # guard of the fused mul and add
+            x = torch.ones(3, 4)
+            for _ in range(2):
+                self.assertEqual(foo(x), torch.full((6, 4), 3.))
+            g = torch.jit.last_executed_optimized_graph()
+            FileCheck().check("Float(6, 4").check("prim::TypeCheck").run(g)
+
+            # the other batch sizes of the bucket fail the guard and still
+            # get the right result from the fallback
+            for batch in [5, 8, 3, 6]:
+                self.assertEqual(foo(torch.ones(batch, 4)), torch.full((2 * batch, 4), 3.))
+        finally:
+            torch._C._jit_set_batch_size_buckets(old_buckets)
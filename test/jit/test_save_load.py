@@ -5,6 +5,7 @@ import os
 import pathlib
 import random
 import sys
+import zipfile
 
 from torch import Tensor
 from torch.testing._internal.common_utils import TemporaryFileName
@@ -916,6 +917,50 @@ class TestSaveLoad(JitTestCase):
             extra_files['bar'] = ''
             torch.jit.load(buffer, _extra_files=extra_files)
 
+    def test_save_load_stream_pickles(self):
+        class Foo(torch.nn.Module):
+            def __init__(self):
+                super(Foo, self).__init__()
+                self.a = torch.randn(2, 3)
+                self.b = torch.randn(4)
+
+            def forward(self, x):
+                return x + self.a.sum() + self.b.sum()
+
+        sm = torch.jit.script(Foo())
+
+        def save(stream_pickles):
+            prev = torch._C._jit_get_export_stream_pickles()
+            torch._C._jit_set_export_stream_pickles(stream_pickles)
+            try:
+                buffer = io.BytesIO()
+                torch.jit.save(sm, buffer)
+                return buffer.getvalue()
+            finally:
+                torch._C._jit_set_export_stream_pickles(prev)
+
+        default, streamed = save(False), save(True)
+        self.assertFalse(torch._C._jit_get_export_stream_pickles())
+
+        # zipfile is an independent reader, which checks the crc and the
+        # zip64 metadata of the streamed records
+        with zipfile.ZipFile(io.BytesIO(default)) as z_default, \
+                zipfile.ZipFile(io.BytesIO(streamed)) as z_streamed:
+            self.assertIsNone(z_streamed.testzip())
+            names = z_default.namelist()
+            self.assertEqual(sorted(names), sorted(z_streamed.namelist()))
+            for name in names:
+                self.assertEqual(z_default.read(name), z_streamed.read(name))
+            # by default the pickle is written after the tensors it refers to
+            data_pkl = [n for n in names if n.endswith("/data.pkl")][0]
+            tensors = [n for n in names if "/data/" in n]
+            self.assertTrue(all(names.index(t) < names.index(data_pkl) for t in tensors))
+
+        x = torch.randn(3)
+        for archive in (default, streamed):
+            loaded = torch.jit.load(io.BytesIO(archive))
+            self.assertEqual(sm(x), loaded(x))
+
     def test_save_load_using_pathlib(self):
         class MyMod(torch.jit.ScriptModule):
             @torch.jit.script_method
@@ -2697,6 +2697,66 @@ class TestDynamicQuantizedLinear(TestCase):
         self.assertEqual(Y_fp32, Y_fp32_ref,
                          msg="torch.ops.quantized.fbgemm_linear_dynamic results are off")
 
+    @given(
+        batch_size=st.integers(1, 9),
+        input_channels=st.integers(1, 40),
+        output_channels=st.integers(1, 20),
+        use_bias=st.booleans(),
+        use_relu=st.booleans(),
+        use_multi_dim_input=st.booleans(),
+        use_channelwise=st.booleans(),
+        reduce_range=st.booleans())
+    def test_qlinear_no_qengine(self, batch_size, input_channels, output_channels,
+                                use_bias, use_relu, use_multi_dim_input,
+                                use_channelwise, reduce_range):
+        """Tests the portable kernel used when the quantized engine is 'none'.
+
+        Activations are quantized per row, so the result is compared against
+        the float linear on the dequantized weight with a tolerance in the
+        order of the activation quantization error.
+        """
+        X = torch.randn(batch_size, input_channels) * 4 - 1
+        if use_multi_dim_input:
+            X = X.view(1, batch_size, input_channels)
+        W = torch.randn(output_channels, input_channels)
+        b = torch.randn(output_channels) if use_bias else None
+        if use_channelwise:
+            W_scales = W.abs().amax(dim=1).clamp_min(1e-3) / 127
+            W_zps = torch.randint(-3, 4, (output_channels,))
+            W_q = torch.quantize_per_channel(W, W_scales.double(), W_zps, 0, torch.qint8)
+        else:
+            W_q = torch.quantize_per_tensor(W, W.abs().max().item() / 127 + 1e-3, 2, torch.qint8)
+
+        with override_quantized_engine('none'):
+            W_prepack = torch.ops.quantized.linear_prepack(W_q, b)
+            if use_relu:
+                Y = torch.ops.quantized.linear_relu_dynamic(X, W_prepack, reduce_range)
+            else:
+                Y = torch.ops.quantized.linear_dynamic(X, W_prepack, reduce_range)
+            W_unpacked, b_unpacked = torch.ops.quantized.linear_unpack(W_prepack)
+
+        self.assertEqual(W_unpacked.int_repr(), W_q.int_repr())
+        self.assertEqual(W_unpacked.qscheme(), W_q.qscheme())
+        self.assertEqual(b_unpacked, b)
+
+        Y_ref = F.linear(X, W_q.dequantize(), b)
+        if use_relu:
+            Y_ref = F.relu(Y_ref)
+        # Each row of X is quantized with its own scale.
+        X_range = X.amax(dim=-1).clamp_min(0) - X.amin(dim=-1).clamp_max(0)
+        X_scale = X_range / (127 if reduce_range else 255)
+        atol = (X_scale.unsqueeze(-1) * W_q.dequantize().abs().sum(dim=1)).max().item() + 1e-4
+        self.assertEqual(Y, Y_ref, atol=atol, rtol=0)
+
+    def test_qlinear_no_qengine_per_channel_axis(self):
+        """The portable kernel has a scale per output channel, i.e. per row."""
+        W = torch.randn(4, 6)
+        W_q = torch.quantize_per_channel(
+            W, torch.rand(6).double() + 0.1, torch.zeros(6, dtype=torch.long), 1, torch.qint8)
+        with override_quantized_engine('none'):
+            with self.assertRaisesRegex(RuntimeError, "axis 0"):
+                torch.ops.quantized.linear_prepack(W_q, None)
+
 
 class TestDynamicQuantizedRNNOp(TestCase):
     """Tests the correctness of the dynamic quantized lstm/gru."""
@@ -179,6 +179,32 @@ class TestTEFuser(JitTestCase):
             self.checkScript(func, (a,))
             self.assertLastGraphAllFused()
 
+    def test_whole_graph_frozen_module(self):
+        class M(nn.Module):
+            def __init__(self):
+                super(M, self).__init__()
+                self.conv = nn.Conv2d(3, 4, 3, padding=1)
+                self.weight = nn.Parameter(torch.rand(8, 8))
+
+            def forward(self, x):
+                return torch.matmul(F.relu(self.conv(x)), self.weight) + 1
+
+        model = M().eval()
+        frozen = torch.jit.freeze(torch.jit.script(model))
+        x = torch.rand(1, 3, 8, 8)
+        old = torch._C._jit_set_texpr_whole_graph_enabled(True)
+        try:
+            with torch.no_grad():
+                warmup_forward(frozen, x)
+                self.assertEqual(frozen(x), model(x))
+            graph = torch.jit.last_executed_optimized_graph()
+            fusion_groups = self.findFusionGroups(graph)
+            self.assertEqual(len(fusion_groups), 1)
+            FileCheck().check("aten::conv2d").check("aten::relu") \
+                .check("aten::matmul").check("aten::add").run(fusion_groups[0])
+        finally:
+            torch._C._jit_set_texpr_whole_graph_enabled(old)
+
     def test_abs_cpu(self):
         self._test_fused_abs()
 
@@ -5545,6 +5545,29 @@ else:
         for b1, b2, ref, out_tensor in generate_tensor():
             self._test_addbmm_baddbmm("baddbmm", b1, b2, ref, out_tensor)
 
+    # Shapes around the register tiles of the small GEMM kernel used by
+    # bmm / baddbmm / mm on CPU, including row and column tails.
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_bmm_small_gemm_shapes(self, device, dtype):
+        shapes = [(1, 1, 100), (5, 7, 3), (6, 16, 16), (7, 17, 9), (13, 3, 70),
+                  (16, 64, 16), (16, 16, 64), (11, 33, 20), (2, 1, 130)]
+        for (m, k, n), transpose_a in itertools.product(shapes, (False, True)):
+            b1 = make_tensor((4, m, k), device, dtype, low=-1, high=1)
+            if transpose_a:
+                b1 = b1.transpose(1, 2).contiguous().transpose(1, 2)
+            b2 = make_tensor((4, k, n), device, dtype, low=-1, high=1)
+            expect = torch.from_numpy(b1.numpy() @ b2.numpy())
+
+            # The output is not read when beta is zero.
+            out = torch.full((4, m, n), nan, dtype=dtype, device=device)
+            self.assertEqual(torch.bmm(b1, b2, out=out), expect)
+
+            t = make_tensor((4, m, n), device, dtype, low=-1, high=1)
+            self.assertEqual(torch.baddbmm(t, b1, b2, beta=0.5, alpha=2), 0.5 * t + 2 * expect)
+            self.assertEqual(torch.addmm(t[0], b1[0], b2[0], beta=0.5, alpha=2), 0.5 * t[0] + 2 * expect[0])
+            self.assertEqual(torch.mm(b1[0], b2[0]), expect[0])
+
     # TODO: update to compare against NumPy
     @onlyCUDA
     def test_solve_methods_arg_device(self, device):
@@ -7032,6 +7032,36 @@ class TestNN(NNTestCase):
             self.assertEqual(output1, output2)
             self.assertEqual(hidden1, hidden2)
 
+    def test_rnn_fused_cpu_inference(self):
+        # Under no_grad float RNNs on CPU take the fused whole-sequence path,
+        # check it against the differentiable one.
+        lengths = [7, 7, 5, 3, 1]
+        for mode, bidirectional, batch_first, bias in product(
+                ['RNN_TANH', 'RNN_RELU', 'GRU', 'LSTM'], [False, True], [False, True], [False, True]):
+            if mode.startswith('RNN'):
+                rnn = nn.RNN(10, 20, 2, nonlinearity=mode[4:].lower(), bias=bias,
+                             batch_first=batch_first, bidirectional=bidirectional)
+            else:
+                rnn = getattr(nn, mode)(10, 20, 2, bias=bias, batch_first=batch_first,
+                                        bidirectional=bidirectional)
+            num_directions = 2 if bidirectional else 1
+            input = torch.randn(len(lengths), max(lengths), 10)
+            if not batch_first:
+                input = input.transpose(0, 1).contiguous()
+            hx = torch.randn(2 * num_directions, len(lengths), 20)
+            if mode == 'LSTM':
+                hx = (hx, torch.randn_like(hx))
+            packed = rnn_utils.pack_padded_sequence(input, lengths, batch_first=batch_first)
+
+            for inp in (input, packed):
+                output_ref, hy_ref = rnn(inp, hx)
+                with torch.no_grad():
+                    output, hy = rnn(inp, hx)
+                if isinstance(output, rnn_utils.PackedSequence):
+                    output, output_ref = output.data, output_ref.data
+                self.assertEqual(output, output_ref)
+                self.assertEqual(hy, hy_ref)
+
     def test_projections_lstm_initial_hidden_state(self):
         for bidir in [False, True]:
             rnn = nn.LSTM(30, 20, 2, bidirectional=bidir, proj_size=10)
@@ -8733,6 +8763,68 @@ class TestNN(NNTestCase):
                         with cudnn.flags(enabled=False):
                             test(N, C, H, W, mode, padding_mode, align_corners=align_corners)
 
+    def test_grid_sample_plan(self):
+        # See NOTE [ Grid Sample Plans ]
+        for mode, padding_mode, align_corners in itertools.product(
+                ('bilinear', 'nearest', 'bicubic'), ('zeros', 'border', 'reflection'), (True, False)):
+            for N, plan_N, channels_last in ((3, 3, False), (3, 3, True), (4, 1, False), (4, 1, True)):
+                C, IH, IW, H, W = 19, 7, 6, 5, 8
+                input = torch.randn(N, C, IH, IW, dtype=torch.double)
+                if channels_last:
+                    input = input.contiguous(memory_format=torch.channels_last)
+                # some locations fall out of the input
+                grid = torch.rand(plan_N, H, W, 2, dtype=torch.double) * 2.4 - 1.2
+                indices, weights, input_hw = torch._grid_sampler_2d_plan(
+                    grid, (IH, IW), F.GRID_SAMPLE_INTERPOLATION_MODES[mode],
+                    F.GRID_SAMPLE_PADDING_MODES[padding_mode], align_corners)
+                self.assertEqual(indices.dtype, torch.long)
+                self.assertEqual(input_hw.tolist(), [IH, IW])
+
+                input.requires_grad_()
+                out = torch._grid_sampler_2d_apply_plan(input, indices, weights, input_hw)
+                expected = F.grid_sample(input, grid.expand(N, H, W, 2), mode=mode,
+                                         padding_mode=padding_mode, align_corners=align_corners)
+                self.assertEqual(out, expected)
+                if channels_last:
+                    self.assertTrue(out.is_contiguous(memory_format=torch.channels_last))
+
+                grad_output = torch.randn_like(out)
+                grad_input, = torch.autograd.grad(out, input, grad_output)
+                expected_grad_input, = torch.autograd.grad(expected, input, grad_output)
+                self.assertEqual(grad_input, expected_grad_input)
+
+                input = torch.randn(2, 3, IH, IW, dtype=torch.double, requires_grad=True)
+                self.assertTrue(gradcheck(
+                    lambda inp: torch._grid_sampler_2d_apply_plan(inp, indices[:1], weights[:1], input_hw), (input,)))
+                self.assertTrue(gradgradcheck(
+                    lambda inp: torch._grid_sampler_2d_apply_plan(inp, indices[:1], weights[:1], input_hw), (input,)))
+
+        # [N, C, 1, 1] channels last inputs are also contiguous
+        grid = torch.rand(1, 3, 4, 2, dtype=torch.double) * 2 - 1
+        indices, weights, input_hw = torch._grid_sampler_2d_plan(grid, (1, 1), 0, 1, False)
+        input = torch.randn(2, 5, 1, 1, dtype=torch.double).contiguous(memory_format=torch.channels_last)
+        input.requires_grad_()
+        out = torch._grid_sampler_2d_apply_plan(input, indices, weights, input_hw)
+        expected = F.grid_sample(input, grid.expand(2, 3, 4, 2), padding_mode='border', align_corners=False)
+        self.assertEqual(out, expected)
+        grad_output = torch.randn_like(out).contiguous(memory_format=torch.channels_last)
+        grad_input, = torch.autograd.grad(out, input, grad_output)
+        expected_grad_input, = torch.autograd.grad(expected, input, grad_output)
+        self.assertEqual(grad_input, expected_grad_input)
+
+        grid = torch.zeros(1, 2, 2, 2)
+        indices, weights, input_hw = torch._grid_sampler_2d_plan(grid, (5, 5), 0, 0, False)
+        with self.assertRaisesRegex(RuntimeError, r"the plan was made for an input of spatial size \[5, 5\]"):
+            torch._grid_sampler_2d_apply_plan(torch.randn(1, 1, 2, 2), indices, weights, input_hw)
+        # same number of pixels, different layout
+        with self.assertRaisesRegex(RuntimeError, r"the plan was made for an input of spatial size \[5, 5\]"):
+            torch._grid_sampler_2d_apply_plan(torch.randn(1, 1, 1, 25), indices, weights, input_hw)
+        with self.assertRaisesRegex(RuntimeError, "expected input and weights to have same dtype"):
+            torch._grid_sampler_2d_apply_plan(torch.randn(1, 1, 5, 5, dtype=torch.double), indices, weights, input_hw)
+        with self.assertRaisesRegex(RuntimeError, "or a plan of batch size 1"):
+            torch._grid_sampler_2d_apply_plan(
+                torch.randn(2, 1, 5, 5), indices.expand(3, -1, -1, -1), weights.expand(3, -1, -1, -1), input_hw)
+
     def test_grid_sample_3d(self):
         def test(N, C, D, H, W, mode, padding_mode, align_corners):
             def test_shape(N, C, ID, IH, IW, D, H, W, mode, padding_mode, align_corners):
@@ -9164,6 +9256,15 @@ class TestNN(NNTestCase):
                     input = torch.randn(2, 2, 2, 2, requires_grad=True)
                     gradcheck(lambda x: F.interpolate(x, out_size, **kwargs), [input])
 
+            # channels last inputs keep their memory format and match the contiguous result
+            for scale_factor in [0.5, 1, 1.5, 2]:
+                in_t = torch.randn(2, 19, 5, 6)
+                out_t = F.interpolate(in_t, scale_factor=scale_factor, **kwargs)
+                out_cl = F.interpolate(in_t.contiguous(memory_format=torch.channels_last),
+                                       scale_factor=scale_factor, **kwargs)
+                self.assertTrue(out_cl.is_contiguous(memory_format=torch.channels_last))
+                self.assertEqual(out_t, out_cl)
+
     def test_upsampling_not_recompute_scale_factor(self):
         # test output against known input: result must match opencv
         in_t = torch.arange(8.).view(1, 2, 2, 2)
@@ -11494,6 +11595,32 @@ class TestNNDeviceType(NNTestCase):
         if self.device_type == 'cuda':
             self._test_LayerNorm_cuda_half(device)
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_add_layer_norm_cpu(self, device, dtype):
+        activations = {'none': lambda x: x, 'relu': F.relu, 'gelu': F.gelu}
+        # 37 and 768 cover the vectorized body with and without a tail
+        for shape, normalized_shape in [((4, 7, 768), (768,)), ((3, 37), (37,)), ((2, 5, 6), (5, 6))]:
+            input = torch.randn(shape, device=device, dtype=dtype)
+            residual = torch.randn(shape, device=device, dtype=dtype)
+            weight = torch.randn(normalized_shape, device=device, dtype=dtype)
+            bias = torch.randn(normalized_shape, device=device, dtype=dtype)
+            for activation, fn in activations.items():
+                out = torch._add_layer_norm(input, residual, normalized_shape, weight, bias, 1e-5, activation)
+                ref = fn(F.layer_norm(input + residual, normalized_shape, weight, bias, 1e-5))
+                self.assertEqual(out, ref)
+            out = torch._add_layer_norm(input, residual, normalized_shape, None, None, 1e-5)
+            self.assertEqual(out, F.layer_norm(input + residual, normalized_shape))
+
+        # broadcasting residuals go through the unfused ops
+        input = torch.randn(2, 3, 8, device=device, dtype=dtype)
+        residual = torch.randn(8, device=device, dtype=dtype)
+        out = torch._add_layer_norm(input, residual, (8,), None, None, 1e-5, 'relu')
+        self.assertEqual(out, F.relu(F.layer_norm(input + residual, (8,))))
+
+        with self.assertRaisesRegex(RuntimeError, "expected activation"):
+            torch._add_layer_norm(input, input, (8,), None, None, 1e-5, 'tanh')
+
     @onlyOnCPUAndCUDA
     def test_GroupNorm_general(self, device):
         self._test_GroupNorm_general(device)
@@ -11501,6 +11628,49 @@ class TestNNDeviceType(NNTestCase):
         if self.device_type == 'cuda':
             self._test_GroupNorm_cuda_half()
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_GroupNorm_nhwc_cpu(self, device, dtype):
+        for shape, groups in [((4, 8, 3, 3), 2), ((2, 35, 5, 7), 5), ((3, 6, 1, 4), 6)]:
+            mod = nn.GroupNorm(groups, shape[1]).to(device, dtype)
+            mod.weight.data.uniform_()
+            mod.bias.data.uniform_()
+            input = torch.randn(shape, device=device, dtype=dtype)
+            input = input.contiguous(memory_format=torch.channels_last).requires_grad_()
+            ref_input = input.detach().clone().contiguous().requires_grad_()
+            grad = torch.randn(shape, device=device, dtype=dtype)
+
+            out = mod(input)
+            out.backward(grad)
+            ref_out = mod(ref_input)
+            ref_out.backward(grad)
+
+            self.assertTrue(out.is_contiguous(memory_format=torch.channels_last))
+            self.assertEqual(out, ref_out)
+            self.assertEqual(input.grad, ref_input.grad)
+
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_GroupNorm_ndhwc_cpu(self, device, dtype):
+        # there is no NDHWC kernel, channels_last_3d inputs are normalized on
+        # a contiguous copy
+        shape, groups = (2, 6, 3, 4, 5), 3
+        mod = nn.GroupNorm(groups, shape[1]).to(device, dtype)
+        mod.weight.data.uniform_()
+        mod.bias.data.uniform_()
+        input = torch.randn(shape, device=device, dtype=dtype)
+        input = input.contiguous(memory_format=torch.channels_last_3d).requires_grad_()
+        ref_input = input.detach().clone().contiguous().requires_grad_()
+        grad = torch.randn(shape, device=device, dtype=dtype)
+
+        out = mod(input)
+        out.backward(grad)
+        ref_out = mod(ref_input)
+        ref_out.backward(grad)
+
+        self.assertEqual(out, ref_out)
+        self.assertEqual(input.grad, ref_input.grad)
+
     def test_GroupNorm_raises_error_if_one_value_per_group(self, device):
         x = torch.rand(10)[None, :, None]
         with self.assertRaises(ValueError):
@@ -12162,7 +12332,8 @@ class TestNNDeviceType(NNTestCase):
                 with self.assertRaisesRegex(RuntimeError, "not implemented"):
                     output = module(input)
 
-    @onlyCUDA
+    @onlyOnCPUAndCUDA
+    @dtypes(torch.float, torch.double)
     @dtypesIfCUDA(torch.half, torch.float, torch.double)
     def test_avg_pool2d_nhwc(self, device, dtype):
         def helper(n, c, h, w, kernel_size, stride=None,
@@ -12196,7 +12367,8 @@ class TestNNDeviceType(NNTestCase):
         helper(4, 8, 8, 8, 3, count_include_pad=False, padding=2, stride=2)
         helper(4, 8, 8, 8, 3, divisor_override=42)
         helper(4, 8, 8, 8, 7)
-        helper(200, 512, 28, 28, 2)
+        if self.device_type == 'cuda':
+            helper(200, 512, 28, 28, 2)
         helper(4, 8, 7, 7, 3, stride=1)
         helper(4, 8, 7, 7, 3, padding=2, stride=1)
         helper(10, 512, 31, 31, 3, stride=2)
@@ -12289,7 +12461,8 @@ class TestNNDeviceType(NNTestCase):
         helper(1, 100000, 32, 32, ks=4)
         helper(1, 100000, 1, 4, ks=(1, 4))  # test for max_pool1d
 
-    @onlyCUDA
+    @onlyOnCPUAndCUDA
+    @dtypes(torch.float, torch.double)
     @dtypesIfCUDA(torch.half, torch.float, torch.double)
     def test_max_pool2d_nhwc(self, device, dtype):
         def helper(n, c, h, w, kernel_size, stride=None):
@@ -12316,7 +12489,8 @@ class TestNNDeviceType(NNTestCase):
             self.assertTrue(torch.allclose(input.grad, ref_input.grad))
 
         helper(4, 8, 8, 8, 7)
-        helper(200, 512, 28, 28, 2)
+        if self.device_type == 'cuda':
+            helper(200, 512, 28, 28, 2)
         helper(4, 8, 7, 7, 3, stride=1)
         helper(10, 512, 31, 31, 3, stride=2)
         helper(1, 129, 8, 8, 3, stride=2)
@@ -13790,6 +13964,39 @@ class TestNNDeviceType(NNTestCase):
     def test_batchnorm_eval_bfloat16(self, device):
         self._test_batchnorm_eval(device, torch.bfloat16)
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_batchnorm_nhwc_cpu(self, device, dtype):
+        def helper(mod, input, grad):
+            ref_mod = deepcopy(mod)
+            input = input.contiguous(memory_format=torch.channels_last).requires_grad_()
+            grad = grad.contiguous(memory_format=torch.channels_last)
+            ref_input = input.detach().clone().contiguous().requires_grad_()
+            ref_grad = grad.detach().clone().contiguous()
+
+            out = mod(input)
+            out.backward(grad)
+            ref_out = ref_mod(ref_input)
+            ref_out.backward(ref_grad)
+
+            self.assertTrue(out.is_contiguous(memory_format=torch.channels_last))
+            self.assertTrue(ref_out.is_contiguous())
+            self.assertEqual(out, ref_out)
+            self.assertEqual(input.grad, ref_input.grad)
+            self.assertEqual(mod.running_mean, ref_mod.running_mean)
+            self.assertEqual(mod.running_var, ref_mod.running_var)
+
+        for shape in [(4, 8, 2, 2), (2, 35, 5, 7), (3, 1, 4, 4)]:
+            c = shape[1]
+            mod = nn.BatchNorm2d(c).to(device, dtype)
+            mod.weight.data.uniform_()
+            mod.bias.data.uniform_()
+            input = torch.randn(shape, device=device, dtype=dtype)
+            grad = torch.randn(shape, device=device, dtype=dtype)
+            helper(mod, input, grad)
+            mod.eval()
+            helper(mod, input, grad)
+
     def _test_batchnorm_simple_average(self, device, dtype):
         module = nn.BatchNorm1d(3, momentum=None).to(dtype=dtype, device=device)
         zeros = torch.zeros(3, dtype=dtype, device=device)
@@ -14353,6 +14560,42 @@ class TestNNDeviceType(NNTestCase):
         helper(1, 16, 56, 56, out_channels=16, kernel_size=3, groups=1)
         helper(1, 16, 56, 56, out_channels=16, kernel_size=3, groups=16)
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_conv_nhwc_cpu(self, device, dtype):
+        def helper(n, c, h, w, out_channels, kernel_size, groups, **kwargs):
+            conv = nn.Conv2d(c, out_channels, kernel_size, groups=groups, **kwargs).to(device, dtype)
+            input = torch.randn(n, c, h, w, device=device, dtype=dtype)
+            ref_out = conv(input)
+
+            # The direct channels last path is inference only.
+            with torch.no_grad():
+                out = conv(input.contiguous(memory_format=torch.channels_last))
+            self.assertTrue(out.is_contiguous(memory_format=torch.channels_last))
+            self.assertEqual(out, ref_out)
+
+            # With autograd recording, the slow path keeps handling it.
+            out = conv(input.contiguous(memory_format=torch.channels_last))
+            self.assertEqual(out, ref_out)
+
+        with torch.backends.mkldnn.flags(enabled=False):
+            helper(2, 3, 9, 11, out_channels=16, kernel_size=3, groups=1, padding=1)
+            helper(1, 8, 7, 13, out_channels=20, kernel_size=3, groups=1, stride=2, padding=1)
+            helper(1, 32, 7, 7, out_channels=64, kernel_size=1, groups=1, bias=False)
+            helper(1, 12, 9, 9, out_channels=18, kernel_size=3, groups=3, padding=2, dilation=2)
+            helper(2, 4, 5, 5, out_channels=40, kernel_size=(2, 3), groups=2)
+            helper(2, 16, 8, 8, out_channels=16, kernel_size=3, groups=16, padding=1)
+            helper(1, 24, 10, 10, out_channels=24, kernel_size=5, groups=24, stride=2, padding=2, bias=False)
+            helper(1, 6, 5, 8, out_channels=3, kernel_size=(3, 1), groups=1, padding=1, dilation=(2, 1))
+
+            # Without input channels, the output is the bias.
+            input = torch.randn(2, 0, 6, 6, device=device, dtype=dtype).contiguous(memory_format=torch.channels_last)
+            weight = torch.randn(4, 0, 3, 3, device=device, dtype=dtype)
+            bias = torch.randn(4, device=device, dtype=dtype)
+            with torch.no_grad():
+                out = F.conv2d(input, weight, bias)
+            self.assertEqual(out, bias.view(1, 4, 1, 1).expand(2, 4, 4, 4))
+
     def _run_conv(self, layer, device, inp, grad, ref_conv, ref_input, ref_out,
                   input_format, weight_format, grad_format, output_format):
         conv = layer(inp.size(1), grad.size(1),
@@ -701,6 +701,16 @@ class TestReductions(TestCase):
     def test_bincount_alert_nondeterministic(self, device):
         torch.bincount(torch.tensor([], device=device, dtype=torch.long))
 
+    @onlyCPU
+    def test_bincount_parallel(self, device):
+        # large enough for the per-thread private counts
+        for nbins in (1, 7, 1000):
+            input = torch.randint(nbins, (100000,), device=device)
+            weights = torch.rand(100000, device=device, dtype=torch.double)
+            self.assertEqual(input.bincount(), torch.from_numpy(np.bincount(input.numpy())))
+            self.assertEqual(input.bincount(weights),
+                             torch.from_numpy(np.bincount(input.numpy(), weights.numpy())))
+
     # TODO: how many var stability tests are there?
     def test_var_stability2(self, device):
         tensor = torch.FloatTensor([2281.5, 2281.25]).to(device)
@@ -941,6 +951,23 @@ class TestReductions(TestCase):
         test_output_dtype(torch.int32, False)
         test_output_dtype(torch.int64, True)
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double, torch.long)
+    def test_bucketization_1d_boundaries(self, device, dtype):
+        # many values searched in the same boundaries, with duplicated
+        # boundaries, values equal to boundaries and values out of the range
+        for num_boundaries in (1, 2, 5, 64, 1000):
+            boundaries = torch.randint(-50, 50, (num_boundaries,), device=device).to(dtype).sort().values
+            values = torch.randint(-60, 60, (3, 10007), device=device).to(dtype)
+            if dtype.is_floating_point:
+                values[:, ::13] = float('nan')
+            for right in (False, True):
+                side = 'right' if right else 'left'
+                expected = torch.from_numpy(np.searchsorted(boundaries.numpy(), values.numpy(), side=side))
+                self.assertEqual(torch.bucketize(values, boundaries, right=right), expected)
+                self.assertEqual(torch.bucketize(values, boundaries, right=right, out_int32=True),
+                                 expected.to(torch.int32))
+
     @dtypesIfCUDA(torch.half, torch.float, torch.double,
                   torch.int8, torch.short, torch.int, torch.long)
     @dtypes(torch.float, torch.double,
@@ -2174,6 +2201,25 @@ class TestReductions(TestCase):
         noncontig = torch.randn(100, 3, device=device)[:, 2]
         test_against_np(noncontig)
 
+    @onlyCPU
+    @dtypes(torch.float, torch.double)
+    def test_histc_parallel(self, device, dtype):
+        # large enough for the per-thread private histograms, with values out
+        # of the range, on the max and on the edges of the bins
+        input = torch.randn(200003, device=device, dtype=dtype)
+        input[::7] = torch.randint(-4, 5, (input[::7].numel(),), device=device).to(dtype) / 2
+        nan_input = input.clone()
+        nan_input[::1001] = float('nan')
+        for input, bins, min, max in ((nan_input, 10, -2, 2), (nan_input, 1000, -3, 1), (input, 3, 0, 0)):
+            actual = torch.histc(input, bins=bins, min=min, max=max)
+            if min == max:
+                min, max = input.min(), input.max()
+            else:
+                min, max = torch.tensor(min, dtype=dtype), torch.tensor(max, dtype=dtype)
+            in_range = input[(input >= min) & (input <= max)]
+            expected_bins = ((in_range - min) / (max - min) * bins).long().clamp(max=bins - 1)
+            self.assertEqual(actual, torch.bincount(expected_bins, minlength=bins).to(dtype))
+
         multidim = torch.randn(3, 5, 7, 2, device=device)
         test_against_np(multidim)
 
@@ -11,7 +11,7 @@ import random
 from torch.testing._internal.common_utils import (
     TestCase, run_tests, do_test_empty_full, TEST_WITH_ROCM, suppress_warnings,
     torch_to_numpy_dtype_dict, slowTest, TEST_SCIPY, IS_MACOS, IS_PPC,
-    IS_WINDOWS)
+    IS_WINDOWS, make_tensor)
 from torch.testing._internal.common_device_type import (
     instantiate_device_type_tests, deviceCountAtLeast, onlyOnCPUAndCUDA,
     onlyCPU, largeTensorTest, precisionOverride, dtypes,
@@ -1036,6 +1036,37 @@ class TestTensorCreation(TestCase):
         result = torch.cat(concat_list)
         self.assertEqual(result.size(0), SIZE1 + SIZE2)
 
+    @onlyCPU
+    @dtypes(torch.bool, torch.uint8, torch.half, torch.bfloat16, torch.float, torch.long, torch.cfloat)
+    def test_cat_many_small_inputs(self, device, dtype):
+        # contiguous inputs are copied in parallel across inputs and outer
+        # slices; compare with the slices of the result
+        for batch, dim, memory_format in [(1, 1, torch.contiguous_format), (2048, 1, torch.contiguous_format),
+                                          (64, 1, torch.channels_last), (64, 2, torch.channels_last)]:
+            sizes = [random.randint(0, 7) for _ in range(300)]
+            inputs = []
+            for size in sizes:
+                shape = [batch, 3, 2, 2]
+                shape[dim] = size
+                t = make_tensor(shape, device, dtype)
+                inputs.append(t.contiguous(memory_format=memory_format))
+            result = torch.cat(inputs, dim)
+            self.assertEqual(result.size(dim), sum(sizes))
+            self.assertEqual(result, torch.cat([t.contiguous() for t in inputs], dim))
+            self.assertEqual(torch.split(result, sizes, dim), inputs)
+
+    @onlyCPU
+    def test_cat_many_small_inputs_type_promotion(self, device):
+        inputs = [torch.randint(-9, 9, (512, random.randint(1, 5)), device=device, dtype=dtype)
+                  for dtype in (torch.int, torch.long, torch.float, torch.double) for _ in range(50)]
+        result = torch.cat(inputs, 1)
+        self.assertEqual(result.dtype, torch.double)
+        self.assertEqual(result, torch.cat([t.double() for t in inputs], 1))
+
+        out = torch.empty(0, device=device, dtype=torch.long)
+        with self.assertRaisesRegex(RuntimeError, "can't be cast to the desired output type"):
+            torch.cat(inputs, 1, out=out)
+
     @onlyCPU
     def test_cat_bad_input_sizes(self, device):
         x = torch.randn(2, 1, device=device)
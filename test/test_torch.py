@@ -751,6 +751,41 @@ class AbstractTestCases:
             self.assertEqual(seeded, reseeded, atol=0, rtol=0,
                              msg='repeated calls to manual_seed not generating same sequence of normally distributed numbers')
 
+        def test_philox_cpu_rng(self):
+            # See Note [Philox CPU RNG]
+            prev = torch._C._get_philox_cpu_rng()
+            num_threads = torch.get_num_threads()
+            torch._C._set_philox_cpu_rng(True)
+            try:
+                def draw(gen):
+                    return (torch.empty(100003).uniform_(generator=gen),
+                            torch.empty(100003, dtype=torch.double).normal_(generator=gen),
+                            torch.empty(100003).bernoulli_(0.3, generator=gen),
+                            torch.nn.functional.dropout(torch.ones(3, 10001), 0.5))
+
+                gen = torch.Generator().manual_seed(123)
+                torch.manual_seed(123)
+                first = draw(gen)
+                # the results don't depend on the number of threads
+                torch.set_num_threads(1)
+                gen.manual_seed(123)
+                torch.manual_seed(123)
+                self.assertEqual(first, draw(gen), atol=0, rtol=0)
+
+                # the Philox offset is part of the generator state
+                state = gen.get_state()
+                second = draw(gen)
+                gen.set_state(state)
+                self.assertEqual(second, draw(gen), atol=0, rtol=0)
+                self.assertNotEqual(first[0], second[0])
+
+                self.assertEqual(first[0].mean(), 0.5, atol=0.01, rtol=0)
+                self.assertEqual(first[1].std(), 1, atol=0.02, rtol=0)
+                self.assertEqual(first[2].mean(), 0.3, atol=0.01, rtol=0)
+            finally:
+                torch._C._set_philox_cpu_rng(prev)
+                torch.set_num_threads(num_threads)
+
         def test_manual_seed(self):
             rng_state = torch.get_rng_state()
             torch.manual_seed(2)
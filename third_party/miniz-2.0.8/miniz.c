@@ -6641,6 +6641,183 @@ mz_bool mz_zip_writer_add_file(mz_zip_archive *pZip, const char *pArchive_name,
 }
 #endif /* #ifndef MINIZ_NO_STDIO */
 
+mz_bool mz_zip_writer_add_stream_begin(mz_zip_archive *pZip, mz_zip_writer_stream_state *pStream, const char *pArchive_name, mz_uint level_and_flags,
+                                       const char *user_extra_data, mz_uint user_extra_data_len)
+{
+    mz_uint num_alignment_padding_bytes;
+    mz_uint64 cur_archive_file_ofs;
+    size_t archive_name_size;
+    mz_uint8 local_dir_header[MZ_ZIP_LOCAL_DIR_HEADER_SIZE];
+    mz_uint8 extra_data[MZ_ZIP64_MAX_CENTRAL_EXTRA_FIELD_SIZE];
+    mz_uint32 extra_size = 0;
+    mz_uint64 unknown_size = 0;
+    mz_zip_internal_state *pState;
+
+    if ((int)level_and_flags < 0)
+        level_and_flags = MZ_NO_COMPRESSION;
+
+    /* Only stored entries can be streamed, the data is passed through as-is. */
+    if ((!pZip) || (!pZip->m_pState) || (pZip->m_zip_mode != MZ_ZIP_MODE_WRITING) || (!pStream) || (!pArchive_name) ||
+        (level_and_flags & 0xF) || (level_and_flags & MZ_ZIP_FLAG_COMPRESSED_DATA))
+        return mz_zip_set_error(pZip, MZ_ZIP_INVALID_PARAMETER);
+
+    pState = pZip->m_pState;
+    MZ_CLEAR_OBJ(*pStream);
+
+    pStream->m_bit_flags = MZ_ZIP_LDH_BIT_FLAG_HAS_LOCATOR;
+    if (!(level_and_flags & MZ_ZIP_FLAG_ASCII_FILENAME))
+        pStream->m_bit_flags |= MZ_ZIP_GENERAL_PURPOSE_BIT_FLAG_UTF8;
+
+    if (pState->m_zip64)
+    {
+        if (pZip->m_total_files == MZ_UINT32_MAX)
+            return mz_zip_set_error(pZip, MZ_ZIP_TOO_MANY_FILES);
+    }
+    else if (pZip->m_total_files == MZ_UINT16_MAX)
+    {
+        pState->m_zip64 = MZ_TRUE;
+    }
+
+    if (!mz_zip_writer_validate_archive_name(pArchive_name))
+        return mz_zip_set_error(pZip, MZ_ZIP_INVALID_FILENAME);
+
+    archive_name_size = strlen(pArchive_name);
+    if ((archive_name_size > MZ_UINT16_MAX) || ((archive_name_size) && (pArchive_name[archive_name_size - 1] == '/')))
+        return mz_zip_set_error(pZip, MZ_ZIP_INVALID_FILENAME);
+
+#ifndef MINIZ_NO_TIME
+    {
+        MZ_TIME_T cur_time;
+        time(&cur_time);
+        mz_zip_time_t_to_dos_time(cur_time, &pStream->m_dos_time, &pStream->m_dos_date);
+    }
+#endif /* #ifndef MINIZ_NO_TIME */
+
+    num_alignment_padding_bytes = mz_zip_writer_compute_padding_needed_for_file_alignment(pZip);
+    cur_archive_file_ofs = pZip->m_archive_size;
+
+    if (!mz_zip_writer_write_zeros(pZip, cur_archive_file_ofs, num_alignment_padding_bytes))
+        return MZ_FALSE;
+
+    cur_archive_file_ofs += num_alignment_padding_bytes;
+    pStream->m_local_dir_header_ofs = cur_archive_file_ofs;
+
+    /* The size is not known yet and may end up >= 4GB, so the local header always has a zip64 extra field with */
+    /* zero sizes (and the sizes in the header set to 0xFFFFFFFF), which makes the data descriptor a 64-bit one. */
+    /* The real sizes go into the data descriptor and the central directory. */
+    extra_size = mz_zip_writer_create_zip64_extra_data(extra_data, &unknown_size, &unknown_size,
+                                                       (cur_archive_file_ofs >= MZ_UINT32_MAX) ? &pStream->m_local_dir_header_ofs : NULL);
+    pStream->m_local_zip64 = MZ_TRUE;
+
+    MZ_CLEAR_OBJ(local_dir_header);
+    if (!mz_zip_writer_create_local_dir_header(pZip, local_dir_header, (mz_uint16)archive_name_size, extra_size + user_extra_data_len, MZ_UINT32_MAX, MZ_UINT32_MAX, 0, 0, pStream->m_bit_flags, pStream->m_dos_time, pStream->m_dos_date))
+        return mz_zip_set_error(pZip, MZ_ZIP_INTERNAL_ERROR);
+
+    if (pZip->m_pWrite(pZip->m_pIO_opaque, cur_archive_file_ofs, local_dir_header, sizeof(local_dir_header)) != sizeof(local_dir_header))
+        return mz_zip_set_error(pZip, MZ_ZIP_FILE_WRITE_FAILED);
+    cur_archive_file_ofs += sizeof(local_dir_header);
+
+    if (pZip->m_pWrite(pZip->m_pIO_opaque, cur_archive_file_ofs, pArchive_name, archive_name_size) != archive_name_size)
+        return mz_zip_set_error(pZip, MZ_ZIP_FILE_WRITE_FAILED);
+    cur_archive_file_ofs += archive_name_size;
+
+    if (extra_size)
+    {
+        if (pZip->m_pWrite(pZip->m_pIO_opaque, cur_archive_file_ofs, extra_data, extra_size) != extra_size)
+            return mz_zip_set_error(pZip, MZ_ZIP_FILE_WRITE_FAILED);
+        cur_archive_file_ofs += extra_size;
+    }
+
+    if (user_extra_data_len > 0)
+    {
+        if (pZip->m_pWrite(pZip->m_pIO_opaque, cur_archive_file_ofs, user_extra_data, user_extra_data_len) != user_extra_data_len)
+            return mz_zip_set_error(pZip, MZ_ZIP_FILE_WRITE_FAILED);
+        cur_archive_file_ofs += user_extra_data_len;
+    }
+
+    pStream->m_cur_archive_file_ofs = cur_archive_file_ofs;
+    pStream->m_crc32 = MZ_CRC32_INIT;
+    pStream->m_active = MZ_TRUE;
+    return MZ_TRUE;
+}
+
+mz_bool mz_zip_writer_add_stream_write(mz_zip_archive *pZip, mz_zip_writer_stream_state *pStream, const void *pBuf, size_t buf_size)
+{
+    if ((!pZip) || (!pStream) || (!pStream->m_active) || ((buf_size) && (!pBuf)))
+        return mz_zip_set_error(pZip, MZ_ZIP_INVALID_PARAMETER);
+
+    if (!buf_size)
+        return MZ_TRUE;
+
+    if (pZip->m_pWrite(pZip->m_pIO_opaque, pStream->m_cur_archive_file_ofs, pBuf, buf_size) != buf_size)
+        return mz_zip_set_error(pZip, MZ_ZIP_FILE_WRITE_FAILED);
+
+    pStream->m_crc32 = (mz_uint32)mz_crc32(pStream->m_crc32, (const mz_uint8 *)pBuf, buf_size);
+    pStream->m_cur_archive_file_ofs += buf_size;
+    pStream->m_size += buf_size;
+    return MZ_TRUE;
+}
+
+mz_bool mz_zip_writer_add_stream_end(mz_zip_archive *pZip, mz_zip_writer_stream_state *pStream, const char *pArchive_name,
+                                     const char *user_extra_data_central, mz_uint user_extra_data_central_len)
+{
+    mz_uint64 size, local_dir_header_ofs, cur_archive_file_ofs;
+    mz_uint8 local_dir_footer[MZ_ZIP_DATA_DESCRIPTER_SIZE64];
+    mz_uint32 local_dir_footer_size = MZ_ZIP_DATA_DESCRIPTER_SIZE32;
+    mz_uint8 extra_data[MZ_ZIP64_MAX_CENTRAL_EXTRA_FIELD_SIZE];
+    mz_uint32 extra_size = 0;
+    mz_bool wide_sizes;
+
+    if ((!pZip) || (!pZip->m_pState) || (!pStream) || (!pStream->m_active) || (!pArchive_name))
+        return mz_zip_set_error(pZip, MZ_ZIP_INVALID_PARAMETER);
+
+    pStream->m_active = MZ_FALSE;
+    size = pStream->m_size;
+    local_dir_header_ofs = pStream->m_local_dir_header_ofs;
+    cur_archive_file_ofs = pStream->m_cur_archive_file_ofs;
+    wide_sizes = (size >= MZ_UINT32_MAX);
+
+    if ((wide_sizes) && (!pZip->m_pState->m_zip64))
+        return mz_zip_set_error(pZip, MZ_ZIP_FILE_TOO_LARGE);
+
+    MZ_WRITE_LE32(local_dir_footer + 0, MZ_ZIP_DATA_DESCRIPTOR_ID);
+    MZ_WRITE_LE32(local_dir_footer + 4, pStream->m_crc32);
+    /* 8 byte sizes must come with the zip64 extra field in the local header */
+    if ((wide_sizes) && (!pStream->m_local_zip64))
+        return mz_zip_set_error(pZip, MZ_ZIP_INTERNAL_ERROR);
+    if (pStream->m_local_zip64)
+    {
+        MZ_WRITE_LE64(local_dir_footer + 8, size);
+        MZ_WRITE_LE64(local_dir_footer + 16, size);
+        local_dir_footer_size = MZ_ZIP_DATA_DESCRIPTER_SIZE64;
+    }
+    else
+    {
+        MZ_WRITE_LE32(local_dir_footer + 8, size);
+        MZ_WRITE_LE32(local_dir_footer + 12, size);
+    }
+
+    if (pZip->m_pWrite(pZip->m_pIO_opaque, cur_archive_file_ofs, local_dir_footer, local_dir_footer_size) != local_dir_footer_size)
+        return mz_zip_set_error(pZip, MZ_ZIP_FILE_WRITE_FAILED);
+    cur_archive_file_ofs += local_dir_footer_size;
+
+    if ((wide_sizes) || (local_dir_header_ofs >= MZ_UINT32_MAX))
+    {
+        extra_size = mz_zip_writer_create_zip64_extra_data(extra_data, wide_sizes ? &size : NULL, wide_sizes ? &size : NULL,
+                                                           (local_dir_header_ofs >= MZ_UINT32_MAX) ? &local_dir_header_ofs : NULL);
+    }
+
+    if (!mz_zip_writer_add_to_central_dir(pZip, pArchive_name, (mz_uint16)strlen(pArchive_name), extra_size ? extra_data : NULL, (mz_uint16)extra_size, NULL, 0,
+                                          size, size, pStream->m_crc32, 0, pStream->m_bit_flags, pStream->m_dos_time, pStream->m_dos_date, local_dir_header_ofs, 0,
+                                          user_extra_data_central, user_extra_data_central_len))
+        return MZ_FALSE;
+
+    pZip->m_total_files++;
+    pZip->m_archive_size = cur_archive_file_ofs;
+
+    return MZ_TRUE;
+}
+
 static mz_bool mz_zip_writer_update_zip64_extension_block(mz_zip_array *pNew_ext, mz_zip_archive *pZip, const mz_uint8 *pExt, uint32_t ext_len, mz_uint64 *pComp_size, mz_uint64 *pUncomp_size, mz_uint64 *pLocal_header_ofs, mz_uint32 *pDisk_start)
 {
     /* + 64 should be enough for any new zip64 data */
@@ -1281,6 +1281,28 @@ mz_bool mz_zip_writer_add_cfile(mz_zip_archive *pZip, const char *pArchive_name,
                                 const char *user_extra_data_central, mz_uint user_extra_data_central_len);
 #endif
 
+/* Adds a stored (uncompressed) file whose size isn't known up front, by pushing its data in pieces. */
+/* The local header is written with the data descriptor bit set and a zip64 extra field; the size and crc32 are emitted in a 64-bit data descriptor after the data and in the central directory. */
+/* No other file may be added to the archive between mz_zip_writer_add_stream_begin() and mz_zip_writer_add_stream_end(), and pArchive_name must be the same in both calls. */
+typedef struct
+{
+    mz_uint64 m_local_dir_header_ofs;
+    mz_uint64 m_cur_archive_file_ofs;
+    mz_uint64 m_size;
+    mz_uint32 m_crc32;
+    mz_uint16 m_bit_flags;
+    mz_uint16 m_dos_time;
+    mz_uint16 m_dos_date;
+    mz_bool m_local_zip64;
+    mz_bool m_active;
+} mz_zip_writer_stream_state;
+
+mz_bool mz_zip_writer_add_stream_begin(mz_zip_archive *pZip, mz_zip_writer_stream_state *pStream, const char *pArchive_name, mz_uint level_and_flags,
+                                       const char *user_extra_data_local, mz_uint user_extra_data_local_len);
+mz_bool mz_zip_writer_add_stream_write(mz_zip_archive *pZip, mz_zip_writer_stream_state *pStream, const void *pBuf, size_t buf_size);
+mz_bool mz_zip_writer_add_stream_end(mz_zip_archive *pZip, mz_zip_writer_stream_state *pStream, const char *pArchive_name,
+                                     const char *user_extra_data_central, mz_uint user_extra_data_central_len);
+
 /* Adds a file to an archive by fully cloning the data from another archive. */
 /* This function fully clones the source file's compressed data (no recompression), along with its full filename, extra data (it may add or modify the zip64 local header extra data field), and the optional descriptor following the compressed data. */
 mz_bool mz_zip_writer_add_from_zip_reader(mz_zip_archive *pZip, mz_zip_archive *pSource_zip, mz_uint src_file_index);
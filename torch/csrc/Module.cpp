@@ -15,6 +15,7 @@
 #include <ATen/dlpack.h>
 #include <ATen/DLConvertor.h>
 #include <ATen/Parallel.h>
+#include <ATen/TensorIterator.h>
 #include <ATen/Utils.h>
 #include <ATen/VmapMode.h>
 #include <pybind11/pybind11.h>
@@ -481,6 +482,34 @@ PyObject *THPModule_deterministicAlgorithms(PyObject *_unused, PyObject *noargs)
   Py_RETURN_FALSE;
 }
 
+PyObject *THPModule_setCacheTensorIteratorPlans(PyObject *_unused, PyObject *arg)
+{
+  THPUtils_assert(PyBool_Check(arg), "set_cache_tensor_iterator_plans expects a bool, "
+          "but got %s", THPUtils_typename(arg));
+  at::globalContext().setCacheTensorIteratorPlans(arg == Py_True);
+  Py_RETURN_NONE;
+}
+
+PyObject *THPModule_cacheTensorIteratorPlans(PyObject *_unused, PyObject *noargs)
+{
+  if (at::globalContext().cacheTensorIteratorPlans()) Py_RETURN_TRUE;
+  else Py_RETURN_FALSE;
+}
+
+PyObject *THPModule_setUsePhiloxCPURNG(PyObject *_unused, PyObject *arg)
+{
+  THPUtils_assert(PyBool_Check(arg), "set_philox_cpu_rng expects a bool, "
+          "but got %s", THPUtils_typename(arg));
+  at::globalContext().setUsePhiloxCPURNG(arg == Py_True);
+  Py_RETURN_NONE;
+}
+
+PyObject *THPModule_usePhiloxCPURNG(PyObject *_unused, PyObject *noargs)
+{
+  if (at::globalContext().usePhiloxCPURNG()) Py_RETURN_TRUE;
+  else Py_RETURN_FALSE;
+}
+
 PyObject *THPModule_setWarnAlways(PyObject *_unused, PyObject *arg)
 {
   THPUtils_assert(PyBool_Check(arg), "setWarnOnlyOnce expects a bool, "
@@ -682,6 +711,10 @@ static PyMethodDef TorchMethods[] = {
   {"_set_cudnn_deterministic", THPModule_setDeterministicCuDNN, METH_O,  nullptr},
   {"_get_deterministic_algorithms", THPModule_deterministicAlgorithms, METH_NOARGS,     nullptr},
   {"_set_deterministic_algorithms", THPModule_setDeterministicAlgorithms, METH_O,  nullptr},
+  {"_get_cache_tensor_iterator_plans", THPModule_cacheTensorIteratorPlans, METH_NOARGS,     nullptr},
+  {"_set_cache_tensor_iterator_plans", THPModule_setCacheTensorIteratorPlans, METH_O,  nullptr},
+  {"_get_philox_cpu_rng", THPModule_usePhiloxCPURNG, METH_NOARGS,     nullptr},
+  {"_set_philox_cpu_rng", THPModule_setUsePhiloxCPURNG, METH_O,  nullptr},
   {"_get_warnAlways", THPModule_warnAlways, METH_NOARGS,     nullptr},
   {"_set_warnAlways", THPModule_setWarnAlways, METH_O,  nullptr},
   {"_get_cublas_allow_tf32", THPModule_allowTF32CuBLAS, METH_NOARGS,     nullptr},
@@ -918,6 +951,12 @@ PyObject* initModule() {
   py_module.def("_demangle", &c10::demangle);
   py_module.def("_log_api_usage_once", &LogAPIUsageOnceFromPython);
 
+  py_module.def("_tensor_iterator_plan_cache_stats", []() {
+    auto stats = at::tensor_iterator_plan_cache_stats();
+    return std::make_tuple(stats.hits, stats.misses);
+  });
+  py_module.def("_clear_tensor_iterator_plan_cache", &at::clear_tensor_iterator_plan_cache);
+
   py_module.def(
     "init_num_threads",
     torch::wrap_pybind_function(at::init_num_threads),
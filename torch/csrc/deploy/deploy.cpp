@@ -2,8 +2,16 @@
 
 #include <dlfcn.h>
 #include <libgen.h>
+#include <pthread.h>
+#include <sched.h>
 #include <unistd.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <sstream>
+
 // these symbols are generated by cmake, using ld -r -b binary
 // libtorch_deployinterpreter.so which takes the contents of the so and embeds
 // it into a symbol that is then linked into libtorch_deploy.so. This enables us
@@ -15,10 +23,258 @@ extern "C" char _binary_libtorch_deployinterpreter_so_end[];
 namespace torch {
 namespace deploy {
 
+InterpreterManager::InterpreterManager(size_t n_interp)
+    : resources_(n_interp) {
+  for (size_t i = 0; i < n_interp; ++i) {
+    instances_.emplace_back(this);
+    auto I = instances_.back().acquire_session();
+    // make torch.version.interp be the interpreter id
+    // can be used for balancing work across GPUs
+    I.global("torch", "version").attr("__setattr__")({"interp", int(i)});
+    // std::cerr << "Interpreter " << i << " initialized\n";
+  }
+}
+
+InterpreterManager::~InterpreterManager() = default;
+
 Package InterpreterManager::load_package(const std::string& uri) {
   return Package(uri, this);
 }
 
+// A queue of requests per interpreter, served by a worker thread per
+// interpreter. Workers pop their own queue from the front and steal from the
+// back of the others when it is empty, so a long request only holds up the
+// queue it was submitted to until another worker goes idle.
+struct RequestQueues {
+  struct Request {
+    std::function<at::IValue(InterpreterSession&)> fn;
+    std::promise<at::IValue> result;
+    std::chrono::steady_clock::time_point submitted;
+  };
+
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Request> requests;
+    // queued and running requests, used to pick a queue in `submit`
+    std::atomic<size_t> load{0};
+    std::atomic<uint64_t> requests_done{0};
+    std::atomic<uint64_t> stolen{0};
+    std::atomic<uint64_t> total_queue_ns{0};
+    std::atomic<uint64_t> total_run_ns{0};
+    std::atomic<uint64_t> max_run_ns{0};
+  };
+
+  RequestQueues(InterpreterManager* manager, std::vector<std::vector<int>> cpus)
+      : manager_(manager), queues_(manager->instances_.size()) {
+    TORCH_CHECK(
+        cpus.empty() || cpus.size() == queues_.size(),
+        "Expected the cores of ",
+        queues_.size(),
+        " interpreters, got ",
+        cpus.size());
+    for (size_t i = 0; i < queues_.size(); ++i) {
+      workers_.emplace_back(
+          &RequestQueues::work,
+          this,
+          i,
+          cpus.empty() ? std::vector<int>{} : cpus[i]);
+    }
+  }
+
+  ~RequestQueues() {
+    {
+      std::lock_guard<std::mutex> lock(wait_mutex_);
+      stop_ = true;
+    }
+    wait_cv_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  std::future<at::IValue> submit(
+      std::function<at::IValue(InterpreterSession&)> fn,
+      int interp) {
+    size_t where = 0;
+    if (interp >= 0) {
+      TORCH_CHECK(
+          (size_t)interp < queues_.size(), "No interpreter ", interp);
+      where = interp;
+    } else {
+      for (size_t i = 1; i < queues_.size(); ++i) {
+        if (queues_[i].load < queues_[where].load) {
+          where = i;
+        }
+      }
+    }
+    Request request{std::move(fn), {}, std::chrono::steady_clock::now()};
+    auto result = request.result.get_future();
+    auto& queue = queues_[where];
+    {
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      queue.requests.push_back(std::move(request));
+      queue.load++;
+    }
+    {
+      std::lock_guard<std::mutex> lock(wait_mutex_);
+      pending_++;
+    }
+    wait_cv_.notify_one();
+    return result;
+  }
+
+  InterpreterStats stats(size_t interp) const {
+    const auto& queue = queues_.at(interp);
+    InterpreterStats stats;
+    stats.requests = queue.requests_done;
+    stats.stolen = queue.stolen;
+    stats.total_queue_ns = queue.total_queue_ns;
+    stats.total_run_ns = queue.total_run_ns;
+    stats.max_run_ns = queue.max_run_ns;
+    return stats;
+  }
+
+ private:
+  bool pop(size_t idx, Request& request, size_t& owner) {
+    for (size_t i = 0; i < queues_.size(); ++i) {
+      owner = (idx + i) % queues_.size();
+      auto& queue = queues_[owner];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.requests.empty()) {
+        continue;
+      }
+      if (owner == idx) {
+        request = std::move(queue.requests.front());
+        queue.requests.pop_front();
+      } else {
+        request = std::move(queue.requests.back());
+        queue.requests.pop_back();
+      }
+      return true;
+    }
+    return false;
+  }
+
+  void work(size_t idx, std::vector<int> cpus) {
+    if (!cpus.empty()) {
+      cpu_set_t set;
+      CPU_ZERO(&set);
+      for (int cpu : cpus) {
+        CPU_SET(cpu, &set);
+      }
+      int rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+      if (rc != 0) {
+        TORCH_WARN("Failed to pin interpreter ", idx, " (error ", rc, ")");
+      }
+    }
+
+    auto& interp = manager_->instances_[idx];
+    auto& counters = queues_[idx];
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(wait_mutex_);
+        wait_cv_.wait(lock, [&] { return stop_ || pending_ > 0; });
+        if (pending_ == 0) {
+          // stopping and every request was served
+          return;
+        }
+        pending_--;
+      }
+      Request request;
+      size_t owner = 0;
+      // requests are counted in pending_ after they are queued, so there is
+      // one for us, but another worker may take the one we would have found
+      // while we scan the queues
+      while (!pop(idx, request, owner)) {
+      }
+
+      auto start = std::chrono::steady_clock::now();
+      at::IValue result;
+      std::exception_ptr error;
+      try {
+        InterpreterSession I = interp.acquire_session();
+        manager_->resources_.use(idx);
+        I.notify_idx_ = idx;
+        result = request.fn(I);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      auto end = std::chrono::steady_clock::now();
+      queues_[owner].load--;
+
+      auto ns = [](std::chrono::steady_clock::duration d) {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(d)
+            .count();
+      };
+      uint64_t run_ns = ns(end - start);
+      counters.requests_done++;
+      counters.stolen += owner != idx;
+      counters.total_queue_ns += ns(start - request.submitted);
+      counters.total_run_ns += run_ns;
+      uint64_t max_ns = counters.max_run_ns;
+      while (run_ns > max_ns &&
+             !counters.max_run_ns.compare_exchange_weak(max_ns, run_ns)) {
+      }
+
+      // the counters are up to date by the time the caller sees the result
+      if (error) {
+        request.result.set_exception(error);
+      } else {
+        request.result.set_value(std::move(result));
+      }
+    }
+  }
+
+  InterpreterManager* manager_;
+  std::vector<Queue> queues_;
+  std::mutex wait_mutex_;
+  std::condition_variable wait_cv_;
+  // requests queued but not yet popped by a worker
+  size_t pending_ = 0;
+  bool stop_ = false;
+  std::vector<std::thread> workers_;
+};
+
+void InterpreterManager::start_workers(std::vector<std::vector<int>> cpus) {
+  TORCH_CHECK(!queues_, "Workers are already running");
+  queues_ = std::make_unique<RequestQueues>(this, std::move(cpus));
+}
+
+std::future<at::IValue> InterpreterManager::submit(
+    std::function<at::IValue(InterpreterSession&)> fn,
+    int interp) {
+  TORCH_CHECK(queues_, "start_workers must be called before submit");
+  return queues_->submit(std::move(fn), interp);
+}
+
+InterpreterStats InterpreterManager::stats(size_t interp) const {
+  return queues_ ? queues_->stats(interp) : InterpreterStats();
+}
+
+std::vector<int> InterpreterManager::numa_node_cpus(int node) {
+  std::ifstream file(
+      "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+  TORCH_CHECK(file, "Could not read the cores of NUMA node ", node);
+  // a list of ranges, e.g. 0-3,8-11
+  std::vector<int> cpus;
+  std::string range;
+  while (std::getline(file, range, ',')) {
+    int first = 0;
+    int last = 0;
+    char dash = 0;
+    std::istringstream ss(range);
+    // a node without cpus has an empty list
+    if (!(ss >> first)) {
+      continue;
+    }
+    last = (ss >> dash >> last) ? last : first;
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
 Obj InterpreterSession::from_movable(const ReplicatedObj& obj) {
   return impl_->unpickle_or_get(obj.pImpl_->object_id_, obj.pImpl_->data_);
 }
@@ -38,6 +294,15 @@ InterpreterSession::~InterpreterSession() {
   }
 }
 
+std::future<at::IValue> ReplicatedObj::call_async(std::vector<at::IValue> args) {
+  auto self = *this;
+  return pImpl_->manager_->submit(
+      [self, args = std::move(args)](InterpreterSession& I) {
+        I.self = I.from_movable(self);
+        return I.self(args).toIValue();
+      });
+}
+
 void ReplicatedObjImpl::unload(const Interpreter* on_this_interpreter) {
   if (!on_this_interpreter) {
     for (auto& interp : manager_->all_instances()) {
@@ -140,6 +405,10 @@ int LoadBalancer::acquire() {
   return min_idx;
 }
 
+void LoadBalancer::use(int where) {
+  __atomic_fetch_add(&uses_[8 * where], 1ULL, __ATOMIC_SEQ_CST);
+}
+
 void LoadBalancer::free(int where) {
   __atomic_fetch_sub(&uses_[8 * where], 1ULL, __ATOMIC_SEQ_CST);
 }
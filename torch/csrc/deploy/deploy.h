@@ -1,7 +1,10 @@
 #pragma once
 #include <assert.h>
 #include <torch/csrc/deploy/interpreter/interpreter_impl.h>
+#include <atomic>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <string>
 #include <thread>
@@ -12,6 +15,7 @@ namespace deploy {
 
 struct ReplicatedObj;
 struct InterpreterManager;
+struct RequestQueues;
 
 struct TORCH_API InterpreterSession {
   InterpreterSession(
@@ -37,6 +41,7 @@ struct TORCH_API InterpreterSession {
   friend struct Package;
   friend struct InterpreterManager;
   friend struct ReplicatedObjImpl;
+  friend struct RequestQueues;
   std::unique_ptr<InterpreterSessionImpl> impl_;
   InterpreterManager* manager_; // if created from one
   int64_t notify_idx_ = -1;
@@ -82,6 +87,8 @@ struct TORCH_API LoadBalancer {
     n_ = n;
   }
   int acquire();
+  // count a user of an interpreter that was chosen without `acquire`
+  void use(int where);
   void free(int where);
 
  private:
@@ -91,17 +98,21 @@ struct TORCH_API LoadBalancer {
   size_t n_;
 };
 
+// Counters of the requests an interpreter served from the request queues,
+// see `InterpreterManager::start_workers`.
+struct InterpreterStats {
+  uint64_t requests = 0;
+  // requests taken from the queue of another interpreter
+  uint64_t stolen = 0;
+  // time between `submit` and the start of the request
+  uint64_t total_queue_ns = 0;
+  // time spent running the request
+  uint64_t total_run_ns = 0;
+  uint64_t max_run_ns = 0;
+};
+
 struct TORCH_API InterpreterManager {
-  InterpreterManager(size_t n_interp = 2) : resources_(n_interp) {
-    for (size_t i = 0; i < n_interp; ++i) {
-      instances_.emplace_back(this);
-      auto I = instances_.back().acquire_session();
-      // make torch.version.interp be the interpreter id
-      // can be used for balancing work across GPUs
-      I.global("torch", "version").attr("__setattr__")({"interp", int(i)});
-      // std::cerr << "Interpreter " << i << " initialized\n";
-    }
-  }
+  InterpreterManager(size_t n_interp = 2);
   // get a free model, guarenteed that no other user of acquire_one has the same
   // model. It _is_ possible that other users will be using the interpreter.
   InterpreterSession acquire_one() {
@@ -121,6 +132,23 @@ struct TORCH_API InterpreterManager {
     resources_.setResourceLimit(N);
   }
   Package load_package(const std::string& uri);
+
+  // Starts a worker thread per interpreter that serves the requests queued by
+  // `submit`. Each interpreter has its own queue and an idle worker steals
+  // from the others. If `cpus` is not empty, worker i is pinned to the cores
+  // in cpus[i] (e.g. the cores of a NUMA node, see `numa_node_cpus`), which
+  // keeps the state of an interpreter in the caches of those cores.
+  void start_workers(std::vector<std::vector<int>> cpus = {});
+  // Queues `fn` to run with a session of an interpreter. It goes to the queue
+  // of `interp` if given, otherwise to the least loaded queue.
+  std::future<at::IValue> submit(
+      std::function<at::IValue(InterpreterSession&)> fn,
+      int interp = -1);
+  InterpreterStats stats(size_t interp) const;
+  // the cores of NUMA node `node`, as listed by sysfs
+  static std::vector<int> numa_node_cpus(int node);
+
+  ~InterpreterManager();
   InterpreterManager(const InterpreterManager&) = delete;
   InterpreterManager& operator=(const InterpreterManager&) = delete;
   InterpreterManager& operator=(InterpreterManager&&) = delete;
@@ -128,9 +156,12 @@ struct TORCH_API InterpreterManager {
  private:
   friend struct Package;
   friend struct InterpreterSession;
+  friend struct RequestQueues;
   size_t next_object_id_ = 0;
   std::vector<Interpreter> instances_;
   LoadBalancer resources_;
+  // declared last so the workers stop before the interpreters go away
+  std::unique_ptr<RequestQueues> queues_;
 };
 
 struct TORCH_API ReplicatedObjImpl {
@@ -154,6 +185,8 @@ struct TORCH_API ReplicatedObj {
     auto I = acquire_session();
     return I.self(args).toIValue();
   }
+  // runs the object through the request queues of its InterpreterManager
+  std::future<at::IValue> call_async(std::vector<at::IValue> args);
   void unload(const Interpreter* on_this_interpreter = nullptr);
 
  private:
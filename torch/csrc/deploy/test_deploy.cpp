@@ -2,9 +2,11 @@
 #include <torch/csrc/deploy/deploy.h>
 #include <torch/script.h>
 #include <torch/torch.h>
+#include <chrono>
 #include <future>
 #include <iostream>
 #include <string>
+#include <thread>
 
 int main(int argc, char* argv[]) {
   ::testing::InitGoogleTest(&argc, argv);
@@ -121,3 +123,59 @@ TEST(TorchpyTest, ThreadedSimpleModel) {
     ASSERT_TRUE(ref_output.equal(outputs[i]));
   }
 }
+
+TEST(TorchpyTest, QueuedSimpleModel) {
+  size_t ninterp = 3;
+  torch::deploy::InterpreterManager manager(ninterp);
+  // pin every worker to the first core, which always exists
+  manager.start_workers(std::vector<std::vector<int>>(ninterp, {0}));
+
+  torch::deploy::Package p = manager.load_package(path("SIMPLE", simple));
+  auto model = p.load_pickle("model", "model.pkl");
+  auto ref_model = torch::jit::load(path("SIMPLE_JIT", simple_jit));
+
+  auto input = torch::ones({10, 20});
+  size_t nrequests = 30;
+  std::vector<std::future<at::IValue>> futures;
+  for (size_t i = 0; i < nrequests; i++) {
+    futures.push_back(model.call_async({input}));
+  }
+
+  auto ref_output = ref_model.forward({input}).toTensor();
+  for (auto& future : futures) {
+    ASSERT_TRUE(ref_output.equal(future.get().toTensor()));
+  }
+
+  uint64_t served = 0;
+  for (size_t i = 0; i < ninterp; i++) {
+    auto stats = manager.stats(i);
+    ASSERT_LE(stats.max_run_ns, stats.total_run_ns);
+    served += stats.requests;
+  }
+  ASSERT_EQ(served, nrequests);
+
+  // requests queued on one interpreter are taken over by the idle workers
+  std::vector<uint64_t> stolen_before;
+  for (size_t i = 0; i < ninterp; i++) {
+    stolen_before.push_back(manager.stats(i).stolen);
+  }
+  futures.clear();
+  for (size_t i = 0; i < nrequests; i++) {
+    futures.push_back(manager.submit(
+        [](torch::deploy::InterpreterSession&) -> at::IValue {
+          std::this_thread::sleep_for(std::chrono::milliseconds(5));
+          return at::IValue();
+        },
+        0));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+  // the other queues are empty, so the owner has nothing to steal
+  ASSERT_EQ(manager.stats(0).stolen, stolen_before[0]);
+  uint64_t stolen = 0;
+  for (size_t i = 1; i < ninterp; i++) {
+    stolen += manager.stats(i).stolen - stolen_before[i];
+  }
+  ASSERT_GT(stolen, 0);
+}
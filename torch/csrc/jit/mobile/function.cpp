@@ -111,7 +111,29 @@ const at::optional<c10::FunctionSchema>& Function::getSchema() const {
   return schema_;
 }
 
+void Function::set_deferred_init(std::function<void(Function&)> init) {
+  deferred_init_ = std::move(init);
+}
+
+void Function::run_deferred_init() const {
+  if (!deferred_init_) {
+    return;
+  }
+  std::call_once(deferred_init_flag_, [this] {
+    try {
+      deferred_init_(const_cast<Function&>(*this));
+    } catch (...) {
+      // the function may be half built, so every later call fails the same
+      deferred_init_error_ = std::current_exception();
+    }
+  });
+  if (deferred_init_error_) {
+    std::rethrow_exception(deferred_init_error_);
+  }
+}
+
 bool Function::run(Stack& stack) const {
+  run_deferred_init();
   const auto& schema = getSchema();
   if (schema) { // if we have a schema then resolve optional args if any
     schema->checkAndNormalizeInputs(
@@ -127,6 +149,7 @@ c10::IValue Function::operator()(Stack& stack) const {
 }
 
 const std::shared_ptr<Code> Function::get_code() const {
+  run_deferred_init();
   return code_;
 }
 
@@ -2,6 +2,9 @@
 
 #include <ATen/core/function_schema.h>
 #include <ATen/core/ivalue.h>
+#include <exception>
+#include <functional>
+#include <mutex>
 #include <vector>
 
 namespace torch {
@@ -37,9 +40,18 @@ class Function {
   void setSchema(c10::FunctionSchema schema);
   const at::optional<c10::FunctionSchema>& getSchema() const;
 
+  // Defers part of building the function to the first time its code is
+  // needed, see MobileModuleLoadOptions::LAZY_METHODS
+  void set_deferred_init(std::function<void(Function&)> init);
+
  private:
+  void run_deferred_init() const;
+
   c10::QualifiedName name_;
   std::shared_ptr<Code> code_;
+  std::function<void(Function&)> deferred_init_;
+  mutable std::once_flag deferred_init_flag_;
+  mutable std::exception_ptr deferred_init_error_;
   at::optional<c10::FunctionSchema> schema_; // (byte-code version 4+)
   std::vector<std::string> pc_to_module_debug_info_;
 };
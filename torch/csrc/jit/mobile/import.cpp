@@ -1,5 +1,6 @@
 #include <torch/csrc/jit/mobile/import.h>
 
+#include <ATen/Parallel.h>
 #include <ATen/core/ivalue.h>
 #include <caffe2/serialize/inline_container.h>
 #include <torch/csrc/jit/api/compilation_unit.h>
@@ -109,6 +110,54 @@ void print_unsupported_ops_and_throw(
       error_message);
 }
 
+/**
+ * Loads operators by looking them up in the Dispatcher and returns
+ * the set of operator names (with overload) that are not supported
+ * by the current runtime.
+ */
+std::unordered_set<std::string> load_and_find_unsupported_operator_names(
+    const std::vector<IValue>& ops_list,
+    mobile::Function* function,
+    int64_t model_version) {
+  std::unordered_set<std::string> unsupported_op_names;
+  // ops_list is the list of operator names that were read in from
+  // bytecode.plk for the method that is currently being processed.
+  for (const auto& op : ops_list) {
+    auto op_item = op.toTuple()->elements();
+    TORCH_CHECK(
+        op_item.size() == 2, "There should be two parts in an operator name.");
+    auto op_found = function->append_operator(
+        op_item[0].toString()->string(),
+        op_item[1].toString()->string(),
+        model_version);
+    if (!op_found) {
+      unsupported_op_names.emplace(operator_str(
+          op_item[0].toString()->string(), op_item[1].toString()->string()));
+    }
+  }
+  return unsupported_op_names;
+}
+
+void append_types(
+    const std::vector<IValue>& types_list,
+    mobile::Function* function) {
+  static const c10::QualifiedName classPrefix = "__torch__.torch.classes";
+  for (const auto& t : types_list) {
+    c10::QualifiedName qn(t.toStringRef());
+    if (classPrefix.isPrefixOf(qn)) {
+      auto classType = getCustomClass(qn.qualifiedName());
+      TORCH_CHECK(
+          classType,
+          "The implementation of class ",
+          qn.qualifiedName(),
+          " cannot be found.");
+      function->append_type(classType);
+    } else {
+      function->append_type(c10::parseType(t.toStringRef()));
+    }
+  }
+}
+
 // The deserializer class which loads the bytecode package from bc files.
 class BytecodeDeserializer final {
  public:
@@ -136,15 +185,6 @@ class BytecodeDeserializer final {
       std::shared_ptr<mobile::CompilationUnit> mcu);
   std::unordered_map<std::string, std::string> readMobileMetadata(
       std::shared_ptr<mobile::CompilationUnit> mcu);
-  /**
-   * Loads operators by looking them up in the Dispatcher and returns
-   * the set of operator names (with overload) that are not supported
-   * by the current runtime.
-   */
-  std::unordered_set<std::string> load_and_find_unsupported_operator_names(
-      const std::vector<IValue>& ops_list,
-      mobile::Function* function,
-      int64_t model_version) const;
   std::shared_ptr<CompilationUnit> compilation_unit_;
   std::unordered_set<std::string> imported_libs_;
   std::unique_ptr<PyTorchStreamReader> reader_{};
@@ -159,30 +199,6 @@ BytecodeDeserializer::BytecodeDeserializer(
       reader_(std::move(reader)),
       module_load_options_(module_load_options) {}
 
-std::unordered_set<std::string> BytecodeDeserializer::
-    load_and_find_unsupported_operator_names(
-        const std::vector<IValue>& ops_list,
-        mobile::Function* function,
-        int64_t model_version) const {
-  std::unordered_set<std::string> unsupported_op_names;
-  // ops_list is the list of operator names that were read in from
-  // bytecode.plk for the method that is currently being processed.
-  for (const auto& op : ops_list) {
-    auto op_item = op.toTuple()->elements();
-    TORCH_CHECK(
-        op_item.size() == 2, "There should be two parts in an operator name.");
-    auto op_found = function->append_operator(
-        op_item[0].toString()->string(),
-        op_item[1].toString()->string(),
-        model_version);
-    if (!op_found) {
-      unsupported_op_names.emplace(operator_str(
-          op_item[0].toString()->string(), op_item[1].toString()->string()));
-    }
-  }
-  return unsupported_op_names;
-}
-
 TypePtr BytecodeDeserializer::resolveTypeName(const c10::QualifiedName& qn) {
   // HACK: first we check whether the name starts with special prefix to
   // tell if it's a supported pytorch class type. There are two special
@@ -236,6 +252,18 @@ void BytecodeDeserializer::parseMethods(
         "The numbers of bytecode values and debug info values do not match.");
   }
 
+  const bool check_operators =
+      module_load_options_ & MobileModuleLoadOptions::OPERATOR_CHECK;
+  const bool lazy_methods =
+      module_load_options_ & MobileModuleLoadOptions::LAZY_METHODS;
+  const bool parallel_lookup = !lazy_methods &&
+      (module_load_options_ &
+       MobileModuleLoadOptions::PARALLEL_OPERATOR_LOOKUP);
+  // With PARALLEL_OPERATOR_LOOKUP the operators of all the methods are
+  // looked up after the loop, once every function has been built.
+  std::vector<std::pair<mobile::Function*, std::vector<IValue>>>
+      pending_operators;
+
   // Process all methods in this mobile module.
   for (size_t i = method_i_start; i < vals.size(); ++i) {
     const auto& element = vals[i];
@@ -310,34 +338,37 @@ void BytecodeDeserializer::parseMethods(
       }
     }
 
-    std::unordered_set<std::string> unsupported_op_names =
-        load_and_find_unsupported_operator_names(
-            ops_list, function.get(), model_version);
-    if ((module_load_options_ & MobileModuleLoadOptions::OPERATOR_CHECK) &&
-        !unsupported_op_names.empty()) {
-      print_unsupported_ops_and_throw(unsupported_op_names);
+    if (lazy_methods) {
+      // The operator lookup and the type parsing dominate the load time of
+      // large models, so they are left to the first call of the method.
+      function->set_deferred_init(
+          [ops_list, types_list, model_version, check_operators](
+              mobile::Function& f) {
+            auto unsupported_op_names =
+                load_and_find_unsupported_operator_names(
+                    ops_list, &f, model_version);
+            if (check_operators && !unsupported_op_names.empty()) {
+              print_unsupported_ops_and_throw(unsupported_op_names);
+            }
+            append_types(types_list, &f);
+          });
+    } else if (parallel_lookup) {
+      pending_operators.emplace_back(function.get(), ops_list);
+      append_types(types_list, function.get());
+    } else {
+      std::unordered_set<std::string> unsupported_op_names =
+          load_and_find_unsupported_operator_names(
+              ops_list, function.get(), model_version);
+      if (check_operators && !unsupported_op_names.empty()) {
+        print_unsupported_ops_and_throw(unsupported_op_names);
+      }
+      append_types(types_list, function.get());
     }
 
     for (const auto& constant : consts_list) {
       function->append_constant(constant);
     }
 
-    static const c10::QualifiedName classPrefix = "__torch__.torch.classes";
-    for (const auto& t : types_list) {
-      c10::QualifiedName qn(t.toStringRef());
-      if (classPrefix.isPrefixOf(qn)) {
-        auto classType = getCustomClass(qn.qualifiedName());
-        TORCH_CHECK(
-            classType,
-            "The implementation of class ",
-            qn.qualifiedName(),
-            " cannot be found.");
-        function->append_type(classType);
-      } else {
-        function->append_type(c10::parseType(t.toStringRef()));
-      }
-    }
-
     function->set_register_size(register_size);
 
     // function schema
@@ -383,6 +414,29 @@ void BytecodeDeserializer::parseMethods(
 
     mcu.register_function(std::move(function));
   }
+
+  if (!pending_operators.empty()) {
+    // Every task only appends to its own function, and the operator
+    // registry and the dispatcher serialize the lookups themselves.
+    std::vector<std::unordered_set<std::string>> unsupported(
+        pending_operators.size());
+    at::parallel_for(
+        0, pending_operators.size(), 1, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            unsupported[i] = load_and_find_unsupported_operator_names(
+                pending_operators[i].second,
+                pending_operators[i].first,
+                model_version);
+          }
+        });
+    std::unordered_set<std::string> unsupported_op_names;
+    for (const auto& names : unsupported) {
+      unsupported_op_names.insert(names.begin(), names.end());
+    }
+    if (check_operators && !unsupported_op_names.empty()) {
+      print_unsupported_ops_and_throw(unsupported_op_names);
+    }
+  }
 }
 
 std::unordered_map<std::string, std::string> BytecodeDeserializer::
@@ -437,7 +491,17 @@ mobile::Module BytecodeDeserializer::deserialize(
   }
   parseMethods(bvals, debug_info_bvals, *mcu);
   auto meta_dict = readMobileMetadata(mcu);
-  return mobile::Module(readArchive("data", mcu).toObject(), meta_dict, mcu);
+  mobile::Module result(readArchive("data", mcu).toObject(), meta_dict, mcu);
+  const std::string plans_key =
+      std::string("extra/") + mobile::kAllocationPlansExtraFile;
+  if (reader_->hasRecord(plans_key)) {
+    at::DataPtr plans_ptr;
+    size_t plans_size = 0;
+    std::tie(plans_ptr, plans_size) = reader_->getRecord(plans_key);
+    result.import_allocation_plans(
+        std::string(static_cast<char*>(plans_ptr.get()), plans_size));
+  }
+  return result;
 }
 
 std::unordered_map<std::string, std::string> BytecodeDeserializer::
@@ -460,23 +524,7 @@ c10::IValue BytecodeDeserializer::readArchive(
     std::shared_ptr<mobile::CompilationUnit> mcu) {
   std::stringstream picklename;
   picklename << archive_name << ".pkl";
-  at::DataPtr pickle_ptr;
-  size_t pickle_size;
-  std::tie(pickle_ptr, pickle_size) = reader_->getRecord(picklename.str());
-
-  size_t bytes_read = 0;
-  auto data = reinterpret_cast<const char*>(pickle_ptr.get());
-  auto reader = [&](char* buffer, size_t len) -> size_t {
-    if (bytes_read >= pickle_size) {
-      return 0;
-    }
-    len = std::min(pickle_size - bytes_read, len);
-    // Copy len bytes into buffer
-    const char* start = data + bytes_read;
-    std::memcpy(buffer, start, len);
-    bytes_read += len;
-    return len;
-  };
+  auto reader = reader_->getRecordReader(picklename.str());
 
   auto type_resolver = [this](const c10::QualifiedName& qn) {
     return c10::StrongTypePtr(compilation_unit_, resolveTypeName(qn));
@@ -585,6 +633,17 @@ mobile::Module _load_for_mobile(
   return module;
 }
 
+mobile::Module _load_for_mobile(
+    std::istream& in,
+    c10::optional<at::Device> device,
+    ExtraFilesMap& extra_files,
+    uint64_t module_load_options) {
+  std::unique_ptr<IStreamAdapter> rai = std::make_unique<IStreamAdapter>(&in);
+  auto module = _load_for_mobile_impl(
+      std::move(rai), device, extra_files, module_load_options);
+  return module;
+}
+
 mobile::Module _load_for_mobile(
     const std::string& filename,
     c10::optional<at::Device> device,
@@ -15,6 +15,13 @@ using ExtraFilesMap = std::unordered_map<std::string, std::string>;
 
 enum MobileModuleLoadOptions {
   OPERATOR_CHECK = 1,
+  // Look up the operators and parse the types of a method on its first call
+  // instead of at load time, for apps that only run some of the methods. The
+  // OPERATOR_CHECK failure of a method is then raised by that call.
+  LAZY_METHODS = 2,
+  // Look up the operators of all the methods on the intra-op thread pool.
+  // Ignored with LAZY_METHODS.
+  PARALLEL_OPERATOR_LOOKUP = 4,
 };
 
 const uint64_t _default_mobile_module_load_options =
@@ -37,6 +44,12 @@ TORCH_API mobile::Module _load_for_mobile(
     c10::optional<c10::Device> device,
     ExtraFilesMap& extra_files);
 
+TORCH_API mobile::Module _load_for_mobile(
+    std::istream& in,
+    c10::optional<at::Device> device,
+    ExtraFilesMap& extra_files,
+    uint64_t module_load_options);
+
 TORCH_API mobile::Module _load_for_mobile(
     const std::string& filename,
     c10::optional<at::Device> device,
@@ -60,23 +60,7 @@ c10::IValue BytecodeDeserializer::readArchive(
     c10::optional<at::Device> device) {
   std::stringstream picklename;
   picklename << archive_name << ".pkl";
-  at::DataPtr pickle_ptr;
-  size_t pickle_size;
-  std::tie(pickle_ptr, pickle_size) = reader_->getRecord(picklename.str());
-
-  size_t bytes_read = 0;
-  auto data = reinterpret_cast<const char*>(pickle_ptr.get());
-  auto reader = [&](char* buffer, size_t len) -> size_t {
-    if (bytes_read >= pickle_size) {
-      return 0;
-    }
-    len = std::min(pickle_size - bytes_read, len);
-    // Copy len bytes into buffer
-    const char* start = data + bytes_read;
-    std::memcpy(buffer, start, len);
-    bytes_read += len;
-    return len;
-  };
+  auto reader = reader_->getRecordReader(picklename.str());
 
   static const c10::QualifiedName torchPrefix = "__torch__";
   auto type_resolver = [&](const c10::QualifiedName& qn) {
@@ -4,7 +4,10 @@
 #include <torch/csrc/jit/mobile/observer.h>
 #include <torch/csrc/jit/runtime/jit_exception.h>
 #include <exception>
+#include <limits>
+#include <sstream>
 
+#include <ATen/core/functional.h>
 #include <ATen/record_function.h>
 
 namespace torch {
@@ -117,6 +120,193 @@ bool Module::is_training() const {
   return true;
 }
 
+namespace {
+// A plan only replays when the allocations of the method are the same, so
+// it is keyed by everything in the inputs that decides the sizes.
+c10::optional<std::string> allocation_plan_key(
+    const std::string& method_name,
+    const Stack& inputs) {
+  std::ostringstream ss;
+  ss << method_name;
+  for (const auto& input : inputs) {
+    if (input.isTensor()) {
+      const auto& t = input.toTensor();
+      if (!t.defined()) {
+        ss << " undefined";
+        continue;
+      }
+      ss << " " << t.scalar_type() << t.sizes()
+         << (t.is_contiguous() ? "" : "nc");
+    } else if (
+        input.isInt() || input.isDouble() || input.isBool() ||
+        input.isNone()) {
+      ss << " " << input;
+    } else {
+      return c10::nullopt;
+    }
+  }
+  return ss.str();
+}
+
+void add_allocation_plan(
+    std::unordered_map<std::string, std::unique_ptr<PlannedAllocations>>&
+        plans,
+    const std::string& key,
+    std::unique_ptr<PlannedAllocations> planned) {
+  // Allocate the arena now rather than in the first planned call
+  planned->allocator.set_plan(&planned->plan);
+  planned->allocator.unset_plan();
+  plans[key] = std::move(planned);
+}
+
+// Copies the tensors of a value that are in the arena of the allocator, so
+// that they outlive the planned call.
+c10::IValue copy_out_of_arena(
+    const c10::IValue& value,
+    const c10::CPUProfilingAllocator& allocator) {
+  if (value.isTensor()) {
+    const auto& t = value.toTensor();
+    if (t.defined() && t.has_storage() && allocator.owns(t.storage().data())) {
+      return t.clone();
+    }
+  } else if (value.isTuple()) {
+    return c10::ivalue::Tuple::create(
+        fmap(value.toTuple()->elements(), [&](const c10::IValue& elem) {
+          return copy_out_of_arena(elem, allocator);
+        }));
+  } else if (value.isList()) {
+    auto list = value.toList();
+    for (size_t i = 0; i < list.size(); ++i) {
+      list.set(i, copy_out_of_arena(list.get(i), allocator));
+    }
+  }
+  return value;
+}
+
+// Runs the function in the arena of the plan, with planned.mutex held. The
+// key of a plan does not capture everything that decides the allocations:
+// data dependent sizes, control flow on values, or a plan imported from a
+// build with other kernels. Once a call departs from the plan, its following
+// allocations go to malloc and the call completes as usual; the plan is then
+// disabled. The call is not run again, as it may have side effects like
+// updating its inputs in place.
+void run_with_allocation_plan(
+    const Function& function,
+    PlannedAllocations& planned,
+    Stack& stack) {
+  c10::WithProfilingAllocatorGuard guard(
+      &planned.allocator, &planned.plan, /*fallback_on_mismatch=*/true);
+  try {
+    function.run(stack);
+  } catch (...) {
+    // Tensors from the arena must not outlive the planned call
+    stack.clear();
+    throw;
+  }
+  // Outputs are not planned in the arena, unless the allocations diverged.
+  // The copies are made while the guard is active, so that the originals go
+  // back to the arena.
+  bool diverged =
+      planned.allocator.diverged() || planned.allocator.has_live_allocations();
+  if (planned.allocator.has_live_allocations()) {
+    for (auto& value : stack) {
+      value = copy_out_of_arena(value, planned.allocator);
+    }
+  }
+  if (!diverged) {
+    planned.num_replays++;
+    return;
+  }
+  planned.disabled = true;
+  TORCH_CHECK(
+      !planned.allocator.has_live_allocations(),
+      "Tensors allocated from the allocation plan outlive the call, e.g. in "
+      "attributes of the module.");
+}
+} // namespace
+
+void Module::record_allocation_plan(
+    const std::string& method_name,
+    const std::vector<c10::IValue>& inputs) {
+  auto key = allocation_plan_key(method_name, inputs);
+  TORCH_CHECK(
+      key,
+      "Cannot plan the allocations of method '",
+      method_name,
+      "' for inputs other than tensors and scalars.");
+  auto method = get_method(method_name);
+  // The first call may build the method and fill caches, which would not
+  // be repeated by the planned calls.
+  method(inputs);
+  auto planned = std::make_unique<PlannedAllocations>();
+  {
+    c10::WithProfileAllocationsGuard profile_guard(&planned->plan);
+    method(inputs);
+  }
+  bool success = false;
+  {
+    c10::WithValidateAllocationPlanGuard validation_guard(
+        &planned->plan, &success);
+    method(inputs);
+  }
+  TORCH_CHECK(
+      success,
+      "The allocations of method '",
+      method_name,
+      "' change from call to call and cannot be planned.");
+  add_allocation_plan(*allocation_plans_, *key, std::move(planned));
+}
+
+std::string Module::export_allocation_plans() const {
+  // <header> <num plans>, then a line for the key and a line for the plan
+  std::ostringstream ss;
+  ss << "mobile_allocation_plans_v1 " << allocation_plans_->size() << "\n";
+  for (const auto& kv : *allocation_plans_) {
+    ss << kv.first << "\n" << kv.second->plan.serialize() << "\n";
+  }
+  return ss.str();
+}
+
+void Module::import_allocation_plans(const std::string& plans) {
+  std::istringstream ss(plans);
+  std::string header;
+  size_t num_plans = 0;
+  ss >> header >> num_plans;
+  TORCH_CHECK(
+      ss && header == "mobile_allocation_plans_v1",
+      "Unsupported format of mobile allocation plans.");
+  ss.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  for (size_t i = 0; i < num_plans; ++i) {
+    std::string key, plan;
+    TORCH_CHECK(
+        std::getline(ss, key) && std::getline(ss, plan),
+        "Truncated mobile allocation plans.");
+    auto planned = std::make_unique<PlannedAllocations>();
+    planned->plan = c10::AllocationPlan::deserialize(plan);
+    add_allocation_plan(*allocation_plans_, key, std::move(planned));
+  }
+}
+
+PlannedAllocations* Module::find_allocation_plan(
+    const std::string& method_name,
+    const Stack& inputs) const {
+  // Plans do not nest, and are not used while another one is recorded.
+  if (allocation_plans_->empty() ||
+      c10::GetThreadLocalProfilingAllocator() != nullptr ||
+      c10::GetThreadLocalAllocationPlanner() != nullptr) {
+    return nullptr;
+  }
+  auto key = allocation_plan_key(method_name, inputs);
+  if (!key) {
+    return nullptr;
+  }
+  auto it = allocation_plans_->find(*key);
+  if (it == allocation_plans_->end() || it->second->disabled) {
+    return nullptr;
+  }
+  return it->second.get();
+}
+
 const std::vector<Method> Module::get_methods() const {
   std::vector<Method> methods;
   for (std::unique_ptr<Function>& fn : cu_->methods()) {
@@ -149,9 +339,24 @@ void Method::run(Stack& stack) const {
   debug_info->setMethodName(function_->name());
   at::DebugInfoGuard guard(at::DebugInfoKind::MOBILE_RUNTIME_INFO, debug_info);
 
+  // A planned call holds the arena of its plan; concurrent calls with the
+  // same inputs use the default allocation instead.
+  std::unique_lock<std::mutex> plan_lock;
+  auto planned = owner_->find_allocation_plan(function_->name(), stack);
+  if (planned) {
+    plan_lock = std::unique_lock<std::mutex>(planned->mutex, std::try_to_lock);
+    if (!plan_lock.owns_lock()) {
+      planned = nullptr;
+    }
+  }
+
   try {
     stack.insert(stack.begin(), owner_->_ivalue()); // self
-    function_->run(stack);
+    if (planned) {
+      run_with_allocation_plan(*function_, *planned, stack);
+    } else {
+      function_->run(stack);
+    }
     if (observer) {
       observer->onExitRunMethod(instance_key);
     }
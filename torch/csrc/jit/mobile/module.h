@@ -1,8 +1,12 @@
 #pragma once
 #include <ATen/core/jit_type.h>
+#include <c10/mobile/CPUProfilingAllocator.h>
 #include <torch/csrc/jit/mobile/function.h>
 #include <torch/csrc/jit/mobile/method.h>
 
+#include <atomic>
+#include <mutex>
+
 namespace torch {
 namespace jit {
 namespace mobile {
@@ -41,6 +45,23 @@ class CompilationUnit {
   std::vector<std::unique_ptr<Function>> methods_;
 };
 
+// Name of the extra file of a .ptl archive that holds the allocation plans
+// of its methods, as returned by Module::export_allocation_plans.
+constexpr const char* kAllocationPlansExtraFile = "mobile_allocation_plans";
+
+// The allocation plan recorded for a method and an input signature, and the
+// arena it is replayed in. The arena serves one call at a time.
+struct PlannedAllocations {
+  c10::AllocationPlan plan;
+  c10::CPUProfilingAllocator allocator;
+  std::mutex mutex;
+  // Set when a call did not allocate as planned, after which the plan is
+  // not used anymore.
+  std::atomic<bool> disabled{false};
+  // Calls that ran in the arena, guarded by mutex.
+  size_t num_replays{0};
+};
+
 // A Torch Mobile Module is a representation of the model (trained in case
 // of inference). A Mobile Module contains
 //
@@ -97,6 +118,25 @@ class TORCH_API Module {
   }
   const std::vector<Method> get_methods() const;
 
+  // Runs the method on the inputs to record the allocations it makes. The
+  // later calls with inputs of the same dtypes and sizes then take their
+  // intermediate tensors from a single arena allocated up front, instead of
+  // going to malloc. Only the mobile CPU allocator is planned, and the inputs
+  // can only be tensors and scalars. Not thread safe with calls of the
+  // module.
+  void record_allocation_plan(
+      const std::string& method_name,
+      const std::vector<c10::IValue>& inputs);
+  // Saving the string as the kAllocationPlansExtraFile extra file of the
+  // model makes _load_for_mobile import the plans.
+  std::string export_allocation_plans() const;
+  void import_allocation_plans(const std::string& plans);
+  // Returns the plan to run the method with, if any, given its inputs
+  // without self.
+  PlannedAllocations* find_allocation_plan(
+      const std::string& method_name,
+      const Stack& inputs) const;
+
   c10::IValue attr(const std::string& name, c10::IValue or_else) const {
     if (auto r = object_->type()->findAttributeSlot(name)) {
       return object_->getSlot(*r);
@@ -111,6 +151,13 @@ class TORCH_API Module {
   c10::intrusive_ptr<c10::ivalue::Object> object_;
   std::unordered_map<std::string, std::string> metadata_;
   std::shared_ptr<CompilationUnit> cu_;
+  // Keyed by method name and input signature, shared by the copies of the
+  // module.
+  std::shared_ptr<
+      std::unordered_map<std::string, std::unique_ptr<PlannedAllocations>>>
+      allocation_plans_ = std::make_shared<std::unordered_map<
+          std::string,
+          std::unique_ptr<PlannedAllocations>>>();
 };
 } // namespace mobile
 } // namespace jit
@@ -2,6 +2,8 @@
 #include <torch/csrc/jit/ir/ir_views.h>
 #include <torch/csrc/jit/passes/frozen_conv_folding.h>
 #include <torch/csrc/jit/passes/frozen_graph_optimizations.h>
+#include <torch/csrc/jit/passes/frozen_linear_batching.h>
+#include <torch/csrc/jit/passes/fuse_add_layer_norm.h>
 #include <torch/csrc/jit/passes/remove_dropout.h>
 #include <torch/csrc/jit/runtime/graph_executor.h>
 #include <torch/csrc/utils/memory.h>
@@ -20,7 +22,10 @@ void OptimizeFrozenGraph(
       FoldFrozenConvAddOrSub(graph);
       FoldFrozenConvMulOrDiv(graph);
     }
+    // bmm doesn't round exactly like the separate mm calls
+    BatchFrozenLinears(graph);
   }
+  FuseAddLayerNorm(graph);
 }
 
 } // namespace jit
@@ -8,6 +8,8 @@
  * - FoldFrozenConvBatchnorm
  * - FoldFrozenConvAddOrSub
  * - FoldFrozenConvMulOrDiv
+ * - BatchFrozenLinears
+ * - FuseAddLayerNorm
  */
 
 namespace torch {
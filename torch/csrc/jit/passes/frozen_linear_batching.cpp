@@ -0,0 +1,269 @@
+#include <torch/csrc/jit/passes/frozen_linear_batching.h>
+
+#include <ATen/ATen.h>
+#include <ATen/core/functional.h>
+#include <c10/util/Exception.h>
+#include <torch/csrc/jit/ir/alias_analysis.h>
+#include <torch/csrc/jit/ir/constants.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/runtime/custom_operator.h>
+
+#include <algorithm>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+c10::AliasAnalysisKind aliasAnalysisFromSchema() {
+  return AliasAnalysisKind::FROM_SCHEMA;
+}
+
+// Multi-head models run many linear layers of the same shape on different
+// weights, each of them too small to keep all the cores busy. Once the module
+// is frozen the weights are constants, so they can be stacked into a single
+// [n, K, N] tensor ahead of time:
+//
+//  %y1 = aten::linear(%x1, %w1, %b1)     %xs = prim::ListConstruct(%x1, ...)
+//  %y2 = aten::linear(%x2, %w2, %b2)  => %ys = prim::BatchedLinear(%xs, %w, %b)
+//  ...                                   %y1, ... = prim::ListUnpack(%ys)
+//
+// prim::BatchedLinear stacks the inputs and runs a single bmm (or baddbmm with
+// the stacked biases). It has a schema, so frozen modules that went through
+// this pass can still be saved and loaded.
+
+// Tunable parameter. Stacking copies the inputs, so there is nothing to gain
+// for a couple of linears.
+static constexpr size_t min_batch_size = 4;
+
+// The inputs can only be stacked when they all have the same shape, which is
+// not known at freeze time; otherwise each linear runs on its own slice of the
+// stacked weights.
+bool can_stack(at::TensorList inputs, const at::Tensor& weight) {
+  const auto& first = inputs[0];
+  if (first.dim() == 0 || first.numel() == 0 ||
+      first.size(-1) != weight.size(1)) {
+    return false;
+  }
+  return std::all_of(inputs.begin(), inputs.end(), [&](const at::Tensor& t) {
+    return t.sizes() == first.sizes() &&
+        t.scalar_type() == weight.scalar_type() &&
+        t.device() == weight.device();
+  });
+}
+
+std::vector<at::Tensor> batched_linear(
+    const std::vector<at::Tensor>& inputs,
+    const at::Tensor& weight,
+    const c10::optional<at::Tensor>& bias) {
+  TORCH_CHECK(
+      weight.dim() == 3 &&
+          static_cast<size_t>(weight.size(0)) == inputs.size(),
+      "prim::BatchedLinear expects one [K, N] weight per input");
+  if (can_stack(inputs, weight)) {
+    auto batch =
+        at::stack(inputs).reshape({weight.size(0), -1, weight.size(1)});
+    auto out =
+        bias ? at::baddbmm(*bias, batch, weight) : at::bmm(batch, weight);
+    auto out_sizes = inputs[0].sizes().vec();
+    out_sizes.back() = weight.size(2);
+    // Not unbind: its outputs can't be modified in place in grad mode, and
+    // the outputs of the graph may be.
+    std::vector<at::Tensor> outputs;
+    outputs.reserve(inputs.size());
+    for (int64_t i = 0; i < out.size(0); ++i) {
+      outputs.push_back(out.select(0, i).view(out_sizes));
+    }
+    return outputs;
+  }
+  std::vector<at::Tensor> outputs;
+  outputs.reserve(inputs.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    auto out = at::matmul(inputs[i], weight[i]);
+    if (bias) {
+      out.add_((*bias)[i][0]);
+    }
+    outputs.push_back(std::move(out));
+  }
+  return outputs;
+}
+
+RegisterOperators batched_linear_reg({Operator(
+    "prim::BatchedLinear(Tensor[] inputs, Tensor weight, Tensor? bias) -> Tensor[]",
+    [](Stack* stack) {
+      auto bias = pop(stack).toOptional<at::Tensor>();
+      auto weight = pop(stack).toTensor();
+      auto inputs = pop(stack).toTensorVector();
+      push(stack, batched_linear(inputs, weight, bias));
+    },
+    aliasAnalysisFromSchema())});
+
+struct FrozenLinear {
+  Node* node;
+  // [K, N], i.e. already transposed for aten::linear
+  at::Tensor rhs;
+  // [N], undefined if the node has no bias
+  at::Tensor bias;
+};
+
+bool isFrozenTensor(Value* v, AliasDb& aliasDb) {
+  return v->node()->kind() == prim::Constant && v->uses().size() == 1 &&
+      v->type()->cast<TensorType>() && !aliasDb.hasWriters(v);
+}
+
+// Weights used by several nodes are left alone, stacking them would keep a
+// second copy alive. So are linears whose output is written to: the outputs
+// of a batch are slices of one tensor, which the schema of
+// prim::BatchedLinear doesn't tell alias analysis about.
+c10::optional<FrozenLinear> asFrozenLinear(Node* n, AliasDb& aliasDb) {
+  bool is_linear = n->matches(
+      "aten::linear(Tensor input, Tensor weight, Tensor? bias=None) -> Tensor");
+  if (!is_linear &&
+      !n->matches("aten::matmul(Tensor self, Tensor other) -> Tensor")) {
+    return c10::nullopt;
+  }
+  if (aliasDb.hasWriters(n->output())) {
+    return c10::nullopt;
+  }
+  Value* weight = n->input(1);
+  if (!isFrozenTensor(weight, aliasDb)) {
+    return c10::nullopt;
+  }
+  auto w = constant_as<at::Tensor>(weight).value();
+  if (w.dim() != 2) {
+    return c10::nullopt;
+  }
+  FrozenLinear linear{n, is_linear ? w.t() : w, at::Tensor()};
+  if (is_linear && n->input(2)->type() != NoneType::get()) {
+    if (!isFrozenTensor(n->input(2), aliasDb)) {
+      return c10::nullopt;
+    }
+    linear.bias = constant_as<at::Tensor>(n->input(2)).value();
+    if (linear.bias.dim() != 1 || linear.bias.size(0) != w.size(0) ||
+        linear.bias.scalar_type() != w.scalar_type() ||
+        linear.bias.device() != w.device()) {
+      return c10::nullopt;
+    }
+  }
+  return linear;
+}
+
+bool batchableWith(const FrozenLinear& a, const FrozenLinear& b) {
+  return a.rhs.sizes() == b.rhs.sizes() &&
+      a.rhs.scalar_type() == b.rhs.scalar_type() &&
+      a.rhs.device() == b.rhs.device() &&
+      a.bias.defined() == b.bias.defined();
+}
+
+// Same as in BatchMMSide: drop the nodes that depend on an earlier one of the
+// group, the others can all be moved next to each other.
+void filterDependent(std::vector<FrozenLinear>& group, AliasDb& aliasDb) {
+  std::vector<FrozenLinear> independent;
+  for (const auto& linear : group) {
+    bool depends = std::any_of(
+        independent.begin(),
+        independent.end(),
+        [&](const FrozenLinear& earlier) {
+          return !aliasDb.couldMoveBeforeTopologically(
+              linear.node, earlier.node);
+        });
+    if (!depends) {
+      independent.push_back(linear);
+    }
+  }
+  group = std::move(independent);
+}
+
+void batchLinears(std::vector<FrozenLinear>& group, AliasDb& aliasDb) {
+  for (int64_t i = static_cast<int64_t>(group.size()) - 2; i >= 0; --i) {
+    bool move_ok =
+        aliasDb.moveBeforeTopologicallyValid(group[i].node, group[i + 1].node);
+    TORCH_INTERNAL_ASSERT(move_ok);
+  }
+
+  Graph* graph = group[0].node->owningGraph();
+  WithInsertPoint insert_guard{group[0].node};
+  Value* weight = graph->insertConstant(at::stack(
+      fmap(group, [](const FrozenLinear& linear) { return linear.rhs; })));
+  Value* bias = nullptr;
+  if (group[0].bias.defined()) {
+    auto biases =
+        fmap(group, [](const FrozenLinear& linear) { return linear.bias; });
+    bias = graph->insertConstant(at::stack(biases).unsqueeze(1));
+  } else {
+    bias = graph->insertConstant(IValue());
+  }
+  auto input_values = fmap(group, [](const FrozenLinear& linear) {
+    return linear.node->input(0);
+  });
+  Value* inputs =
+      graph->insertNode(graph->createList(TensorType::get(), input_values))
+          ->output();
+  Value* outputs =
+      graph->insert(Symbol::prim("BatchedLinear"), {inputs, weight, bias});
+  Node* unpack =
+      graph->insertNode(graph->createListUnpack(outputs, group.size()));
+  for (size_t i = 0; i < group.size(); ++i) {
+    Node* n = group[i].node;
+    unpack->output(i)->setType(n->output()->type());
+    n->output()->replaceAllUsesWith(unpack->output(i));
+    n->destroy();
+  }
+  GRAPH_UPDATE("Batched ", group.size(), " linears into ", *outputs->node());
+}
+
+bool batchFrozenLinears(Block* block, AliasDb& aliasDb) {
+  std::vector<std::vector<FrozenLinear>> groups;
+  for (Node* n : block->nodes()) {
+    for (Block* b : n->blocks()) {
+      if (batchFrozenLinears(b, aliasDb)) {
+        return true;
+      }
+    }
+    auto linear = asFrozenLinear(n, aliasDb);
+    if (!linear) {
+      continue;
+    }
+    auto it = std::find_if(
+        groups.begin(), groups.end(), [&](const std::vector<FrozenLinear>& g) {
+          return batchableWith(g[0], *linear);
+        });
+    if (it == groups.end()) {
+      groups.push_back({*linear});
+    } else {
+      it->push_back(*linear);
+    }
+  }
+  for (auto& group : groups) {
+    filterDependent(group, aliasDb);
+    if (group.size() >= min_batch_size) {
+      batchLinears(group, aliasDb);
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+void BatchFrozenLinears(std::shared_ptr<Graph>& graph) {
+  // AliasDb doesn't know about the nodes inserted for a batch, so it is
+  // rebuilt after each one. Nodes dropped from a group because they depend on
+  // another one are picked up by the next round.
+  bool changed = false;
+  while (true) {
+    AliasDb aliasDb(graph);
+    if (!batchFrozenLinears(graph->block(), aliasDb)) {
+      break;
+    }
+    changed = true;
+  }
+  if (changed) {
+    EliminateDeadCode(graph);
+  }
+  GRAPH_DUMP("After BatchFrozenLinears: ", graph);
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Batches independent aten::linear and aten::matmul nodes whose weights are
+// frozen 2-d constants of the same shape into a single prim::BatchedLinear,
+// which stacks the weights once at freeze time and runs one bmm at runtime.
+// This pass only works on Frozen Graphs; otherwise it is a No-Op.
+TORCH_API void BatchFrozenLinears(std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,90 @@
+#include <torch/csrc/jit/passes/fuse_add_layer_norm.h>
+#include <torch/csrc/jit/passes/quantization/helper.h>
+#include <torch/csrc/jit/passes/subgraph_rewrite.h>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// The intermediate values of a match disappear once it is rewritten, so they
+// must not be used outside of it.
+bool value_has_single_use(
+    const Match& match,
+    const std::unordered_map<std::string, Value*>& vmap,
+    const std::string& vname) {
+  const auto& match_vmap = match.values_map;
+  return match_vmap.at(vmap.at(vname))->uses().size() == 1;
+}
+
+// aten::add also has overloads taking a Scalar
+bool residual_is_tensor(
+    const Match& match,
+    const std::unordered_map<std::string, Value*>& vmap) {
+  const auto& match_vmap = match.values_map;
+  return match_vmap.at(vmap.at("residual"))
+      ->type()
+      ->isSubtypeOf(TensorType::get());
+}
+
+} // namespace
+
+void FuseAddLayerNorm(std::shared_ptr<Graph>& graph) {
+  auto sum_has_single_use =
+      [](const Match& match,
+         const std::unordered_map<std::string, Value*>& vmap) {
+        return value_has_single_use(match, vmap, "sum");
+      };
+  auto norm_has_single_use =
+      [](const Match& match,
+         const std::unordered_map<std::string, Value*>& vmap) {
+        return value_has_single_use(match, vmap, "norm");
+      };
+
+  // Fuse the activations first, so that the plain pattern below does not
+  // take their add + layer_norm.
+  for (const std::string activation : {"relu", "gelu"}) {
+    std::string add_layer_norm_activation_pattern = R"IR(
+    graph(%input, %residual, %alpha, %shape, %weight, %bias, %eps, %cudnn_enable):
+        %sum = aten::add(%input, %residual, %alpha)
+        %norm = aten::layer_norm(%sum, %shape, %weight, %bias, %eps, %cudnn_enable)
+        %res = aten::)IR" +
+        activation + R"IR((%norm)
+        return (%res))IR";
+    std::string fused_add_layer_norm_activation = R"IR(
+    graph(%input, %residual, %alpha, %shape, %weight, %bias, %eps, %cudnn_enable):
+        %activation : str = prim::Constant[value=")IR" +
+        activation + R"IR("]()
+        %res = aten::_add_layer_norm(%input, %residual, %shape, %weight, %bias, %eps, %activation)
+        return (%res))IR";
+
+    SubgraphRewriter add_layer_norm_activation;
+    add_layer_norm_activation.RegisterRewritePattern(
+        add_layer_norm_activation_pattern, fused_add_layer_norm_activation);
+    add_layer_norm_activation.runOnGraph(
+        graph,
+        {aten_add_alpha_is_one,
+         residual_is_tensor,
+         sum_has_single_use,
+         norm_has_single_use});
+  }
+
+  std::string add_layer_norm_pattern = R"IR(
+    graph(%input, %residual, %alpha, %shape, %weight, %bias, %eps, %cudnn_enable):
+        %sum = aten::add(%input, %residual, %alpha)
+        %res = aten::layer_norm(%sum, %shape, %weight, %bias, %eps, %cudnn_enable)
+        return (%res))IR";
+  std::string fused_add_layer_norm = R"IR(
+    graph(%input, %residual, %alpha, %shape, %weight, %bias, %eps, %cudnn_enable):
+        %activation : str = prim::Constant[value="none"]()
+        %res = aten::_add_layer_norm(%input, %residual, %shape, %weight, %bias, %eps, %activation)
+        return (%res))IR";
+
+  SubgraphRewriter add_layer_norm;
+  add_layer_norm.RegisterRewritePattern(
+      add_layer_norm_pattern, fused_add_layer_norm);
+  add_layer_norm.runOnGraph(
+      graph, {aten_add_alpha_is_one, residual_is_tensor, sum_has_single_use});
+}
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,18 @@
+/** \brief Fusing residual add + layer_norm patterns into a single
+ * aten::_add_layer_norm
+ */
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+/** \brief Match aten::add followed by aten::layer_norm, optionally followed
+ * by aten::relu or aten::gelu, and fuse it into aten::_add_layer_norm.
+ * The fused op has no derivative, so this pass is meant for frozen graphs,
+ * which also have their dropouts removed already.
+ */
+TORCH_API void FuseAddLayerNorm(std::shared_ptr<Graph>& graph);
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,341 @@
+#include <torch/csrc/jit/passes/symbolic_shape_analysis.h>
+
+#include <ATen/core/functional.h>
+#include <torch/csrc/jit/ir/constants.h>
+#include <torch/csrc/jit/ir/ir_views.h>
+#include <torch/csrc/jit/jit_log.h>
+#include <torch/csrc/jit/passes/constant_propagation.h>
+#include <torch/csrc/jit/passes/dead_code_elimination.h>
+#include <torch/csrc/jit/passes/peephole.h>
+#include <torch/csrc/jit/passes/remove_mutation.h>
+#include <torch/csrc/jit/runtime/symbolic_shape_registry.h>
+
+#include <map>
+
+namespace torch {
+namespace jit {
+
+namespace {
+
+// Shape functions loop over the dims of their inputs, or over constant lists
+// like the dims of a reduction.
+static constexpr int64_t kMaxUnrolledTripCount = 64;
+static constexpr size_t kMaxOptimizationRounds = 8;
+
+// Once the ranks are known, the loops of a shape function have constant trip
+// counts, and unrolling them is what lets RemoveListMutation turn the
+// appended output list into a prim::ListConstruct.
+void unrollLoop(Node* n, int64_t trip_count) {
+  LoopView loop(n);
+  Graph* graph = n->owningGraph();
+  WithInsertPoint guard(n);
+  std::vector<Value*> carried = loop.carriedInputs().vec();
+  for (int64_t i = 0; i < trip_count; ++i) {
+    std::unordered_map<Value*, Value*> env;
+    env[loop.currentTripCount()] = graph->insertConstant(i);
+    for (size_t j = 0; j < carried.size(); ++j) {
+      env[loop.bodyCarriedInputs().at(j)] = carried[j];
+    }
+    auto value_map = [&](Value* v) {
+      auto it = env.find(v);
+      return it != env.end() ? it->second : v;
+    };
+    for (Node* body_node : loop.bodyBlock()->nodes()) {
+      Node* clone = graph->insertNode(graph->createClone(body_node, value_map));
+      for (size_t k = 0; k < body_node->outputs().size(); ++k) {
+        env[body_node->output(k)] = clone->output(k);
+      }
+    }
+    carried = fmap(loop.bodyCarriedOutputs(), value_map);
+  }
+  for (size_t j = 0; j < carried.size(); ++j) {
+    loop.carriedOutputs().at(j)->replaceAllUsesWith(carried[j]);
+  }
+  n->destroy();
+}
+
+bool unrollConstantLoops(Block* block) {
+  bool changed = false;
+  for (auto it = block->nodes().begin(); it != block->nodes().end();) {
+    Node* n = *it++;
+    for (Block* b : n->blocks()) {
+      changed |= unrollConstantLoops(b);
+    }
+    if (n->kind() != prim::Loop) {
+      continue;
+    }
+    LoopView loop(n);
+    auto trip_count = constant_as<int64_t>(loop.maxTripCount());
+    if (loop.loopType() != LoopView::For || !trip_count ||
+        *trip_count > kMaxUnrolledTripCount) {
+      continue;
+    }
+    unrollLoop(n, std::max<int64_t>(*trip_count, 0));
+    changed = true;
+  }
+  return changed;
+}
+
+bool sameInt(Value* a, Value* b) {
+  if (a == b) {
+    return true;
+  }
+  auto a_ival = constant_as<int64_t>(a);
+  auto b_ival = constant_as<int64_t>(b);
+  return a_ival && b_ival && *a_ival == *b_ival;
+}
+
+// In `if a == b: x = b else: x = a`, x is always a, but ConstantPropagation
+// only folds the outputs of an If that are the same value in both branches.
+// Shape functions compare sizes this way, e.g. broadcast of a symbolic size
+// and a size of 1.
+bool foldIfsOnIntEquality(Block* block) {
+  bool changed = false;
+  for (Node* n : block->nodes()) {
+    for (Block* b : n->blocks()) {
+      changed |= foldIfsOnIntEquality(b);
+    }
+    if (n->kind() != prim::If) {
+      continue;
+    }
+    Node* cond = n->input()->node();
+    if ((cond->kind() != aten::eq && cond->kind() != aten::ne) ||
+        cond->inputs().size() != 2 ||
+        !cond->input(0)->type()->cast<IntType>() ||
+        !cond->input(1)->type()->cast<IntType>()) {
+      continue;
+    }
+    IfView if_view(n);
+    bool is_eq = cond->kind() == aten::eq;
+    Block* equal_block = is_eq ? if_view.thenBlock() : if_view.elseBlock();
+    Block* other_block = is_eq ? if_view.elseBlock() : if_view.thenBlock();
+    for (size_t i = 0; i < n->outputs().size(); ++i) {
+      Value* equal_output = equal_block->outputs().at(i);
+      Value* other_output = other_block->outputs().at(i);
+      // other_output must be one of the compared values, which are defined
+      // outside of the If
+      if (!n->output(i)->hasUses() ||
+          (other_output != cond->input(0) && other_output != cond->input(1)) ||
+          !(sameInt(equal_output, cond->input(0)) ||
+            sameInt(equal_output, cond->input(1)))) {
+        continue;
+      }
+      n->output(i)->replaceAllUsesWith(other_output);
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+size_t countNodes(Block* block) {
+  size_t count = 0;
+  for (Node* n : block->nodes()) {
+    ++count;
+    for (Block* b : n->blocks()) {
+      count += countNodes(b);
+    }
+  }
+  return count;
+}
+
+// Partially evaluates a shape function whose inputs were replaced with what
+// is known about the node, until it stops changing.
+void optimizeShapeComputeGraph(std::shared_ptr<Graph>& graph) {
+  size_t num_nodes = countNodes(graph->block());
+  for (size_t i = 0; i < kMaxOptimizationRounds; ++i) {
+    bool unrolled = unrollConstantLoops(graph->block());
+    RemoveListMutation(graph);
+    ConstantPropagation(graph);
+    // also folds len() and indexing of prim::ListConstruct
+    PeepholeOptimize(graph);
+    bool folded = foldIfsOnIntEquality(graph->block());
+    EliminateDeadCode(graph);
+    size_t new_num_nodes = countNodes(graph->block());
+    if (!unrolled && !folded && new_num_nodes == num_nodes) {
+      break;
+    }
+    num_nodes = new_num_nodes;
+  }
+}
+
+// Replaces the inputs of a copy of a shape function with what is known about
+// the inputs of `node`, and reads the output sizes back from it.
+struct SymbolicShapeNodeAnalyzer {
+  SymbolicShapeNodeAnalyzer(Node* node, const std::shared_ptr<Graph>& graph)
+      : node_(node), graph_(graph->copy()) {}
+
+  c10::optional<std::vector<c10::ShapeSymbol>> run() {
+    {
+      WithInsertPoint guard(*graph_->nodes().begin());
+      // the inputs of the shape function are the leading arguments of the
+      // schema, so they line up with the leading inputs of the node
+      size_t num_inputs = graph_->inputs().size();
+      for (size_t i = 0; i < num_inputs; ++i) {
+        Value* shape_input = graph_->inputs().at(i);
+        if (!shape_input->hasUses()) {
+          continue;
+        }
+        if (Value* replacement = substitute(node_->input(i))) {
+          shape_input->replaceAllUsesWith(replacement);
+        }
+      }
+    }
+    optimizeShapeComputeGraph(graph_);
+    GRAPH_DEBUG(
+        "Shape compute graph of ", getHeader(node_), " after partial eval:\n",
+        *graph_);
+    return extractOutputShape();
+  }
+
+ private:
+  Value* dimValue(const c10::ShapeSymbol& symbol) {
+    if (symbol.is_static()) {
+      return graph_->insertConstant(symbol.static_size());
+    }
+    auto it = symbol_values_.find(symbol);
+    if (it != symbol_values_.end()) {
+      return it->second;
+    }
+    Value* v = graph_->addInput()->setType(IntType::get());
+    symbol_values_[symbol] = v;
+    value_symbols_[v] = symbol;
+    return v;
+  }
+
+  Value* sizesOf(Value* tensor) {
+    auto tt = tensor->type()->cast<TensorType>();
+    if (!tt) {
+      return nullptr;
+    }
+    auto sizes = tt->symbolic_sizes().sizes();
+    if (!sizes) {
+      return nullptr;
+    }
+    auto dims = fmap(
+        *sizes, [&](const c10::ShapeSymbol& s) { return dimValue(s); });
+    return graph_->insertNode(graph_->createList(IntType::get(), dims))
+        ->output();
+  }
+
+  // x.size(d) used as a size in e.g. view keeps the symbol of that dim
+  Value* intValue(Value* v) {
+    if (auto ival = toIValue(v)) {
+      return graph_->insertConstant(*ival);
+    }
+    if (v->node()->matches("aten::size.int(Tensor self, int dim) -> int")) {
+      auto tt = v->node()->input(0)->type()->cast<TensorType>();
+      auto dim = constant_as<int64_t>(v->node()->input(1));
+      auto rank = tt ? tt->symbolic_sizes().rank() : c10::nullopt;
+      if (dim && rank) {
+        int64_t wrapped =
+            *dim < 0 ? *dim + static_cast<int64_t>(*rank) : *dim;
+        if (wrapped >= 0 && wrapped < static_cast<int64_t>(*rank)) {
+          return dimValue(tt->symbolic_sizes()[wrapped]);
+        }
+      }
+    }
+    return graph_->addInput()->setType(IntType::get());
+  }
+
+  Value* substitute(Value* node_input) {
+    const TypePtr& type = node_input->type();
+    if (type->cast<TensorType>()) {
+      return sizesOf(node_input);
+    }
+    if (auto ival = toIValue(node_input)) {
+      return graph_->insertConstant(*ival);
+    }
+    Node* list = node_input->node();
+    if (list->kind() != prim::ListConstruct) {
+      return nullptr;
+    }
+    auto elem_type = type->expect<ListType>()->getElementType();
+    if (elem_type->cast<TensorType>()) {
+      std::vector<Value*> sizes;
+      for (Value* tensor : list->inputs()) {
+        Value* tensor_sizes = sizesOf(tensor);
+        if (!tensor_sizes) {
+          return nullptr;
+        }
+        sizes.push_back(tensor_sizes);
+      }
+      return graph_->insertNode(graph_->createList(ListType::ofInts(), sizes))
+          ->output();
+    }
+    if (elem_type->cast<IntType>()) {
+      auto elems = fmap(list->inputs(), [&](Value* v) { return intValue(v); });
+      return graph_->insertNode(graph_->createList(IntType::get(), elems))
+          ->output();
+    }
+    return nullptr;
+  }
+
+  c10::optional<std::vector<c10::ShapeSymbol>> extractOutputShape() {
+    // the shape function raises for these inputs, so will the node
+    for (Node* n : graph_->nodes()) {
+      if (n->kind() == prim::RaiseException) {
+        return c10::nullopt;
+      }
+    }
+    Value* output = graph_->outputs().at(0);
+    if (auto sizes = constant_as<c10::List<int64_t>>(output)) {
+      return fmap(sizes->vec(), [](int64_t size) {
+        return c10::ShapeSymbol::fromStaticSize(size);
+      });
+    }
+    if (output->node()->kind() != prim::ListConstruct) {
+      return c10::nullopt;
+    }
+    return fmap(output->node()->inputs(), [&](Value* v) {
+      if (auto size = constant_as<int64_t>(v)) {
+        return c10::ShapeSymbol::fromStaticSize(*size);
+      }
+      auto it = value_symbols_.find(v);
+      if (it != value_symbols_.end()) {
+        return it->second;
+      }
+      return c10::ShapeSymbol::newSymbol();
+    });
+  }
+
+  Node* node_;
+  std::shared_ptr<Graph> graph_;
+  std::map<c10::ShapeSymbol, Value*> symbol_values_;
+  std::unordered_map<Value*, c10::ShapeSymbol> value_symbols_;
+};
+
+void PropagateShapesOnBlock(Block* block) {
+  for (Node* n : block->nodes()) {
+    for (Block* b : n->blocks()) {
+      PropagateShapesOnBlock(b);
+    }
+    if (n->outputs().size() != 1) {
+      continue;
+    }
+    auto output_type = n->output()->type()->cast<TensorType>();
+    const FunctionSchema* schema = n->maybeSchema();
+    if (!output_type || !schema) {
+      continue;
+    }
+    auto shape_compute_graph = shapeComputeGraphForSchema(*schema);
+    if (!shape_compute_graph) {
+      continue;
+    }
+    auto sizes = SymbolicShapeNodeAnalyzer(n, *shape_compute_graph).run();
+    if (!sizes) {
+      continue;
+    }
+    n->output()->setType(
+        output_type->withSymbolicShapes(c10::SymbolicShape(*sizes)));
+  }
+}
+
+} // namespace
+
+void PropagateShapesOnGraph(std::shared_ptr<Graph>& graph) {
+  PropagateShapesOnBlock(graph->block());
+  GRAPH_DUMP("After PropagateShapesOnGraph: ", graph);
+}
+
+} // namespace jit
+} // namespace torch
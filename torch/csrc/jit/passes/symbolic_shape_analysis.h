@@ -0,0 +1,22 @@
+#pragma once
+
+#include <torch/csrc/jit/ir/ir.h>
+
+namespace torch {
+namespace jit {
+
+// Propagates the symbolic sizes of the tensors in `graph`, starting from the
+// sizes set on its inputs, through the shape functions registered in
+// symbolic_shape_registry.h.
+//
+// For every node with a shape function, the function is specialized to the
+// known sizes and constant arguments of the node and partially evaluated.
+// Static dims of the output become static sizes; dims that are a dim of an
+// input are given that dim's ShapeSymbol, so equal sizes stay equal across
+// the graph; the rest get new symbols. Nodes without a shape function, or
+// whose output rank can't be determined, keep their type; the nodes after
+// them are still analyzed.
+TORCH_API void PropagateShapesOnGraph(std::shared_ptr<Graph>& graph);
+
+} // namespace jit
+} // namespace torch
@@ -27,6 +27,7 @@ namespace torch {
 namespace jit {
 
 static bool texpr_reductions_enabled = false;
+static bool texpr_whole_graph_enabled = false;
 
 bool isSupportedForBlock(Node* node) {
   switch (node->kind()) {
@@ -165,6 +166,83 @@ static const OperatorSet& supported_eltwise_set() {
   return supported_eltwise_set;
 }
 
+// Ops that TE lowers to calls of ATen kernels, see
+// NOTE [ Whole Graph TensorExpr Kernels ]
+static const OperatorSet& supported_external_call_set() {
+  // clang-format off
+  static const OperatorSet supported_external_call_set{
+      "aten::matmul(Tensor self, Tensor other) -> Tensor",
+      "aten::mm(Tensor self, Tensor mat2) -> Tensor",
+      "aten::conv2d(Tensor input, Tensor weight, Tensor? bias=None, int[2] stride=1, int[2] padding=0, int[2] dilation=1, int groups=1) -> Tensor",
+      "aten::adaptive_avg_pool2d(Tensor self, int[2] output_size) -> Tensor",
+  };
+  // clang-format on
+  return supported_external_call_set;
+}
+
+// NOTE [ Whole Graph TensorExpr Kernels ]
+//
+// Fusion groups normally end at every op TE cannot generate loops for, so
+// in a CNN or an MLP each matmul or conv splits the graph, and every group
+// boundary materializes its outputs through the interpreter. With
+// setTexprWholeGraphEnabled(true) the ops of supported_external_call_set
+// become fusible too: the kernel emits an ExternalCall to the ATen
+// implementation registered in tensorexpr/external_functions.cpp, writing
+// into a TE buffer. A frozen inference graph made of these ops and of
+// pointwise ops then compiles into one kernel. Its intermediates are TE
+// buffers, and the pointwise ops that follow a call are generated as loops
+// over its output within the same kernel.
+//
+// The external functions only run on CPU and take the int arguments of the
+// op as immediates, so these have to be constants, as they are once the
+// module is frozen.
+static bool externalCallIsSupported(Node* node) {
+  auto device = tensorexpr::pickDeviceType(node->inputs());
+  if (!device || !device->is_cpu()) {
+    return false;
+  }
+  for (Value* v : node->inputs()) {
+    if (auto tt = v->type()->cast<TensorType>()) {
+      if (!tt->scalarType() || *tt->scalarType() != c10::ScalarType::Float) {
+        return false;
+      }
+    }
+  }
+  auto isIntPair = [](Value* v, int64_t expected = -1) {
+    auto ival = toIValue(v);
+    if (!ival || !ival->isIntList()) {
+      return false;
+    }
+    auto list = ival->toIntVector();
+    if (list.size() != 2) {
+      return false;
+    }
+    return expected < 0 || (list[0] == expected && list[1] == expected);
+  };
+  switch (node->kind()) {
+    case aten::mm:
+    case aten::matmul:
+      return true;
+    case aten::conv2d: {
+      auto groups = toIValue(node->input(6));
+      if (!groups || !groups->isInt()) {
+        return false;
+      }
+      // nnc_aten_conv2d only takes the convolution parameters with a bias
+      if (node->input(2)->type()->cast<NoneType>()) {
+        return isIntPair(node->input(3), 1) && isIntPair(node->input(4), 0) &&
+            isIntPair(node->input(5), 1) && groups->toInt() == 1;
+      }
+      return isIntPair(node->input(3)) && isIntPair(node->input(4)) &&
+          isIntPair(node->input(5));
+    }
+    case aten::adaptive_avg_pool2d:
+      return isIntPair(node->input(1));
+    default:
+      return false;
+  }
+}
+
 bool isSupported(Node* node) {
   // For Block codegen we allow limited ops.
   if (tensorexpr::getTEGenerateBlockCode()) {
@@ -228,6 +306,11 @@ bool isSupported(Node* node) {
     return true;
   }
 
+  if (texpr_whole_graph_enabled &&
+      node->isMemberOf(supported_external_call_set())) {
+    return externalCallIsSupported(node);
+  }
+
   // unschematized ops
   switch (node->kind()) {
     case prim::ConstantChunk:
@@ -268,6 +351,16 @@ bool texprReductionsEnabled() {
   return texpr_reductions_enabled;
 }
 
+bool setTexprWholeGraphEnabled(bool value) {
+  bool old_value = texpr_whole_graph_enabled;
+  texpr_whole_graph_enabled = value;
+  return old_value;
+}
+
+bool texprWholeGraphEnabled() {
+  return texpr_whole_graph_enabled;
+}
+
 void removeProfileNodesAndSpecializeTypes(Block* b) {
   for (auto it = b->nodes().begin(); it != b->nodes().end(); it++) {
     if (it->kind() == prim::profile) {
@@ -24,6 +24,11 @@ TORCH_API void setTensorExprFuserEnabled(bool val);
 TORCH_API bool tensorExprFuserEnabled();
 TORCH_API bool setTexprReductionsEnabled(bool value);
 TORCH_API bool texprReductionsEnabled();
+// Lets fusion groups take in matmuls, convolutions and a few other ops that
+// TE calls into ATen for, so that frozen inference graphs compile to a single
+// kernel. Off by default, returns the previous value.
+TORCH_API bool setTexprWholeGraphEnabled(bool value);
+TORCH_API bool texprWholeGraphEnabled();
 
 TORCH_API void RemoveProfileNodesAndSpecializeTypes(
     std::shared_ptr<Graph>& graph);
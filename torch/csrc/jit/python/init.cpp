@@ -24,7 +24,9 @@
 #include <torch/csrc/jit/passes/freeze_module.h>
 #include <torch/csrc/jit/passes/frozen_conv_folding.h>
 #include <torch/csrc/jit/passes/frozen_graph_optimizations.h>
+#include <torch/csrc/jit/passes/frozen_linear_batching.h>
 #include <torch/csrc/jit/passes/frozen_ops_to_mkldnn.h>
+#include <torch/csrc/jit/passes/fuse_add_layer_norm.h>
 #include <torch/csrc/jit/passes/fuse_linear.h>
 #include <torch/csrc/jit/passes/fuse_relu.h>
 #include <torch/csrc/jit/passes/graph_fuser.h>
@@ -67,6 +69,7 @@
 #include <torch/csrc/jit/passes/shape_analysis.h>
 #include <torch/csrc/jit/passes/specialize_autogradzero.h>
 #include <torch/csrc/jit/passes/subgraph_rewrite.h>
+#include <torch/csrc/jit/passes/symbolic_shape_analysis.h>
 #include <torch/csrc/jit/passes/tensorexpr_fuser.h>
 #include <torch/csrc/jit/passes/utils/check_alias_annotation.h>
 #include <torch/csrc/jit/passes/vulkan_rewrite.h>
@@ -317,6 +320,8 @@ void initJITBindings(PyObject* module) {
       .def("_jit_pass_convert_frozen_ops_to_mkldnn", &ConvertFrozenOpsToMKLDNN)
       .def("_jit_pass_optimize_frozen_graph", &OptimizeFrozenGraph)
       .def("_jit_pass_fuse_linear", &FuseLinear)
+      .def("_jit_pass_fuse_add_layer_norm", &FuseAddLayerNorm)
+      .def("_jit_pass_batch_frozen_linears", &BatchFrozenLinears)
       .def(
           "_jit_pass_fuse_add_relu",
           [](std::shared_ptr<Graph>& graph) { FuseAddRelu(graph); })
@@ -455,6 +460,7 @@ void initJITBindings(PyObject* module) {
           [](std::shared_ptr<Graph>& g) { return ConstantPropagation(g); },
           py::arg("graph"))
       .def("_jit_pass_erase_shape_information", EraseShapeInformation)
+      .def("_jit_pass_propagate_shapes_on_graph", PropagateShapesOnGraph)
       .def(
           "_jit_pass_create_autodiff_subgraphs",
           [](const std::shared_ptr<Graph>& graph) {
@@ -566,6 +572,13 @@ void initJITBindings(PyObject* module) {
             getBailoutDepth() = depth;
             return old_depth;
           })
+      .def(
+          "_jit_set_batch_size_buckets",
+          [](std::vector<int64_t> buckets) {
+            auto old_buckets = getBatchSizeBuckets();
+            setBatchSizeBuckets(std::move(buckets));
+            return old_buckets;
+          })
       .def(
           "_jit_set_inline_everything_mode",
           [](bool enabled) { getInlineEverythingMode() = enabled; })
@@ -627,6 +640,8 @@ void initJITBindings(PyObject* module) {
       .def("_jit_texpr_set_fallback_allowed", &tensorexpr::setFallbackAllowed)
       .def("_jit_set_texpr_reductions_enabled", &setTexprReductionsEnabled)
       .def("_jit_texpr_reductions_enabled", &texprReductionsEnabled)
+      .def("_jit_set_texpr_whole_graph_enabled", &setTexprWholeGraphEnabled)
+      .def("_jit_texpr_whole_graph_enabled", &texprWholeGraphEnabled)
       .def(
           "_jit_set_te_generate_block_code",
           [](bool gen_block_code) {
@@ -651,6 +666,24 @@ void initJITBindings(PyObject* module) {
             using namespace torch::jit::tensorexpr;
             getTEMustUseLLVMOnCPU() = use_llvm;
           })
+      .def(
+          "_jit_get_te_parallelize_cpu",
+          []() -> bool {
+            using namespace torch::jit::tensorexpr;
+            return getTEParallelizeOnCPU();
+          })
+      .def(
+          "_jit_set_te_parallelize_cpu",
+          [](bool parallelize) {
+            using namespace torch::jit::tensorexpr;
+            getTEParallelizeOnCPU() = parallelize;
+          })
+      .def(
+          "_jit_set_te_cpu_parallel_threshold",
+          [](int64_t threshold) {
+            using namespace torch::jit::tensorexpr;
+            getTECPUParallelThreshold() = threshold;
+          })
       .def(
           "_jit_cat_wo_conditionals",
           [](bool optimize_cat) {
@@ -1349,6 +1349,16 @@ void initJitScriptBindings(PyObject* module) {
           [](const StrongFunctionPtr& self) {
             return self.function_->get_executor().debugFlushCompilationCache();
           })
+      .def(
+          "_export_profile",
+          [](const StrongFunctionPtr& self) {
+            return py::bytes(self.function_->get_executor().exportProfile());
+          })
+      .def(
+          "_import_profile",
+          [](const StrongFunctionPtr& self, const std::string& profile) {
+            return self.function_->get_executor().importProfile(profile);
+          })
       .def_property_readonly(
           "name",
           [](const StrongFunctionPtr& self) { return self.function_->name(); })
@@ -1398,6 +1408,16 @@ void initJitScriptBindings(PyObject* module) {
           [](Method& self) {
             return self.get_executor().debugFlushCompilationCache();
           })
+      .def(
+          "_export_profile",
+          [](Method& self) {
+            return py::bytes(self.get_executor().exportProfile());
+          })
+      .def(
+          "_import_profile",
+          [](Method& self, const std::string& profile) {
+            return self.get_executor().importProfile(profile);
+          })
       .def_property_readonly(
           "code_with_constants",
           [](Method& self) {
@@ -1644,6 +1664,8 @@ void initJitScriptBindings(PyObject* module) {
     return debugMakeSet(torch::jit::mobile::_export_operator_list(sm));
   });
 
+  m.def("_jit_set_export_stream_pickles", &SetExportStreamPickles);
+  m.def("_jit_get_export_stream_pickles", &GetExportStreamPickles);
   m.def("_jit_set_emit_hooks", setEmitHooks);
   m.def("_jit_get_emit_hooks", getEmitHooks);
   m.def("_jit_clear_class_registry", []() {
@@ -793,6 +793,20 @@ void GraphExecutor::debugFlushCompilationCache() {
   }
 }
 
+std::string GraphExecutor::exportProfile() {
+  auto ppImpl = std::dynamic_pointer_cast<ProfilingGraphExecutorImpl>(pImpl);
+  TORCH_CHECK(ppImpl, "Profiles are only collected by the profiling executor");
+  return ppImpl->exportProfile();
+}
+
+bool GraphExecutor::importProfile(const std::string& profile) {
+  if (auto ppImpl =
+          std::dynamic_pointer_cast<ProfilingGraphExecutorImpl>(pImpl)) {
+    return ppImpl->importProfile(profile);
+  }
+  return false;
+}
+
 TORCH_API bool IsNewExecutorEnabled() {
   static const auto disable_new_executor =
       std::getenv("TORCH_JIT_DISABLE_NEW_EXECUTOR");
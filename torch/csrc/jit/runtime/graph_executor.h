@@ -87,6 +87,13 @@ struct TORCH_API GraphExecutor {
 
   void debugFlushCompilationCache();
 
+  // Profiles collected by the profiling executor can be saved next to a model
+  // and imported by another process running the same graph, to skip the
+  // profiling runs. Only supported by the profiling executor, and not while
+  // batch size buckets are set.
+  std::string exportProfile();
+  bool importProfile(const std::string& profile);
+
  private:
   std::shared_ptr<GraphExecutorImplBase> pImpl;
 };
@@ -109,6 +116,10 @@ TORCH_API std::atomic<bool>& getProfilingMode();
 TORCH_API std::atomic<bool>& getExecutorMode();
 TORCH_API std::atomic<size_t>& getNumProfiledRuns();
 TORCH_API std::atomic<size_t>& getBailoutDepth();
+// Upper bounds of the batch size buckets of the profiling executor, see
+// NOTE [ Batch Size Buckets ]. Empty if bucketing is disabled.
+TORCH_API std::vector<int64_t> getBatchSizeBuckets();
+TORCH_API void setBatchSizeBuckets(std::vector<int64_t> buckets);
 TORCH_API bool IsNewExecutorEnabled();
 
 struct TORCH_API GraphOptimizerEnabledGuard {
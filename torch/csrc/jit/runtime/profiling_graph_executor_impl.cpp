@@ -59,6 +59,12 @@ C10_DEFINE_int64(
     kDefaultBailoutDepth,
     "Number of re-specializations");
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+C10_DEFINE_int64(
+    torch_jit_max_bucketed_plans,
+    16,
+    "Maximum number of batch size buckets a function is specialized for");
+
 namespace torch {
 namespace jit {
 
@@ -105,6 +111,26 @@ std::atomic<size_t>& getBailoutDepth() {
   return bailout_depth;
 }
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static std::mutex batch_size_buckets_mutex;
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+static std::vector<int64_t> batch_size_buckets;
+
+std::vector<int64_t> getBatchSizeBuckets() {
+  std::lock_guard<std::mutex> lock(batch_size_buckets_mutex);
+  return batch_size_buckets;
+}
+
+void setBatchSizeBuckets(std::vector<int64_t> buckets) {
+  for (auto bound : buckets) {
+    TORCH_CHECK(bound > 0, "Batch size buckets must be positive, got ", bound);
+  }
+  std::sort(buckets.begin(), buckets.end());
+  buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+  std::lock_guard<std::mutex> lock(batch_size_buckets_mutex);
+  batch_size_buckets = std::move(buckets);
+}
+
 static bool needsGradientInProfilingMode(Block* b) {
   for (auto n : b->nodes()) {
     if (n->kind() == prim::BailOut) {
@@ -550,11 +576,129 @@ void ProfilingGraphExecutorImpl::runProfilingInsensitiveOptimizations(
       *graph);
 }
 
+// NOTE [ Batch Size Buckets ]
+// Every input shape that doesn't match the profiled one fails a guard and
+// calls a fallback function that profiles and specializes again, until the
+// bailout depth is used up. With traffic of many batch sizes that's a long
+// chain of guards per call and eventually an unoptimized graph. When batch
+// size buckets are set (`setBatchSizeBuckets`), the entry executor of a
+// function instead keys its plans on the rank of every tensor input and the
+// bucket its first dim falls into, and keeps a separate executor, with its
+// own profile and plan, per key. Bucket `i` covers the batch sizes
+// `(bounds[i - 1], bounds[i]]`, and sizes above the last bound share an
+// overflow bucket.
+// A bucket of a single batch size specializes on it like before. The plan of
+// a wider bucket must serve every size in it, so the sizes seen while
+// profiling it are replaced by shape symbols in the profiled types before
+// optimizing. That keeps the guards from checking them, at the cost of not
+// fusing the ops whose shapes become incomplete.
+// This matches sizes by value, in any dim of any profiled value, since the
+// profiled types don't record where a size came from. So it is a heuristic:
+// - sizes derived from the batch size (e.g. 2 * B after a cat or a repeat)
+//   stay static, and a guard on them fails for the other batch sizes of the
+//   bucket, which then go through the fallback function like without
+//   buckets;
+// - unrelated dims that happen to equal a profiled batch size are
+//   generalized too, and lose their specialization.
+// Profiling a bucket with several batch sizes avoids the first case, since
+// merging the profiled types already drops the sizes that changed.
+// Once `torch_jit_max_bucketed_plans` keys have been seen, new keys run the
+// graph of the simple executor, as if the bailout depth was used up.
+
+static void generalizeProfiledSizes(
+    Block* b,
+    const std::map<int64_t, c10::ShapeSymbol>& symbols) {
+  for (auto n : b->nodes()) {
+    if (n->kind() == prim::profile && n->hasAttribute(attr::profiled_type)) {
+      auto type = n->ty(attr::profiled_type)->expect<TensorType>();
+      if (auto sizes = type->symbolic_sizes().sizes()) {
+        for (auto& s : *sizes) {
+          if (s.is_static() && symbols.count(s.static_size())) {
+            s = symbols.at(s.static_size());
+          }
+        }
+        n->ty_(
+            attr::profiled_type,
+            type->withSymbolicShapes(c10::SymbolicShape(*sizes)));
+      }
+    }
+    for (auto ib : n->blocks()) {
+      generalizeProfiledSizes(ib, symbols);
+    }
+  }
+}
+
+std::unique_ptr<ProfilingGraphExecutorImpl> ProfilingGraphExecutorImpl::
+    createBucketExecutor(bool generalize_batch_sizes) {
+  auto executor =
+      std::make_unique<ProfilingGraphExecutorImpl>(graph, function_name_);
+  executor->batch_size_buckets_ = std::vector<int64_t>{};
+  executor->generalize_batch_sizes_ = generalize_batch_sizes;
+  return executor;
+}
+
+const ExecutionPlan& ProfilingGraphExecutorImpl::getBucketedPlanFor(
+    Stack& stack) {
+  const auto& buckets = *batch_size_buckets_;
+  std::vector<int64_t> key;
+  bool generalize = false;
+  for (const IValue& v : last(stack, graph->inputs().size())) {
+    if (!v.isTensor()) {
+      continue;
+    }
+    const auto& t = v.toTensor();
+    if (!t.defined()) {
+      key.push_back(-1);
+      continue;
+    }
+    key.push_back(t.dim());
+    if (t.dim() > 0) {
+      auto it = std::lower_bound(buckets.begin(), buckets.end(), t.size(0));
+      size_t bucket = it - buckets.begin();
+      key.push_back(bucket);
+      int64_t lower = bucket == 0 ? 1 : buckets[bucket - 1] + 1;
+      generalize |= it == buckets.end() || *it > lower;
+    }
+  }
+
+  auto it = bucketed_executors_.find(key);
+  if (it == bucketed_executors_.end()) {
+    if (bucketed_executors_.size() >=
+        static_cast<size_t>(FLAGS_torch_jit_max_bucketed_plans)) {
+      if (!overflow_executor_) {
+        overflow_executor_ = createBucketExecutor(false);
+      }
+      return overflow_executor_->getPlanFor(stack, 0);
+    }
+    GRAPH_DEBUG(
+        "Creating a plan for batch size bucket key ", c10::IntArrayRef(key));
+    it = bucketed_executors_
+             .emplace(std::move(key), createBucketExecutor(generalize))
+             .first;
+  }
+  return it->second->getPlanFor(stack, *remaining_bailout_depth_);
+}
+
 ProfilingGraphExecutorImpl::ProfilingGraphExecutorImpl(
     const std::shared_ptr<Graph>& graph,
     std::string function_name)
     : GraphExecutorImplBase(graph, std::move(function_name)) {}
 
+std::unique_ptr<ProfilingRecord> ProfilingGraphExecutorImpl::
+    instrumentGraph() {
+  auto copy = graph->copy();
+  runProfilingInsensitiveOptimizations(copy);
+  auto pr = ProfilingRecord::instrumentGraph(copy);
+  // `InsertProfileNodesForSpecializeAutogradZero` profiles a definition vs a
+  // use and it doesn't expect any profile nodes between a graph input and its
+  // consumer, `aten::_grad_sum_to_size`. This means we need to run it first,
+  // before any other pass that could insert `prim::iprofile_value` node on
+  // `aten::_grad_sum_to_size` input.
+  InsertProfileNodesForSpecializeAutogradZero(pr.get());
+  GRAPH_DUMP("Profiled Graph: ", pr->graph());
+  return pr;
+}
+
 const ExecutionPlan& ProfilingGraphExecutorImpl::getOptimizedPlanFor(
     Stack& stack,
     size_t remaining_bailout_depth) {
@@ -593,29 +737,45 @@ const ExecutionPlan& ProfilingGraphExecutorImpl::getOptimizedPlanFor(
     return *optimized_plan_;
   }
 
+  // only the entry executor of a function buckets: fallback functions start
+  // with a reduced depth and run inside the plan of a bucket already
+  if (!batch_size_buckets_) {
+    batch_size_buckets_ = remaining_bailout_depth < getBailoutDepth()
+        ? std::vector<int64_t>{}
+        : getBatchSizeBuckets();
+  }
+  if (!batch_size_buckets_->empty()) {
+    return getBucketedPlanFor(stack);
+  }
+
   // if a profiling graph hasn't been created yet
   if (!pr_) {
-    auto copy = graph->copy();
-    runProfilingInsensitiveOptimizations(copy);
-    pr_ = ProfilingRecord::instrumentGraph(copy);
-    // `InsertProfileNodesForSpecializeAutogradZero` profiles a definition vs a
-    // use and it doesn't expect any profile nodes between a graph input and its
-    // consumer, `aten::_grad_sum_to_size`. This means we need to run it first,
-    // before any other pass that could insert `prim::iprofile_value` node on
-    // `aten::_grad_sum_to_size` input.
-    InsertProfileNodesForSpecializeAutogradZero(pr_.get());
-    GRAPH_DUMP("Profiled Graph: ", pr_->graph());
+    pr_ = instrumentGraph();
     profiling_plan_ = ExecutionPlan(pr_->graph(), function_name_);
     // fall-through
   }
 
   // profile until a graph is ready
   if (!pr_->ready()) {
+    if (generalize_batch_sizes_) {
+      for (const IValue& v : last(stack, graph->inputs().size())) {
+        if (v.isTensor() && v.toTensor().defined() && v.toTensor().dim() > 0) {
+          profiled_batch_sizes_.insert(v.toTensor().size(0));
+        }
+      }
+    }
     return *profiling_plan_;
   }
 
   auto copy = pr_->graph()->copy();
   ProfilingRecord::removeProfileCounter(copy->block());
+  if (!profiled_batch_sizes_.empty()) {
+    std::map<int64_t, c10::ShapeSymbol> symbols;
+    for (auto size : profiled_batch_sizes_) {
+      symbols.emplace(size, c10::ShapeSymbol::newSymbol());
+    }
+    generalizeProfiledSizes(copy->block(), symbols);
+  }
   runProfilingOptimizations(copy);
   // replaces a fallback graph inserted by
   // specialize_autogradzero if one exists
@@ -640,7 +800,42 @@ const ExecutionPlan& ProfilingGraphExecutorImpl::getPlanFor(
   return getOptimizedPlanFor(stack, remaining_bailout_depth);
 }
 
+std::string ProfilingGraphExecutorImpl::exportProfile() {
+  std::lock_guard<std::mutex> lock(compile_mutex);
+  TORCH_CHECK(
+      pr_ && pr_->ready(),
+      "Profile can only be exported after the profiling runs of ",
+      function_name_);
+  return pr_->exportProfile();
+}
+
+bool ProfilingGraphExecutorImpl::importProfile(const std::string& profile) {
+  std::lock_guard<std::mutex> lock(compile_mutex);
+  // each bucket keeps its own profile, see NOTE [ Batch Size Buckets ]
+  bool buckets = batch_size_buckets_ ? !batch_size_buckets_->empty()
+                                     : !getBatchSizeBuckets().empty();
+  TORCH_CHECK(
+      !buckets,
+      "Profiles can't be imported by ",
+      function_name_,
+      " while batch size buckets are set");
+  // the profiling callbacks of a running profiling plan hold on to pr_
+  if (pr_ || optimized_plan_) {
+    return false;
+  }
+  auto pr = instrumentGraph();
+  if (!pr->importProfile(profile)) {
+    return false;
+  }
+  pr_ = std::move(pr);
+  profiling_plan_ = ExecutionPlan(pr_->graph(), function_name_);
+  return true;
+}
+
 GraphExecutorState ProfilingGraphExecutorImpl::getDebugState() {
+  if (!optimized_plan_ && !bucketed_executors_.empty()) {
+    return bucketed_executors_.begin()->second->getDebugState();
+  }
   GraphExecutorState state;
   TORCH_INTERNAL_ASSERT(optimized_plan_);
   auto opt_plan = *optimized_plan_;
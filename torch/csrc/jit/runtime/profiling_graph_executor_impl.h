@@ -1,6 +1,9 @@
 #pragma once
 #include <torch/csrc/jit/runtime/graph_executor_impl.h>
 
+#include <map>
+#include <set>
+
 namespace torch {
 namespace jit {
 
@@ -23,14 +26,29 @@ struct ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
     // prevent memory leaks
     fallback_functions_.clear();
     remaining_bailout_depth_.reset();
+    batch_size_buckets_.reset();
+    bucketed_executors_.clear();
+    overflow_executor_.reset();
+    profiled_batch_sizes_.clear();
   }
 
+  // Returns the profile collected by this executor once profiling is done.
+  std::string exportProfile();
+  // Seeds a fresh executor with a profile exported by an executor of the same
+  // graph, so the first run goes straight to optimization. Returns false if
+  // the profile doesn't match or the executor has already started profiling.
+  bool importProfile(const std::string& profile);
+
  private:
   const ExecutionPlan& getOptimizedPlanFor(
       Stack& stack,
       size_t remaining_bailout_depth);
   void runProfilingInsensitiveOptimizations(std::shared_ptr<Graph>& graph);
   void runProfilingOptimizations(std::shared_ptr<Graph>& graph);
+  std::unique_ptr<ProfilingRecord> instrumentGraph();
+  const ExecutionPlan& getBucketedPlanFor(Stack& stack);
+  std::unique_ptr<ProfilingGraphExecutorImpl> createBucketExecutor(
+      bool generalize_batch_sizes);
   void replaceFallbackGraphWithFallbackFunction(Block* b);
   std::unique_ptr<ProfilingRecord> pr_;
   c10::optional<ExecutionPlan>
@@ -48,6 +66,18 @@ struct ProfilingGraphExecutorImpl : public GraphExecutorImplBase {
   // of the GraphExecutor and only shared with InterpreterState
   std::vector<std::unique_ptr<Function>> fallback_functions_;
   c10::optional<size_t> remaining_bailout_depth_;
+
+  // see NOTE [ Batch Size Buckets ]
+  // decided on the first optimized run; empty if this executor doesn't bucket
+  c10::optional<std::vector<int64_t>> batch_size_buckets_;
+  // one executor per bucket key, up to `torch_jit_max_bucketed_plans`
+  std::map<std::vector<int64_t>, std::unique_ptr<ProfilingGraphExecutorImpl>>
+      bucketed_executors_;
+  // runs the keys that don't fit in `bucketed_executors_` anymore
+  std::unique_ptr<ProfilingGraphExecutorImpl> overflow_executor_;
+  // set on the executor of a bucket covering more than one batch size
+  bool generalize_batch_sizes_ = false;
+  std::set<int64_t> profiled_batch_sizes_;
 };
 
 } // namespace jit
@@ -8,6 +8,9 @@
 #include <torch/csrc/jit/runtime/autodiff.h>
 #include <torch/csrc/jit/runtime/graph_executor.h>
 #include <torch/csrc/jit/runtime/interpreter.h>
+#include <torch/version.h>
+
+#include <sstream>
 
 namespace torch {
 namespace jit {
@@ -300,12 +303,24 @@ void ProfilingRecord::removeProfilingNodes(Block* b) {
   }
 }
 
+// FNV-1a of the printed graph. Unlike std::hash, it is the same in every
+// build and process, so profiles can be exported and imported across them.
+static uint64_t fingerprintGraph(const Graph& graph) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : graph.toString(false)) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
 std::unique_ptr<ProfilingRecord> ProfilingRecord::instrumentGraph(
     const std::shared_ptr<Graph>& graph) {
   auto new_g = graph->copy();
 
   auto pr = std::unique_ptr<ProfilingRecord>(new ProfilingRecord(new_g));
   auto raw_pr = pr.get();
+  pr->graph_fingerprint_ = fingerprintGraph(*graph);
   unprofileGraphInputs(new_g);
   unprofileBlock(new_g->block());
   pr->instrumentBlock(new_g->block());
@@ -387,5 +402,288 @@ std::unique_ptr<ProfilingRecord> ProfilingRecord::instrumentGraph(
   return pr;
 }
 
+// NOTE [ Profile Serialization ]
+// Everything the optimizing passes learn from the profiling runs lives on the
+// profile nodes of a ready record: the merged `profiled_type` of every
+// prim::profile and the none counts of every prim::profile_ivalue.
+// Instrumentation is deterministic, so the profile is written out as one line
+// per profile node in graph order and applied to a freshly instrumented copy
+// of the same graph in another process. The header holds the version of the
+// build and a hash of the graph that was instrumented, and every line names
+// the node the profile feeds, so a profile taken for another graph, or by a
+// build that profiles a different set of nodes, is rejected rather than
+// applied to the wrong values. Shape
+// symbols are written as ids local to the profile and renamed on import: the
+// sets of equal dimensions survive, but they don't collide with symbols
+// already handed out in the importing process.
+
+static constexpr const char* kProfileVersion = "profiling_record_v2";
+
+static std::string buildVersion() {
+  return c10::str(
+      TORCH_VERSION_MAJOR, '.', TORCH_VERSION_MINOR, '.', TORCH_VERSION_PATCH);
+}
+static const auto noneCountsAttribute = Symbol::attr("none_counts");
+
+static void collectProfileNodes(Block* b, std::vector<Node*>& nodes) {
+  for (auto n : b->nodes()) {
+    // the counter is the only prim::profile without an output
+    if ((n->kind() == prim::profile && n->outputs().size() == 1) ||
+        n->kind() == prim::profile_ivalue) {
+      nodes.push_back(n);
+    }
+    for (auto ib : n->blocks()) {
+      collectProfileNodes(ib, nodes);
+    }
+  }
+}
+
+static std::string profiledUse(Node* n) {
+  const auto& uses = n->output()->uses();
+  return uses.empty() ? "-" : uses[0].user->kind().toQualString();
+}
+
+template <typename T>
+static void writeOptional(std::ostream& out, const c10::optional<T>& v) {
+  if (v) {
+    out << ' ' << *v;
+  } else {
+    out << " -";
+  }
+}
+
+template <typename T>
+static bool readOptional(std::istream& in, c10::optional<T>& v) {
+  std::string token;
+  if (!(in >> token)) {
+    return false;
+  }
+  if (token == "-") {
+    v = c10::nullopt;
+    return true;
+  }
+  std::istringstream ss(token);
+  T value;
+  if (!(ss >> value)) {
+    return false;
+  }
+  v = value;
+  return true;
+}
+
+static void writeTensorType(
+    std::ostream& out,
+    const TensorType& type,
+    std::map<ShapeSymbol, int64_t>& symbol_ids) {
+  c10::optional<int64_t> dtype;
+  if (type.scalarType()) {
+    dtype = static_cast<int64_t>(*type.scalarType());
+  }
+  c10::optional<std::string> device;
+  if (type.device()) {
+    device = type.device()->str();
+  }
+  writeOptional(out, dtype);
+  writeOptional(out, device);
+  writeOptional(out, type.requiresGrad());
+  writeOptional(out, type.undefined());
+
+  const auto& sizes = type.symbolic_sizes().sizes();
+  writeOptional(out, type.symbolic_sizes().rank());
+  if (sizes) {
+    for (const auto& s : *sizes) {
+      if (s.is_static()) {
+        out << ' ' << s.static_size();
+      } else {
+        auto it = symbol_ids.emplace(s, -1 - (int64_t)symbol_ids.size()).first;
+        out << ' ' << it->second;
+      }
+    }
+  }
+
+  const auto& strides = type.stride_properties();
+  writeOptional(out, strides.size());
+  if (strides.sizes()) {
+    for (const auto& stride : *strides.sizes()) {
+      auto st = stride.value_or(Stride());
+      writeOptional(out, st.stride_index_);
+      writeOptional(out, st.contiguous_);
+      writeOptional(out, st.stride_);
+    }
+  }
+}
+
+static TensorTypePtr readTensorType(
+    std::istream& in,
+    std::map<int64_t, ShapeSymbol>& symbols) {
+  c10::optional<int64_t> dtype;
+  c10::optional<std::string> device;
+  c10::optional<bool> requires_grad;
+  c10::optional<bool> undefined;
+  c10::optional<size_t> rank;
+  if (!readOptional(in, dtype) || !readOptional(in, device) ||
+      !readOptional(in, requires_grad) || !readOptional(in, undefined) ||
+      !readOptional(in, rank)) {
+    return nullptr;
+  }
+  // the dtype is cast to at::ScalarType below, so it must name one
+  c10::optional<at::ScalarType> scalar_type;
+  if (dtype) {
+    if (*dtype < 0 ||
+        *dtype >= static_cast<int64_t>(at::ScalarType::NumOptions)) {
+      return nullptr;
+    }
+    scalar_type = static_cast<at::ScalarType>(*dtype);
+  }
+
+  SymbolicShape sizes;
+  if (rank) {
+    std::vector<ShapeSymbol> dims;
+    for (size_t i = 0; i < *rank; i++) {
+      int64_t id = 0;
+      if (!(in >> id)) {
+        return nullptr;
+      }
+      if (id >= 0) {
+        dims.push_back(ShapeSymbol::fromStaticSize(id));
+      } else {
+        auto it = symbols.find(id);
+        if (it == symbols.end()) {
+          it = symbols.emplace(id, ShapeSymbol::newSymbol()).first;
+        }
+        dims.push_back(it->second);
+      }
+    }
+    sizes = SymbolicShape(std::move(dims));
+  }
+
+  c10::optional<size_t> strides_rank;
+  if (!readOptional(in, strides_rank)) {
+    return nullptr;
+  }
+  VaryingShape<Stride> strides(strides_rank);
+  if (strides_rank) {
+    std::vector<c10::optional<Stride>> props;
+    for (size_t i = 0; i < *strides_rank; i++) {
+      Stride st;
+      if (!readOptional(in, st.stride_index_) ||
+          !readOptional(in, st.contiguous_) || !readOptional(in, st.stride_)) {
+        return nullptr;
+      }
+      if (st.stride_index_ || st.contiguous_ || st.stride_) {
+        props.emplace_back(st);
+      } else {
+        props.emplace_back(c10::nullopt);
+      }
+    }
+    strides = VaryingShape<Stride>(std::move(props));
+  }
+
+  c10::optional<Device> parsed_device;
+  if (device) {
+    try {
+      parsed_device = Device(*device);
+    } catch (const c10::Error&) {
+      return nullptr;
+    }
+  }
+  return TensorType::create(
+      scalar_type,
+      parsed_device,
+      sizes,
+      strides,
+      requires_grad,
+      undefined);
+}
+
+std::string ProfilingRecord::exportProfile() const {
+  TORCH_CHECK(ready(), "Profile can only be exported once profiling is done");
+  std::vector<Node*> nodes;
+  collectProfileNodes(profiled_graph_->block(), nodes);
+
+  std::ostringstream out;
+  out << kProfileVersion << ' ' << buildVersion() << ' ' << graph_fingerprint_
+      << ' ' << nodes.size() << '\n';
+  std::map<ShapeSymbol, int64_t> symbol_ids;
+  for (auto n : nodes) {
+    if (n->kind() == prim::profile) {
+      out << "profile " << profiledUse(n);
+      writeTensorType(
+          out, *n->ty(attr::profiled_type)->expect<TensorType>(), symbol_ids);
+    } else {
+      auto counts = c10::impl::toTypedDict<std::string, int64_t>(
+          n->ival(noneCountsAttribute).toGenericDict());
+      out << "profile_ivalue " << counts.at("num_none") << ' '
+          << counts.at("num_present");
+    }
+    out << '\n';
+  }
+  return out.str();
+}
+
+bool ProfilingRecord::importProfile(const std::string& profile) {
+  std::vector<Node*> nodes;
+  collectProfileNodes(profiled_graph_->block(), nodes);
+
+  std::istringstream in(profile);
+  std::string version;
+  std::string build_version;
+  uint64_t fingerprint = 0;
+  size_t num_nodes = 0;
+  if (!(in >> version >> build_version >> fingerprint >> num_nodes) ||
+      version != kProfileVersion || build_version != buildVersion() ||
+      fingerprint != graph_fingerprint_ || num_nodes != nodes.size()) {
+    GRAPH_DEBUG("Profile doesn't match the graph");
+    return false;
+  }
+
+  // parse everything before touching the graph, so a bad profile leaves
+  // the record as it was
+  std::vector<TypePtr> types;
+  std::vector<std::pair<int64_t, int64_t>> none_counts;
+  std::map<int64_t, ShapeSymbol> symbols;
+  for (auto n : nodes) {
+    std::string kind;
+    if (!(in >> kind) || kind != n->kind().toUnqualString()) {
+      GRAPH_DEBUG("Profile doesn't match ", getHeader(n));
+      return false;
+    }
+    if (n->kind() == prim::profile) {
+      std::string use;
+      TensorTypePtr type;
+      if (!(in >> use) || use != profiledUse(n) ||
+          !(type = readTensorType(in, symbols))) {
+        GRAPH_DEBUG("Profile doesn't match ", getHeader(n));
+        return false;
+      }
+      types.emplace_back(std::move(type));
+    } else {
+      int64_t num_none = 0;
+      int64_t num_present = 0;
+      if (!(in >> num_none >> num_present)) {
+        return false;
+      }
+      none_counts.emplace_back(num_none, num_present);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto type_it = types.begin();
+  auto counts_it = none_counts.begin();
+  for (auto n : nodes) {
+    if (n->kind() == prim::profile) {
+      n->ty_(attr::profiled_type, *type_it++);
+    } else {
+      c10::Dict<std::string, int64_t> counts;
+      counts.insert("num_none", counts_it->first);
+      counts.insert("num_present", counts_it->second);
+      counts_it++;
+      n->ival_(noneCountsAttribute, IValue(counts));
+    }
+  }
+  profiling_count_ = 0;
+  return true;
+}
+
 } // namespace jit
 } // namespace torch
@@ -9,6 +9,7 @@
 
 #include <list>
 #include <map>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -206,6 +207,15 @@ struct ProfilingRecord {
 
   TORCH_API ProfileIValueOp* createProfileIValueNode(Value* in_val);
 
+  // Serializes the merged profile of a ready record so that another process
+  // running the same graph can skip the profiling runs, see
+  // NOTE [ Profile Serialization ]
+  TORCH_API std::string exportProfile() const;
+  // Applies a profile written by `exportProfile` and marks the record ready.
+  // Returns false and leaves the record untouched if the profile was taken
+  // for a different graph or by a build that instruments it differently.
+  TORCH_API bool importProfile(const std::string& profile);
+
  private:
   ProfileOp* createProfileNode(
       const std::function<void(Stack&)>& fp,
@@ -213,6 +223,8 @@ struct ProfilingRecord {
   void instrumentBlock(Block* block);
   void insertShapeProfile(Node* n, size_t offset);
   ProfilingRecord(std::shared_ptr<Graph> g);
+  // hash of the graph this record was instrumented from
+  uint64_t graph_fingerprint_ = 0;
 };
 
 } // namespace jit
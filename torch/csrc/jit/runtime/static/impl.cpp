@@ -1,5 +1,6 @@
 #include <torch/csrc/jit/runtime/static/impl.h>
 
+#include <ATen/Parallel.h>
 #include <ATen/core/LegacyTypeDispatch.h>
 #include <ATen/core/interned_strings.h>
 #include <c10/core/CPUAllocator.h>
@@ -15,6 +16,10 @@
 #include <torch/csrc/jit/runtime/static/passes.h>
 #include <torch/csrc/jit/runtime/vararg_functions.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
 namespace torch {
 namespace jit {
 
@@ -38,12 +43,25 @@ void OptimizeGraph(std::shared_ptr<torch::jit::Graph>& graph) {
   ConstantPropagation(graph);
 }
 
-void CheckGraphEligibility(const std::shared_ptr<torch::jit::Graph>& graph) {
-  for (auto n : graph->nodes()) {
+void CheckBlockEligibility(Block* block) {
+  for (auto n : block->nodes()) {
     if (n->kind() == c10::Symbol::fromQualString("prim::GetAttr")) {
       throw std::runtime_error("Cannot accelerate unfrozen graphs");
     }
+    if (!n->blocks().empty()) {
+      TORCH_CHECK(
+          n->kind() == prim::If || n->kind() == prim::Loop,
+          "Static Runtime only supports the control flow of prim::If and prim::Loop, but got ",
+          n->kind().toQualString());
+      for (Block* sub_block : n->blocks()) {
+        CheckBlockEligibility(sub_block);
+      }
+    }
   }
+}
+
+void CheckGraphEligibility(const std::shared_ptr<torch::jit::Graph>& graph) {
+  CheckBlockEligibility(graph->block());
   // check output types
   // Static Runtime supports output types include None, Tensor and List/Tuple
   // of Tensor
@@ -106,26 +124,45 @@ bool mayContainAlias(
   return db.mayContainAlias(as, bs);
 }
 
+// Whether `v` is defined in `block` or in one of its sub-blocks
+bool isDefinedInBlock(const Value* v, const Block* block) {
+  for (const Node* n = v->node(); n; n = n->owningBlock()->owningNode()) {
+    if (n->owningBlock() == block) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// The node of `block` that is `n`, or that has `n` in one of its sub-blocks
+const Node* findNodeInBlock(const Node* n, const Block* block) {
+  while (n->owningBlock() != block) {
+    n = n->owningBlock()->owningNode();
+    TORCH_INTERNAL_ASSERT(n, "Node is not in the block");
+  }
+  return n;
+}
+
 // Returns two useful constructs:
 //  first: map each value to all values that are alive
 //    at the same time.
 //  second: set of all inputs/outputs/constants (always alive)
 //    and their aliases
 //  The algorithm does a traversal of the execution graph
-//  while keeping track of the live values.
+//  while keeping track of the live values. Only the values defined by the
+//  nodes of `block` are tracked: a prim::If or prim::Loop node of the block
+//  uses all the values that its sub-blocks use.
 using LivenessInformation = std::pair<
     std::unordered_map<const Value*, std::set<const Value*>>,
     std::unordered_set<const Value*>>;
 
-LivenessInformation GetLivenessInformation(
-    const std::shared_ptr<torch::jit::Graph>& graph,
-    AliasDb& db) {
+LivenessInformation GetLivenessInformation(Block* block, AliasDb& db) {
   std::unordered_map<const Value*, std::set<const Value*>> liveness_map;
   std::unordered_set<const Value*> always_alive;
 
   std::vector<const Value*> values_in_creation_order;
   std::unordered_map<const Value*, size_t> values_in_creation_order_idx;
-  for (const auto* node : graph->nodes()) {
+  for (const auto* node : block->nodes()) {
     for (const auto* v : node->outputs()) {
       values_in_creation_order_idx[v] = values_in_creation_order.size();
       values_in_creation_order.emplace_back(v);
@@ -142,14 +179,14 @@ LivenessInformation GetLivenessInformation(
   std::unordered_map<const Node*, std::set<const Value*>> live_nodes;
 
   // inputs and outputs are marked permanently alive
-  for (const auto* input : graph->inputs()) {
+  for (const auto* input : block->inputs()) {
     always_alive.insert(input);
   }
-  for (const auto* output : graph->outputs()) {
+  for (const auto* output : block->outputs()) {
     always_alive.insert(output);
   }
 
-  for (const auto* node : graph->nodes()) {
+  for (const auto* node : block->nodes()) {
     if (node->kind() == prim::Constant) {
       for (const auto* output : node->outputs()) {
         always_alive.insert(output);
@@ -157,6 +194,27 @@ LivenessInformation GetLivenessInformation(
     }
   }
 
+  // so are the values of the enclosing blocks that a sub-block uses
+  std::function<void(const Block* b)> add_free_values;
+  add_free_values = [&](const Block* b) {
+    for (const auto* node : b->nodes()) {
+      for (const auto* input : node->inputs()) {
+        if (!isDefinedInBlock(input, block)) {
+          always_alive.insert(input);
+        }
+      }
+      for (const auto* sub_block : node->blocks()) {
+        add_free_values(sub_block);
+      }
+    }
+    for (const auto* output : b->outputs()) {
+      if (!isDefinedInBlock(output, block)) {
+        always_alive.insert(output);
+      }
+    }
+  };
+  add_free_values(block);
+
   std::function<void(const Value* v)> add_live_value;
   add_live_value = [&](const Value* v) {
     if (liveness_map.count(v)) {
@@ -176,7 +234,7 @@ LivenessInformation GetLivenessInformation(
     }
 
     for (const auto& u : v->uses()) {
-      const auto* node = u.user;
+      const auto* node = findNodeInBlock(u.user, block);
       // track deps of this value
       live_values.at(v).insert(node);
       live_nodes[node].insert(v);
@@ -196,7 +254,7 @@ LivenessInformation GetLivenessInformation(
     for (auto* aliased_v : aliased_vs) {
       add_live_value(aliased_v);
       for (const auto& u : aliased_v->uses()) {
-        const auto* node = u.user;
+        const auto* node = findNodeInBlock(u.user, block);
         // track deps of the aliased values is if they
         // are our own
         live_values.at(v).insert(node);
@@ -216,7 +274,7 @@ LivenessInformation GetLivenessInformation(
     }
   };
 
-  for (const auto* node : graph->nodes()) {
+  for (const auto* node : block->nodes()) {
     for (const auto* v : node->outputs()) {
       if (mayContainAlias(db, ValueSet{v}, always_alive)) {
         always_alive.insert(v);
@@ -236,7 +294,7 @@ LivenessInformation GetLivenessInformation(
     TORCH_CHECK(always_alive.count(v.first));
   }
 
-  for (const auto* node : graph->nodes()) {
+  for (const auto* node : block->nodes()) {
     for (const auto* input : node->inputs()) {
       for (const auto* output : node->outputs()) {
         if (liveness_map.count(input) && liveness_map.count(output)) {
@@ -259,7 +317,7 @@ LivenessInformation GetLivenessInformation(
 //   first: Values that can be optimized
 //   second: A deterministc order of all values
 std::pair<std::vector<const Value*>, std::vector<const Value*>>
-GetOptimizableValues(const std::shared_ptr<torch::jit::Graph>& graph) {
+GetOptimizableValues(Block* block) {
   // for determinism
   std::unordered_set<const Value*> seen_values;
   std::vector<const Value*> all_values;
@@ -267,7 +325,7 @@ GetOptimizableValues(const std::shared_ptr<torch::jit::Graph>& graph) {
   // values used by unsupported ops (as either inputs or outputs)
   // these need to be removed from "can_reuse" after analyzing all nodes
   std::unordered_set<const Value*> cannot_reuse;
-  for (auto* n : graph->nodes()) {
+  for (auto* n : block->nodes()) {
     for (const auto* v : n->inputs()) {
       if (!seen_values.count(v)) {
         all_values.emplace_back(v);
@@ -424,6 +482,303 @@ std::unordered_map<const Value*, std::vector<const Value*>> FindShared(
   return shared;
 }
 
+// The indices of the nodes of `block` in StaticModule::nodes(), which skips
+// the constants
+std::unordered_map<const Node*, size_t> GetNodeIndices(Block* block) {
+  std::unordered_map<const Node*, size_t> node_indices;
+  for (const auto* node : block->nodes()) {
+    if (node->kind() != prim::Constant) {
+      const auto idx = node_indices.size();
+      node_indices[node] = idx;
+    }
+  }
+  return node_indices;
+}
+
+// Whether the node, or a node of its sub-blocks, has effects that are not
+// captured by its inputs and outputs
+bool IsInterOpBarrier(Node* node, AliasDb& db) {
+  if (node->hasSideEffects() || db.isMutable(node) ||
+      db.writesToWildcard(node)) {
+    return true;
+  }
+  for (Block* sub_block : node->blocks()) {
+    for (Node* n : sub_block->nodes()) {
+      if (IsInterOpBarrier(n, db)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Computes the dependency graph of the nodes of the top level block for
+// inter op parallelism. A node depends on the nodes producing the values
+// that it or its sub-blocks use. Barriers, see IsInterOpBarrier, depend on
+// all the nodes since the previous barrier, and the nodes after a barrier
+// depend on it, so the barriers keep their order with respect to all the
+// other nodes.
+void GetNodeDependencies(
+    Block* block,
+    AliasDb& db,
+    std::vector<std::vector<size_t>>& dependents,
+    std::vector<size_t>& num_dependencies) {
+  const auto node_indices = GetNodeIndices(block);
+  dependents.assign(node_indices.size(), {});
+  num_dependencies.assign(node_indices.size(), 0);
+
+  c10::optional<size_t> last_barrier;
+  std::vector<size_t> since_last_barrier;
+  for (Node* node : block->nodes()) {
+    if (node->kind() == prim::Constant) {
+      continue;
+    }
+    const size_t idx = node_indices.at(node);
+    std::set<size_t> dependencies;
+    auto add_dependency = [&](const Value* v) {
+      auto it = node_indices.find(v->node());
+      if (it != node_indices.end()) {
+        dependencies.insert(it->second);
+      }
+    };
+    std::function<void(Block*)> add_block_dependencies;
+    add_block_dependencies = [&](Block* b) {
+      for (Node* n : b->nodes()) {
+        for (const auto* input : n->inputs()) {
+          add_dependency(input);
+        }
+        for (Block* sub_block : n->blocks()) {
+          add_block_dependencies(sub_block);
+        }
+      }
+      for (const auto* output : b->outputs()) {
+        add_dependency(output);
+      }
+    };
+    for (const auto* input : node->inputs()) {
+      add_dependency(input);
+    }
+    for (Block* sub_block : node->blocks()) {
+      add_block_dependencies(sub_block);
+    }
+
+    if (IsInterOpBarrier(node, db)) {
+      dependencies.insert(since_last_barrier.begin(), since_last_barrier.end());
+      since_last_barrier.clear();
+      if (last_barrier) {
+        dependencies.insert(*last_barrier);
+      }
+      last_barrier = idx;
+    } else {
+      if (last_barrier) {
+        dependencies.insert(*last_barrier);
+      }
+      since_last_barrier.emplace_back(idx);
+    }
+
+    for (auto dependency : dependencies) {
+      dependents[dependency].emplace_back(idx);
+    }
+    num_dependencies[idx] = dependencies.size();
+  }
+}
+
+// An upper bound of the number of nodes that can run at the same time: the
+// largest number of nodes at the same depth of the dependency graph
+size_t GetInterOpWidth(const std::vector<std::vector<size_t>>& dependents) {
+  std::vector<size_t> depth(dependents.size(), 0);
+  std::vector<size_t> num_nodes_per_depth;
+  // the nodes are in topological order
+  for (size_t i = 0; i < dependents.size(); ++i) {
+    if (depth[i] >= num_nodes_per_depth.size()) {
+      num_nodes_per_depth.resize(depth[i] + 1, 0);
+    }
+    num_nodes_per_depth[depth[i]]++;
+    for (auto dependent : dependents[i]) {
+      depth[dependent] = std::max(depth[dependent], depth[i] + 1);
+    }
+  }
+  size_t width = 1;
+  for (auto num_nodes : num_nodes_per_depth) {
+    width = std::max(width, num_nodes);
+  }
+  return width;
+}
+
+// With inter op parallelism, the nodes of the top level block may run in any
+// order that respects their dependencies, so two values of the block can be
+// alive at the same time unless all the nodes using one of them must run
+// before the node producing the other. Marks all such values as alive at the
+// same time in the liveness map.
+void AddInterOpLiveness(
+    Block* block,
+    const std::vector<std::vector<size_t>>& dependents,
+    LivenessInformation& lm) {
+  auto& liveness_map = lm.first;
+  const auto node_indices = GetNodeIndices(block);
+  const size_t num_nodes = dependents.size();
+
+  // runs_before[i][j]: node i must run before node j
+  std::vector<std::vector<bool>> runs_before(
+      num_nodes, std::vector<bool>(num_nodes, false));
+  // the nodes are in topological order
+  for (size_t i = num_nodes; i-- > 0;) {
+    for (auto j : dependents[i]) {
+      runs_before[i][j] = true;
+      for (size_t k = j + 1; k < num_nodes; ++k) {
+        if (runs_before[j][k]) {
+          runs_before[i][k] = true;
+        }
+      }
+    }
+  }
+
+  struct Lifetime {
+    const Value* value;
+    size_t producer;
+    // the nodes using the value, empty if the value is used by the return
+    // node of the block and is alive until the end
+    std::vector<size_t> users;
+  };
+  std::vector<Lifetime> lifetimes;
+  for (const auto& p : liveness_map) {
+    const Value* v = p.first;
+    auto producer = node_indices.find(v->node());
+    if (producer == node_indices.end()) {
+      continue;
+    }
+    Lifetime lifetime{v, producer->second, {}};
+    bool used_until_end = false;
+    for (const auto& u : v->uses()) {
+      auto user = node_indices.find(findNodeInBlock(u.user, block));
+      if (user == node_indices.end()) {
+        used_until_end = true;
+        break;
+      }
+      lifetime.users.emplace_back(user->second);
+    }
+    if (used_until_end) {
+      lifetime.users.clear();
+    } else if (lifetime.users.empty()) {
+      // dies right after being produced
+      lifetime.users.emplace_back(lifetime.producer);
+    }
+    lifetimes.emplace_back(std::move(lifetime));
+  }
+
+  auto dies_before = [&](const Lifetime& a, const Lifetime& b) {
+    if (a.users.empty()) {
+      return false;
+    }
+    for (auto user : a.users) {
+      if (!runs_before[user][b.producer]) {
+        return false;
+      }
+    }
+    return true;
+  };
+  for (size_t i = 0; i < lifetimes.size(); ++i) {
+    for (size_t j = i + 1; j < lifetimes.size(); ++j) {
+      const auto& a = lifetimes[i];
+      const auto& b = lifetimes[j];
+      if (!dies_before(a, b) && !dies_before(b, a)) {
+        liveness_map.at(a.value).insert(b.value);
+        liveness_map.at(b.value).insert(a.value);
+      }
+    }
+  }
+}
+
+// The state of a run of the top level block with inter op parallelism. It is
+// shared with the tasks of the inter op thread pool, which may only start
+// after the run is over.
+struct InterOpRunState {
+  explicit InterOpRunState(const std::vector<size_t>& num_dependencies)
+      : num_pending(new std::atomic<size_t>[num_dependencies.size()]),
+        num_remaining(num_dependencies.size()) {
+    for (size_t i = 0; i < num_dependencies.size(); ++i) {
+      num_pending[i].store(num_dependencies[i], std::memory_order_relaxed);
+    }
+    // popped from the back, so that the nodes start in their original order
+    for (size_t i = num_dependencies.size(); i-- > 0;) {
+      if (num_dependencies[i] == 0) {
+        ready.emplace_back(i);
+      }
+    }
+  }
+
+  // the number of dependencies of each node that have not run yet
+  std::unique_ptr<std::atomic<size_t>[]> num_pending;
+  // the number of nodes that have not run yet
+  std::atomic<size_t> num_remaining;
+  std::atomic<bool> failed{false};
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  // guarded by mutex
+  std::vector<size_t> ready;
+  std::exception_ptr error;
+};
+
+// Runs ready nodes until all the nodes have run. A node that becomes ready
+// when its last dependency finishes runs on the same thread, and only the
+// other nodes it releases go through the shared queue. When a node throws,
+// the nodes that are left are released without running.
+void RunInterOpWorker(
+    InterOpRunState& state,
+    const std::vector<std::vector<size_t>>& dependents,
+    const std::function<void(size_t)>& run_node) {
+  c10::optional<size_t> next;
+  while (true) {
+    if (!next) {
+      std::unique_lock<std::mutex> lock(state.mutex);
+      state.cv.wait(lock, [&] {
+        return !state.ready.empty() || state.num_remaining.load() == 0;
+      });
+      if (state.ready.empty()) {
+        return;
+      }
+      next = state.ready.back();
+      state.ready.pop_back();
+    }
+    const size_t idx = *next;
+    next = c10::nullopt;
+
+    if (!state.failed.load()) {
+      try {
+        run_node(idx);
+      } catch (...) {
+        std::lock_guard<std::mutex> guard(state.mutex);
+        if (!state.error) {
+          state.error = std::current_exception();
+        }
+        state.failed.store(true);
+      }
+    }
+
+    bool released = false;
+    for (auto dependent : dependents[idx]) {
+      if (state.num_pending[dependent].fetch_sub(1) == 1) {
+        if (!next) {
+          next = dependent;
+        } else {
+          std::lock_guard<std::mutex> guard(state.mutex);
+          state.ready.emplace_back(dependent);
+          released = true;
+        }
+      }
+    }
+    if (released) {
+      state.cv.notify_all();
+    }
+    if (state.num_remaining.fetch_sub(1) == 1) {
+      // notify under the lock, so that no thread misses that the run is over
+      std::lock_guard<std::mutex> guard(state.mutex);
+      state.cv.notify_all();
+    }
+  }
+}
+
 } // namespace
 
 void PrepareGraphForStaticModule(std::shared_ptr<torch::jit::Graph> graph) {
@@ -488,61 +843,103 @@ StaticModule::StaticModule(
   // aware of the new order!
 
   // Fill constants first, so we have a std::vector<IValue> we can reference
-  // later
-  for (Node* node : graph_->nodes()) {
-    if (node->kind() != prim::Constant) {
-      continue;
+  // later. Constants are usually all in the top level block, but sub-blocks
+  // may have some of their own.
+  std::vector<Node*> constant_nodes;
+  std::function<void(Block*)> collect_constants;
+  collect_constants = [&](Block* block) {
+    for (Node* node : block->nodes()) {
+      if (node->kind() == prim::Constant) {
+        constant_nodes.emplace_back(node);
+      }
+      for (Block* sub_block : node->blocks()) {
+        collect_constants(sub_block);
+      }
     }
+  };
+  collect_constants(graph_->block());
+  for (Node* node : constant_nodes) {
     auto* v = node->output();
     TORCH_CHECK(v->type()->kind() != FunctionType::Kind);
     constants_.emplace_back(toIValue(v).value());
   }
-  {
-    int i = 0;
-    for (Node* node : graph_->nodes()) {
-      if (node->kind() != prim::Constant) {
-        continue;
-      }
-      auto* v = node->output();
-      // constants denoted -2, i
-      val_to_idx[v] = std::make_pair(-2, i);
-      val_to_ival[v] = &(constants_[i++]);
-    }
+  for (auto i = 0; i < constant_nodes.size(); ++i) {
+    auto* v = constant_nodes[i]->output();
+    // constants denoted -2, i
+    val_to_idx[v] = std::make_pair(-2, i);
+    val_to_ival[v] = &(constants_[i]);
   }
 
+  // The blocks are laid out one after the other in nodes_, in breadth first
+  // order, so that the top level block comes first and the values that a
+  // sub-block uses from its enclosing blocks are known before it is reached.
+  blocks_.emplace_back();
+  blocks_[0].block = graph_->block();
   int node_idx = 0;
-  for (Node* node : graph_->nodes()) {
-    if (node->kind() == prim::Constant) {
-      continue;
+  for (auto block_idx = 0; block_idx < blocks_.size(); ++block_idx) {
+    Block* block = blocks_[block_idx].block;
+    if (block_idx > 0) {
+      blocks_[block_idx].inputs_begin = num_block_inputs_;
+      for (Value* input : block->inputs()) {
+        val_to_ival[input] = nullptr;
+        // inputs of sub-blocks denoted by -3
+        val_to_idx[input] =
+            std::make_pair(-3, static_cast<int>(num_block_inputs_++));
+      }
     }
-    std::vector<const IValue*> inputs;
-    std::vector<std::pair<int, int>> indices;
-    for (Value* input : node->inputs()) {
-      inputs.emplace_back(val_to_ival.at(input));
-      indices.emplace_back(val_to_idx.at(input));
+    blocks_[block_idx].nodes_begin = node_idx;
+    for (Node* node : block->nodes()) {
+      if (node->kind() == prim::Constant) {
+        continue;
+      }
+      std::vector<const IValue*> inputs;
+      std::vector<std::pair<int, int>> indices;
+      for (Value* input : node->inputs()) {
+        inputs.emplace_back(val_to_ival.at(input));
+        indices.emplace_back(val_to_idx.at(input));
+      }
+      index_map_[node_idx] = indices;
+      nodes_.emplace_back(
+          ProcessedNode(node, std::move(inputs), opts.enable_out_variant));
+      std::vector<size_t> sub_blocks;
+      for (Block* sub_block : node->blocks()) {
+        sub_blocks.emplace_back(blocks_.size());
+        blocks_.emplace_back();
+        blocks_.back().block = sub_block;
+      }
+      nodes_.back().set_blocks(std::move(sub_blocks));
+      for (auto i = 0; i < node->outputs().size(); ++i) {
+        val_to_ival[node->outputs()[i]] = nullptr;
+        val_to_idx[node->outputs()[i]] = std::make_pair(node_idx, i);
+      }
+      node_idx++;
     }
-    index_map_[node_idx] = indices;
-    nodes_.emplace_back(
-        ProcessedNode(node, std::move(inputs), opts.enable_out_variant));
-    for (auto i = 0; i < node->outputs().size(); ++i) {
-      val_to_ival[node->outputs()[i]] = nullptr;
-      val_to_idx[node->outputs()[i]] = std::make_pair(node_idx, i);
+    blocks_[block_idx].nodes_end = node_idx;
+    for (auto output : block->outputs()) {
+      blocks_[block_idx].output_indices.emplace_back(val_to_idx.at(output));
     }
-    node_idx++;
-  }
-  for (auto output : graph_->outputs()) {
-    output_indices_.emplace_back(val_to_idx[output]);
   }
 
   AliasDb alias_db(graph_);
-  auto lm = GetLivenessInformation(graph_, alias_db);
-  external_values_ = lm.second;
-  if (opts_.optimize_memory) {
-    auto values = GetOptimizableValues(graph_);
-    if (!opts_.enable_out_variant) {
-      values.first = {};
+  if (opts_.enable_inter_op_parallelism) {
+    GetNodeDependencies(
+        graph_->block(), alias_db, dependents_, num_dependencies_);
+    inter_op_width_ = GetInterOpWidth(dependents_);
+  }
+  for (auto& block : blocks_) {
+    auto lm = GetLivenessInformation(block.block, alias_db);
+    // the sub-blocks run sequentially within their prim::If or prim::Loop
+    if (opts_.enable_inter_op_parallelism && block.block == graph_->block()) {
+      AddInterOpLiveness(block.block, dependents_, lm);
+    }
+    block.external_values = lm.second;
+    if (opts_.optimize_memory) {
+      auto values = GetOptimizableValues(block.block);
+      if (!opts_.enable_out_variant) {
+        values.first = {};
+      }
+      block.shared_values = FindShared(lm, values, alias_db);
     }
-    shared_values_ = FindShared(lm, values, alias_db);
   }
 }
 
@@ -578,6 +975,7 @@ c10::IValue StaticModule::operator()(
 StaticRuntime::StaticRuntime(const StaticModule& sm) : static_module_(sm) {
   // NB: create unchanging std::vector<IValue>s we can reference
   inputs_.resize(sm.num_inputs());
+  block_inputs_.resize(sm.num_block_inputs());
   nodes_.resize(sm.nodes().size());
   for (auto idx = 0; idx < sm.nodes().size(); ++idx) {
     const auto& n_ref = sm.nodes()[idx];
@@ -595,6 +993,8 @@ StaticRuntime::StaticRuntime(const StaticModule& sm) : static_module_(sm) {
           n.set_input(i, &inputs_[out_idx]);
         } else if (node_idx == -2) {
           n.set_input(i, &sm.constants()[out_idx]);
+        } else if (node_idx == -3) {
+          n.set_input(i, &block_inputs_[out_idx]);
         } else {
           n.set_input(i, &(nodes_[node_idx].Output(out_idx)));
         }
@@ -602,22 +1002,36 @@ StaticRuntime::StaticRuntime(const StaticModule& sm) : static_module_(sm) {
     }
   }
 
-  for (const auto& index_pair : sm.output_indices()) {
-    int node_idx;
-    int out_idx;
-    std::tie(node_idx, out_idx) = index_pair;
-    if (node_idx == -1) {
-      outputs_.emplace_back(&inputs_[out_idx]);
-    } else if (node_idx == -2) {
-      // This is a very rare case where const correctness
-      // breaks -- the user is returning a constant from
-      // the graph.
-      outputs_.emplace_back(const_cast<IValue*>(&sm.constants()[out_idx]));
-    } else {
-      auto& n = nodes_.at(node_idx);
-      auto* out = &n.Output(out_idx);
-      outputs_.emplace_back(out);
+  auto get_outputs = [&](const std::vector<std::pair<int, int>>& indices) {
+    std::vector<IValue*> outputs;
+    for (const auto& index_pair : indices) {
+      int node_idx;
+      int out_idx;
+      std::tie(node_idx, out_idx) = index_pair;
+      if (node_idx == -1) {
+        outputs.emplace_back(&inputs_[out_idx]);
+      } else if (node_idx == -2) {
+        // This is a very rare case where const correctness
+        // breaks -- the user is returning a constant from
+        // the graph.
+        outputs.emplace_back(const_cast<IValue*>(&sm.constants()[out_idx]));
+      } else if (node_idx == -3) {
+        outputs.emplace_back(&block_inputs_[out_idx]);
+      } else {
+        auto& n = nodes_.at(node_idx);
+        auto* out = &n.Output(out_idx);
+        outputs.emplace_back(out);
+      }
     }
+    return outputs;
+  };
+  outputs_ = get_outputs(sm.output_indices());
+
+  block_outputs_.resize(sm.blocks().size());
+  block_planners_.resize(sm.blocks().size());
+  for (auto block_idx = 1; block_idx < sm.blocks().size(); ++block_idx) {
+    block_outputs_[block_idx] =
+        get_outputs(sm.blocks()[block_idx].output_indices);
   }
 }
 
@@ -678,17 +1092,19 @@ c10::IValue StaticRuntime::operator()(
   // NB: before optimizing the order of execution, ensure that the
   // memory optimization pass (LivenessMap) is
   // aware of the new order!
-  for (auto& n : nodes_) {
-    n.run();
+  const auto& block = static_module_.blocks()[0];
+  if (static_module_.opts().enable_inter_op_parallelism) {
+    run_nodes_inter_op();
+  } else {
+    for (size_t i = block.nodes_begin; i < block.nodes_end; ++i) {
+      run_node(nodes_[i]);
+    }
   }
 
   if (static_module_.opts().cleanup_activations) {
     if (!planner_) {
       planner_ = std::make_unique<MemoryPlanner>(
-          this,
-          static_module_.shared_values(),
-          static_module_.external_values(),
-          static_module_.opts().enable_out_variant);
+          this, block, outputs_, static_module_.opts().enable_out_variant);
     }
     planner_->deallocate();
     // clean up owning refs of input tensors
@@ -716,6 +1132,115 @@ c10::IValue StaticRuntime::operator()(
   return std::move(*outputs_[0]);
 }
 
+void StaticRuntime::run_node(ProcessedNode& n) {
+  if (n.blocks().empty()) {
+    n.run();
+  } else {
+    run_control_flow(n);
+  }
+}
+
+void StaticRuntime::run_nodes_inter_op() {
+  const auto& dependents = static_module_.dependents();
+  auto state =
+      std::make_shared<InterOpRunState>(static_module_.num_dependencies());
+  std::function<void(size_t)> run = [this](size_t idx) {
+    run_node(nodes_[idx]);
+  };
+
+  // The calling thread runs nodes too, so the run completes even if the inter
+  // op threads are busy. at::launch propagates the thread local state, e.g.
+  // the AutoNonVariableTypeMode of the run.
+  const size_t num_helpers = std::min<size_t>(
+      at::get_num_interop_threads(), static_module_.inter_op_width() - 1);
+  for (size_t i = 0; i < num_helpers; ++i) {
+    at::launch([state, &dependents, run]() {
+      RunInterOpWorker(*state, dependents, run);
+    });
+  }
+  RunInterOpWorker(*state, dependents, run);
+
+  if (state->error) {
+    std::rethrow_exception(state->error);
+  }
+}
+
+void StaticRuntime::run_control_flow(ProcessedNode& n) {
+  const auto& blocks = n.blocks();
+  if (n.node()->kind() == prim::If) {
+    const size_t block_idx = n.Input(0).toBool() ? blocks[0] : blocks[1];
+    run_block(block_idx);
+    const auto& block_outputs = block_outputs_[block_idx];
+    for (size_t i = 0; i < block_outputs.size(); ++i) {
+      n.Output(i) = *block_outputs[i];
+    }
+    cleanup_block(block_idx);
+    return;
+  }
+
+  DCHECK(n.node()->kind() == prim::Loop);
+  // node inputs: max trip count, initial condition, initial carried values
+  // block inputs: trip count, carried values
+  // block outputs: condition, carried values
+  const size_t block_idx = blocks[0];
+  const auto& block_outputs = block_outputs_[block_idx];
+  IValue* block_inputs =
+      &block_inputs_[static_module_.blocks()[block_idx].inputs_begin];
+  const size_t num_carried = n.outputs().size();
+  for (size_t i = 0; i < num_carried; ++i) {
+    block_inputs[i + 1] = n.Input(i + 2);
+  }
+  const int64_t max_trip_count = n.Input(0).toInt();
+  bool condition = n.Input(1).toBool();
+  std::vector<IValue> carried(num_carried);
+  for (int64_t trip_count = 0; condition && trip_count < max_trip_count;
+       ++trip_count) {
+    block_inputs[0] = trip_count;
+    run_block(block_idx);
+    condition = block_outputs[0]->toBool();
+    // the block outputs may be block inputs, so all of them are read before
+    // the block inputs are updated
+    for (size_t i = 0; i < num_carried; ++i) {
+      carried[i] = *block_outputs[i + 1];
+    }
+    cleanup_block(block_idx);
+    for (size_t i = 0; i < num_carried; ++i) {
+      block_inputs[i + 1] = std::move(carried[i]);
+    }
+  }
+  for (size_t i = 0; i < num_carried; ++i) {
+    n.Output(i) = std::move(block_inputs[i + 1]);
+  }
+  block_inputs[0] = IValue();
+}
+
+void StaticRuntime::run_block(size_t block_idx) {
+  const auto& block = static_module_.blocks()[block_idx];
+  if (block_planners_[block_idx]) {
+    block_planners_[block_idx]->allocate();
+  }
+  for (size_t i = block.nodes_begin; i < block.nodes_end; ++i) {
+    run_node(nodes_[i]);
+  }
+}
+
+// Must be called once the outputs of the block have been read, as they are
+// cleaned up together with the other values of the block.
+void StaticRuntime::cleanup_block(size_t block_idx) {
+  if (!static_module_.opts().cleanup_activations) {
+    return;
+  }
+  auto& planner = block_planners_[block_idx];
+  if (!planner) {
+    planner = std::make_unique<MemoryPlanner>(
+        this,
+        static_module_.blocks()[block_idx],
+        std::vector<IValue*>(),
+        static_module_.opts().enable_out_variant);
+  }
+  planner->deallocate();
+}
+
 void StaticRuntime::benchmark(
     const std::vector<c10::IValue>& args,
     const std::unordered_map<std::string, c10::IValue>& kwargs,
@@ -728,7 +1253,8 @@ void StaticRuntime::benchmark(
   IndividualMetrics results =
       benchmark_individual_ops(args, kwargs, warmup_runs, main_runs);
 
-  for (size_t i = 0; i < nodes_.size(); i++) {
+  // the nodes of the sub-blocks are timed with their prim::If or prim::Loop
+  for (size_t i = 0; i < results.time_per_node.size(); i++) {
     const Node* node = nodes_[i].node();
     std::cout << "Node #" << i << ": " << results.time_per_node[i]
               << " ms/iter, ";
@@ -802,7 +1328,8 @@ StaticRuntime::IndividualMetrics StaticRuntime::benchmark_individual_ops(
   at::AutoNonVariableTypeMode non_var_type_mode(true);
 
   IndividualMetrics results;
-  results.time_per_node.resize(nodes_.size(), 0);
+  const auto& block = static_module_.blocks()[0];
+  results.time_per_node.resize(block.nodes_end - block.nodes_begin, 0);
 
   // setup time
   caffe2::Timer timer;
@@ -837,9 +1364,9 @@ StaticRuntime::IndividualMetrics StaticRuntime::benchmark_individual_ops(
     float millis = timer.MilliSeconds();
     results.memory_alloc_time += millis;
 
-    for (size_t i = 0; i < nodes_.size(); i++) {
+    for (size_t i = 0; i < results.time_per_node.size(); i++) {
       timer.Start();
-      nodes_[i].run();
+      run_node(nodes_[block.nodes_begin + i]);
       millis = timer.MilliSeconds();
       results.time_per_node[i] += millis;
     }
@@ -847,10 +1374,7 @@ StaticRuntime::IndividualMetrics StaticRuntime::benchmark_individual_ops(
     if (static_module_.opts().cleanup_activations) {
       if (!planner_) {
         planner_ = std::make_unique<MemoryPlanner>(
-            this,
-            static_module_.shared_values(),
-            static_module_.external_values(),
-            static_module_.opts().enable_out_variant);
+            this, block, outputs_, static_module_.opts().enable_out_variant);
       }
       planner_->deallocate();
       // clean up owning refs of input tensors
@@ -887,7 +1411,7 @@ StaticRuntime::IndividualMetrics StaticRuntime::benchmark_individual_ops(
   }
 
   // post processing
-  for (size_t i = 0; i < nodes_.size(); i++) {
+  for (size_t i = 0; i < results.time_per_node.size(); i++) {
     const Node* node = nodes_[i].node();
     std::string kind = std::string(node->kind().toQualString());
     results.time_per_node[i] /= static_cast<float>(main_runs);
@@ -914,6 +1438,10 @@ void StaticRuntime::check_for_memory_leak(bool output_returned) {
   for (size_t i = 0; i < inputs_.size(); i++) {
     TORCH_CHECK(inputs_[i].isNone(), "Input ", i, " was not cleaned up");
   }
+  for (size_t i = 0; i < block_inputs_.size(); i++) {
+    TORCH_CHECK(
+        block_inputs_[i].isNone(), "Block input ", i, " was not cleaned up");
+  }
 
   std::unordered_set<const IValue*> output_ivalues(
       outputs_.begin(), outputs_.end());
@@ -947,16 +1475,23 @@ void StaticRuntime::check_for_memory_leak(bool output_returned) {
   }
 }
 
+// `outputs` are the values returned by the runtime, which deallocate() leaves
+// alone. The outputs of sub-blocks are copied out before deallocate(), so they
+// are cleaned up with the other values of the block.
 MemoryPlanner::MemoryPlanner(
     StaticRuntime* runtime,
-    const std::unordered_map<const Value*, std::vector<const Value*>>&
-        should_share,
-    const std::unordered_set<const Value*>& external_values,
+    const StaticBlockInfo& block,
+    const std::vector<IValue*>& outputs,
     bool out_variants) {
+  const auto& should_share = block.shared_values;
+  const auto& external_values = block.external_values;
+  auto& nodes = runtime->nodes();
+
   // collect register indices of outputs of ops with out variant
   std::unordered_set<const Value*> managed_values;
   std::unordered_set<IValue*> unmanaged_ivalue_set;
-  for (ProcessedNode& pnode : runtime->nodes()) {
+  for (size_t n = block.nodes_begin; n < block.nodes_end; ++n) {
+    ProcessedNode& pnode = nodes[n];
     if (canReuseInputsOutputs(pnode.node())) {
       for (auto i = 0; i < pnode.outputs().size(); ++i) {
         // Types are stored in the underlying TorchScript IR
@@ -983,10 +1518,10 @@ MemoryPlanner::MemoryPlanner(
   }
 
   // remove model outputs from managed_values and unmanaged_ivalue_set
-  for (const Value* output : runtime->graph().outputs()) {
+  for (const Value* output : block.block->outputs()) {
     managed_values.erase(output);
   }
-  for (IValue* output : runtime->outputs()) {
+  for (IValue* output : outputs) {
     unmanaged_ivalue_set.erase(output);
   }
 
@@ -1002,7 +1537,8 @@ MemoryPlanner::MemoryPlanner(
   std::unordered_set<c10::StorageImpl*> managed_storage_impls;
 
   // Snapshot of the current memory state
-  for (const auto& pnode : runtime->nodes()) {
+  for (size_t n = block.nodes_begin; n < block.nodes_end; ++n) {
+    const ProcessedNode& pnode = nodes[n];
     for (auto i = 0; i < pnode.outputs().size(); ++i) {
       const auto& ival = pnode.outputs()[i];
       const auto* val = pnode.node()->outputs()[i];
@@ -1105,6 +1641,10 @@ ProcessedNode::ProcessedNode(
     : node_(node), inputs_(std::move(inputs)) {
   // TODO leverage type information
   outputs_.resize(node->outputs().size());
+  if (node->kind() == prim::If || node->kind() == prim::Loop) {
+    // the sub-blocks are run by StaticRuntime::run_control_flow
+    return;
+  }
   if (node->kind() != prim::ListConstruct &&
       node->kind() != prim::TupleConstruct &&
       node->kind() != prim::ListUnpack) {
@@ -16,6 +16,9 @@ struct TORCH_API StaticModuleOptions {
   bool cleanup_activations{true};
   bool enable_out_variant{true};
   bool optimize_memory{true};
+  // Run the independent nodes of the top level block concurrently on the
+  // inter op thread pool, see StaticModule::dependents()
+  bool enable_inter_op_parallelism{false};
 };
 
 /// The static runime supports two execution modes.
@@ -63,6 +66,27 @@ struct TORCH_API StaticModuleOptions {
 /// @endcode
 ///
 
+/// A block of the graph run by Static Runtime: either the top level block of
+/// the graph, or a sub-block of a prim::If or prim::Loop node. The nodes of a
+/// block are contiguous in StaticModule::nodes(), the top level block coming
+/// first. Each block has its own memory planner, so the liveness analysis
+/// below only covers the nodes of the block, the nodes of its sub-blocks being
+/// accounted for as part of their prim::If or prim::Loop node.
+struct TORCH_API StaticBlockInfo {
+  Block* block{nullptr};
+  // the nodes of the block are nodes()[nodes_begin, nodes_end)
+  size_t nodes_begin{0};
+  size_t nodes_end{0};
+  // the inputs of a sub-block are stored from inputs_begin in the block inputs
+  // of StaticRuntime. The inputs of the top level block are the graph inputs.
+  size_t inputs_begin{0};
+  std::vector<std::pair<int, int>> output_indices;
+  // Output of liveness analyis. A mapping from a value to the set of values
+  // with which it could potentially share memory.
+  std::unordered_map<const Value*, std::vector<const Value*>> shared_values;
+  std::unordered_set<const Value*> external_values;
+};
+
 class MemoryPlanner;
 class ProcessedNode;
 class StaticRuntime;
@@ -106,7 +130,7 @@ class TORCH_API StaticModule {
   }
 
   inline const std::vector<std::pair<int, int>>& output_indices() const {
-    return output_indices_;
+    return blocks_[0].output_indices;
   }
 
   inline const std::vector<IValue>& constants() const {
@@ -123,11 +147,39 @@ class TORCH_API StaticModule {
 
   inline const std::unordered_map<const Value*, std::vector<const Value*>>&
   shared_values() const {
-    return shared_values_;
+    return blocks_[0].shared_values;
   }
 
   inline const std::unordered_set<const Value*>& external_values() const {
-    return external_values_;
+    return blocks_[0].external_values;
+  }
+
+  // blocks()[0] is the top level block of the graph
+  inline const std::vector<StaticBlockInfo>& blocks() const {
+    return blocks_;
+  }
+
+  // total number of inputs of the sub-blocks
+  inline size_t num_block_inputs() const {
+    return num_block_inputs_;
+  }
+
+  // With enable_inter_op_parallelism, the dependency graph of the nodes of
+  // the top level block: for each node, the nodes that must run after it,
+  // either because they use its outputs, or because one of the two nodes has
+  // side effects or writes to its inputs, and the number of nodes that must
+  // run before it.
+  inline const std::vector<std::vector<size_t>>& dependents() const {
+    return dependents_;
+  }
+
+  inline const std::vector<size_t>& num_dependencies() const {
+    return num_dependencies_;
+  }
+
+  // upper bound of the number of nodes that can run at the same time
+  inline size_t inter_op_width() const {
+    return inter_op_width_;
   }
 
   StaticRuntime& runtime();
@@ -138,14 +190,14 @@ class TORCH_API StaticModule {
   std::unique_ptr<StaticRuntime> cached_runtime_;
   // IValue table (including inputs, outputs, intermediates, and weights)
   std::vector<IValue> constants_;
-  std::vector<std::pair<int, int>> output_indices_;
   std::unordered_map<int, std::vector<std::pair<int, int>>> index_map_;
-  // The nodes we need to run
+  // The nodes we need to run, block after block
   std::vector<ProcessedNode> nodes_;
-  // Output of liveness analyis. A mapping from a value to the set of values
-  // with which it could potentially share memory.
-  std::unordered_map<const Value*, std::vector<const Value*>> shared_values_;
-  std::unordered_set<const Value*> external_values_;
+  std::vector<StaticBlockInfo> blocks_;
+  size_t num_block_inputs_{0};
+  std::vector<std::vector<size_t>> dependents_;
+  std::vector<size_t> num_dependencies_;
+  size_t inter_op_width_{1};
 
   // Original input
   std::shared_ptr<torch::jit::Graph> graph_;
@@ -225,12 +277,27 @@ class TORCH_API StaticRuntime {
   void check_for_memory_leak(bool output_returned = true);
 
  private:
+  // runs a node of the top level block or of a sub-block, including the
+  // sub-blocks of prim::If and prim::Loop nodes
+  void run_node(ProcessedNode& n);
+  void run_control_flow(ProcessedNode& n);
+  // runs the nodes of the top level block on the inter op thread pool
+  void run_nodes_inter_op();
+  void run_block(size_t block_idx);
+  void cleanup_block(size_t block_idx);
+
   // Memory planning is only enabled if sm->opts().cleanup_activations is true.
   // Otherwise, the memory used by activations is cached inside the static
   // runtime.
   std::unique_ptr<MemoryPlanner> planner_;
+  // planners of the sub-blocks, indexed like StaticModule::blocks(). The
+  // planner of the top level block is planner_.
+  std::vector<std::unique_ptr<MemoryPlanner>> block_planners_;
   std::vector<IValue> inputs_;
   std::vector<IValue*> outputs_;
+  // inputs and outputs of the sub-blocks
+  std::vector<IValue> block_inputs_;
+  std::vector<std::vector<IValue*>> block_outputs_;
   const StaticModule& static_module_;
   std::vector<ProcessedNode> nodes_;
 };
@@ -262,10 +329,12 @@ class TORCH_API StaticRuntime {
 
 class MemoryPlanner {
  public:
+  // Plans the memory of the nodes of `block`, whose outputs are
+  // `block_outputs` in `runtime`.
   explicit MemoryPlanner(
       StaticRuntime* runtime,
-      const std::unordered_map<const Value*, std::vector<const Value*>>&,
-      const std::unordered_set<const Value*>& external_values,
+      const StaticBlockInfo& block,
+      const std::vector<IValue*>& block_outputs,
       bool out_variants);
 
   void allocate();
@@ -334,6 +403,16 @@ class ProcessedNode {
     return static_cast<bool>(fn_);
   }
 
+  // the sub-blocks of a prim::If or prim::Loop node, as indices into
+  // StaticModule::blocks()
+  const std::vector<size_t>& blocks() const {
+    return blocks_;
+  }
+
+  inline void set_blocks(std::vector<size_t>&& blocks) {
+    blocks_ = std::move(blocks);
+  }
+
  private:
   Node* node_;
   c10::optional<Operation> op_;
@@ -341,6 +420,7 @@ class ProcessedNode {
   std::function<void(ProcessedNode*)> native_fn_;
   std::vector<const IValue*> inputs_; // unowned
   std::vector<IValue> outputs_;
+  std::vector<size_t> blocks_;
 };
 
 } // namespace jit
@@ -4,10 +4,12 @@
 #include <ATen/InferSize.h>
 #include <ATen/NativeFunctions.h>
 #include <ATen/TensorUtils.h>
+#include <ATen/WrapDimUtils.h>
 #include <ATen/native/EmbeddingBag.h>
 #include <ATen/native/IndexingUtils.h>
 #include <ATen/native/Resize.h>
 #include <ATen/native/TensorAdvancedIndexing.h>
+#include <ATen/native/TypeProperties.h>
 #include <ATen/native/quantized/cpu/qembeddingbag.h>
 #include <torch/csrc/jit/ir/ir.h>
 #include <torch/csrc/jit/runtime/vararg_functions.h>
@@ -326,9 +328,13 @@ REGISTER_OPERATOR_FUNCTOR(
 REGISTER_OPERATOR_FUNCTOR(aten::cat, aten_cat, [](Node* n) -> SROperator {
   return [](ProcessedNode* p_node) {
     const auto in0_tl = p_node->Input(0).toTensorVector();
-    const auto in1_i = p_node->Input(1).toInt();
+    TORCH_CHECK(!in0_tl.empty(), "expected a non-empty list of Tensors");
+    const auto in1_i = at::legacy_cat_wrap_dim(p_node->Input(1).toInt(), in0_tl);
     if (p_node->Output(0).isNone()) {
-      p_node->Output(0) = create_empty_from(in0_tl[0]);
+      // the output keeps its storage across runs, so _cat_out_cpu writes
+      // every input straight into the planned buffer
+      p_node->Output(0) =
+          create_empty_from(in0_tl[0], at::native::result_type(in0_tl));
     }
     auto& out_t = p_node->Output(0).toTensor();
     fastResizeToZero(out_t);
@@ -0,0 +1,509 @@
+#include <torch/csrc/jit/runtime/symbolic_shape_registry.h>
+
+#include <torch/csrc/jit/frontend/ir_emitter.h>
+#include <torch/csrc/jit/passes/inliner.h>
+#include <torch/csrc/jit/runtime/operator.h>
+
+#include <mutex>
+#include <unordered_map>
+
+namespace torch {
+namespace jit {
+namespace {
+std::mutex lock;
+
+const std::string shape_compute_functions =
+    R"(
+        ####     SHAPE COMPUTE FUNCTIONS    ###
+        def unary(self: List[int]):
+          out: List[int] = []
+          for elem in self:
+            out.append(elem)
+          return out
+
+        def broadcast(a: List[int], b: List[int]):
+          dimsA = len(a)
+          dimsB = len(b)
+          ndim = max(dimsA, dimsB)
+          expandedSizes: List[int] = []
+          for i in range(ndim):
+            offset = ndim - 1 - i
+            dimA = dimsA - 1 - offset
+            dimB = dimsB - 1 - offset
+            # a missing dim takes the other size as is, which keeps a symbolic
+            # size rather than merging it with a 1
+            if dimA < 0:
+              expandedSizes.append(b[dimB])
+            elif dimB < 0:
+              expandedSizes.append(a[dimA])
+            else:
+              sizeA = a[dimA]
+              sizeB = b[dimB]
+              # the size is picked through the value of the If rather than by
+              # appending in its branches, so that two equal symbolic sizes,
+              # or a symbolic size and a 1, still give a known size
+              if sizeA == 1:
+                size = sizeB
+              else:
+                if sizeB != 1 and sizeA != sizeB:
+                  raise AssertionError("The size of tensor a must match the size of tensor b at non-singleton dimension")
+                size = sizeA
+              expandedSizes.append(size)
+          return expandedSizes
+
+        def maybe_wrap_dim(dim: int, dim_post_expr: int, wrap_scalar: bool = True):
+          if dim_post_expr <= 0:
+            assert wrap_scalar
+            dim_post_expr = 1
+          lo = -dim_post_expr
+          hi = dim_post_expr - 1
+          assert not (dim < lo or dim > hi)
+          if dim < 0:
+            dim += dim_post_expr
+          return dim
+
+        def multiply_integers(li: List[int]):
+          out = 1
+          for elem in li:
+            out = out * elem
+          return out
+
+        def mm(self: List[int], mat2: List[int]):
+          assert len(self) == 2, "self must be a matrix"
+          assert len(mat2) == 2, "mat2 must be a matrix"
+          assert self[1] == mat2[0]
+          return [self[0], mat2[1]]
+
+        def bmm(self: List[int], mat2: List[int]):
+          assert len(self) == 3, "self must be a 3D tensor"
+          assert len(mat2) == 3, "mat2 must be a 3D tensor"
+          assert self[0] == mat2[0]
+          assert self[2] == mat2[1]
+          return [self[0], self[1], mat2[2]]
+
+        def dot(self: List[int], tensor: List[int]):
+          assert len(self) == 1 and len(tensor) == 1
+          assert self[0] == tensor[0]
+          out: List[int] = []
+          return out
+
+        def mv(self: List[int], vec: List[int]):
+          assert len(self) == 2 and len(vec) == 1
+          assert self[1] == vec[0]
+          return [self[0]]
+
+        def addmm(self: List[int], mat1: List[int], mat2: List[int]):
+          return broadcast(self, mm(mat1, mat2))
+
+        def unsqueeze(li: List[int], dim: int):
+          dim = maybe_wrap_dim(dim, len(li) + 1)
+          out: List[int] = []
+          for i in range(len(li)):
+            if i == dim:
+              out.append(1)
+            out.append(li[i])
+          if dim == len(li):
+            out.append(1)
+          return out
+
+        def squeeze(li: List[int], dim: int):
+          wrapped_dim = maybe_wrap_dim(dim, len(li))
+          out: List[int] = []
+          for i in range(len(li)):
+            if i == wrapped_dim:
+              if li[i] != 1:
+                out.append(li[i])
+            else:
+              out.append(li[i])
+          return out
+
+        def select(self: List[int], dim: int, index: int):
+          ndim = len(self)
+          assert ndim != 0
+          dim = maybe_wrap_dim(dim, ndim)
+          out: List[int] = []
+          for i in range(ndim):
+            if i != dim:
+              out.append(self[i])
+          return out
+
+        def t(self: List[int]):
+          assert len(self) <= 2
+          self_len = len(self)
+          if self_len == 0:
+            out: List[int] = []
+            return out
+          elif self_len == 1:
+            return [self[0]]
+          else:
+            return [self[1], self[0]]
+
+        def transpose(self: List[int], dim0: int, dim1: int):
+          ndims = len(self)
+          dim0 = maybe_wrap_dim(dim0, ndims)
+          dim1 = maybe_wrap_dim(dim1, ndims)
+          out: List[int] = []
+          for i in range(ndims):
+            if i == dim0:
+              out.append(self[dim1])
+            elif i == dim1:
+              out.append(self[dim0])
+            else:
+              out.append(self[i])
+          return out
+
+        def permute(input: List[int], dims: List[int]):
+          assert len(input) == len(dims)
+          ndim = len(dims)
+          out: List[int] = []
+          for i in range(ndim):
+            out.append(input[maybe_wrap_dim(dims[i], ndim)])
+          return out
+
+        def infer_size_impl(shape: List[int], numel: int) -> List[int]:
+          newsize = 1
+          infer_dim: Optional[int] = None
+          for dim in range(len(shape)):
+            if shape[dim] == -1:
+              if infer_dim is not None:
+                raise AssertionError("only one dimension can be inferred")
+              infer_dim = dim
+            elif shape[dim] >= 0:
+              newsize *= shape[dim]
+            else:
+              raise AssertionError("invalid shape dimensions")
+          if not (numel == newsize or (infer_dim is not None and newsize > 0 and numel % newsize == 0)):
+            raise AssertionError("invalid shape")
+          out: List[int] = []
+          for dim in range(len(shape)):
+            if infer_dim is not None and dim == infer_dim:
+              out.append(numel // newsize)
+            else:
+              out.append(shape[dim])
+          return out
+
+        def view(self: List[int], sizes: List[int]):
+          return infer_size_impl(sizes, multiply_integers(self))
+
+        def expand_as(self: List[int], other: List[int]):
+          return unary(other)
+
+        def flatten(input: List[int], start_dim: int, end_dim: int):
+          start_dim = maybe_wrap_dim(start_dim, len(input))
+          end_dim = maybe_wrap_dim(end_dim, len(input))
+          assert start_dim <= end_dim
+          if len(input) == 0:
+            return [1]
+          if start_dim == end_dim:
+            return unary(input)
+          slice_numel = 1
+          for i in range(start_dim, end_dim + 1):
+            slice_numel *= input[i]
+          shape: List[int] = []
+          for i in range(start_dim):
+            shape.append(input[i])
+          shape.append(slice_numel)
+          for i in range(end_dim + 1, len(input)):
+            shape.append(input[i])
+          return shape
+
+        def cat(tensors: List[List[int]], dim: int):
+          assert len(tensors) > 0
+          ndim = len(tensors[0])
+          out_dim = maybe_wrap_dim(dim, ndim)
+          cat_dim_size = 0
+          for size in tensors:
+            assert len(size) == ndim
+            cat_dim_size = cat_dim_size + size[out_dim]
+          out: List[int] = []
+          for i in range(ndim):
+            if i == out_dim:
+              out.append(cat_dim_size)
+            else:
+              out.append(tensors[0][i])
+          return out
+
+        def mean_dim(self: List[int], dims: List[int], keep_dim: bool):
+          out: List[int] = []
+          for idx in range(len(self)):
+            # an empty dims reduces all the dims, as in make_dim_mask
+            is_mean_dim: bool = len(dims) == 0
+            for reduce_dim in dims:
+              if idx == maybe_wrap_dim(reduce_dim, len(self)):
+                is_mean_dim = True
+            if is_mean_dim:
+              if keep_dim:
+                out.append(1)
+            else:
+              out.append(self[idx])
+          return out
+
+        def matmul(tensor1: List[int], tensor2: List[int]):
+          dim_tensor1 = len(tensor1)
+          dim_tensor2 = len(tensor2)
+          if dim_tensor1 == 1 and dim_tensor2 == 1:
+            return dot(tensor1, tensor2)
+          elif dim_tensor1 == 2 and dim_tensor2 == 1:
+            return mv(tensor1, tensor2)
+          elif dim_tensor1 == 1 and dim_tensor2 == 2:
+            return squeeze(mm(unsqueeze(tensor1, 0), tensor2), 0)
+          elif dim_tensor1 == 2 and dim_tensor2 == 2:
+            return mm(tensor1, tensor2)
+          elif dim_tensor1 >= 1 and dim_tensor2 >= 1:
+            # the batch dims are broadcast, the matrix dims multiplied
+            n = tensor1[-2] if dim_tensor1 > 1 else 1
+            batch_tensor1: List[int] = []
+            for i in range(dim_tensor1 - 2):
+              batch_tensor1.append(tensor1[i])
+            p = tensor2[-1]
+            batch_tensor2: List[int] = []
+            for i in range(dim_tensor2 - 2):
+              batch_tensor2.append(tensor2[i])
+            output_shape = broadcast(batch_tensor1, batch_tensor2)
+            if dim_tensor1 > 1:
+              output_shape.append(n)
+            if dim_tensor2 > 1:
+              output_shape.append(p)
+            return output_shape
+          else:
+            raise AssertionError("both arguments to matmul need to be at least 1D")
+
+        def linear(input: List[int], weight: List[int]):
+          return matmul(input, t(weight))
+
+        def embedding(weight: List[int], indices: List[int]):
+          assert len(weight) == 2
+          out = unary(indices)
+          out.append(weight[1])
+          return out
+
+        def conv_output_size(input_size: List[int], weight_size: List[int], bias: Optional[List[int]], stride: List[int], padding: List[int], dilation: List[int], groups: int):
+          dim = len(input_size)
+          assert dim == len(weight_size)
+          output_size: List[int] = []
+          output_size.append(input_size[0])
+          output_size.append(weight_size[0])
+          for d in range(2, dim):
+            kernel = dilation[d - 2] * (weight_size[d] - 1) + 1
+            output_size.append((input_size[d] + (2 * padding[d - 2]) - kernel) // stride[d - 2] + 1)
+          return output_size
+
+        def pooling_output_shape(inputSize: int, kernelSize: int, pad: int, stride: int, dilation: int, ceil_mode: bool):
+          assert stride != 0, "stride should not be zero"
+          numerator = inputSize + 2 * pad - dilation * (kernelSize - 1) - 1 + (stride - 1 if ceil_mode else 0)
+          outputSize = numerator // stride + 1
+          if ceil_mode:
+            # ensure that the last pooling starts inside the image
+            if (outputSize - 1) * stride >= inputSize + pad:
+              outputSize = outputSize - 1
+          return outputSize
+
+        def pool2d(input: List[int], kernel_size: List[int], stride: List[int], padding: List[int], dilation: List[int], ceil_mode: bool):
+          assert len(kernel_size) == 1 or len(kernel_size) == 2
+          kH = kernel_size[0]
+          kW = kH if len(kernel_size) == 1 else kernel_size[1]
+          assert len(stride) == 0 or len(stride) == 1 or len(stride) == 2
+          dH = kH if len(stride) == 0 else stride[0]
+          dW = kW if len(stride) == 0 else (dH if len(stride) == 1 else stride[1])
+          assert len(padding) == 1 or len(padding) == 2
+          padH = padding[0]
+          padW = padH if len(padding) == 1 else padding[1]
+          assert len(dilation) == 1 or len(dilation) == 2
+          dilationH = dilation[0]
+          dilationW = dilationH if len(dilation) == 1 else dilation[1]
+          assert len(input) == 3 or len(input) == 4
+          nInputPlane = input[-3]
+          outputHeight = pooling_output_shape(input[-2], kH, padH, dH, dilationH, ceil_mode)
+          outputWidth = pooling_output_shape(input[-1], kW, padW, dW, dilationW, ceil_mode)
+          if len(input) == 3:
+            return [nInputPlane, outputHeight, outputWidth]
+          else:
+            return [input[-4], nInputPlane, outputHeight, outputWidth]
+
+        def max_pool2d(input: List[int], kernel_size: List[int], stride: List[int], padding: List[int], dilation: List[int], ceil_mode: bool):
+          return pool2d(input, kernel_size, stride, padding, dilation, ceil_mode)
+
+        def avg_pool2d(input: List[int], kernel_size: List[int], stride: List[int], padding: List[int], ceil_mode: bool):
+          return pool2d(input, kernel_size, stride, padding, [1], ceil_mode)
+
+        def adaptive_avg_pool2d(self: List[int], out: List[int]):
+          assert len(out) == 2
+          assert len(self) == 3 or len(self) == 4
+          shape: List[int] = []
+          for i in range(0, len(self) - 2):
+            shape.append(self[i])
+          for elem in out:
+            shape.append(elem)
+          return shape
+    )";
+
+// Shape functions only take the leading arguments of the schema they are
+// registered for, see symbolic_shape_registry.h
+const std::vector<std::pair<const char*, const char*>> schema_to_function = {
+    {"aten::relu(Tensor self) -> Tensor", "unary"},
+    {"aten::sigmoid(Tensor self) -> Tensor", "unary"},
+    {"aten::tanh(Tensor self) -> Tensor", "unary"},
+    {"aten::gelu(Tensor self) -> Tensor", "unary"},
+    {"aten::hardswish(Tensor self) -> Tensor", "unary"},
+    {"aten::hardsigmoid(Tensor self) -> Tensor", "unary"},
+    {"aten::hardtanh(Tensor self, Scalar min_val=-1, Scalar max_val=1) -> Tensor",
+     "unary"},
+    {"aten::leaky_relu(Tensor self, Scalar negative_slope=0.01) -> Tensor",
+     "unary"},
+    {"aten::silu(Tensor self) -> Tensor", "unary"},
+    {"aten::elu(Tensor self, Scalar alpha=1, Scalar scale=1, Scalar input_scale=1) -> Tensor",
+     "unary"},
+    {"aten::clamp(Tensor self, Scalar? min=None, Scalar? max=None) -> Tensor",
+     "unary"},
+    {"aten::abs(Tensor self) -> Tensor", "unary"},
+    {"aten::neg(Tensor self) -> Tensor", "unary"},
+    {"aten::exp(Tensor self) -> Tensor", "unary"},
+    {"aten::log(Tensor self) -> Tensor", "unary"},
+    {"aten::sqrt(Tensor self) -> Tensor", "unary"},
+    {"aten::rsqrt(Tensor self) -> Tensor", "unary"},
+    {"aten::erf(Tensor self) -> Tensor", "unary"},
+    {"aten::dropout(Tensor input, float p, bool train) -> Tensor", "unary"},
+    {"aten::contiguous(Tensor(a) self, *, MemoryFormat memory_format=contiguous_format) -> Tensor(a)",
+     "unary"},
+    {"aten::softmax.int(Tensor self, int dim, ScalarType? dtype=None) -> Tensor",
+     "unary"},
+    {"aten::log_softmax.int(Tensor self, int dim, ScalarType? dtype=None) -> Tensor",
+     "unary"},
+    {"aten::batch_norm(Tensor input, Tensor? weight, Tensor? bias, Tensor? running_mean, Tensor? running_var, bool training, float momentum, float eps, bool cudnn_enabled) -> Tensor",
+     "unary"},
+    {"aten::layer_norm(Tensor input, int[] normalized_shape, Tensor? weight=None, Tensor? bias=None, float eps=1e-05, bool cudnn_enable=True) -> Tensor",
+     "unary"},
+    {"aten::_add_layer_norm(Tensor input, Tensor residual, int[] normalized_shape, Tensor? weight, Tensor? bias, float eps, str activation=\"none\") -> Tensor",
+     "unary"},
+    {"aten::add.Scalar(Tensor self, Scalar other, Scalar alpha=1) -> Tensor",
+     "unary"},
+    {"aten::sub.Scalar(Tensor self, Scalar other, Scalar alpha=1) -> Tensor",
+     "unary"},
+    {"aten::mul.Scalar(Tensor self, Scalar other) -> Tensor", "unary"},
+    {"aten::div.Scalar(Tensor self, Scalar other) -> Tensor", "unary"},
+    {"aten::pow.Tensor_Scalar(Tensor self, Scalar exponent) -> Tensor",
+     "unary"},
+    {"aten::add.Tensor(Tensor self, Tensor other, *, Scalar alpha=1) -> Tensor",
+     "broadcast"},
+    {"aten::sub.Tensor(Tensor self, Tensor other, *, Scalar alpha=1) -> Tensor",
+     "broadcast"},
+    {"aten::mul.Tensor(Tensor self, Tensor other) -> Tensor", "broadcast"},
+    {"aten::div.Tensor(Tensor self, Tensor other) -> Tensor", "broadcast"},
+    {"aten::pow.Tensor_Tensor(Tensor self, Tensor exponent) -> Tensor",
+     "broadcast"},
+    {"aten::maximum(Tensor self, Tensor other) -> Tensor", "broadcast"},
+    {"aten::minimum(Tensor self, Tensor other) -> Tensor", "broadcast"},
+    {"aten::eq.Tensor(Tensor self, Tensor other) -> Tensor", "broadcast"},
+    {"aten::ne.Tensor(Tensor self, Tensor other) -> Tensor", "broadcast"},
+    {"aten::lt.Tensor(Tensor self, Tensor other) -> Tensor", "broadcast"},
+    {"aten::gt.Tensor(Tensor self, Tensor other) -> Tensor", "broadcast"},
+    {"aten::le.Tensor(Tensor self, Tensor other) -> Tensor", "broadcast"},
+    {"aten::ge.Tensor(Tensor self, Tensor other) -> Tensor", "broadcast"},
+    {"aten::mm(Tensor self, Tensor mat2) -> Tensor", "mm"},
+    {"aten::bmm(Tensor self, Tensor mat2) -> Tensor", "bmm"},
+    {"aten::dot(Tensor self, Tensor tensor) -> Tensor", "dot"},
+    {"aten::mv(Tensor self, Tensor vec) -> Tensor", "mv"},
+    {"aten::matmul(Tensor self, Tensor other) -> Tensor", "matmul"},
+    {"aten::linear(Tensor input, Tensor weight, Tensor? bias=None) -> Tensor",
+     "linear"},
+    {"aten::addmm(Tensor self, Tensor mat1, Tensor mat2, *, Scalar beta=1, Scalar alpha=1) -> Tensor",
+     "addmm"},
+    {"aten::t(Tensor(a) self) -> Tensor(a)", "t"},
+    {"aten::transpose.int(Tensor(a) self, int dim0, int dim1) -> Tensor(a)",
+     "transpose"},
+    {"aten::unsqueeze(Tensor(a) self, int dim) -> Tensor(a)", "unsqueeze"},
+    {"aten::squeeze.dim(Tensor(a) self, int dim) -> Tensor(a)", "squeeze"},
+    {"aten::select.int(Tensor(a) self, int dim, int index) -> Tensor(a)",
+     "select"},
+    {"aten::permute(Tensor(a) self, int[] dims) -> Tensor(a)", "permute"},
+    {"aten::view(Tensor(a) self, int[] size) -> Tensor(a)", "view"},
+    {"aten::reshape(Tensor(a) self, int[] shape) -> Tensor(a)", "view"},
+    {"aten::expand_as(Tensor(a) self, Tensor other) -> Tensor(a)",
+     "expand_as"},
+    {"aten::flatten.using_ints(Tensor(a) self, int start_dim=0, int end_dim=-1) -> Tensor(a)",
+     "flatten"},
+    {"aten::cat(Tensor[] tensors, int dim=0) -> Tensor", "cat"},
+    {"aten::mean.dim(Tensor self, int[1] dim, bool keepdim=False, *, ScalarType? dtype=None) -> Tensor",
+     "mean_dim"},
+    {"aten::sum.dim_IntList(Tensor self, int[1] dim, bool keepdim=False, *, ScalarType? dtype=None) -> Tensor",
+     "mean_dim"},
+    {"aten::embedding(Tensor weight, Tensor indices, int padding_idx=-1, bool scale_grad_by_freq=False, bool sparse=False) -> Tensor",
+     "embedding"},
+    {"aten::conv1d(Tensor input, Tensor weight, Tensor? bias=None, int[1] stride=1, int[1] padding=0, int[1] dilation=1, int groups=1) -> Tensor",
+     "conv_output_size"},
+    {"aten::conv2d(Tensor input, Tensor weight, Tensor? bias=None, int[2] stride=1, int[2] padding=0, int[2] dilation=1, int groups=1) -> Tensor",
+     "conv_output_size"},
+    {"aten::conv3d(Tensor input, Tensor weight, Tensor? bias=None, int[3] stride=1, int[3] padding=0, int[3] dilation=1, int groups=1) -> Tensor",
+     "conv_output_size"},
+    {"aten::max_pool2d(Tensor self, int[2] kernel_size, int[2] stride=[], int[2] padding=0, int[2] dilation=1, bool ceil_mode=False) -> Tensor",
+     "max_pool2d"},
+    {"aten::avg_pool2d(Tensor self, int[2] kernel_size, int[2] stride=[], int[2] padding=0, bool ceil_mode=False, bool count_include_pad=True, int? divisor_override=None) -> Tensor",
+     "avg_pool2d"},
+    {"aten::adaptive_avg_pool2d(Tensor self, int[2] output_size) -> Tensor",
+     "adaptive_avg_pool2d"},
+};
+
+// Keyed by the schema of the registered operator, which lives as long as the
+// operator does.
+std::unordered_map<const FunctionSchema*, std::shared_ptr<Graph>>
+    cached_schema_to_graph;
+
+// CompilationUnit that holds all these Functions and keeps them alive.
+CompilationUnit compilation_unit;
+
+void checkShapeComputeGraph(
+    const FunctionSchema& schema,
+    const std::shared_ptr<Graph>& graph) {
+  TORCH_INTERNAL_ASSERT(
+      graph->inputs().size() <= schema.arguments().size(),
+      "Shape function for ",
+      schema,
+      " takes more arguments than the operator");
+  TORCH_INTERNAL_ASSERT(graph->outputs().size() == 1);
+}
+
+void loadFunctions() {
+  compilation_unit.define(
+      c10::nullopt, shape_compute_functions, nativeResolver(), nullptr);
+
+  for (const auto& pair : schema_to_function) {
+    const FunctionSchema& schema = getOperatorForLiteral(pair.first)->schema();
+    auto graph = compilation_unit.get_function(pair.second).graph()->copy();
+    // the helpers are called from the shape functions, inline them so the
+    // whole computation can be folded
+    Inline(*graph);
+    checkShapeComputeGraph(schema, graph);
+    cached_schema_to_graph[&schema] = graph;
+  }
+}
+
+void ensureLoaded() {
+  if (cached_schema_to_graph.size() == 0) {
+    loadFunctions();
+  }
+}
+
+} // anonymous namespace
+
+c10::optional<std::shared_ptr<Graph>> shapeComputeGraphForSchema(
+    const FunctionSchema& schema) {
+  std::lock_guard<std::mutex> guard(lock);
+  ensureLoaded();
+  auto cache_it = cached_schema_to_graph.find(&schema);
+  if (cache_it != cached_schema_to_graph.end()) {
+    return cache_it->second;
+  }
+  return c10::nullopt;
+}
+
+void RegisterShapeComputeGraphForSchema(
+    const FunctionSchema& schema,
+    std::shared_ptr<Graph> graph) {
+  std::lock_guard<std::mutex> guard(lock);
+  ensureLoaded();
+  checkShapeComputeGraph(schema, graph);
+  cached_schema_to_graph[&schema] = std::move(graph);
+}
+
+} // namespace jit
+} // namespace torch
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <torch/csrc/jit/api/module.h>
+
+namespace torch {
+namespace jit {
+
+/*
+Shape functions compute the output sizes of an operator from the sizes of its
+inputs. They are TorchScript graphs whose inputs line up with the leading
+arguments of the operator schema: Tensor arguments are passed as their sizes
+(List[int]), Tensor[] arguments as List[List[int]] and all other arguments
+as is. Trailing arguments that don't affect the output shape (alpha, eps,
+dtype, ...) can be left out. The graph returns the output sizes as a
+List[int].
+
+See symbolic_shape_analysis.h for how they are evaluated.
+*/
+
+TORCH_API c10::optional<std::shared_ptr<Graph>> shapeComputeGraphForSchema(
+    const FunctionSchema& schema);
+
+// Registers (or replaces) the shape function of `schema`, which must be the
+// schema of a registered operator.
+TORCH_API void RegisterShapeComputeGraphForSchema(
+    const FunctionSchema& schema,
+    std::shared_ptr<Graph> graph);
+
+} // namespace jit
+} // namespace torch
@@ -101,6 +101,13 @@ TORCH_API void writeArchiveAndTensors(
 using ExportModuleExtraFilesHook = std::function<ExtraFilesMap(const Module&)>;
 TORCH_API void SetExportModuleExtraFilesHook(ExportModuleExtraFilesHook hook);
 
+// When enabled, the pickles of saved modules and mobile data are streamed
+// into the archive as they are produced instead of being built in memory
+// first. This changes the layout of the archive: a streamed pickle is written
+// with a zip data descriptor, and before its tensors. Off by default.
+TORCH_API void SetExportStreamPickles(bool enabled);
+TORCH_API bool GetExportStreamPickles();
+
 using ExportModuleMobileInfoConverter =
     std::function<c10::Dict<std::string, std::string>(
         const Module&,
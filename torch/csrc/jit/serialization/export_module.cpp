@@ -23,6 +23,7 @@
 
 #include <ATen/core/jit_type.h>
 #include <ATen/core/qualified_name.h>
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -38,6 +39,11 @@ ExportModuleExtraFilesHook& GetExtraFilesHook() {
   return func;
 }
 
+std::atomic<bool>& GetExportStreamPicklesFlag() {
+  static std::atomic<bool> enabled{false};
+  return enabled;
+}
+
 ExportModuleMobileInfoConverter& GetMobileInfoConverter() {
   static ExportModuleMobileInfoConverter func = nullptr;
   return func;
@@ -352,6 +358,14 @@ void SetExportModuleExtraFilesHook(ExportModuleExtraFilesHook hook) {
   GetExtraFilesHook() = std::move(hook);
 }
 
+void SetExportStreamPickles(bool enabled) {
+  GetExportStreamPicklesFlag() = enabled;
+}
+
+bool GetExportStreamPickles() {
+  return GetExportStreamPicklesFlag();
+}
+
 void SetExportModuleMobileInfoConverter(
     ExportModuleMobileInfoConverter converter) {
   GetMobileInfoConverter() = std::move(converter);
@@ -398,9 +412,20 @@ class ScriptModuleSerializer {
     std::vector<char> data;
     // Vector to capture the run-time class types during pickling the IValues
     std::vector<c10::ClassTypePtr> memoizedClassTypes;
+    // A streamed pickle goes into the archive as it is produced; its tensors
+    // are only known once pickling is done, so they are written after it.
+    const bool stream = GetExportStreamPickles();
+    std::string fname = archive_name + ".pkl";
+    if (stream) {
+      writer_.startRecord(fname);
+    }
     Pickler data_pickle(
         [&](const char* buf, size_t size) {
-          data.insert(data.end(), buf, buf + size);
+          if (stream) {
+            writer_.writeRecordChunk(buf, size);
+          } else {
+            data.insert(data.end(), buf, buf + size);
+          }
         },
         nullptr,
         [&](const c10::ClassTypePtr& t) {
@@ -410,15 +435,21 @@ class ScriptModuleSerializer {
     data_pickle.protocol();
     data_pickle.pushIValue(value);
     data_pickle.stop();
+    if (stream) {
+      writer_.endRecord();
+    }
     size_t i = 0;
     std::string prefix = archive_name + "/";
     for (const auto& td : data_pickle.tensorData()) {
       WriteableTensorData writable_td = getWriteableTensorData(td);
-      std::string fname = prefix + c10::to_string(i++);
-      writer_.writeRecord(fname, writable_td.data(), writable_td.sizeInBytes());
+      writer_.writeRecord(
+          prefix + c10::to_string(i++),
+          writable_td.data(),
+          writable_td.sizeInBytes());
+    }
+    if (!stream) {
+      writer_.writeRecord(fname, data.data(), data.size());
     }
-    std::string fname = archive_name + ".pkl";
-    writer_.writeRecord(fname, data.data(), data.size());
 
     // serialize all the captured run-time class types
     for (const c10::ClassTypePtr& wroteType : memoizedClassTypes) {
@@ -65,23 +65,9 @@ IValue readArchiveAndTensors(
     c10::optional<at::Device> device,
     PyTorchStreamReader& stream_reader) {
   std::string picklename = archive_name + ".pkl";
-  at::DataPtr pickle_ptr;
-  size_t pickle_size;
-  std::tie(pickle_ptr, pickle_size) = stream_reader.getRecord(picklename);
-
-  size_t bytes_read = 0;
-  auto data = reinterpret_cast<const char*>(pickle_ptr.get());
-  auto reader = [&](char* buffer, size_t len) -> size_t {
-    if (bytes_read >= pickle_size) {
-      return 0;
-    }
-    len = std::min(pickle_size - bytes_read, len);
-    // Copy len bytes into buffer
-    const char* start = data + bytes_read;
-    std::memcpy(buffer, start, len);
-    bytes_read += len;
-    return len;
-  };
+  // Feed the unpickler straight from the archive in bounded chunks rather than
+  // loading the whole pickle into memory first.
+  auto reader = stream_reader.getRecordReader(picklename);
 
   std::string archive_name_plus_slash = archive_name + "/";
   auto read_record = [&](const std::string& name) {
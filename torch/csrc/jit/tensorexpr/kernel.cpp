@@ -1,11 +1,13 @@
 #include <torch/csrc/jit/tensorexpr/kernel.h>
 
 #include <ATen/ExpandUtils.h>
+#include <ATen/Parallel.h>
 #include <ATen/TensorGeometry.h>
 #include <c10/util/string_utils.h>
 #include <torch/csrc/jit/jit_log.h>
 #include <torch/csrc/jit/passes/utils/subgraph_utils.h>
 #include <torch/csrc/jit/tensorexpr/analysis.h>
+#include <torch/csrc/jit/tensorexpr/ir_mutator.h>
 #include <torch/csrc/jit/tensorexpr/ir_printer.h>
 #include <torch/csrc/jit/tensorexpr/ir_simplifier.h>
 #include <torch/csrc/jit/tensorexpr/loopnest.h>
@@ -23,6 +25,8 @@ static int te_cuda_pointwise_block_size = -1;
 static bool fallback_allowed = false;
 static bool te_generate_block_code = false;
 static bool te_must_use_llvm_on_cpu = true;
+static bool te_parallelize_on_cpu = false;
+static int64_t te_cpu_parallel_threshold = at::internal::GRAIN_SIZE;
 static bool cat_wo_conditionals = false; // NOLINT
 
 bool setFallbackAllowed(bool value) {
@@ -88,6 +92,14 @@ bool& getTEMustUseLLVMOnCPU() {
   return te_must_use_llvm_on_cpu;
 }
 
+bool& getTEParallelizeOnCPU() {
+  return te_parallelize_on_cpu;
+}
+
+int64_t& getTECPUParallelThreshold() {
+  return te_cpu_parallel_threshold;
+}
+
 bool& getCatWoConditionals() {
   return cat_wo_conditionals;
 }
@@ -1533,12 +1545,218 @@ Tensor* TensorExprKernel::computeValue(const torch::jit::Value* v) {
       return computeSoftmax(v, true);
     }
 
+    case aten::matmul:
+    case aten::mm:
+    case aten::conv2d:
+    case aten::adaptive_avg_pool2d: {
+      return computeExternalCall(v);
+    }
+
     default: {
       throw std::runtime_error("Unhandled node kind");
     }
   }
 }
 
+namespace {
+
+constexpr int kReductionVectorWidth = 8;
+
+// Returns the constant trip count of a loop, or -1 if it is not known at
+// compile time.
+int64_t constantTripCount(const For* f) {
+  const Expr* extent =
+      IRSimplifier::simplify(new Sub(f->stop(), f->start()));
+  if (!extent->isConstant()) {
+    return -1;
+  }
+  return immediateAs<int64_t>(extent);
+}
+
+// Drops the output indices from the accesses to an rfactor buffer. The buffer
+// is only live within one iteration of the output loops, so it can shrink to
+// a single vector of partial results.
+class RfactorBufCompressor : public IRMutator {
+ public:
+  explicit RfactorBufCompressor(const Buf* buf) : buf_(buf) {}
+
+  const Expr* mutate(const Load* v) override {
+    if (v->buf() != buf_) {
+      return IRMutator::mutate(v);
+    }
+    return new Load(
+        v->dtype(),
+        buf_,
+        {v->indices().back()->accept_mutator(this)},
+        v->mask()->accept_mutator(this));
+  }
+
+  Stmt* mutate(const Store* v) override {
+    if (v->buf() != buf_) {
+      return IRMutator::mutate(v);
+    }
+    return new Store(
+        buf_,
+        {v->indices().back()->accept_mutator(this)},
+        v->value()->accept_mutator(this),
+        v->mask()->accept_mutator(this));
+  }
+
+ private:
+  const Buf* buf_;
+};
+
+// Vectorizes single-axis reductions whose reduction loop is innermost:
+//
+//   for r in 0..R:                 for ri in 0..8:         (vectorized)
+//     acc = acc + in[r]     =>       tmp[ri] = 0
+//                                  for ro in 0..R/8:
+//                                    for ri in 0..8:       (vectorized)
+//                                      tmp[ri] = tmp[ri] + in[ro * 8 + ri]
+//                                  for ri in 0..8:
+//                                    acc = acc + tmp[ri]
+//                                  <tail loop over r>
+//
+// The partial sums live in a small buffer that is allocated here, in the
+// innermost scope enclosing the reduction. Each iteration of the outer loops
+// then has its own partial sums, so they stay parallelizable.
+void vectorizeReductions(LoopNest& l) {
+  for (auto* reduce_op : NodeFinder<ReduceOp>::find(l.root_stmt())) {
+    if (reduce_op->reduce_args().size() != 1) {
+      continue;
+    }
+    const Var* reduce_var = reduce_op->reduce_args()[0];
+    For* reduce_loop = nullptr;
+    for (auto* store : NodeFinder<Store>::find(l.root_stmt())) {
+      if (store->value() == reduce_op) {
+        reduce_loop = LoopNest::getParentLoop(store);
+        break;
+      }
+    }
+    if (!reduce_loop || reduce_loop->var() != reduce_var ||
+        constantTripCount(reduce_loop) < 2 * kReductionVectorWidth) {
+      continue;
+    }
+
+    For *outer, *inner, *tail;
+    LoopNest::splitWithTail(
+        reduce_loop, kReductionVectorWidth, &outer, &inner, &tail);
+    auto reduces = NodeFinder<ReduceOp>::find(outer);
+    if (reduces.size() != 1) {
+      continue;
+    }
+    Buf* rfac_buf = nullptr;
+    l.rfactor(reduces[0], inner->var(), nullptr, &rfac_buf);
+    if (!rfac_buf) {
+      continue;
+    }
+
+    // The initializer of the rfactor buffer is the shallowest loop writing to
+    // it, and sits in the block enclosing all the uses of the buffer.
+    For* init_loop = nullptr;
+    for (For* loop : l.getAllInnermostLoopsWritingToBuf(rfac_buf)) {
+      if (!init_loop ||
+          LoopNest::getEnclosingLoopNest(loop).size() <
+              LoopNest::getEnclosingLoopNest(init_loop).size()) {
+        init_loop = loop;
+      }
+    }
+    Block* parent =
+        init_loop ? dynamic_cast<Block*>(init_loop->get_parent()) : nullptr;
+    if (!parent) {
+      continue;
+    }
+    RfactorBufCompressor compressor(rfac_buf);
+    std::vector<Stmt*> stmts(parent->begin(), parent->end());
+    for (Stmt* stmt : stmts) {
+      Stmt* new_stmt = stmt->accept_mutator(&compressor);
+      if (new_stmt != stmt) {
+        parent->replace_stmt(stmt, new_stmt);
+      }
+    }
+    rfac_buf->set_dims({new IntImm(kReductionVectorWidth)});
+    parent->prepend_stmt(new Allocate(rfac_buf));
+    parent->append_stmt(new Free(rfac_buf));
+
+    for (For* loop : l.getAllInnermostLoopsWritingToBuf(rfac_buf)) {
+      LoopNest::vectorize(loop);
+    }
+  }
+}
+
+// Estimates the number of elements a statement computes, counting every lane
+// of a vectorized store. Returns -1 if the statement has dynamic loop bounds.
+int64_t estimateWork(const Stmt* s) {
+  if (auto* f = dynamic_cast<const For*>(s)) {
+    int64_t trip_count = constantTripCount(f);
+    int64_t body_work = estimateWork(f->body());
+    if (trip_count < 0 || body_work < 0) {
+      return -1;
+    }
+    return trip_count * body_work;
+  }
+  if (auto* b = dynamic_cast<const Block*>(s)) {
+    int64_t work = 0;
+    for (const Stmt* stmt : b->stmts()) {
+      int64_t stmt_work = estimateWork(stmt);
+      if (stmt_work < 0) {
+        return -1;
+      }
+      work += stmt_work;
+    }
+    return work;
+  }
+  if (auto* store = dynamic_cast<const Store*>(s)) {
+    return store->value()->dtype().lanes();
+  }
+  return 1;
+}
+
+// Returns the variables of the outermost loops of the top-level loop nests
+// that do enough work to amortize the dispatch onto the thread pool and whose
+// iterations are independent. Loops with dynamic bounds are left serial. This
+// has to run before prepareForCodegen(), which flattens the indices of stores
+// and so hides whether a store is indexed by the loop variable.
+std::unordered_set<const Var*> findParallelizableOuterLoops(LoopNest& l) {
+  std::unordered_set<const Var*> loop_vars;
+  Block* root = dynamic_cast<Block*>(l.root_stmt());
+  if (!root) {
+    return loop_vars;
+  }
+  for (Stmt* s : *root) {
+    For* f = dynamic_cast<For*>(s);
+    if (!f || constantTripCount(f) < 2) {
+      continue;
+    }
+    if (estimateWork(f) < getTECPUParallelThreshold()) {
+      continue;
+    }
+    if (LoopNest::isParallelizable(f)) {
+      loop_vars.insert(f->var());
+    }
+  }
+  return loop_vars;
+}
+
+// Marks the top-level loops found by findParallelizableOuterLoops() as
+// parallel. Lowering keeps the loop variables, so they identify the loops.
+void parallelizeOuterLoops(
+    LoopNest& l,
+    const std::unordered_set<const Var*>& loop_vars) {
+  Block* root = dynamic_cast<Block*>(l.root_stmt());
+  if (!root) {
+    return;
+  }
+  for (Stmt* s : *root) {
+    For* f = dynamic_cast<For*>(s);
+    if (f && loop_vars.count(f->var()) && f->loop_options().isDefault()) {
+      LoopNest::setParallel(f);
+    }
+  }
+}
+
+} // namespace
+
 Stmt* TensorExprKernel::transformLoops(BackendType backendType, Stmt* st) {
   torch::jit::tensorexpr::LoopNest l(st, bufOutputs_);
   GRAPH_DEBUG("Original Stmt:\n", std::to_string(l.root_stmt()), "\n");
@@ -1631,12 +1849,25 @@ Stmt* TensorExprKernel::transformLoops(BackendType backendType, Stmt* st) {
     }
   }
 
+  if (backendType == kLLVMCodeGen && hasReduction) {
+    vectorizeReductions(l);
+  }
+
+  std::unordered_set<const Var*> parallel_loop_vars;
+  if (backendType == kLLVMCodeGen && getTEParallelizeOnCPU()) {
+    parallel_loop_vars = findParallelizableOuterLoops(l);
+  }
+
   l.prepareForCodegen();
 
   if (backendType == kLLVMCodeGen && !hasReduction) {
     l.vectorizeInnerLoops();
   }
 
+  if (!parallel_loop_vars.empty()) {
+    parallelizeOuterLoops(l, parallel_loop_vars);
+  }
+
   Stmt* stmt = l.root_stmt();
   // Arithmetic Simplification.
   stmt = IRSimplifier::simplify(stmt);
@@ -2082,6 +2313,92 @@ Tensor* TensorExprKernel::computeCatWoConditionals(const torch::jit::Value* v) {
   return new Tensor(output_buf, IRSimplifier::simplify(block));
 }
 
+Tensor* TensorExprKernel::computeExternalCall(const torch::jit::Value* v) {
+  auto const& n = v->node();
+  auto dtype = findDtypeForValue(v);
+  if (!dtype) {
+    throw malformed_input("dtype of external call output is not known");
+  }
+
+  std::vector<BufHandle> bufArgs;
+  std::vector<ExprHandle> extraArgs;
+  auto addBufArg = [&](const torch::jit::Value* arg) {
+    bufArgs.emplace_back(tensors_.at(arg->unique())->buf());
+  };
+  // The fuser only lets in constant int arguments
+  auto intConstant = [](const torch::jit::Value* arg) {
+    auto ival = toIValue(arg);
+    if (!ival || !ival->isInt()) {
+      throw malformed_input("expected a constant int");
+    }
+    return ival->toInt();
+  };
+  auto intPair = [](const torch::jit::Value* arg) {
+    auto ival = toIValue(arg);
+    if (!ival || !ival->isIntList() || ival->toIntVector().size() != 2) {
+      throw malformed_input("expected a constant list of two ints");
+    }
+    return ival->toIntVector();
+  };
+
+  std::string externalFunction;
+  switch (n->kind()) {
+    case aten::matmul: {
+      externalFunction = "nnc_aten_matmul";
+      addBufArg(n->input(0));
+      addBufArg(n->input(1));
+    } break;
+
+    case aten::mm: {
+      externalFunction = "nnc_aten_mm";
+      addBufArg(n->input(0));
+      addBufArg(n->input(1));
+    } break;
+
+    case aten::conv2d: {
+      externalFunction = "nnc_aten_conv2d";
+      addBufArg(n->input(0));
+      addBufArg(n->input(1));
+      // nnc_aten_conv2d takes the convolution parameters only along with a
+      // bias, without one it runs with the defaults.
+      if (!n->input(2)->type()->cast<NoneType>()) {
+        addBufArg(n->input(2));
+        auto stride = intPair(n->input(3));
+        auto padding = intPair(n->input(4));
+        auto dilation = intPair(n->input(5));
+        int64_t groups = intConstant(n->input(6));
+        extraArgs = {
+            stride[0],
+            stride[1],
+            padding[0],
+            padding[1],
+            dilation[0],
+            dilation[1],
+            groups};
+      }
+    } break;
+
+    case aten::adaptive_avg_pool2d: {
+      externalFunction = "nnc_aten_adaptive_avg_pool2d";
+      addBufArg(n->input(0));
+      auto outputSize = intPair(n->input(1));
+      extraArgs = {outputSize[0], outputSize[1]};
+    } break;
+
+    default: {
+      throw std::runtime_error("Unhandled node kind");
+    }
+  }
+
+  BufHandle resultBuf(
+      "nnc_" + std::string(n->kind().toUnqualString()),
+      sizesForValue(v),
+      ToDtype(*dtype));
+  return new Tensor(
+      resultBuf.node(),
+      ExternalCall::make(resultBuf, externalFunction, bufArgs, extraArgs));
+}
+
 TensorExprKernel::ReductionInfo TensorExprKernel::getReductionInfo(
     const torch::jit::Node* node) {
   std::vector<size_t> axes;
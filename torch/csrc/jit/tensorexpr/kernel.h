@@ -142,6 +142,10 @@ class TORCH_API TensorExprKernel {
 
   Tensor* computeCatWoConditionals(const torch::jit::Value* v);
 
+  // Lowers ops that TE has no loops for into calls of the ATen kernels
+  // registered in external_functions.cpp.
+  Tensor* computeExternalCall(const torch::jit::Value* v);
+
   Tensor* computeValue(const torch::jit::Value* v);
 
   Stmt* transformLoops(BackendType backendType, Stmt* st);
@@ -214,6 +218,8 @@ TORCH_API int& getTECudaPointwiseBlockCount();
 TORCH_API int& getTECudaPointwiseBlockSize();
 TORCH_API bool& getTEGenerateBlockCode();
 TORCH_API bool& getTEMustUseLLVMOnCPU();
+TORCH_API bool& getTEParallelizeOnCPU();
+TORCH_API int64_t& getTECPUParallelThreshold();
 TORCH_API bool fallbackAllowed();
 TORCH_API bool setFallbackAllowed(bool value);
 TORCH_API bool& getCatWoConditionals();
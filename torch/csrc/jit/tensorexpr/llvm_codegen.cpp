@@ -2,8 +2,10 @@
 
 #include <torch/csrc/jit/tensorexpr/llvm_codegen.h>
 
+#include <ATen/Parallel.h>
 #include <c10/util/Exception.h>
 #include <torch/csrc/jit/tensorexpr/llvm_jit.h>
+#include <exception>
 
 #include <memory>
 
@@ -32,6 +34,7 @@
 #include <llvm/Support/TypeSize.h>
 #endif
 
+#include <torch/csrc/jit/tensorexpr/analysis.h>
 #include <torch/csrc/jit/tensorexpr/execution_counter.h>
 #include <torch/csrc/jit/tensorexpr/expr.h>
 #include <torch/csrc/jit/tensorexpr/external_functions_registry.h>
@@ -53,6 +56,39 @@ C10_DEFINE_bool(
 DEFINE_TRIGGER(llvm_codegen_created);
 DEFINE_TRIGGER(llvm_codegen_executed);
 
+// Runtime entry point for loops marked as parallel. The generated code outlines
+// the body of a parallel loop into a function taking the loop index and a
+// pointer to the captured values, and calls this helper to run it on the ATen
+// intra-op thread pool. Like the NNC external functions, it must not throw
+// into the generated code, which has no unwind information: the exception is
+// kept and rethrown by LLVMCodeGen::call once the generated code returns.
+typedef void (*ParallelCallee)(int64_t index, int8_t* packed_data);
+
+namespace {
+thread_local std::exception_ptr parallel_dispatch_exception;
+} // namespace
+
+void DispatchParallel(
+    int8_t* func,
+    int64_t start,
+    int64_t stop,
+    int8_t* packed_data) noexcept {
+  if (parallel_dispatch_exception) {
+    // An earlier parallel loop of this call failed, its outputs are garbage.
+    return;
+  }
+  try {
+    ParallelCallee callee = reinterpret_cast<ParallelCallee>(func);
+    at::parallel_for(start, stop, 1, [&](int64_t f_begin, int64_t f_end) {
+      for (int64_t index = f_begin; index < f_end; index++) {
+        callee(index, packed_data);
+      }
+    });
+  } catch (...) {
+    parallel_dispatch_exception = std::current_exception();
+  }
+}
+
 namespace torch {
 namespace jit {
 namespace tensorexpr {
@@ -218,6 +254,8 @@ class LLVMCodeGenImpl : public IRVisitor {
 
   void emitIsNan(const Intrinsics* v);
 
+  void processParallelFor(const For* v);
+
   llvm::Value* emitUnmaskedLoad(llvm::Value* addr, llvm::Value* idx);
   llvm::Value* emitMaskedLoad(
       llvm::Value* addr,
@@ -291,6 +329,11 @@ void LLVMCodeGen::call(const std::vector<CallArg>& args) {
     argv[i] = argToPtr(bufferArg, callArg);
   }
   value<float>(argv);
+  if (parallel_dispatch_exception) {
+    std::exception_ptr e = parallel_dispatch_exception;
+    parallel_dispatch_exception = nullptr;
+    std::rethrow_exception(e);
+  }
   USE_TRIGGER(llvm_codegen_executed);
 }
 
@@ -1129,6 +1172,11 @@ void LLVMCodeGenImpl::visit(const Load* v) {
 }
 
 void LLVMCodeGenImpl::visit(const For* v) {
+  if (v->loop_options().is_parallel()) {
+    processParallelFor(v);
+    return;
+  }
+
   // Create "start" and "stop" values.
   v->start()->accept(this);
   auto start = this->value_;
@@ -1393,6 +1441,119 @@ struct FunctionCallee {
 
 } // namespace
 
+void LLVMCodeGenImpl::processParallelFor(const For* v) {
+  // Create "start" and "stop" values.
+  v->start()->accept(this);
+  auto start = this->value_;
+  v->stop()->accept(this);
+  auto stop = this->value_;
+
+  // Find the values defined outside of the loop that its body refers to:
+  // kernel arguments, enclosing loop indices, lets and allocated buffers.
+  // These are captured into a struct on the caller's stack and forwarded to
+  // the outlined body.
+  std::vector<const Var*> captured_vars;
+  std::vector<llvm::Value*> captured_vals;
+  for (const Var* var : VarFinder::find(v->body())) {
+    if (var == v->var()) {
+      continue;
+    }
+    if (varToArg_.count(var)) {
+      captured_vars.push_back(var);
+      captured_vals.push_back(fn_->arg_begin() + varToArg_.at(var));
+    } else if (varToVal_.count(var)) {
+      captured_vars.push_back(var);
+      captured_vals.push_back(varToVal_.at(var));
+    }
+  }
+
+  std::vector<llvm::Type*> captured_types;
+  for (llvm::Value* val : captured_vals) {
+    captured_types.push_back(val->getType());
+  }
+  llvm::StructType* packed_ty =
+      llvm::StructType::create(getContext(), captured_types, "parallel_args");
+
+  // Allocate the closure in the entry block so that a parallel loop nested in
+  // a serial one does not grow the stack on every iteration.
+  llvm::IRBuilder<> entry_irb(
+      &fn_->getEntryBlock(), fn_->getEntryBlock().getFirstInsertionPt());
+  llvm::Value* packed_caller_args = entry_irb.CreateAlloca(packed_ty);
+  for (size_t i = 0; i < captured_vals.size(); i++) {
+    auto gep = irb_.CreateStructGEP(packed_ty, packed_caller_args, i);
+    irb_.CreateStore(captured_vals[i], gep);
+  }
+
+  // Emit the outlined body: void func(int64_t index, int8_t* packed_args).
+  llvm::BasicBlock* caller_block = irb_.GetInsertBlock();
+  llvm::Function* caller_fn = fn_;
+  auto func_type = llvm::FunctionType::get(
+      llvm::Type::getVoidTy(getContext()), {LongTy_, Int8PtrTy_}, false);
+  llvm::Function* func = llvm::Function::Create(
+      func_type, llvm::Function::PrivateLinkage, "parallel_body", module_.get());
+  auto func_body = llvm::BasicBlock::Create(getContext(), "entry", func);
+  irb_.SetInsertPoint(func_body);
+
+  auto func_args = func->arg_begin();
+  llvm::Value* index = irb_.CreateIntCast(func_args++, IntTy_, true);
+  llvm::Value* packed_func_args =
+      irb_.CreatePointerCast(func_args++, packed_ty->getPointerTo());
+
+  // Inside the outlined function every captured Var resolves to the value
+  // unpacked from the closure, including the kernel arguments.
+  auto caller_var_to_arg = std::move(varToArg_);
+  varToArg_.clear();
+  std::unordered_map<const Var*, llvm::Value*> caller_var_to_val;
+  for (size_t i = 0; i < captured_vars.size(); i++) {
+    const Var* var = captured_vars[i];
+    if (varToVal_.count(var)) {
+      caller_var_to_val[var] = varToVal_.at(var);
+    }
+    auto gep = irb_.CreateStructGEP(packed_ty, packed_func_args, i);
+    varToVal_[var] = irb_.CreateLoad(captured_types[i], gep);
+  }
+  if (varToVal_.count(v->var())) {
+    throw std::runtime_error("var should not exist before");
+  }
+  varToVal_.emplace(v->var(), index);
+
+  fn_ = func;
+  if (v->body()) {
+    v->body()->accept(this);
+  }
+  irb_.CreateRetVoid();
+  fn_ = caller_fn;
+
+  // Restore the caller's view of the captured Vars.
+  varToVal_.erase(v->var());
+  for (const Var* var : captured_vars) {
+    varToVal_.erase(var);
+  }
+  for (auto const& kv : caller_var_to_val) {
+    varToVal_[kv.first] = kv.second;
+  }
+  varToArg_ = std::move(caller_var_to_arg);
+
+  // Call the dispatcher from the original insertion point.
+  irb_.SetInsertPoint(caller_block);
+  FunctionCallee dispatcher = module_->getOrInsertFunction(
+      "DispatchParallel",
+      llvm::FunctionType::get(
+          llvm::Type::getVoidTy(getContext()),
+          {Int8PtrTy_, LongTy_, LongTy_, Int8PtrTy_},
+          false));
+  llvm::cast<llvm::Function>(dispatcher.getCallee())
+      ->addFnAttr(llvm::Attribute::NoUnwind);
+  irb_.CreateCall(
+      dispatcher.getFunctionType(),
+      dispatcher.getCallee(),
+      {irb_.CreatePointerCast(func, Int8PtrTy_),
+       irb_.CreateIntCast(start, LongTy_, true),
+       irb_.CreateIntCast(stop, LongTy_, true),
+       irb_.CreatePointerCast(packed_caller_args, Int8PtrTy_)});
+  value_ = llvm::ConstantInt::get(IntTy_, 0);
+}
+
 llvm::Value* LLVMCodeGenImpl::toVec(llvm::Value* v, int lanes) {
   if (lanes > 1) {
     return irb_.CreateVectorSplat(lanes, v);
@@ -1794,7 +1955,12 @@ void LLVMCodeGenImpl::visit(const Allocate* v) {
 
   if (llvm::ConstantInt* CI = llvm::dyn_cast<llvm::ConstantInt>(size)) {
     if (CI->getSExtValue() < 512) {
-      llvm::Value* alloca = irb_.CreateAlloca(dtypeToLLVM(v->dtype()), size);
+      // Emit the alloca in the entry block, so that buffers allocated inside a
+      // loop body do not grow the stack on every iteration.
+      llvm::IRBuilder<> entry_irb(
+          &fn_->getEntryBlock(), fn_->getEntryBlock().getFirstInsertionPt());
+      llvm::Value* alloca =
+          entry_irb.CreateAlloca(dtypeToLLVM(v->dtype()), size);
       varToVal_[v->buffer_var()] = alloca;
       return;
     }
@@ -84,6 +84,9 @@ static void registerIntrinsics(
   }
   assertSuccess(JD.define(absoluteSymbols(symbols)));
 
+  assertSuccess(JD.define(
+      absoluteSymbols({entry("DispatchParallel", &DispatchParallel)})));
+
   for (const auto& kv : getNNCFunctionRegistry()) {
     assertSuccess(
         JD.define(absoluteSymbols({entry(kv.first.c_str(), kv.second)})));
@@ -12,6 +12,16 @@
 #include <memory>
 #include <string>
 
+// Runs the outlined body of a parallel loop on the ATen intra-op thread pool.
+// Called from LLVM-generated code, see LLVMCodeGenImpl::processParallelFor.
+extern "C" {
+TORCH_API void DispatchParallel(
+    int8_t* func,
+    int64_t start,
+    int64_t stop,
+    int8_t* packed_data) noexcept;
+}
+
 namespace torch {
 namespace jit {
 namespace tensorexpr {
@@ -792,8 +792,10 @@ void LoopNest::inlineIntermediateBufs(bool allow_duplicated_work) {
       // tensors, always inline, bc we are not duplicating any work
       // and avoiding an intermediary buffer
       if (stores.size() == 1) {
+        // the store can also be an ExternalCall, which is never inlined
         auto store = dynamic_cast<Store*>(stores[0].s);
-        auto input_as_load = dynamic_cast<const Load*>(store->value());
+        auto input_as_load =
+            store ? dynamic_cast<const Load*>(store->value()) : nullptr;
         if (input_as_load && input_bufs.count(input_as_load->buf())) {
           bufs_to_inline.insert(buf);
           continue;
@@ -948,9 +950,17 @@ Stmt* LoopNest::insertAllocFree(Stmt* stmt) {
 
   std::unordered_map<const Buf*, std::vector<BufLoadOrStoreUse>> uses =
       findLoadOrStoreUses(stmt);
+  // Buffers that a transformation already allocated keep their allocation.
+  std::unordered_set<const Var*> allocated_bufs;
+  for (auto const* alloc : NodeFinder<Allocate>::find(stmt)) {
+    allocated_bufs.insert(alloc->buffer_var());
+  }
   // Insert allocations and frees for temporary buffers in the innermost
   // possible scope.
   for (const Buf* buf : intermediate_bufs) {
+    if (allocated_bufs.count(buf->base_handle())) {
+      continue;
+    }
     Stmt* alloc = new Allocate(buf);
     Stmt* free = new Free(buf);
     Block* alloc_block = findLowestContainingBlock(uses.at(buf));
@@ -1630,6 +1640,51 @@ void LoopNest::setGPUThreadIndex(For* f, int thread_index) {
   f->set_gpu_thread_index(thread_index);
 }
 
+bool LoopNest::isParallelizable(const For* f) {
+  if (!f->loop_options().isDefault()) {
+    return false;
+  }
+  if (!NodeFinder<ExternalCall>::find(f->body()).empty() ||
+      !NodeFinder<AtomicAdd>::find(f->body()).empty()) {
+    return false;
+  }
+  // Buffers allocated inside the body are private to each iteration.
+  std::unordered_set<const Var*> local_bufs;
+  for (auto const* alloc : NodeFinder<Allocate>::find(f->body())) {
+    local_bufs.insert(alloc->buffer_var());
+  }
+  std::unordered_set<const Var*> stored_bufs;
+  for (auto const* store : NodeFinder<Store>::find(f->body())) {
+    if (local_bufs.count(store->base_handle())) {
+      continue;
+    }
+    // An index that is the loop variable itself makes the stores of
+    // different iterations disjoint; e.g. A[i / 2] is not.
+    bool indexedByLoopVar = false;
+    for (const Expr* idx : store->indices()) {
+      if (idx == f->var()) {
+        indexedByLoopVar = true;
+        break;
+      }
+    }
+    if (!indexedByLoopVar) {
+      return false;
+    }
+    stored_bufs.insert(store->base_handle());
+  }
+  // A load may read what another iteration stores, e.g. A[i] = A[i + 1].
+  for (auto const* load : NodeFinder<Load>::find(f->body())) {
+    if (stored_bufs.count(load->base_handle())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void LoopNest::setParallel(For* f) {
+  f->set_parallel();
+}
+
 void LoopNest::setBufferMap(
     For* f,
     const std::unordered_map<std::string, const Buf*>& map) {
@@ -2332,6 +2387,17 @@ void LoopNest::rfactor(
     const Expr* r,
     const Var* reduction_var,
     Block* insertion_point) {
+  rfactor(r, reduction_var, insertion_point, nullptr);
+}
+
+void LoopNest::rfactor(
+    const Expr* r,
+    const Var* reduction_var,
+    Block* insertion_point,
+    Buf** rfac_buf_ptr) {
+  if (rfac_buf_ptr) {
+    *rfac_buf_ptr = nullptr;
+  }
   ReduceOp* reduce_op = dynamic_cast<ReduceOp*>(
       const_cast<Expr*>(r)); // NOLINT: TODO add update()
   if (!reduce_op) {
@@ -2521,6 +2587,10 @@ void LoopNest::rfactor(
 
   std::vector<const Expr*> tmp_dims = getBoundExtents(bounds_it->second);
   tmp_buf->set_dims(tmp_dims);
+
+  if (rfac_buf_ptr) {
+    *rfac_buf_ptr = tmp_buf;
+  }
 }
 
 } // namespace tensorexpr
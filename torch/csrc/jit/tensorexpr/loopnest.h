@@ -120,6 +120,17 @@ class TORCH_API LoopNest {
   void setGPUBlockIndex(For* f, int idx);
   void setGPUThreadIndex(For* f, int idx);
 
+  // Returns true if the iterations of the given loop can run concurrently:
+  // every store in its body must either have the loop variable itself as one
+  // of its indices or go to a buffer allocated inside the body, the body must
+  // not load from the buffers it stores to, and it must not contain external
+  // calls, which write whole buffers. This is conservative: reductions lowered
+  // by prepareForCodegen() read their accumulator and are left serial.
+  static bool isParallelizable(const For* f);
+  // Marks the loop as parallel. Codegens that support it (currently LLVM)
+  // dispatch its iterations onto the ATen intra-op thread pool.
+  static void setParallel(For* f);
+
   using AccessResult = std::pair<const Buf*, Stmt*>;
   // Insert a cache for the consumer's usages of the buffer produced in
   // consumer, and redirect reads and writes in the consumer to that cache.
@@ -139,6 +150,13 @@ class TORCH_API LoopNest {
       const Expr* f,
       const Var* reduction_var,
       Block* insertion_point = nullptr /* optional */);
+  // Same as above, and returns the newly created temporary buffer in
+  // `rfac_buf_ptr`, or nullptr if the reduction could not be rfactored.
+  void rfactor(
+      const Expr* f,
+      const Var* reduction_var,
+      Block* insertion_point,
+      Buf** rfac_buf_ptr);
 
   void setBufferMap(
       For* f,
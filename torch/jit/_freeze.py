@@ -113,6 +113,8 @@ def optimize_frozen_module(mod, optimize_numerics: bool = True):
         - Conv -> Batchnorm folding
         - Conv -> Add/Sub folding
         - Conv -> Mul/Div folding
+        - Batching of independent same-shape Linear/matmul with frozen weights
+        - Add -> LayerNorm fusion
 
     Args:
         mod (:class:`ScriptModule`): a frozen module to be optimized
@@ -121,7 +123,7 @@ def optimize_frozen_module(mod, optimize_numerics: bool = True):
         preserve numerics. These optimizations preserve default rtol and atol of `torch.testing.assert_allclose`
         when applied on a single transformation, however in a module where many transformations are applied
         the rtol or atol may no longer fall within the default `assert_allclose` tolerance. Conv -> Batchnorm folding,
-        Conv-Add/Sub, and Conv -> Mul/Div folding all may alter numerics.
+        Conv-Add/Sub, Conv -> Mul/Div folding and Linear batching all may alter numerics.
 
     Returns:
         None
@@ -153,3 +155,5 @@ def optimize_frozen_module(mod, optimize_numerics: bool = True):
             torch._C._jit_pass_fold_frozen_conv_bn(mod.graph)
             torch._C._jit_pass_fold_frozen_conv_add_or_sub(mod.graph)
             torch._C._jit_pass_fold_frozen_conv_mul_or_div(mod.graph)
+        torch._C._jit_pass_batch_frozen_linears(mod.graph)
+    torch._C._jit_pass_fuse_add_layer_norm(mod.graph)